@@ -6,7 +6,10 @@
 
 // Entry Point
 //============
-uniform float2 g_position_offset;
+// The per-draw constants are set directly into registers (see UniformRingBuffer.h):
+// xy is the position offset and zw is the position scale
+// (which turns quantized positions back into the mesh's local space)
+uniform float4 g_drawConstants : register( c0 );
 void main(
 
 	// Input
@@ -18,6 +21,10 @@ void main(
 	// These values come from one of the sVertex that we filled the vertex buffer with in C code
 	in const float2 i_position : POSITION,
 	in const float4 i_color : COLOR,
+#if defined( EAE6320_INSTANCED )
+	// When instancing this comes from a second stream that only advances once per instance
+	in const float2 i_instance_offset : TEXCOORD0,
+#endif
 
 	// Output
 	//=======
@@ -41,11 +48,12 @@ void main(
 	{
 		// When we move to 3D graphics the screen position that the vertex shader outputs
 		// will be different than the position that is input to it from C code,
-		// but for now the "out" position is set directly from the "in" position:
-		o_position = float4( i_position + g_position_offset, 0.0, 1.0 );
-		// Or, equivalently:
-		// o_position = float4( i_position.xy, 0.0, 1.0 );
-		// o_position = float4( i_position, 0.0, 1.0 );
+		// but for now the "out" position is the "in" position (dequantized) plus the offset:
+		float2 position = ( i_position * g_drawConstants.zw ) + g_drawConstants.xy;
+#if defined( EAE6320_INSTANCED )
+		position += i_instance_offset;
+#endif
+		o_position = float4( position, 0.0, 1.0 );
 	}
 	// Pass the input color to the fragment shader unchanged:
 	{
@@ -68,7 +76,18 @@ void main(
 layout( location = 0 ) in vec2 i_position;
 layout( location = 1 ) in vec4 i_color;
 
-uniform vec2 g_position_offset;
+#if defined( EAE6320_INSTANCED )
+// When instancing this comes from a buffer whose attribute divisor is 1
+// (i.e. it only advances once per instance)
+layout( location = 2 ) in vec2 i_instance_offset;
+#endif
+// The per-draw constants come from a range of the uniform ring buffer (see UniformRingBuffer.h).
+// The scale turns quantized positions back into the mesh's local space
+layout( std140 ) uniform DrawConstants
+{
+	vec2 g_position_offset;
+	vec2 g_position_scale;
+};
 
 // Output
 //=======
@@ -95,11 +114,12 @@ void main()
 	{
 		// When we move to 3D graphics the screen position that the vertex shader outputs
 		// will be different than the position that is input to it from C code,
-		// but for now the "out" position is set directly from the "in" position:
-		gl_Position = vec4( i_position + g_position_offset, 0.0, 1.0 );
-		// Or, equivalently:
-		// gl_Position = vec4( i_position.xy, 0.0, 1.0 );
-		// gl_Position = vec4( i_position, 0.0, 1.0 );
+		// but for now the "out" position is the "in" position (dequantized) plus the offset:
+		vec2 position = ( i_position * g_position_scale ) + g_position_offset;
+#if defined( EAE6320_INSTANCED )
+		position += i_instance_offset;
+#endif
+		gl_Position = vec4( position, 0.0, 1.0 );
 	}
 	// Pass the input color to the fragment shader unchanged:
 	{
@@ -0,0 +1,457 @@
+// Header Files
+//=============
+
+#include "EntityStore.h"
+
+#include <cassert>
+
+#include "JobSystem.h"
+#include "../Memory/Memory.h"
+#include "../Graphics/RenderQueue.h"
+#include "../Math/cFrustum.h"
+
+// Static Data Initialization
+//===========================
+
+const eae6320::Core::sEntityHandle eae6320::Core::InvalidEntity = { ~0u, 0 };
+
+namespace
+{
+	// A slot that isn't in use maps to this
+	const uint32_t s_invalidDenseIndex = ~0u;
+	// Small enough that a few thousand entities are split between threads
+	// but big enough that a job's overhead is insignificant compared to its work
+	const uint32_t s_entitiesPerJob = 1024;
+
+	struct sIntegrateJob
+	{
+		float* positionsX;
+		float* positionsY;
+		const float* velocitiesX;
+		const float* velocitiesY;
+		float secondsElapsed;
+	};
+	struct sUpdateRenderablesJob
+	{
+		const float* positionsX;
+		const float* positionsY;
+		eae6320::Graphics::Renderable* renderables;
+	};
+	struct sSubmitRenderablesJob
+	{
+		eae6320::Graphics::Renderable* renderables;
+		eae6320::Graphics::sDrawPacket* packets;
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void IntegrateRange( const uint32_t i_begin, const uint32_t i_end, void* io_userData );
+	void UpdateRenderablesRange( const uint32_t i_begin, const uint32_t i_end, void* io_userData );
+	void SubmitRenderablesRange( const uint32_t i_begin, const uint32_t i_end, void* io_userData );
+}
+
+// Interface
+//==========
+
+// Entities
+//---------
+
+eae6320::Core::sEntityHandle eae6320::Core::EntityStore::Create( const char* i_meshPath )
+{
+	const sEntityHandle entity = AllocateEntity();
+	if ( !m_renderables.back().Initialize( i_meshPath ) )
+	{
+		Destroy( entity );
+		return InvalidEntity;
+	}
+	SetBoundsFromMesh( static_cast<uint32_t>( m_entities.size() - 1 ) );
+	return entity;
+}
+
+eae6320::Core::sEntityHandle eae6320::Core::EntityStore::CreateAsync( const char* i_meshPath )
+{
+	const sEntityHandle entity = AllocateEntity();
+	if ( !m_renderables.back().InitializeAsync( i_meshPath ) )
+	{
+		Destroy( entity );
+		return InvalidEntity;
+	}
+	if ( m_renderables.back().IsReady() )
+	{
+		// The asset loader wasn't initialized, and so it was loaded immediately
+		SetBoundsFromMesh( static_cast<uint32_t>( m_entities.size() - 1 ) );
+	}
+	else
+	{
+		m_loadingEntities.push_back( entity );
+	}
+	return entity;
+}
+
+eae6320::Core::sEntityHandle eae6320::Core::EntityStore::Create( const sEntityHandle i_shareRenderableWith )
+{
+	uint32_t sourceIndex;
+	if ( !GetDenseIndex( i_shareRenderableWith, sourceIndex ) )
+	{
+		return InvalidEntity;
+	}
+	const sEntityHandle entity = AllocateEntity();
+	// AllocateEntity() can reallocate the array, and so the source must be looked up afterwards
+	if ( !m_renderables.back().Initialize( m_renderables[sourceIndex] ) )
+	{
+		Destroy( entity );
+		return InvalidEntity;
+	}
+	if ( m_renderables.back().IsReady() )
+	{
+		SetBoundsFromMesh( static_cast<uint32_t>( m_entities.size() - 1 ) );
+	}
+	else
+	{
+		// The source is still loading
+		m_loadingEntities.push_back( entity );
+	}
+	return entity;
+}
+
+bool eae6320::Core::EntityStore::Destroy( const sEntityHandle i_entity )
+{
+	uint32_t denseIndex;
+	if ( !GetDenseIndex( i_entity, denseIndex ) )
+	{
+		return false;
+	}
+
+	m_renderables[denseIndex].ShutDown();
+
+	// Move the last entity into the hole
+	const uint32_t lastIndex = static_cast<uint32_t>( m_entities.size() - 1 );
+	if ( denseIndex != lastIndex )
+	{
+		const sEntityHandle movedEntity = m_entities[lastIndex];
+		m_entities[denseIndex] = movedEntity;
+		m_positionsX[denseIndex] = m_positionsX[lastIndex];
+		m_positionsY[denseIndex] = m_positionsY[lastIndex];
+		m_velocitiesX[denseIndex] = m_velocitiesX[lastIndex];
+		m_velocitiesY[denseIndex] = m_velocitiesY[lastIndex];
+		m_renderables[denseIndex] = m_renderables[lastIndex];
+		m_boundsCentersX[denseIndex] = m_boundsCentersX[lastIndex];
+		m_boundsCentersY[denseIndex] = m_boundsCentersY[lastIndex];
+		m_boundsRadii[denseIndex] = m_boundsRadii[lastIndex];
+		m_denseIndices[movedEntity.slot] = denseIndex;
+	}
+	m_entities.pop_back();
+	m_positionsX.pop_back();
+	m_positionsY.pop_back();
+	m_velocitiesX.pop_back();
+	m_velocitiesY.pop_back();
+	m_renderables.pop_back();
+	m_boundsCentersX.pop_back();
+	m_boundsCentersY.pop_back();
+	m_boundsRadii.pop_back();
+	m_spatialIndex.Remove( i_entity.slot );
+
+	// Retire the handle
+	m_denseIndices[i_entity.slot] = s_invalidDenseIndex;
+	++m_generations[i_entity.slot];
+	m_freeSlots.push_back( i_entity.slot );
+
+	return true;
+}
+
+bool eae6320::Core::EntityStore::IsAlive( const sEntityHandle i_entity ) const
+{
+	uint32_t denseIndex;
+	return GetDenseIndex( i_entity, denseIndex );
+}
+
+void eae6320::Core::EntityStore::DestroyAll()
+{
+	// Entities that share another entity's renderable don't own anything,
+	// but the ones that they share from do, and so the order doesn't matter here
+	while ( !m_entities.empty() )
+	{
+		Destroy( m_entities.back() );
+	}
+}
+
+// Components
+//-----------
+
+float* eae6320::Core::EntityStore::GetPositionX( const sEntityHandle i_entity )
+{
+	uint32_t denseIndex;
+	return GetDenseIndex( i_entity, denseIndex ) ? &m_positionsX[denseIndex] : NULL;
+}
+
+float* eae6320::Core::EntityStore::GetPositionY( const sEntityHandle i_entity )
+{
+	uint32_t denseIndex;
+	return GetDenseIndex( i_entity, denseIndex ) ? &m_positionsY[denseIndex] : NULL;
+}
+
+float* eae6320::Core::EntityStore::GetVelocityX( const sEntityHandle i_entity )
+{
+	uint32_t denseIndex;
+	return GetDenseIndex( i_entity, denseIndex ) ? &m_velocitiesX[denseIndex] : NULL;
+}
+
+float* eae6320::Core::EntityStore::GetVelocityY( const sEntityHandle i_entity )
+{
+	uint32_t denseIndex;
+	return GetDenseIndex( i_entity, denseIndex ) ? &m_velocitiesY[denseIndex] : NULL;
+}
+
+eae6320::Graphics::Renderable* eae6320::Core::EntityStore::GetRenderable( const sEntityHandle i_entity )
+{
+	uint32_t denseIndex;
+	return GetDenseIndex( i_entity, denseIndex ) ? &m_renderables[denseIndex] : NULL;
+}
+
+// Systems
+//--------
+
+void eae6320::Core::EntityStore::Integrate( const float i_secondsElapsed )
+{
+	sIntegrateJob job;
+	job.positionsX = GetPositionsX();
+	job.positionsY = GetPositionsY();
+	job.velocitiesX = GetVelocitiesX();
+	job.velocitiesY = GetVelocitiesY();
+	job.secondsElapsed = i_secondsElapsed;
+	JobSystem::ParallelFor( static_cast<uint32_t>( m_entities.size() ), s_entitiesPerJob, IntegrateRange, &job );
+}
+
+void eae6320::Core::EntityStore::UpdateRenderables()
+{
+	sUpdateRenderablesJob job;
+	job.positionsX = GetPositionsX();
+	job.positionsY = GetPositionsY();
+	job.renderables = GetRenderables();
+	JobSystem::ParallelFor( static_cast<uint32_t>( m_entities.size() ), s_entitiesPerJob, UpdateRenderablesRange, &job );
+}
+
+void eae6320::Core::EntityStore::SubmitRenderables( Graphics::RenderQueue& io_renderQueue )
+{
+	const uint32_t count = static_cast<uint32_t>( m_entities.size() );
+	sSubmitRenderablesJob job;
+	job.renderables = GetRenderables();
+	// Every job fills in its own part of the queue
+	job.packets = io_renderQueue.AllocatePackets( count );
+	JobSystem::ParallelFor( count, s_entitiesPerJob, SubmitRenderablesRange, &job );
+}
+
+void eae6320::Core::EntityStore::SubmitVisibleRenderables( Graphics::RenderQueue& io_renderQueue, const Math::cFrustum& i_frustum,
+	const Graphics::sLodSettings& i_lodSettings )
+{
+	UpdateSpatialIndex();
+
+	// Find the entities that are in cells that can be seen
+	m_cullingCandidates.clear();
+	const unsigned int culledByGridCount = m_spatialIndex.Query( i_frustum, m_cullingCandidates );
+
+	// Gather the candidates' world-space bounding spheres into contiguous arrays
+	// so that they can be tested with SIMD
+	// (the arrays are only needed for this frame)
+	const size_t candidateCount = m_cullingCandidates.size();
+	Memory::LinearAllocator& frameAllocator = Memory::GetFrameAllocator();
+	float* const centersX = static_cast<float*>( frameAllocator.Allocate( candidateCount * sizeof( float ) ) );
+	float* const centersY = static_cast<float*>( frameAllocator.Allocate( candidateCount * sizeof( float ) ) );
+	float* const radii = static_cast<float*>( frameAllocator.Allocate( candidateCount * sizeof( float ) ) );
+	uint8_t* const results = static_cast<uint8_t*>( frameAllocator.Allocate( candidateCount * sizeof( uint8_t ) ) );
+	if ( !centersX || !centersY || !radii || !results )
+	{
+		return;
+	}
+	for ( size_t i = 0; i < candidateCount; ++i )
+	{
+		// The grid stores slots, so the candidates are changed to dense indices in place
+		const uint32_t denseIndex = m_denseIndices[m_cullingCandidates[i]];
+		m_cullingCandidates[i] = denseIndex;
+		centersX[i] = m_positionsX[denseIndex] + m_boundsCentersX[denseIndex];
+		centersY[i] = m_positionsY[denseIndex] + m_boundsCentersY[denseIndex];
+		radii[i] = m_boundsRadii[denseIndex];
+	}
+	const unsigned int visibleCount = ( candidateCount > 0 ) ?
+		i_frustum.CullSpheres( centersX, centersY, NULL, radii, static_cast<unsigned int>( candidateCount ), results ) :
+		0;
+
+	for ( size_t i = 0; i < candidateCount; ++i )
+	{
+		if ( results[i] )
+		{
+			// There is no camera, and so every entity is the same distance away
+			// and the settings' pixels per unit apply as they are
+			Graphics::Renderable& renderable = m_renderables[m_cullingCandidates[i]];
+			renderable.SelectLod( i_lodSettings );
+			io_renderQueue.Submit( renderable );
+		}
+	}
+
+	m_cullingStats.entityCount = static_cast<unsigned int>( m_entities.size() );
+	m_cullingStats.visibleCount = visibleCount;
+	m_cullingStats.culledCount = m_cullingStats.entityCount - visibleCount;
+	m_cullingStats.culledByGridCount = culledByGridCount;
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+void eae6320::Core::EntityStore::Reserve( const size_t i_entityCount )
+{
+	m_generations.reserve( i_entityCount );
+	m_denseIndices.reserve( i_entityCount );
+	m_entities.reserve( i_entityCount );
+	m_positionsX.reserve( i_entityCount );
+	m_positionsY.reserve( i_entityCount );
+	m_velocitiesX.reserve( i_entityCount );
+	m_velocitiesY.reserve( i_entityCount );
+	m_renderables.reserve( i_entityCount );
+	m_boundsCentersX.reserve( i_entityCount );
+	m_boundsCentersY.reserve( i_entityCount );
+	m_boundsRadii.reserve( i_entityCount );
+}
+
+eae6320::Core::EntityStore::EntityStore()
+{
+	m_cullingStats.entityCount = m_cullingStats.visibleCount = m_cullingStats.culledCount = m_cullingStats.culledByGridCount = 0;
+}
+
+eae6320::Core::EntityStore::~EntityStore()
+{
+	DestroyAll();
+}
+
+// Implementation
+//===============
+
+eae6320::Core::sEntityHandle eae6320::Core::EntityStore::AllocateEntity()
+{
+	sEntityHandle entity;
+	if ( !m_freeSlots.empty() )
+	{
+		entity.slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		// The generation was already incremented once when the slot was freed,
+		// and so slots that are in use always have an odd generation
+		// (which means that a zero-initialized handle is never valid)
+		++m_generations[entity.slot];
+	}
+	else
+	{
+		entity.slot = static_cast<uint32_t>( m_generations.size() );
+		m_generations.push_back( 1 );
+		m_denseIndices.push_back( s_invalidDenseIndex );
+	}
+	entity.generation = m_generations[entity.slot];
+	assert( ( entity.generation & 1 ) != 0 );
+
+	m_denseIndices[entity.slot] = static_cast<uint32_t>( m_entities.size() );
+	m_entities.push_back( entity );
+	m_positionsX.push_back( 0.0f );
+	m_positionsY.push_back( 0.0f );
+	m_velocitiesX.push_back( 0.0f );
+	m_velocitiesY.push_back( 0.0f );
+	m_renderables.push_back( Graphics::Renderable() );
+	m_boundsCentersX.push_back( 0.0f );
+	m_boundsCentersY.push_back( 0.0f );
+	m_boundsRadii.push_back( 0.0f );
+
+	return entity;
+}
+
+void eae6320::Core::EntityStore::SetBoundsFromMesh( const uint32_t i_denseIndex )
+{
+	const Graphics::Mesh* const mesh = m_renderables[i_denseIndex].Mesh;
+	if ( mesh )
+	{
+		const Graphics::MeshFile::sBounds& bounds = mesh->GetBounds();
+		m_boundsCentersX[i_denseIndex] = bounds.sphereCenter[0];
+		m_boundsCentersY[i_denseIndex] = bounds.sphereCenter[1];
+		m_boundsRadii[i_denseIndex] = bounds.sphereRadius;
+	}
+}
+
+void eae6320::Core::EntityStore::UpdateLoadingEntities()
+{
+	for ( size_t i = 0; i < m_loadingEntities.size(); )
+	{
+		uint32_t denseIndex;
+		const bool isAlive = GetDenseIndex( m_loadingEntities[i], denseIndex );
+		if ( !isAlive || m_renderables[denseIndex].IsReady() )
+		{
+			if ( isAlive )
+			{
+				SetBoundsFromMesh( denseIndex );
+			}
+			m_loadingEntities[i] = m_loadingEntities.back();
+			m_loadingEntities.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+void eae6320::Core::EntityStore::UpdateSpatialIndex()
+{
+	UpdateLoadingEntities();
+
+	// Entities that didn't move out of their cell don't change anything
+	const size_t count = m_entities.size();
+	for ( size_t i = 0; i < count; ++i )
+	{
+		m_spatialIndex.Update( m_entities[i].slot,
+			m_positionsX[i] + m_boundsCentersX[i], m_positionsY[i] + m_boundsCentersY[i], m_boundsRadii[i] );
+	}
+}
+
+bool eae6320::Core::EntityStore::GetDenseIndex( const sEntityHandle i_entity, uint32_t& o_denseIndex ) const
+{
+	if ( ( i_entity.slot >= m_generations.size() ) || ( m_generations[i_entity.slot] != i_entity.generation ) )
+	{
+		return false;
+	}
+	o_denseIndex = m_denseIndices[i_entity.slot];
+	return o_denseIndex != s_invalidDenseIndex;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void IntegrateRange( const uint32_t i_begin, const uint32_t i_end, void* io_userData )
+	{
+		const sIntegrateJob& job = *static_cast<const sIntegrateJob*>( io_userData );
+		for ( uint32_t i = i_begin; i < i_end; ++i )
+		{
+			job.positionsX[i] += job.velocitiesX[i] * job.secondsElapsed;
+			job.positionsY[i] += job.velocitiesY[i] * job.secondsElapsed;
+		}
+	}
+
+	void UpdateRenderablesRange( const uint32_t i_begin, const uint32_t i_end, void* io_userData )
+	{
+		const sUpdateRenderablesJob& job = *static_cast<const sUpdateRenderablesJob*>( io_userData );
+		for ( uint32_t i = i_begin; i < i_end; ++i )
+		{
+			job.renderables[i].Offset.x = job.positionsX[i];
+			job.renderables[i].Offset.y = job.positionsY[i];
+		}
+	}
+
+	void SubmitRenderablesRange( const uint32_t i_begin, const uint32_t i_end, void* io_userData )
+	{
+		const sSubmitRenderablesJob& job = *static_cast<const sSubmitRenderablesJob*>( io_userData );
+		for ( uint32_t i = i_begin; i < i_end; ++i )
+		{
+			job.packets[i] = eae6320::Graphics::RenderQueue::CreatePacket( job.renderables[i] );
+		}
+	}
+}
@@ -0,0 +1,185 @@
+/*
+	The entity store keeps game objects as parallel arrays of components
+	instead of as individually allocated GameObjects.
+
+	Every component is stored densely (structure of arrays),
+	so that a system that only needs positions, for example, walks a single contiguous array of floats.
+	Entities are referred to with handles that stay valid while other entities are added and removed:
+	a handle is a slot index and a generation,
+	and the slot maps to wherever the entity's components currently are in the dense arrays.
+	Removing an entity moves the last entity into its place ("swap and pop"),
+	and so both adding and removing are O(1) and the arrays never have holes.
+*/
+
+#ifndef EAE6320_ENTITYSTORE_H
+#define EAE6320_ENTITYSTORE_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LooseGrid.h"
+#include "../Graphics/Renderable.h"
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class RenderQueue;
+	}
+	namespace Math
+	{
+		class cFrustum;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Core
+	{
+		struct sEntityHandle
+		{
+			uint32_t slot;
+			// Incremented every time the slot is reused so that old handles can be detected
+			uint32_t generation;
+
+			bool operator ==( const sEntityHandle& i_rhs ) const { return ( slot == i_rhs.slot ) && ( generation == i_rhs.generation ); }
+			bool operator !=( const sEntityHandle& i_rhs ) const { return !( *this == i_rhs ); }
+		};
+		extern const sEntityHandle InvalidEntity;
+
+		// Counts from the most recent call to EntityStore::SubmitVisibleRenderables()
+		struct sCullingStats
+		{
+			unsigned int entityCount;
+			unsigned int visibleCount;
+			// culledCount == entityCount - visibleCount
+			unsigned int culledCount;
+			// How many of the culled entities were rejected a whole grid cell at a time
+			// instead of being tested individually
+			unsigned int culledByGridCount;
+		};
+
+		class EntityStore
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Entities
+			//---------
+
+			// Creates an entity with a renderable that loads the given mesh
+			sEntityHandle Create( const char* i_meshPath );
+			// Creates an entity whose mesh and effect are loaded in the background
+			// (see Graphics::AssetLoader); it isn't drawn until they have finished loading
+			sEntityHandle CreateAsync( const char* i_meshPath );
+			// Creates an entity with a renderable that shares the mesh and effect of another entity
+			// (the source must not be destroyed while this entity is still alive)
+			sEntityHandle Create( const sEntityHandle i_shareRenderableWith );
+			// Returns false if the entity was already destroyed
+			bool Destroy( const sEntityHandle i_entity );
+			bool IsAlive( const sEntityHandle i_entity ) const;
+			void DestroyAll();
+
+			// Components
+			//-----------
+
+			// These return NULL if the entity isn't alive.
+			// The pointers are only valid until the next Create() or Destroy()
+			float* GetPositionX( const sEntityHandle i_entity );
+			float* GetPositionY( const sEntityHandle i_entity );
+			float* GetVelocityX( const sEntityHandle i_entity );
+			float* GetVelocityY( const sEntityHandle i_entity );
+			Graphics::Renderable* GetRenderable( const sEntityHandle i_entity );
+
+			// Dense arrays for systems to iterate over.
+			// Index i of every array belongs to the same entity, and there are GetCount() of each
+			size_t GetCount() const { return m_entities.size(); }
+			const sEntityHandle* GetEntities() const { return m_entities.empty() ? NULL : &m_entities[0]; }
+			float* GetPositionsX() { return m_positionsX.empty() ? NULL : &m_positionsX[0]; }
+			float* GetPositionsY() { return m_positionsY.empty() ? NULL : &m_positionsY[0]; }
+			float* GetVelocitiesX() { return m_velocitiesX.empty() ? NULL : &m_velocitiesX[0]; }
+			float* GetVelocitiesY() { return m_velocitiesY.empty() ? NULL : &m_velocitiesY[0]; }
+			Graphics::Renderable* GetRenderables() { return m_renderables.empty() ? NULL : &m_renderables[0]; }
+			// Bounding spheres in the entity's local space (from the mesh's bounds)
+			const float* GetBoundsCentersX() const { return m_boundsCentersX.empty() ? NULL : &m_boundsCentersX[0]; }
+			const float* GetBoundsCentersY() const { return m_boundsCentersY.empty() ? NULL : &m_boundsCentersY[0]; }
+			const float* GetBoundsRadii() const { return m_boundsRadii.empty() ? NULL : &m_boundsRadii[0]; }
+
+			// Systems
+			//--------
+
+			// These are split into jobs with JobSystem::ParallelFor()
+			// (and so they run on the calling thread if the job system isn't initialized)
+
+			// Moves every entity by its velocity
+			void Integrate( const float i_secondsElapsed );
+			// Copies every entity's position into its renderable's offset
+			// (this is what GameObject::Update() does for a single object)
+			void UpdateRenderables();
+			void SubmitRenderables( Graphics::RenderQueue& io_renderQueue );
+			// Only submits the entities whose bounding spheres are inside the frustum:
+			// the spatial index rejects whole cells that can't be seen,
+			// and then the entities in the rest of the cells are tested four at a time.
+			// Every visible entity's renderable chooses its level of detail before it's submitted
+			void SubmitVisibleRenderables( Graphics::RenderQueue& io_renderQueue, const Math::cFrustum& i_frustum,
+				const Graphics::sLodSettings& i_lodSettings );
+			const sCullingStats& GetCullingStats() const { return m_cullingStats; }
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			// Reserving avoids reallocating the arrays while entities are being created
+			void Reserve( const size_t i_entityCount );
+			EntityStore();
+			~EntityStore();
+
+			// Data
+			//=====
+
+		private:
+
+			// Sparse (indexed by a handle's slot)
+			std::vector<uint32_t> m_generations;
+			std::vector<uint32_t> m_denseIndices;
+			std::vector<uint32_t> m_freeSlots;
+
+			// Dense (indexed by the values in m_denseIndices)
+			std::vector<sEntityHandle> m_entities;
+			std::vector<float> m_positionsX, m_positionsY;
+			std::vector<float> m_velocitiesX, m_velocitiesY;
+			std::vector<Graphics::Renderable> m_renderables;
+			std::vector<float> m_boundsCentersX, m_boundsCentersY, m_boundsRadii;
+
+			// Spatial index (by slot)
+			LooseGrid m_spatialIndex;
+			// Entities whose bounds have to be set once their mesh has loaded
+			std::vector<sEntityHandle> m_loadingEntities;
+			// Culling
+			// (the rest of the culling data is allocated from the frame allocator)
+			std::vector<uint32_t> m_cullingCandidates;
+			sCullingStats m_cullingStats;
+
+			// Implementation
+			//===============
+
+		private:
+
+			sEntityHandle AllocateEntity();
+			void SetBoundsFromMesh( const uint32_t i_denseIndex );
+			void UpdateLoadingEntities();
+			void UpdateSpatialIndex();
+			bool GetDenseIndex( const sEntityHandle i_entity, uint32_t& o_denseIndex ) const;
+		};
+	}
+}
+
+#endif	// EAE6320_ENTITYSTORE_H
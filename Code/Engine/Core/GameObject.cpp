@@ -1,15 +1,32 @@
 #include "GameObject.h"
 
+#include "../Memory/Memory.h"
+
+namespace
+{
+	eae6320::Memory::Pool<eae6320::Graphics::Renderable> s_renderablePool("Renderables");
+}
+
 eae6320::Core::GameObject::GameObject()
 {
-	Renderable = new eae6320::Graphics::Renderable();
+	Renderable = s_renderablePool.New();
 	Position.x = 0.0f;
 	Position.y = 0.0f;
 }
 
 bool eae6320::Core::GameObject::Initialize(const char * i_FilePath)
 {
-	if (!this->Renderable->Initialize(i_FilePath))
+	if (!this->Renderable || !this->Renderable->Initialize(i_FilePath))
+	{
+		ShutDown();
+		return false;
+	}
+	return true;
+}
+
+bool eae6320::Core::GameObject::Initialize(const GameObject & i_Source)
+{
+	if (!this->Renderable || !i_Source.Renderable || !this->Renderable->Initialize(*i_Source.Renderable))
 	{
 		ShutDown();
 		return false;
@@ -27,6 +44,7 @@ void eae6320::Core::GameObject::ShutDown()
 	if (Renderable)
 	{
 		Renderable->ShutDown();
-		delete Renderable;
+		s_renderablePool.Delete(Renderable);
+		Renderable = NULL;
 	}
 }
\ No newline at end of file
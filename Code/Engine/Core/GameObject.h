@@ -13,6 +13,8 @@ namespace eae6320
 		public:
 			GameObject();
 			bool Initialize(const char * i_FilePath);
+			// Uses the same mesh and effect as another game object
+			bool Initialize(const GameObject & i_Source);
 			void Update();
 			void ShutDown();
 		public:
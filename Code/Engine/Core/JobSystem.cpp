@@ -0,0 +1,507 @@
+// Header Files
+//=============
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	struct sJob
+	{
+		eae6320::Core::JobSystem::tJobFunction function;
+		eae6320::Core::JobSystem::tRangeFunction rangeFunction;
+		void* userData;
+		uint32_t begin, end;
+		eae6320::Core::JobSystem::sCounter* counter;
+		const eae6320::Core::JobSystem::sCounter* dependency;
+		// A job's storage can only be reused once whichever thread took it has copied it
+		std::atomic<bool> isInUse;
+	};
+
+	// This must be a power of two
+	const int64_t s_dequeCapacity = 4096;
+	const int64_t s_dequeMask = s_dequeCapacity - 1;
+	// Keeps data that different threads write on separate cache lines
+	const size_t s_cacheLineSize = 64;
+
+	// Every thread that can run jobs has one of these
+	struct sThread
+	{
+		// Chase-Lev deque:
+		// the owner pushes and pops at the bottom and thieves take from the top
+		std::atomic<int64_t> top;
+		uint8_t padding0[s_cacheLineSize - sizeof( std::atomic<int64_t> )];
+		std::atomic<int64_t> bottom;
+		uint8_t padding1[s_cacheLineSize - sizeof( std::atomic<int64_t> )];
+		std::atomic<sJob*> deque[s_dequeCapacity];
+
+		// Only the owner allocates from its jobs
+		sJob jobs[s_dequeCapacity];
+		unsigned int nextJob;
+
+		std::thread thread;
+
+		// Only the owner writes these
+		std::atomic<unsigned int> jobsRun, jobsStolen, jobsRunInline;
+		uint8_t padding2[s_cacheLineSize];
+	};
+	std::vector<sThread*> s_threads;
+	// The index into s_threads of the current thread, or -1 if the current thread can't run jobs
+	thread_local int s_threadIndex = -1;
+
+	// The number of jobs in all of the deques
+	std::atomic<int> s_pendingJobCount( 0 );
+	// Idle workers sleep instead of spinning
+	std::mutex s_mutex;
+	std::condition_variable s_workAvailable;
+	std::atomic<int> s_sleepingWorkerCount( 0 );
+	std::atomic<bool> s_shouldWorkersExit( false );
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Deque
+	bool Push( sThread& io_thread, sJob* i_job );
+	sJob* Pop( sThread& io_thread );
+	sJob* Steal( sThread& io_thread );
+
+	sJob* AllocateJob( sThread& io_thread );
+	// A job that is put back because its dependency wasn't ready is already included in its counter
+	void Submit( const sJob& i_job, const bool i_isAlreadyCounted = false );
+	bool IsReady( const sJob& i_job );
+	void Execute( const sJob& i_job );
+	// Takes the newest job from the current thread's deque if there is one
+	// (or the oldest if requested) and otherwise steals one from another thread
+	bool TakeJob( const bool i_shouldTakeOldest, sJob& o_job, bool& o_wasStolen );
+	// Returns false if there was no job that could be run
+	bool TryRunJob();
+	void RunWorker( const int i_threadIndex );
+}
+
+// Interface
+//==========
+
+bool eae6320::Core::JobSystem::Initialize( const unsigned int i_threadCount )
+{
+	assert( s_threads.empty() );
+
+	unsigned int threadCount = i_threadCount;
+	if ( threadCount == 0 )
+	{
+		threadCount = std::max( std::thread::hardware_concurrency(), 1u );
+	}
+
+	s_shouldWorkersExit = false;
+	s_pendingJobCount = 0;
+	for ( unsigned int i = 0; i < threadCount; ++i )
+	{
+		sThread* const thread = new sThread;
+		thread->top = 0;
+		thread->bottom = 0;
+		for ( int64_t j = 0; j < s_dequeCapacity; ++j )
+		{
+			thread->deque[j] = NULL;
+			thread->jobs[j].isInUse = false;
+		}
+		thread->nextJob = 0;
+		thread->jobsRun = thread->jobsStolen = thread->jobsRunInline = 0;
+		s_threads.push_back( thread );
+	}
+	// The calling thread is thread 0
+	s_threadIndex = 0;
+	for ( unsigned int i = 1; i < threadCount; ++i )
+	{
+		s_threads[i]->thread = std::thread( RunWorker, static_cast<int>( i ) );
+	}
+
+	return true;
+}
+
+bool eae6320::Core::JobSystem::ShutDown()
+{
+	if ( s_threads.empty() )
+	{
+		return true;
+	}
+
+	// Finish anything that is still queued before stopping the workers
+	while ( s_pendingJobCount.load() > 0 )
+	{
+		if ( !TryRunJob() )
+		{
+			std::this_thread::yield();
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock( s_mutex );
+		s_shouldWorkersExit = true;
+	}
+	s_workAvailable.notify_all();
+	for ( std::vector<sThread*>::iterator i = s_threads.begin(); i != s_threads.end(); ++i )
+	{
+		if ( ( *i )->thread.joinable() )
+		{
+			( *i )->thread.join();
+		}
+		delete *i;
+	}
+	s_threads.clear();
+	s_threadIndex = -1;
+
+	return true;
+}
+
+unsigned int eae6320::Core::JobSystem::GetThreadCount()
+{
+	return static_cast<unsigned int>( s_threads.size() );
+}
+
+void eae6320::Core::JobSystem::Run( const tJobFunction i_function, void* io_userData, sCounter* io_counter, const sCounter* i_dependency )
+{
+	sJob job;
+	job.function = i_function;
+	job.rangeFunction = NULL;
+	job.userData = io_userData;
+	job.begin = job.end = 0;
+	job.counter = io_counter;
+	job.dependency = i_dependency;
+	Submit( job );
+}
+
+void eae6320::Core::JobSystem::Run( const tRangeFunction i_function, const uint32_t i_begin, const uint32_t i_end, void* io_userData,
+	sCounter* io_counter, const sCounter* i_dependency )
+{
+	sJob job;
+	job.function = NULL;
+	job.rangeFunction = i_function;
+	job.userData = io_userData;
+	job.begin = i_begin;
+	job.end = i_end;
+	job.counter = io_counter;
+	job.dependency = i_dependency;
+	Submit( job );
+}
+
+void eae6320::Core::JobSystem::Wait( const sCounter& i_counter )
+{
+	while ( i_counter.value.load( std::memory_order_acquire ) != 0 )
+	{
+		if ( !TryRunJob() )
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void eae6320::Core::JobSystem::ParallelFor( const uint32_t i_count, const uint32_t i_grainSize, const tRangeFunction i_function, void* io_userData )
+{
+	const uint32_t grainSize = std::max( i_grainSize, 1u );
+	if ( ( i_count <= grainSize ) || ( s_threads.size() < 2 ) || ( s_threadIndex < 0 ) )
+	{
+		if ( i_count > 0 )
+		{
+			i_function( 0, i_count, io_userData );
+		}
+		return;
+	}
+
+	sCounter counter;
+	// The calling thread runs the first chunk itself
+	// instead of submitting it and then immediately popping it back
+	for ( uint32_t begin = grainSize; begin < i_count; begin += grainSize )
+	{
+		Run( i_function, begin, std::min( begin + grainSize, i_count ), io_userData, &counter );
+	}
+	i_function( 0, grainSize, io_userData );
+	Wait( counter );
+}
+
+eae6320::Core::JobSystem::sJobSystemStats eae6320::Core::JobSystem::GetStats()
+{
+	sJobSystemStats stats = {};
+	for ( std::vector<sThread*>::const_iterator i = s_threads.begin(); i != s_threads.end(); ++i )
+	{
+		stats.jobsRun += ( *i )->jobsRun.load( std::memory_order_relaxed );
+		stats.jobsStolen += ( *i )->jobsStolen.load( std::memory_order_relaxed );
+		stats.jobsRunInline += ( *i )->jobsRunInline.load( std::memory_order_relaxed );
+	}
+	return stats;
+}
+
+void eae6320::Core::JobSystem::ResetStats()
+{
+	for ( std::vector<sThread*>::iterator i = s_threads.begin(); i != s_threads.end(); ++i )
+	{
+		( *i )->jobsRun = ( *i )->jobsStolen = ( *i )->jobsRunInline = 0;
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	// Deque
+	//------
+
+	bool Push( sThread& io_thread, sJob* i_job )
+	{
+		const int64_t bottom = io_thread.bottom.load( std::memory_order_relaxed );
+		const int64_t top = io_thread.top.load( std::memory_order_acquire );
+		if ( ( bottom - top ) >= s_dequeCapacity )
+		{
+			return false;
+		}
+		io_thread.deque[bottom & s_dequeMask].store( i_job, std::memory_order_relaxed );
+		// Releasing makes the job visible to a thief that sees the new bottom
+		io_thread.bottom.store( bottom + 1, std::memory_order_release );
+		return true;
+	}
+
+	sJob* Pop( sThread& io_thread )
+	{
+		const int64_t bottom = io_thread.bottom.load( std::memory_order_relaxed ) - 1;
+		io_thread.bottom.store( bottom, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		int64_t top = io_thread.top.load( std::memory_order_relaxed );
+		if ( top > bottom )
+		{
+			// The deque was empty
+			io_thread.bottom.store( bottom + 1, std::memory_order_relaxed );
+			return NULL;
+		}
+		sJob* job = io_thread.deque[bottom & s_dequeMask].load( std::memory_order_relaxed );
+		if ( top == bottom )
+		{
+			// This was the last job, and so a thief might be trying to take it at the same time
+			if ( !io_thread.top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+			{
+				job = NULL;
+			}
+			io_thread.bottom.store( bottom + 1, std::memory_order_relaxed );
+		}
+		return job;
+	}
+
+	sJob* Steal( sThread& io_thread )
+	{
+		int64_t top = io_thread.top.load( std::memory_order_acquire );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		const int64_t bottom = io_thread.bottom.load( std::memory_order_acquire );
+		if ( top >= bottom )
+		{
+			return NULL;
+		}
+		sJob* const job = io_thread.deque[top & s_dequeMask].load( std::memory_order_relaxed );
+		if ( !io_thread.top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+		{
+			// Another thread got it first
+			return NULL;
+		}
+		return job;
+	}
+
+	// Jobs
+	//-----
+
+	sJob* AllocateJob( sThread& io_thread )
+	{
+		// Jobs are almost always finished in roughly the order that they're allocated,
+		// and so the next one is usually free
+		for ( int64_t i = 0; i < s_dequeCapacity; ++i )
+		{
+			sJob& job = io_thread.jobs[io_thread.nextJob];
+			io_thread.nextJob = ( io_thread.nextJob + 1 ) & s_dequeMask;
+			if ( !job.isInUse.load( std::memory_order_acquire ) )
+			{
+				return &job;
+			}
+		}
+		return NULL;
+	}
+
+	void Submit( const sJob& i_job, const bool i_isAlreadyCounted )
+	{
+		if ( i_job.counter && !i_isAlreadyCounted )
+		{
+			i_job.counter->value.fetch_add( 1, std::memory_order_relaxed );
+		}
+
+		if ( s_threadIndex >= 0 )
+		{
+			sThread& thread = *s_threads[s_threadIndex];
+			sJob* const job = AllocateJob( thread );
+			if ( job )
+			{
+				job->function = i_job.function;
+				job->rangeFunction = i_job.rangeFunction;
+				job->userData = i_job.userData;
+				job->begin = i_job.begin;
+				job->end = i_job.end;
+				job->counter = i_job.counter;
+				job->dependency = i_job.dependency;
+				job->isInUse.store( true, std::memory_order_relaxed );
+				if ( Push( thread, job ) )
+				{
+					s_pendingJobCount.fetch_add( 1 );
+					if ( s_sleepingWorkerCount.load() > 0 )
+					{
+						// Locking makes sure that a worker that is about to go to sleep sees the new job
+						std::lock_guard<std::mutex> lock( s_mutex );
+						s_workAvailable.notify_one();
+					}
+					return;
+				}
+				job->isInUse.store( false, std::memory_order_relaxed );
+			}
+		}
+
+		// If the job can't be queued it is run right away
+		while ( !IsReady( i_job ) )
+		{
+			if ( !TryRunJob() )
+			{
+				std::this_thread::yield();
+			}
+		}
+		if ( s_threadIndex >= 0 )
+		{
+			s_threads[s_threadIndex]->jobsRunInline.fetch_add( 1, std::memory_order_relaxed );
+		}
+		Execute( i_job );
+	}
+
+	bool IsReady( const sJob& i_job )
+	{
+		return !i_job.dependency || ( i_job.dependency->value.load( std::memory_order_acquire ) == 0 );
+	}
+
+	void Execute( const sJob& i_job )
+	{
+		if ( i_job.function )
+		{
+			i_job.function( i_job.userData );
+		}
+		else
+		{
+			i_job.rangeFunction( i_job.begin, i_job.end, i_job.userData );
+		}
+		if ( i_job.counter )
+		{
+			i_job.counter->value.fetch_sub( 1, std::memory_order_release );
+		}
+	}
+
+	bool TakeJob( const bool i_shouldTakeOldest, sJob& o_job, bool& o_wasStolen )
+	{
+		const int threadCount = static_cast<int>( s_threads.size() );
+		const int threadIndex = s_threadIndex;
+
+		sJob* job = NULL;
+		o_wasStolen = false;
+		if ( threadIndex >= 0 )
+		{
+			// The owner can take from the top of its own deque the same way that a thief does
+			job = i_shouldTakeOldest ? Steal( *s_threads[threadIndex] ) : Pop( *s_threads[threadIndex] );
+		}
+		if ( !job )
+		{
+			// Start with the next thread so that all of the thieves don't go after the same victim
+			for ( int i = 1; ( i <= threadCount ) && !job; ++i )
+			{
+				const int victim = ( threadIndex + i + threadCount ) % threadCount;
+				if ( victim != threadIndex )
+				{
+					job = Steal( *s_threads[victim] );
+				}
+			}
+			o_wasStolen = job != NULL;
+		}
+		if ( !job )
+		{
+			return false;
+		}
+		s_pendingJobCount.fetch_sub( 1 );
+
+		// Copy the job so that its storage can be reused while it is running
+		o_job.function = job->function;
+		o_job.rangeFunction = job->rangeFunction;
+		o_job.userData = job->userData;
+		o_job.begin = job->begin;
+		o_job.end = job->end;
+		o_job.counter = job->counter;
+		o_job.dependency = job->dependency;
+		job->isInUse.store( false, std::memory_order_release );
+		return true;
+	}
+
+	bool TryRunJob()
+	{
+		sJob job;
+		bool wasStolen;
+		if ( !TakeJob( false, job, wasStolen ) )
+		{
+			return false;
+		}
+		if ( !IsReady( job ) )
+		{
+			// Put it back (its counter doesn't change because the job is still outstanding)
+			// and try the oldest job instead:
+			// whatever the newest job depends on was probably submitted before it
+			Submit( job, true );
+			if ( !TakeJob( true, job, wasStolen ) )
+			{
+				return false;
+			}
+			if ( !IsReady( job ) )
+			{
+				Submit( job, true );
+				return false;
+			}
+		}
+
+		Execute( job );
+		if ( s_threadIndex >= 0 )
+		{
+			sThread& thread = *s_threads[s_threadIndex];
+			thread.jobsRun.fetch_add( 1, std::memory_order_relaxed );
+			if ( wasStolen )
+			{
+				thread.jobsStolen.fetch_add( 1, std::memory_order_relaxed );
+			}
+		}
+		return true;
+	}
+
+	void RunWorker( const int i_threadIndex )
+	{
+		s_threadIndex = i_threadIndex;
+		while ( !s_shouldWorkersExit.load() )
+		{
+			if ( TryRunJob() )
+			{
+				continue;
+			}
+			// Wait for something to be submitted
+			std::unique_lock<std::mutex> lock( s_mutex );
+			s_sleepingWorkerCount.fetch_add( 1 );
+			while ( ( s_pendingJobCount.load() <= 0 ) && !s_shouldWorkersExit.load() )
+			{
+				s_workAvailable.wait( lock );
+			}
+			s_sleepingWorkerCount.fetch_sub( 1 );
+		}
+	}
+}
@@ -0,0 +1,86 @@
+/*
+	The job system runs small pieces of work on a pool of worker threads.
+
+	Every thread that can run jobs (the workers and the thread that called Initialize())
+	has its own Chase-Lev deque:
+	the owning thread pushes and pops jobs at the bottom without any locks,
+	and threads that run out of work steal from the top of other threads' deques.
+	A job can be given a counter that is incremented when the job is submitted
+	and decremented when it finishes, so that Wait() can tell when a group of jobs is done;
+	a job can also depend on a counter, in which case it isn't started until the counter reaches zero.
+	Waiting never blocks: a thread that waits runs other jobs until its counter reaches zero.
+
+	ParallelFor() splits a range of indices into chunks and runs one job per chunk.
+	If the job system hasn't been initialized everything runs inline on the calling thread,
+	so code that uses it doesn't need a separate single-threaded path.
+*/
+
+#ifndef EAE6320_JOBSYSTEM_H
+#define EAE6320_JOBSYSTEM_H
+
+// Header Files
+//=============
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Core
+	{
+		namespace JobSystem
+		{
+			typedef void ( *tJobFunction )( void* io_userData );
+			// Called with a half-open range [i_begin, i_end)
+			typedef void ( *tRangeFunction )( const uint32_t i_begin, const uint32_t i_end, void* io_userData );
+
+			// The number of jobs that are still pending
+			struct sCounter
+			{
+				std::atomic<uint32_t> value;
+
+				sCounter() : value( 0 ) {}
+			};
+
+			// Counts since the last call to ResetStats()
+			struct sJobSystemStats
+			{
+				unsigned int jobsRun;
+				// Jobs that one thread took from another thread's deque
+				unsigned int jobsStolen;
+				// Jobs that had to be run immediately by the thread that submitted them
+				// (because its deque was full or because it isn't a job system thread)
+				unsigned int jobsRunInline;
+			};
+
+			// A worker thread count of 0 means to use one thread per hardware core.
+			// The calling thread counts as one of the threads,
+			// and it is the only thread other than the workers that can submit jobs without running them inline
+			bool Initialize( const unsigned int i_threadCount = 0 );
+			bool ShutDown();
+			// Returns 0 if the job system isn't initialized
+			unsigned int GetThreadCount();
+
+			// The counter (if there is one) must stay alive until the job has finished.
+			// If there is a dependency the job won't start until it reaches zero
+			void Run( const tJobFunction i_function, void* io_userData, sCounter* io_counter = NULL, const sCounter* i_dependency = NULL );
+			void Run( const tRangeFunction i_function, const uint32_t i_begin, const uint32_t i_end, void* io_userData,
+				sCounter* io_counter = NULL, const sCounter* i_dependency = NULL );
+			// Runs other jobs until the counter reaches zero
+			void Wait( const sCounter& i_counter );
+
+			// Calls the function for chunks of [0, i_count) that are at most i_grainSize long
+			// and returns once all of them are done
+			void ParallelFor( const uint32_t i_count, const uint32_t i_grainSize, const tRangeFunction i_function, void* io_userData );
+
+			sJobSystemStats GetStats();
+			void ResetStats();
+		}
+	}
+}
+
+#endif	// EAE6320_JOBSYSTEM_H
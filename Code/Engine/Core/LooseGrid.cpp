@@ -0,0 +1,128 @@
+// Header Files
+//=============
+
+#include "LooseGrid.h"
+
+#include <cassert>
+#include <cmath>
+#include "../Math/cFrustum.h"
+#include "../Math/cVector.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const uint32_t s_notInGrid = ~0u;
+}
+
+// Interface
+//==========
+
+void eae6320::Core::LooseGrid::Update( const uint32_t i_id, const float i_x, const float i_y, const float i_radius )
+{
+	if ( i_id >= m_items.size() )
+	{
+		const sItem notInGrid = { s_notInGrid, 0 };
+		m_items.resize( i_id + 1, notInGrid );
+	}
+
+	const uint32_t cell = GetCell( i_x, i_y, i_radius );
+	sItem& item = m_items[i_id];
+	if ( item.cell == cell )
+	{
+		// Most items stay in the same cell from one frame to the next
+		return;
+	}
+	Remove( i_id );
+	item.cell = cell;
+	item.indexInCell = static_cast<uint32_t>( m_cells[cell].ids.size() );
+	m_cells[cell].ids.push_back( i_id );
+}
+
+void eae6320::Core::LooseGrid::Remove( const uint32_t i_id )
+{
+	if ( ( i_id >= m_items.size() ) || ( m_items[i_id].cell == s_notInGrid ) )
+	{
+		return;
+	}
+	sItem& item = m_items[i_id];
+	std::vector<uint32_t>& ids = m_cells[item.cell].ids;
+	// Move the last item in the cell into the hole
+	const uint32_t movedId = ids.back();
+	ids[item.indexInCell] = movedId;
+	m_items[movedId].indexInCell = item.indexInCell;
+	ids.pop_back();
+	item.cell = s_notInGrid;
+}
+
+void eae6320::Core::LooseGrid::Clear()
+{
+	m_cells.resize( 1 );
+	m_cells[s_oversizedCell].ids.clear();
+	m_cellIndices.clear();
+	m_items.clear();
+}
+
+unsigned int eae6320::Core::LooseGrid::Query( const Math::cFrustum& i_frustum, std::vector<uint32_t>& o_ids ) const
+{
+	unsigned int rejectedCount = 0;
+	const float looseness = m_cellSize * 0.5f;
+	for ( std::vector<sCell>::const_iterator i = m_cells.begin(); i != m_cells.end(); ++i )
+	{
+		const sCell& cell = *i;
+		if ( cell.ids.empty() )
+		{
+			continue;
+		}
+		// The oversized items are always returned
+		if ( i != m_cells.begin() )
+		{
+			const Math::cVector looseMin( ( cell.x * m_cellSize ) - looseness, ( cell.y * m_cellSize ) - looseness, 0.0f );
+			const Math::cVector looseMax( ( ( cell.x + 1 ) * m_cellSize ) + looseness, ( ( cell.y + 1 ) * m_cellSize ) + looseness, 0.0f );
+			if ( !i_frustum.IsBoxVisible( looseMin, looseMax ) )
+			{
+				rejectedCount += static_cast<unsigned int>( cell.ids.size() );
+				continue;
+			}
+		}
+		o_ids.insert( o_ids.end(), cell.ids.begin(), cell.ids.end() );
+	}
+	return rejectedCount;
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Core::LooseGrid::LooseGrid( const float i_cellSize )
+	:
+	m_cells( 1 ), m_cellSize( i_cellSize )
+{
+	assert( i_cellSize > 0.0f );
+}
+
+// Implementation
+//===============
+
+uint32_t eae6320::Core::LooseGrid::GetCell( const float i_x, const float i_y, const float i_radius )
+{
+	if ( i_radius > ( m_cellSize * 0.5f ) )
+	{
+		return s_oversizedCell;
+	}
+
+	const int32_t x = static_cast<int32_t>( std::floor( i_x / m_cellSize ) );
+	const int32_t y = static_cast<int32_t>( std::floor( i_y / m_cellSize ) );
+	const uint64_t key = ( static_cast<uint64_t>( static_cast<uint32_t>( x ) ) << 32 ) | static_cast<uint32_t>( y );
+	std::unordered_map<uint64_t, uint32_t>::const_iterator existingCell = m_cellIndices.find( key );
+	if ( existingCell != m_cellIndices.end() )
+	{
+		return existingCell->second;
+	}
+	const uint32_t cell = static_cast<uint32_t>( m_cells.size() );
+	m_cells.push_back( sCell() );
+	m_cells.back().x = x;
+	m_cells.back().y = y;
+	m_cellIndices[key] = cell;
+	return cell;
+}
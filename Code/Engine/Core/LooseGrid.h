@@ -0,0 +1,106 @@
+/*
+	A loose grid is a spatial index that sorts items into square cells by their centers.
+
+	Each cell's bounds are "loose": they are expanded by half of a cell on every side,
+	and so any item whose radius is at most half of a cell is completely inside of the loose bounds
+	of the cell that its center is in.
+	That means that an item only ever belongs to one cell,
+	moving an item is just a matter of checking whether its center crossed into a different cell,
+	and a query can skip every item in a cell whose loose bounds can't be seen.
+	Items that are too big for the cells are kept in a separate list that every query returns.
+
+	The grid is unbounded: cells are created (in a hash map) the first time that something is put in them.
+	It is 2D (in x and y) because everything in the game is currently at z = 0.
+*/
+
+#ifndef EAE6320_LOOSEGRID_H
+#define EAE6320_LOOSEGRID_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cFrustum;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Core
+	{
+		class LooseGrid
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Adds the item if it isn't in the grid yet and otherwise moves it.
+			// IDs are used as indices, and so they should be small (e.g. entity slots)
+			void Update( const uint32_t i_id, const float i_x, const float i_y, const float i_radius );
+			void Remove( const uint32_t i_id );
+			void Clear();
+
+			// Appends the IDs of every item that is in a cell that the frustum can see
+			// (the items themselves still need to be tested)
+			// and returns the number of items that were rejected because their whole cell couldn't be seen
+			unsigned int Query( const Math::cFrustum& i_frustum, std::vector<uint32_t>& o_ids ) const;
+
+			float GetCellSize() const { return m_cellSize; }
+			size_t GetCellCount() const { return m_cells.size(); }
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			explicit LooseGrid( const float i_cellSize = 0.5f );
+
+			// Data
+			//=====
+
+		private:
+
+			struct sCell
+			{
+				int32_t x, y;
+				std::vector<uint32_t> ids;
+			};
+			// The first cell holds the items that are too big for any cell
+			static const uint32_t s_oversizedCell = 0;
+			std::vector<sCell> m_cells;
+			std::unordered_map<uint64_t, uint32_t> m_cellIndices;
+
+			struct sItem
+			{
+				uint32_t cell;
+				uint32_t indexInCell;
+			};
+			// Indexed by ID
+			std::vector<sItem> m_items;
+
+			float m_cellSize;
+
+			// Implementation
+			//===============
+
+		private:
+
+			uint32_t GetCell( const float i_x, const float i_y, const float i_radius );
+		};
+	}
+}
+
+#endif	// EAE6320_LOOSEGRID_H
@@ -0,0 +1,548 @@
+// Header Files
+//=============
+
+#include "AssetLoader.h"
+
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AssetPack.h"
+#include "Effect.h"
+#include "Mesh.h"
+#include "../UserOutput/Log.h"
+#include "../Windows/Includes.h"
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	enum eAssetType
+	{
+		AssetType_mesh,
+		AssetType_effect,
+	};
+
+	struct sRequest
+	{
+		eAssetType type;
+		// This is only used on the render thread,
+		// and it is set to NULL if the load is cancelled
+		void* target;
+		// Effects read both of their shaders
+		std::string paths[2];
+		unsigned int fileCount;
+		// Every file has a NULL terminator after it (which isn't included in its size)
+		void* files[2];
+		size_t fileSizes[2];
+		// Files that are in the mounted AssetPack point into it instead of being read
+		bool areFilesPacked[2];
+		eae6320::Graphics::Mesh::sDecodedMesh decodedMesh;
+		// Reloads only read loose files and swap the result into a mesh or effect that is already loaded
+		bool isReload;
+		std::chrono::steady_clock::time_point submitTime;
+		// Requests that are decoded by the I/O thread aren't dispatched
+		bool wasDispatched;
+		bool wereThereErrors;
+	};
+}
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	std::vector<std::thread> s_ioThreads;
+	bool s_isInitialized = false;
+
+	// This protects everything below it
+	std::mutex s_mutex;
+	std::condition_variable s_ioCondition;
+	bool s_shouldIoThreadsExit = false;
+	// Requests that are waiting to be read
+	std::deque<sRequest*> s_readQueue;
+	// Requests that have been read and are waiting for Update() to dispatch them to be decoded
+	std::vector<sRequest*> s_decodeQueue;
+	// Requests that are waiting for Update() to finish them
+	std::vector<sRequest*> s_finishQueue;
+	// Requests that have been dispatched but not decoded yet
+	unsigned int s_decodingCount = 0;
+	eae6320::Graphics::AssetLoader::tDecodeDispatcher s_decodeDispatcher = NULL;
+	uint64_t s_bytesRead = 0;
+
+	// These are only used on the render thread
+	std::vector<sRequest*> s_requests;
+	eae6320::Graphics::AssetLoader::sAssetLoaderStats s_stats = {};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void IoThreadMain();
+	bool ReadFile( const char* i_path, const bool i_shouldSearchPack, void*& o_file, size_t& o_fileSize, bool& o_isPacked );
+	void DecodeRequest( void* io_request );
+	bool Submit( sRequest* i_request, const bool i_isReload );
+	void FinishRequest( sRequest* io_request );
+	void DestroyRequest( sRequest* io_request );
+}
+
+// Interface
+//==========
+
+bool eae6320::Graphics::AssetLoader::Initialize( const unsigned int i_ioThreadCount )
+{
+	if ( s_isInitialized )
+	{
+		return true;
+	}
+	s_shouldIoThreadsExit = false;
+	s_stats = sAssetLoaderStats();
+	s_bytesRead = 0;
+	const unsigned int ioThreadCount = ( i_ioThreadCount > 0 ) ? i_ioThreadCount : 1;
+	for ( unsigned int i = 0; i < ioThreadCount; ++i )
+	{
+		s_ioThreads.push_back( std::thread( IoThreadMain ) );
+	}
+	s_isInitialized = true;
+	return true;
+}
+
+bool eae6320::Graphics::AssetLoader::ShutDown()
+{
+	if ( !s_isInitialized )
+	{
+		return true;
+	}
+
+	// Stop reading
+	{
+		std::lock_guard<std::mutex> lock( s_mutex );
+		s_shouldIoThreadsExit = true;
+	}
+	s_ioCondition.notify_all();
+	for ( std::vector<std::thread>::iterator i = s_ioThreads.begin(); i != s_ioThreads.end(); ++i )
+	{
+		i->join();
+	}
+	s_ioThreads.clear();
+	// Wait for anything that is being decoded
+	// (a decode job only needs the loader's data, and so it will finish even after the mesh or effect is gone)
+	for ( ;; )
+	{
+		{
+			std::lock_guard<std::mutex> lock( s_mutex );
+			if ( s_decodingCount == 0 )
+			{
+				break;
+			}
+		}
+		std::this_thread::yield();
+	}
+
+	// Every request that is left is in one of the queues
+	{
+		std::lock_guard<std::mutex> lock( s_mutex );
+		s_readQueue.clear();
+		s_decodeQueue.clear();
+		s_finishQueue.clear();
+	}
+	s_stats.loadsCancelled += static_cast<unsigned int>( s_requests.size() );
+	for ( std::vector<sRequest*>::iterator i = s_requests.begin(); i != s_requests.end(); ++i )
+	{
+		DestroyRequest( *i );
+	}
+	s_requests.clear();
+	s_isInitialized = false;
+	return true;
+}
+
+bool eae6320::Graphics::AssetLoader::IsInitialized()
+{
+	return s_isInitialized;
+}
+
+void eae6320::Graphics::AssetLoader::SetDecodeDispatcher( const tDecodeDispatcher i_dispatcher )
+{
+	std::lock_guard<std::mutex> lock( s_mutex );
+	s_decodeDispatcher = i_dispatcher;
+}
+
+bool eae6320::Graphics::AssetLoader::LoadMesh( Mesh& io_mesh, const char* i_path )
+{
+	sRequest* const request = new sRequest;
+	request->type = AssetType_mesh;
+	request->target = &io_mesh;
+	request->paths[0] = i_path;
+	request->fileCount = 1;
+	return Submit( request, false );
+}
+
+bool eae6320::Graphics::AssetLoader::LoadEffect( Effect& io_effect )
+{
+	sRequest* const request = new sRequest;
+	request->type = AssetType_effect;
+	request->target = &io_effect;
+	request->paths[0] = Effect::s_vertexShaderPath;
+	request->paths[1] = Effect::s_fragmentShaderPath;
+	request->fileCount = 2;
+	return Submit( request, false );
+}
+
+bool eae6320::Graphics::AssetLoader::ReloadMesh( Mesh& io_mesh, const char* i_path )
+{
+	Cancel( &io_mesh );
+	sRequest* const request = new sRequest;
+	request->type = AssetType_mesh;
+	request->target = &io_mesh;
+	request->paths[0] = i_path;
+	request->fileCount = 1;
+	return Submit( request, true );
+}
+
+bool eae6320::Graphics::AssetLoader::ReloadEffect( Effect& io_effect )
+{
+	Cancel( &io_effect );
+	sRequest* const request = new sRequest;
+	request->type = AssetType_effect;
+	request->target = &io_effect;
+	request->paths[0] = Effect::s_vertexShaderPath;
+	request->paths[1] = Effect::s_fragmentShaderPath;
+	request->fileCount = 2;
+	return Submit( request, true );
+}
+
+void eae6320::Graphics::AssetLoader::Cancel( const void* i_meshOrEffect )
+{
+	for ( std::vector<sRequest*>::iterator i = s_requests.begin(); i != s_requests.end(); ++i )
+	{
+		if ( ( *i )->target == i_meshOrEffect )
+		{
+			( *i )->target = NULL;
+		}
+	}
+}
+
+unsigned int eae6320::Graphics::AssetLoader::Update()
+{
+	// Requests that are decoded inline by DispatchDecodes() are finished the next time
+	const unsigned int finishedCount = FinishLoads();
+	DispatchDecodes();
+	return finishedCount;
+}
+
+void eae6320::Graphics::AssetLoader::DispatchDecodes()
+{
+	std::vector<sRequest*> requestsToDecode;
+	tDecodeDispatcher decodeDispatcher;
+	{
+		std::lock_guard<std::mutex> lock( s_mutex );
+		requestsToDecode.swap( s_decodeQueue );
+		decodeDispatcher = s_decodeDispatcher;
+		if ( decodeDispatcher )
+		{
+			s_decodingCount += static_cast<unsigned int>( requestsToDecode.size() );
+		}
+	}
+
+	for ( std::vector<sRequest*>::iterator i = requestsToDecode.begin(); i != requestsToDecode.end(); ++i )
+	{
+		if ( decodeDispatcher )
+		{
+			( *i )->wasDispatched = true;
+			decodeDispatcher( DecodeRequest, *i );
+		}
+		else
+		{
+			// The dispatcher was removed after the request was read
+			DecodeRequest( *i );
+		}
+	}
+}
+
+unsigned int eae6320::Graphics::AssetLoader::FinishLoads()
+{
+	std::vector<sRequest*> requestsToFinish;
+	{
+		std::lock_guard<std::mutex> lock( s_mutex );
+		requestsToFinish.swap( s_finishQueue );
+	}
+	for ( std::vector<sRequest*>::iterator i = requestsToFinish.begin(); i != requestsToFinish.end(); ++i )
+	{
+		FinishRequest( *i );
+	}
+	return static_cast<unsigned int>( requestsToFinish.size() );
+}
+
+bool eae6320::Graphics::AssetLoader::HasLoadsToFinish()
+{
+	std::lock_guard<std::mutex> lock( s_mutex );
+	return !s_finishQueue.empty();
+}
+
+unsigned int eae6320::Graphics::AssetLoader::GetPendingLoadCount()
+{
+	return static_cast<unsigned int>( s_requests.size() );
+}
+
+eae6320::Graphics::AssetLoader::sAssetLoaderStats eae6320::Graphics::AssetLoader::GetStats()
+{
+	sAssetLoaderStats stats = s_stats;
+	{
+		std::lock_guard<std::mutex> lock( s_mutex );
+		stats.bytesRead = s_bytesRead;
+	}
+	return stats;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void IoThreadMain()
+	{
+		for ( ;; )
+		{
+			sRequest* request;
+			{
+				std::unique_lock<std::mutex> lock( s_mutex );
+				while ( s_readQueue.empty() && !s_shouldIoThreadsExit )
+				{
+					s_ioCondition.wait( lock );
+				}
+				if ( s_shouldIoThreadsExit )
+				{
+					return;
+				}
+				request = s_readQueue.front();
+				s_readQueue.pop_front();
+			}
+
+			size_t bytesRead = 0;
+			for ( unsigned int i = 0; i < request->fileCount; ++i )
+			{
+				if ( ReadFile( request->paths[i].c_str(), !request->isReload, request->files[i], request->fileSizes[i], request->areFilesPacked[i] ) )
+				{
+					bytesRead += request->fileSizes[i];
+				}
+				else
+				{
+					request->wereThereErrors = true;
+				}
+			}
+
+			bool shouldDecodeNow;
+			{
+				std::lock_guard<std::mutex> lock( s_mutex );
+				s_bytesRead += bytesRead;
+				shouldDecodeNow = s_decodeDispatcher == NULL;
+				if ( !shouldDecodeNow )
+				{
+					s_decodeQueue.push_back( request );
+				}
+			}
+			if ( shouldDecodeNow )
+			{
+				DecodeRequest( request );
+			}
+		}
+	}
+
+	bool ReadFile( const char* i_path, const bool i_shouldSearchPack, void*& o_file, size_t& o_fileSize, bool& o_isPacked )
+	{
+		o_isPacked = false;
+		if ( i_shouldSearchPack )
+		{
+			const void* packedFile;
+			o_isPacked = eae6320::Graphics::AssetPack::Find( i_path, packedFile, o_fileSize );
+			if ( o_isPacked )
+			{
+				o_file = const_cast<void*>( packedFile );
+				return true;
+			}
+		}
+
+		FILE* file;
+		if ( fopen_s( &file, i_path, "rb" ) != 0 )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "The asset loader failed to open \"" << i_path << "\"";
+			EAE6320_LOG_ERROR( "%s", errorMessage.str() );
+			return false;
+		}
+		fseek( file, 0, SEEK_END );
+		const long fileSize = ftell( file );
+		rewind( file );
+		bool wereThereErrors = false;
+		o_file = ( fileSize >= 0 ) ? malloc( static_cast<size_t>( fileSize ) + 1 ) : NULL;
+		if ( o_file )
+		{
+			o_fileSize = static_cast<size_t>( fileSize );
+			if ( fread( o_file, 1, o_fileSize, file ) == o_fileSize )
+			{
+				static_cast<char*>( o_file )[o_fileSize] = '\0';
+			}
+			else
+			{
+				wereThereErrors = true;
+				std::stringstream errorMessage;
+				errorMessage << "The asset loader failed to read \"" << i_path << "\"";
+				EAE6320_LOG_ERROR( "%s", errorMessage.str() );
+				free( o_file );
+				o_file = NULL;
+			}
+		}
+		else
+		{
+			wereThereErrors = true;
+			std::stringstream errorMessage;
+			errorMessage << "The asset loader failed to allocate memory for \"" << i_path << "\"";
+			EAE6320_LOG_ERROR( "%s", errorMessage.str() );
+		}
+		fclose( file );
+		return !wereThereErrors;
+	}
+
+	void DecodeRequest( void* io_request )
+	{
+		sRequest* const request = static_cast<sRequest*>( io_request );
+		if ( !request->wereThereErrors && ( request->type == AssetType_mesh ) )
+		{
+			if ( !eae6320::Graphics::Mesh::Decode( request->files[0], request->fileSizes[0], request->paths[0].c_str(), request->decodedMesh ) )
+			{
+				request->wereThereErrors = true;
+			}
+			// The decoded mesh has its own copy of everything that it needs
+			if ( !request->areFilesPacked[0] )
+			{
+				free( request->files[0] );
+			}
+			request->files[0] = NULL;
+		}
+		// Shaders have to be compiled on the render thread, and so there's nothing to decode
+
+		std::lock_guard<std::mutex> lock( s_mutex );
+		s_finishQueue.push_back( request );
+		if ( request->wasDispatched )
+		{
+			// Requests that were decoded by the I/O thread were never counted
+			// (the I/O threads are stopped before anything waits for this to reach zero)
+			assert( s_decodingCount > 0 );
+			--s_decodingCount;
+		}
+	}
+
+	bool Submit( sRequest* i_request, const bool i_isReload )
+	{
+		if ( !s_isInitialized )
+		{
+			delete i_request;
+			return false;
+		}
+		for ( unsigned int i = 0; i < 2; ++i )
+		{
+			i_request->files[i] = NULL;
+			i_request->fileSizes[i] = 0;
+			i_request->areFilesPacked[i] = false;
+		}
+		i_request->decodedMesh.geometry = NULL;
+		i_request->isReload = i_isReload;
+		i_request->submitTime = std::chrono::steady_clock::now();
+		i_request->wasDispatched = false;
+		i_request->wereThereErrors = false;
+		s_requests.push_back( i_request );
+		++s_stats.loadsRequested;
+		if ( i_isReload )
+		{
+			++s_stats.reloadsRequested;
+		}
+		{
+			std::lock_guard<std::mutex> lock( s_mutex );
+			s_readQueue.push_back( i_request );
+		}
+		s_ioCondition.notify_one();
+		return true;
+	}
+
+	void FinishRequest( sRequest* io_request )
+	{
+		if ( io_request->target == NULL )
+		{
+			++s_stats.loadsCancelled;
+		}
+		else if ( io_request->wereThereErrors )
+		{
+			++s_stats.loadsFailed;
+		}
+		else
+		{
+			// A reload of something that hasn't finished its first load yet is the same as a load
+			bool wasSuccessful;
+			if ( io_request->type == AssetType_mesh )
+			{
+				eae6320::Graphics::Mesh& mesh = *static_cast<eae6320::Graphics::Mesh*>( io_request->target );
+				wasSuccessful = ( io_request->isReload && mesh.IsLoaded() ) ?
+					mesh.Reload( io_request->decodedMesh ) : mesh.Initialize( io_request->decodedMesh );
+			}
+			else
+			{
+				eae6320::Graphics::Effect& effect = *static_cast<eae6320::Graphics::Effect*>( io_request->target );
+				const char* const vertexShaderSource = static_cast<const char*>( io_request->files[0] );
+				const char* const fragmentShaderSource = static_cast<const char*>( io_request->files[1] );
+				wasSuccessful = ( io_request->isReload && effect.IsLoaded() ) ?
+					effect.Reload( vertexShaderSource, fragmentShaderSource ) : effect.Initialize( vertexShaderSource, fragmentShaderSource );
+			}
+			++( wasSuccessful ? s_stats.loadsFinished : s_stats.loadsFailed );
+			// Whatever made a reload fail has already been logged as an error,
+			// and so this only logs how long the reload took or that the previous version is still being used
+			if ( io_request->isReload )
+			{
+				const double milliseconds =
+					std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - io_request->submitTime ).count();
+				if ( wasSuccessful )
+				{
+					EAE6320_LOG_INFO( "Reloaded \"%s\" %.3f ms after the reload was requested", io_request->paths[0], milliseconds );
+				}
+				else
+				{
+					EAE6320_LOG_WARNING( "Failed to reload \"%s\" (the previous version is still being used)", io_request->paths[0] );
+				}
+			}
+		}
+
+		for ( std::vector<sRequest*>::iterator i = s_requests.begin(); i != s_requests.end(); ++i )
+		{
+			if ( *i == io_request )
+			{
+				*i = s_requests.back();
+				s_requests.pop_back();
+				break;
+			}
+		}
+		DestroyRequest( io_request );
+	}
+
+	void DestroyRequest( sRequest* io_request )
+	{
+		for ( unsigned int i = 0; i < 2; ++i )
+		{
+			if ( io_request->files[i] && !io_request->areFilesPacked[i] )
+			{
+				free( io_request->files[i] );
+			}
+		}
+		eae6320::Graphics::Mesh::ReleaseDecoded( io_request->decodedMesh );
+		delete io_request;
+	}
+}
@@ -0,0 +1,104 @@
+/*
+	The asset loader loads meshes and effects in the background.
+
+	A load goes through three stages:
+		* A background I/O thread reads the files
+			(or finds them in the mounted AssetPack)
+		* The files are decoded, either by the decode dispatcher (e.g. on the job system)
+			or, if there isn't one, on the I/O thread
+		* Update() (or FinishLoads()) finishes the load on the render thread,
+			which is the only thread that is allowed to create GPU objects
+	A mesh or effect that is being loaded reports false from IsLoaded() until Update() has finished it,
+	and so a renderable that uses it isn't drawn until then.
+
+	When there is a separate render thread (see RenderThread.h)
+	the game thread can call DispatchDecodes() itself
+	and only needs to wait for the render thread to call FinishLoads() on frames where HasLoadsToFinish() is true.
+
+	The loader never touches a mesh or effect until Update() finishes its load,
+	and Cancel() makes sure that it never will
+	(it must be called before a mesh or effect with a pending load is destroyed).
+
+	A reload (see HotReload) reads the loose file even if there is a mounted AssetPack,
+	and a mesh or effect that is already loaded keeps drawing its old GPU objects until Update() swaps in the new ones
+	(if the new ones fail to load the old ones are kept).
+*/
+
+#ifndef EAE6320_ASSETLOADER_H
+#define EAE6320_ASSETLOADER_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class Effect;
+		class Mesh;
+
+		namespace AssetLoader
+		{
+			typedef void ( *tDecodeFunction )( void* io_request );
+			// The dispatcher must (eventually) call the function with the request on some thread
+			typedef void ( *tDecodeDispatcher )( const tDecodeFunction i_function, void* io_request );
+
+			// Counts since Initialize()
+			struct sAssetLoaderStats
+			{
+				unsigned int loadsRequested;
+				unsigned int loadsFinished;
+				unsigned int loadsFailed;
+				unsigned int loadsCancelled;
+				// Reloads are also counted as loads
+				unsigned int reloadsRequested;
+				uint64_t bytesRead;
+			};
+
+			bool Initialize( const unsigned int i_ioThreadCount = 1 );
+			// Cancels any loads that haven't finished
+			bool ShutDown();
+			bool IsInitialized();
+			// Decoding happens on the I/O threads until a dispatcher is set.
+			// The dispatcher is only called from Update() or DispatchDecodes()
+			void SetDecodeDispatcher( const tDecodeDispatcher i_dispatcher );
+
+			// These return false if the loader isn't initialized
+			// (the mesh or effect must not already be loaded)
+			bool LoadMesh( Mesh& io_mesh, const char* i_path );
+			bool LoadEffect( Effect& io_effect );
+			// These cancel any pending load for the mesh or effect first,
+			// so that an older load can never finish after a newer one
+			bool ReloadMesh( Mesh& io_mesh, const char* i_path );
+			bool ReloadEffect( Effect& io_effect );
+			// Makes sure that any pending load for the mesh or effect is never finished
+			void Cancel( const void* i_meshOrEffect );
+
+			// This must be called on the render thread.
+			// It dispatches files that have been read to be decoded
+			// and finishes the loads that have been decoded.
+			// Returns the number of loads that were finished
+			unsigned int Update();
+			// These are the two halves of Update().
+			// DispatchDecodes() doesn't touch any meshes or effects,
+			// but it must be called on the thread that the decode dispatcher expects
+			void DispatchDecodes();
+			// This must be called on the render thread
+			// while no other thread is using any of the meshes or effects that are being loaded
+			unsigned int FinishLoads();
+			// Whether FinishLoads() has anything to do
+			bool HasLoadsToFinish();
+			// The number of loads that haven't finished yet
+			unsigned int GetPendingLoadCount();
+			sAssetLoaderStats GetStats();
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETLOADER_H
@@ -0,0 +1,293 @@
+// Header Files
+//=============
+
+#include "AssetPack.h"
+
+#include <cctype>
+#include <sstream>
+#include <string>
+
+#include "AssetPackFile.h"
+#include "../UserOutput/UserOutput.h"
+#include "../Windows/WindowsFunctions.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	HANDLE s_fileHandle = INVALID_HANDLE_VALUE;
+	HANDLE s_mappingHandle = NULL;
+	const uint8_t* s_contents = NULL;
+	uint64_t s_size = 0;
+	const eae6320::Graphics::AssetPackFile::sEntry* s_tableOfContents = NULL;
+	uint32_t s_slotMask = 0;
+	// The directory that paths are relative to (including the trailing slash)
+	std::string s_directory;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Returns the part of the path after the pack's directory
+	// (or the whole path if it isn't in that directory)
+	const char* GetRelativePath( const char* i_path );
+	bool Validate( const char* i_path );
+}
+
+// Interface
+//==========
+
+bool eae6320::Graphics::AssetPack::Mount( const char* i_path )
+{
+	bool wereThereErrors = false;
+
+	Unmount();
+
+	// Open the file
+	{
+		const DWORD desiredAccess = FILE_GENERIC_READ;
+		const DWORD otherProgramsCanStillReadTheFile = FILE_SHARE_READ;
+		SECURITY_ATTRIBUTES* useDefaultSecurity = NULL;
+		const DWORD onlySucceedIfFileExists = OPEN_EXISTING;
+		// The pack is read in whatever order assets are requested
+		const DWORD useDefaultAttributes = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS;
+		const HANDLE dontUseTemplateFile = NULL;
+		s_fileHandle = CreateFile( i_path, desiredAccess, otherProgramsCanStillReadTheFile,
+			useDefaultSecurity, onlySucceedIfFileExists, useDefaultAttributes, dontUseTemplateFile );
+		if ( s_fileHandle == INVALID_HANDLE_VALUE )
+		{
+			DWORD errorCode;
+			const std::string windowsErrorMessage = eae6320::GetLastWindowsError( &errorCode );
+			// Not having a pack just means that loose files are used
+			if ( ( errorCode != ERROR_FILE_NOT_FOUND ) && ( errorCode != ERROR_PATH_NOT_FOUND ) )
+			{
+				std::stringstream errorMessage;
+				errorMessage << "Windows failed to open the asset pack \"" << i_path << "\": " << windowsErrorMessage;
+				eae6320::UserOutput::Print( errorMessage.str() );
+			}
+			wereThereErrors = true;
+			goto OnExit;
+		}
+	}
+	// Get its size
+	{
+		LARGE_INTEGER fileSize;
+		if ( GetFileSizeEx( s_fileHandle, &fileSize ) == FALSE )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Windows failed to get the size of the asset pack \"" << i_path << "\": " << eae6320::GetLastWindowsError();
+			eae6320::UserOutput::Print( errorMessage.str() );
+			wereThereErrors = true;
+			goto OnExit;
+		}
+		s_size = static_cast<uint64_t>( fileSize.QuadPart );
+		if ( s_size < sizeof( AssetPackFile::sHeader ) )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "The asset pack \"" << i_path << "\" is too small to be valid";
+			eae6320::UserOutput::Print( errorMessage.str() );
+			wereThereErrors = true;
+			goto OnExit;
+		}
+	}
+	// Map it
+	{
+		SECURITY_ATTRIBUTES* useDefaultSecurity = NULL;
+		const DWORD mapTheWholeFile = 0;
+		const char* const noName = NULL;
+		s_mappingHandle = CreateFileMapping( s_fileHandle, useDefaultSecurity, PAGE_READONLY, mapTheWholeFile, mapTheWholeFile, noName );
+		if ( s_mappingHandle == NULL )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Windows failed to create a mapping of the asset pack \"" << i_path << "\": " << eae6320::GetLastWindowsError();
+			eae6320::UserOutput::Print( errorMessage.str() );
+			wereThereErrors = true;
+			goto OnExit;
+		}
+		const DWORD fromTheBeginning = 0;
+		const SIZE_T viewTheWholeFile = 0;
+		s_contents = static_cast<const uint8_t*>( MapViewOfFile( s_mappingHandle, FILE_MAP_READ, fromTheBeginning, fromTheBeginning, viewTheWholeFile ) );
+		if ( s_contents == NULL )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Windows failed to map a view of the asset pack \"" << i_path << "\": " << eae6320::GetLastWindowsError();
+			eae6320::UserOutput::Print( errorMessage.str() );
+			wereThereErrors = true;
+			goto OnExit;
+		}
+	}
+	if ( !Validate( i_path ) )
+	{
+		wereThereErrors = true;
+		goto OnExit;
+	}
+	// Paths are relative to the pack's directory
+	{
+		size_t directoryLength = 0;
+		for ( size_t i = 0; i_path[i] != '\0'; ++i )
+		{
+			if ( ( i_path[i] == '/' ) || ( i_path[i] == '\\' ) )
+			{
+				directoryLength = i + 1;
+			}
+		}
+		s_directory.assign( i_path, directoryLength );
+	}
+
+OnExit:
+
+	if ( wereThereErrors )
+	{
+		Unmount();
+	}
+
+	return !wereThereErrors;
+}
+
+bool eae6320::Graphics::AssetPack::Unmount()
+{
+	bool wereThereErrors = false;
+
+	if ( s_contents )
+	{
+		if ( UnmapViewOfFile( s_contents ) == FALSE )
+		{
+			eae6320::UserOutput::Print( std::string( "Windows failed to unmap the asset pack: " ) + eae6320::GetLastWindowsError() );
+			wereThereErrors = true;
+		}
+		s_contents = NULL;
+	}
+	if ( s_mappingHandle != NULL )
+	{
+		if ( CloseHandle( s_mappingHandle ) == FALSE )
+		{
+			eae6320::UserOutput::Print( std::string( "Windows failed to close the asset pack's mapping: " ) + eae6320::GetLastWindowsError() );
+			wereThereErrors = true;
+		}
+		s_mappingHandle = NULL;
+	}
+	if ( s_fileHandle != INVALID_HANDLE_VALUE )
+	{
+		if ( CloseHandle( s_fileHandle ) == FALSE )
+		{
+			eae6320::UserOutput::Print( std::string( "Windows failed to close the asset pack: " ) + eae6320::GetLastWindowsError() );
+			wereThereErrors = true;
+		}
+		s_fileHandle = INVALID_HANDLE_VALUE;
+	}
+	s_size = 0;
+	s_tableOfContents = NULL;
+	s_slotMask = 0;
+	s_directory.clear();
+
+	return !wereThereErrors;
+}
+
+bool eae6320::Graphics::AssetPack::IsMounted()
+{
+	return s_tableOfContents != NULL;
+}
+
+bool eae6320::Graphics::AssetPack::Find( const char* i_path, const void*& o_contents, size_t& o_size )
+{
+	if ( !s_tableOfContents )
+	{
+		return false;
+	}
+
+	const uint64_t hash = AssetPackFile::HashPath( GetRelativePath( i_path ) );
+	// The table is never full, and so there is always an empty slot that ends the search
+	for ( uint32_t slot = static_cast<uint32_t>( hash ) & s_slotMask; ; slot = ( slot + 1 ) & s_slotMask )
+	{
+		const AssetPackFile::sEntry& entry = s_tableOfContents[slot];
+		if ( entry.pathHash == hash )
+		{
+			o_contents = s_contents + entry.offset;
+			o_size = static_cast<size_t>( entry.size );
+			return true;
+		}
+		else if ( entry.pathHash == AssetPackFile::s_emptyHash )
+		{
+			return false;
+		}
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	const char* GetRelativePath( const char* i_path )
+	{
+		// The directory is compared the same way that paths are hashed
+		// (ignoring case and the direction of slashes)
+		const size_t directoryLength = s_directory.size();
+		for ( size_t i = 0; i < directoryLength; ++i )
+		{
+			const char c = i_path[i];
+			const char d = s_directory[i];
+			const bool isSlash = ( c == '/' ) || ( c == '\\' );
+			if ( isSlash ? ( ( d != '/' ) && ( d != '\\' ) ) : ( tolower( c ) != tolower( d ) ) )
+			{
+				// (this also stops at the end of a path that is shorter than the directory)
+				return i_path;
+			}
+		}
+		return i_path + directoryLength;
+	}
+
+	bool Validate( const char* i_path )
+	{
+		using namespace eae6320::Graphics;
+
+		const AssetPackFile::sHeader& header = *reinterpret_cast<const AssetPackFile::sHeader*>( s_contents );
+		std::stringstream errorMessage;
+		if ( header.magic != AssetPackFile::s_magic )
+		{
+			errorMessage << "\"" << i_path << "\" isn't an asset pack";
+		}
+		else if ( header.version != AssetPackFile::s_version )
+		{
+			errorMessage << "The asset pack \"" << i_path << "\" is version " << header.version <<
+				" but version " << AssetPackFile::s_version << " is expected (rebuild the assets)";
+		}
+		else if ( ( header.slotCount == 0 ) || ( ( header.slotCount & ( header.slotCount - 1 ) ) != 0 )
+			|| ( header.entryCount >= header.slotCount ) )
+		{
+			errorMessage << "The asset pack \"" << i_path << "\" has an invalid table of contents";
+		}
+		else if ( ( header.tableOfContentsOffset > s_size )
+			|| ( ( s_size - header.tableOfContentsOffset ) / sizeof( AssetPackFile::sEntry ) < header.slotCount ) )
+		{
+			errorMessage << "The asset pack \"" << i_path << "\" is too small for its table of contents";
+		}
+		else
+		{
+			const AssetPackFile::sEntry* const tableOfContents =
+				reinterpret_cast<const AssetPackFile::sEntry*>( s_contents + header.tableOfContentsOffset );
+			// Every entry (and its zero byte) must be inside of the file
+			for ( uint32_t i = 0; i < header.slotCount; ++i )
+			{
+				const AssetPackFile::sEntry& entry = tableOfContents[i];
+				if ( ( entry.pathHash != AssetPackFile::s_emptyHash )
+					&& ( ( entry.offset > s_size ) || ( entry.size >= ( s_size - entry.offset ) ) ) )
+				{
+					errorMessage << "The asset pack \"" << i_path << "\" has an entry that is outside of the file";
+					break;
+				}
+			}
+			if ( errorMessage.tellp() <= 0 )
+			{
+				s_tableOfContents = tableOfContents;
+				s_slotMask = header.slotCount - 1;
+				return true;
+			}
+		}
+		eae6320::UserOutput::Print( errorMessage.str() );
+		return false;
+	}
+}
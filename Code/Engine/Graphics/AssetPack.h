@@ -0,0 +1,46 @@
+/*
+	The asset pack maps a pack file (see AssetPackFile.h) into memory
+	so that assets can be found by path without opening individual files.
+
+	Paths are given the same way as for loose files (e.g. "data/triangle.msh"):
+	if a path starts with the directory that the pack is in
+	it is looked up relative to that directory.
+	When there is no pack mounted, or an asset isn't in it, Find() returns false
+	and the caller should fall back to the loose file
+	(which is how assets are loaded during development).
+
+	A pack should be mounted before anything is loaded and unmounted after everything has finished loading;
+	Find() can be called from any thread while a pack is mounted.
+*/
+
+#ifndef EAE6320_ASSETPACK_H
+#define EAE6320_ASSETPACK_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace AssetPack
+		{
+			// Returns false if the pack doesn't exist or isn't valid
+			// (a pack that doesn't exist isn't reported as an error)
+			bool Mount( const char* i_path );
+			bool Unmount();
+			bool IsMounted();
+
+			// The contents are read-only and stay valid until the pack is unmounted.
+			// They are followed by a zero byte (which isn't included in the size)
+			bool Find( const char* i_path, const void*& o_contents, size_t& o_size );
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETPACK_H
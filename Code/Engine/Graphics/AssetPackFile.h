@@ -0,0 +1,85 @@
+/*
+	This file describes the binary asset pack format that AssetBuilder writes and AssetPack mounts.
+
+	A pack is a header, then a table of contents, then the assets' contents.
+	The table of contents is an open-addressed hash table (with linear probing)
+	that is indexed by the hash of each asset's path,
+	and so finding an asset only needs the path's hash and (usually) a single probe.
+	Every asset starts at a multiple of s_entryAlignment from the start of the file
+	and is followed by at least one zero byte,
+	so that the contents can be used directly from the mapped file
+	(including text assets like shaders, which can be used as C strings).
+*/
+
+#ifndef EAE6320_ASSETPACKFILE_H
+#define EAE6320_ASSETPACKFILE_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace AssetPackFile
+		{
+			// "EPAK" when read as bytes
+			const uint32_t s_magic = 0x4B415045;
+			const uint32_t s_version = 1;
+			const uint64_t s_entryAlignment = 16;
+			// A hash of zero marks an empty slot in the table of contents
+			const uint64_t s_emptyHash = 0;
+
+			struct sHeader
+			{
+				uint32_t magic;
+				uint32_t version;
+				uint32_t entryCount;
+				// Always a power of two
+				uint32_t slotCount;
+				// The table of contents is slotCount sEntries
+				uint64_t tableOfContentsOffset;
+			};
+
+			struct sEntry
+			{
+				uint64_t pathHash;
+				// From the start of the file
+				uint64_t offset;
+				// Not including the zero byte that follows the contents
+				uint64_t size;
+			};
+
+			// Paths are relative to the directory that the pack is in.
+			// Case and the direction of slashes are ignored
+			inline uint64_t HashPath( const char* i_path )
+			{
+				// 64-bit FNV-1a
+				uint64_t hash = 14695981039346656037ull;
+				for ( const char* character = i_path; *character != '\0'; ++character )
+				{
+					char c = *character;
+					if ( ( c >= 'A' ) && ( c <= 'Z' ) )
+					{
+						c = c - 'A' + 'a';
+					}
+					else if ( c == '\\' )
+					{
+						c = '/';
+					}
+					hash ^= static_cast<uint8_t>( c );
+					hash *= 1099511628211ull;
+				}
+				return ( hash != s_emptyHash ) ? hash : 1;
+			}
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETPACKFILE_H
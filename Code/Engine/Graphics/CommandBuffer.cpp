@@ -0,0 +1,190 @@
+// Header Files
+//=============
+
+#include "CommandBuffer.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "Effect.h"
+
+// Interface
+//==========
+
+// Recording
+//----------
+
+void eae6320::Graphics::cCommandBuffer::BindEffect( Effect& i_effect, const bool i_isInstanced )
+{
+	sCommand command;
+	command.type = static_cast<uint8_t>( i_isInstanced ? Command_bindEffectInstanced : Command_bindEffect );
+	command.lod = 0;
+	command.value = 0;
+	command.effect = &i_effect;
+	m_commands.push_back( command );
+	++m_stats.commandCount;
+	m_boundEffect = &i_effect;
+	m_isBoundEffectInstanced = i_isInstanced;
+}
+
+void eae6320::Graphics::cCommandBuffer::BindMesh( Mesh& i_mesh )
+{
+	sCommand command;
+	command.type = static_cast<uint8_t>( Command_bindMesh );
+	command.lod = 0;
+	command.value = 0;
+	command.mesh = &i_mesh;
+	m_commands.push_back( command );
+	++m_stats.commandCount;
+	m_boundMesh = &i_mesh;
+}
+
+void eae6320::Graphics::cCommandBuffer::SetDrawConstants( const sDrawConstants& i_drawConstants, const float i_offsetX, const float i_offsetY )
+{
+	sCommand command;
+	command.type = static_cast<uint8_t>( Command_setDrawConstants );
+	command.lod = 0;
+	command.value = static_cast<uint32_t>( m_drawConstants.size() );
+	command.instances = NULL;
+	m_commands.push_back( command );
+	++m_stats.commandCount;
+	m_drawConstants.push_back( i_drawConstants );
+	sInstance offset;
+	offset.x = i_offsetX;
+	offset.y = i_offsetY;
+	m_offsets.push_back( offset );
+}
+
+void eae6320::Graphics::cCommandBuffer::DrawPrimitives( const unsigned int i_lod )
+{
+	assert( m_boundMesh );
+	sCommand command;
+	command.type = static_cast<uint8_t>( Command_drawPrimitives );
+	command.lod = static_cast<uint8_t>( i_lod );
+	command.value = 0;
+	command.instances = NULL;
+	m_commands.push_back( command );
+	++m_stats.commandCount;
+	++m_stats.drawCount;
+}
+
+void eae6320::Graphics::cCommandBuffer::DrawInstanced( const sInstance* i_instances, const unsigned int i_instanceCount, const unsigned int i_lod )
+{
+	assert( m_boundMesh );
+	sCommand command;
+	command.type = static_cast<uint8_t>( Command_drawInstanced );
+	command.lod = static_cast<uint8_t>( i_lod );
+	command.value = i_instanceCount;
+	command.instances = i_instances;
+	m_commands.push_back( command );
+	++m_stats.commandCount;
+	++m_stats.drawCount;
+}
+
+void eae6320::Graphics::cCommandBuffer::Clear()
+{
+	m_commands.clear();
+	m_drawConstants.clear();
+	m_offsets.clear();
+	m_boundEffect = NULL;
+	m_isBoundEffectInstanced = false;
+	m_boundMesh = NULL;
+	memset( &m_stats, 0, sizeof( m_stats ) );
+}
+
+void eae6320::Graphics::cCommandBuffer::Append( const cCommandBuffer& i_other )
+{
+	const uint32_t firstDrawConstants = static_cast<uint32_t>( m_drawConstants.size() );
+	m_commands.reserve( m_commands.size() + i_other.m_commands.size() );
+	for ( std::vector<sCommand>::const_iterator i = i_other.m_commands.begin(); i != i_other.m_commands.end(); ++i )
+	{
+		sCommand command = *i;
+		switch ( command.type )
+		{
+		case Command_bindEffect:
+		case Command_bindEffectInstanced:
+			{
+				const bool isInstanced = command.type == Command_bindEffectInstanced;
+				if ( ( command.effect == m_boundEffect ) && ( isInstanced == m_isBoundEffectInstanced ) )
+				{
+					++m_stats.bindsElided;
+					continue;
+				}
+				m_boundEffect = command.effect;
+				m_isBoundEffectInstanced = isInstanced;
+			}
+			break;
+		case Command_bindMesh:
+			if ( command.mesh == m_boundMesh )
+			{
+				++m_stats.bindsElided;
+				continue;
+			}
+			m_boundMesh = command.mesh;
+			break;
+		case Command_setDrawConstants:
+			command.value += firstDrawConstants;
+			break;
+		default:
+			++m_stats.drawCount;
+			break;
+		}
+		m_commands.push_back( command );
+		++m_stats.commandCount;
+	}
+	m_drawConstants.insert( m_drawConstants.end(), i_other.m_drawConstants.begin(), i_other.m_drawConstants.end() );
+	m_offsets.insert( m_offsets.end(), i_other.m_offsets.begin(), i_other.m_offsets.end() );
+	m_stats.bindsElided += i_other.m_stats.bindsElided;
+}
+
+// Execution
+//----------
+
+void eae6320::Graphics::cCommandBuffer::Execute() const
+{
+	// The constants for every draw are uploaded at once
+	// (they are pushed in order, and so their handles are the same as their indices)
+	{
+		UniformRingBuffer::Clear();
+		for ( std::vector<sDrawConstants>::const_iterator i = m_drawConstants.begin(); i != m_drawConstants.end(); ++i )
+		{
+			UniformRingBuffer::Push( *i );
+		}
+		UniformRingBuffer::Upload();
+	}
+
+	Mesh* mesh = NULL;
+	for ( std::vector<sCommand>::const_iterator i = m_commands.begin(); i != m_commands.end(); ++i )
+	{
+		switch ( i->type )
+		{
+		case Command_bindEffect:
+			i->effect->Bind();
+			break;
+		case Command_bindEffectInstanced:
+			i->effect->BindInstanced();
+			break;
+		case Command_bindMesh:
+			mesh = i->mesh;
+			mesh->Bind();
+			break;
+		case Command_setDrawConstants:
+			UniformRingBuffer::Bind( i->value );
+			break;
+		case Command_drawPrimitives:
+			mesh->DrawPrimitives( i->lod );
+			break;
+		case Command_drawInstanced:
+			mesh->DrawInstanced( i->instances, i->value, i->lod );
+			break;
+		}
+	}
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Graphics::cCommandBuffer::cCommandBuffer()
+{
+	Clear();
+}
@@ -0,0 +1,140 @@
+/*
+	A command buffer is a linear list of the commands that draw a frame
+	(bind an effect, bind a mesh, set the draw constants, draw a range of indices)
+	that is recorded first and executed later.
+
+	Recording doesn't call into the platform, and so several threads can each record their own buffer at the same time
+	(see RenderQueue::Record()).
+	The buffers are then appended into a single one in order,
+	and any bind of an effect or mesh that is already bound at the end of the buffer that is being appended to is left out.
+	(A buffer that is recorded on its own doesn't know what the buffer before it will have bound,
+	and so it has to start by binding everything that it uses.)
+
+	The merged buffer is executed in a single pass by a backend:
+	Execute() issues it to the current platform,
+	and SoftwareRasterizer::Execute() draws it on the CPU.
+	Draw commands don't name a mesh; they draw the mesh that was bound most recently.
+*/
+
+#ifndef EAE6320_GRAPHICS_COMMANDBUFFER_H
+#define EAE6320_GRAPHICS_COMMANDBUFFER_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Mesh.h"
+#include "UniformRingBuffer.h"
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class Effect;
+
+		class cCommandBuffer
+		{
+			// Interface
+			//==========
+
+		public:
+
+			enum eCommandType
+			{
+				Command_bindEffect,
+				// The variant of the effect that reads the position offset from per-instance data
+				Command_bindEffectInstanced,
+				Command_bindMesh,
+				// The next draw uses these draw constants
+				Command_setDrawConstants,
+				Command_drawPrimitives,
+				Command_drawInstanced,
+			};
+
+			struct sCommand
+			{
+				uint8_t type;
+				// Draw commands
+				uint8_t lod;
+				// Command_setDrawConstants: The index of the draw constants (see GetDrawConstants())
+				// Command_drawInstanced: The number of instances
+				uint32_t value;
+				union
+				{
+					Effect* effect;
+					Mesh* mesh;
+					const sInstance* instances;
+				};
+			};
+
+			// Counts since the last Clear()
+			struct sStats
+			{
+				unsigned int commandCount;
+				unsigned int drawCount;
+				// Binds that Append() left out because the effect or mesh was already bound
+				unsigned int bindsElided;
+			};
+
+			// Recording
+			//----------
+
+			void BindEffect( Effect& i_effect, const bool i_isInstanced = false );
+			void BindMesh( Mesh& i_mesh );
+			// The offset is kept with the constants for backends that don't use the constants themselves
+			// (the offset that is in the constants includes the mesh's bias)
+			void SetDrawConstants( const sDrawConstants& i_drawConstants, const float i_offsetX, const float i_offsetY );
+			void DrawPrimitives( const unsigned int i_lod = 0 );
+			// The instances must stay valid until the buffer has been executed
+			void DrawInstanced( const sInstance* i_instances, const unsigned int i_instanceCount, const unsigned int i_lod = 0 );
+			void Clear();
+
+			// Appends the other buffer's commands,
+			// leaving out binds of an effect or a mesh that is already bound at the end of this buffer
+			void Append( const cCommandBuffer& i_other );
+
+			// Execution
+			//----------
+
+			// Issues every command to the current platform
+			// (the draw constants are uploaded with the UniformRingBuffer first).
+			// This must be called between Graphics' clear and present on the render thread
+			void Execute() const;
+
+			const sCommand* GetCommands() const { return m_commands.empty() ? NULL : &m_commands[0]; }
+			size_t GetCommandCount() const { return m_commands.size(); }
+			const sDrawConstants& GetDrawConstants( const uint32_t i_index ) const { return m_drawConstants[i_index]; }
+			// The offset that was recorded with the draw constants
+			const sInstance& GetOffset( const uint32_t i_index ) const { return m_offsets[i_index]; }
+			const sStats& GetStats() const { return m_stats; }
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			cCommandBuffer();
+
+			// Data
+			//=====
+
+		private:
+
+			std::vector<sCommand> m_commands;
+			std::vector<sDrawConstants> m_drawConstants;
+			std::vector<sInstance> m_offsets;
+			// What is bound after the last command
+			// (these are NULL if nothing has been bound yet)
+			const Effect* m_boundEffect;
+			bool m_isBoundEffectInstanced;
+			const Mesh* m_boundMesh;
+			sStats m_stats;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_COMMANDBUFFER_H
@@ -0,0 +1,192 @@
+#include "Effect.h"
+
+#include <cassert>
+#include <sstream>
+#include "AssetPack.h"
+#include "UniformRingBuffer.h"
+#include "../Memory/Memory.h"
+#include "../UserOutput/Log.h"
+#include "../Windows/WindowsFunctions.h"
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace
+		{
+			uint16_t s_nextId = 0;
+		}
+
+		const char* const Effect::s_vertexShaderPath = "data/vertex.shader";
+		const char* const Effect::s_fragmentShaderPath = "data/fragment.shader";
+
+		Effect::Effect()
+		{
+			mId = s_nextId++;
+			mIsLoaded = false;
+		}
+
+		bool Effect::Initialize()
+		{
+			// The shader sources are only needed until they have been compiled
+			eae6320::Memory::StackAllocator::cScopedMarker loadMarker(eae6320::Memory::GetLoadAllocator());
+			const void* vertexShaderSource;
+			const void* fragmentShaderSource;
+			size_t fileSize;
+			std::string errorMessage;
+			// Sources in a mounted pack are already NULL-terminated in memory
+			if (!AssetPack::Find(s_vertexShaderPath, vertexShaderSource, fileSize) &&
+				!LoadAndAllocateShaderProgram(s_vertexShaderPath, const_cast<void*&>(vertexShaderSource), fileSize, &errorMessage))
+			{
+				EAE6320_LOG_ERROR("%s", errorMessage);
+				return false;
+			}
+			if (!AssetPack::Find(s_fragmentShaderPath, fragmentShaderSource, fileSize) &&
+				!LoadAndAllocateShaderProgram(s_fragmentShaderPath, const_cast<void*&>(fragmentShaderSource), fileSize, &errorMessage))
+			{
+				EAE6320_LOG_ERROR("%s", errorMessage);
+				return false;
+			}
+			return Initialize(reinterpret_cast<const char*>(vertexShaderSource), reinterpret_cast<const char*>(fragmentShaderSource));
+		}
+
+		bool Effect::Reload(const char* i_vertexShaderSource, const char* i_fragmentShaderSource)
+		{
+			// An effect's shaders are only released by ShutDown() (there is no destructor),
+			// and so the new effect can be compiled separately and then copied over this one
+			Effect reloaded;
+			if (!reloaded.Initialize(i_vertexShaderSource, i_fragmentShaderSource))
+			{
+				return false;
+			}
+			ShutDown();
+			const uint16_t id = mId;
+			*this = reloaded;
+			mId = id;
+			return true;
+		}
+
+		bool Effect::LoadAndAllocateShaderProgram(const char* i_path, void*& o_shader, size_t& o_size, std::string* o_errorMessage)
+		{
+			bool wereThereErrors = false;
+
+			// Load the shader source from disk
+			o_shader = NULL;
+			HANDLE fileHandle = INVALID_HANDLE_VALUE;
+			{
+				// Open the file
+				{
+					const DWORD desiredAccess = FILE_GENERIC_READ;
+					const DWORD otherProgramsCanStillReadTheFile = FILE_SHARE_READ;
+					SECURITY_ATTRIBUTES* useDefaultSecurity = NULL;
+					const DWORD onlySucceedIfFileExists = OPEN_EXISTING;
+					const DWORD useDefaultAttributes = FILE_ATTRIBUTE_NORMAL;
+					const HANDLE dontUseTemplateFile = NULL;
+					fileHandle = CreateFile(i_path, desiredAccess, otherProgramsCanStillReadTheFile,
+						useDefaultSecurity, onlySucceedIfFileExists, useDefaultAttributes, dontUseTemplateFile);
+					if (fileHandle == INVALID_HANDLE_VALUE)
+					{
+						wereThereErrors = true;
+						if (o_errorMessage)
+						{
+							std::string windowsErrorMessage = eae6320::GetLastWindowsError();
+							std::stringstream errorMessage;
+							errorMessage << "Windows failed to open the shader file: " << windowsErrorMessage;
+							*o_errorMessage = errorMessage.str();
+						}
+						goto OnExit;
+					}
+				}
+				// Get the file's size
+				{
+					LARGE_INTEGER fileSize_integer;
+					if (GetFileSizeEx(fileHandle, &fileSize_integer) != FALSE)
+					{
+						assert(fileSize_integer.QuadPart <= SIZE_MAX);
+						o_size = static_cast<size_t>(fileSize_integer.QuadPart);
+					}
+					else
+					{
+						wereThereErrors = true;
+						if (o_errorMessage)
+						{
+							std::string windowsErrorMessage = eae6320::GetLastWindowsError();
+							std::stringstream errorMessage;
+							errorMessage << "Windows failed to get the size of shader: " << windowsErrorMessage;
+							*o_errorMessage = errorMessage.str();
+						}
+						goto OnExit;
+					}
+					// Add an extra byte for a NULL terminator
+					o_size += 1;
+				}
+				// Read the file's contents into temporary memory
+				// (the caller's scoped marker frees it)
+				o_shader = eae6320::Memory::GetLoadAllocator().Allocate(o_size);
+				if (o_shader)
+				{
+					DWORD bytesReadCount;
+					OVERLAPPED* readSynchronously = NULL;
+					if (ReadFile(fileHandle, o_shader, o_size,
+						&bytesReadCount, readSynchronously) == FALSE)
+					{
+						wereThereErrors = true;
+						if (o_errorMessage)
+						{
+							std::string windowsErrorMessage = eae6320::GetLastWindowsError();
+							std::stringstream errorMessage;
+							errorMessage << "Windows failed to read the contents of shader: " << windowsErrorMessage;
+							*o_errorMessage = errorMessage.str();
+						}
+						goto OnExit;
+					}
+				}
+				else
+				{
+					wereThereErrors = true;
+					if (o_errorMessage)
+					{
+						std::stringstream errorMessage;
+						errorMessage << "Failed to allocate " << o_size << " bytes to read in the shader program " << i_path;
+						*o_errorMessage = errorMessage.str();
+					}
+					goto OnExit;
+				}
+				// Add the NULL terminator
+				reinterpret_cast<char*>(o_shader)[o_size - 1] = '\0';
+			}
+
+		OnExit:
+
+			if (wereThereErrors)
+			{
+				o_shader = NULL;
+			}
+			if (fileHandle != INVALID_HANDLE_VALUE)
+			{
+				if (CloseHandle(fileHandle) == FALSE)
+				{
+					if (!wereThereErrors && o_errorMessage)
+					{
+						std::string windowsError = eae6320::GetLastWindowsError();
+						std::stringstream errorMessage;
+						errorMessage << "Windows failed to close the shader file handle: " << windowsError;
+						*o_errorMessage = errorMessage.str();
+					}
+					wereThereErrors = true;
+				}
+				fileHandle = INVALID_HANDLE_VALUE;
+			}
+
+			return !wereThereErrors;
+		}
+
+		void Effect::SetDrawCallUniforms(const sDrawConstants & i_drawConstants)
+		{
+			UniformRingBuffer::Clear();
+			const uint32_t handle = UniformRingBuffer::Push(i_drawConstants);
+			UniformRingBuffer::Upload();
+			UniformRingBuffer::Bind(handle);
+		}
+	}
+}
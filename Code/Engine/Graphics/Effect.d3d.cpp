@@ -1,18 +1,16 @@
 #include "Effect.h"
 
 #include <cassert>
+#include <cstring>
 #include <sstream>
-#include "../UserOutput/UserOutput.h"
+#include "RenderState.h"
+#include "../UserOutput/Log.h"
 
 namespace eae6320
 {
 	namespace Graphics
 	{
 		IDirect3DDevice9* Effect::s_direct3dDevice = NULL;
-		Effect::Effect()
-		{
-
-		}
 		void Effect::SetDirect3dDevice(IDirect3DDevice9* i_direct3dDevice)
 		{
 			s_direct3dDevice = i_direct3dDevice;
@@ -21,16 +19,21 @@ namespace eae6320
 		{
 			s_direct3dDevice = NULL;
 		}
-		bool Effect::Initialize()
+		bool Effect::Initialize(const char* i_vertexShaderSource, const char* i_fragmentShaderSource)
 		{
-			if (!LoadVertexShader())
+			if (!LoadVertexShader(false, i_vertexShaderSource))
+			{
+				goto OnError;
+			}
+			if (!LoadVertexShader(true, i_vertexShaderSource))
 			{
 				goto OnError;
 			}
-			if (!LoadFragmentShader())
+			if (!LoadFragmentShader(i_fragmentShaderSource))
 			{
 				goto OnError;
 			}
+			mIsLoaded = true;
 			return true;
 		OnError:
 			ShutDown();
@@ -41,16 +44,15 @@ namespace eae6320
 		{
 			// Set the shaders
 			{
-				HRESULT result = s_direct3dDevice->SetVertexShader(s_vertexShader);
-				assert(SUCCEEDED(result));
-				result = s_direct3dDevice->SetPixelShader(s_fragmentShader);
-				assert(SUCCEEDED(result));
+				RenderState::SetVertexShader(s_vertexShader);
+				RenderState::SetPixelShader(s_fragmentShader);
 			}
 		}
 
-		void Effect::SetDrawCallUniforms(float * floatArray)
+		void Effect::BindInstanced()
 		{
-			HRESULT result = vertexShaderConstantTable->SetFloatArray(s_direct3dDevice, positionHandle, floatArray, 2);
+			RenderState::SetVertexShader(s_instancedVertexShader);
+			RenderState::SetPixelShader(s_fragmentShader);
 		}
 
 		void Effect::ShutDown()
@@ -60,20 +62,27 @@ namespace eae6320
 				s_vertexShader->Release();
 				s_vertexShader = NULL;
 			}
+			if (s_instancedVertexShader)
+			{
+				s_instancedVertexShader->Release();
+				s_instancedVertexShader = NULL;
+			}
 			if (s_fragmentShader)
 			{
 				s_fragmentShader->Release();
 				s_fragmentShader = NULL;
 			}
-			
+			// A new shader could be given the address of a released one
+			RenderState::Invalidate();
+			mIsLoaded = false;
 		}
 
-		bool Effect::LoadFragmentShader()
+		bool Effect::LoadFragmentShader(const char* i_source)
 		{
-			// Load the source code from file and compile it
+			// Compile the source code
 			ID3DXBuffer* compiledShader;
 			{
-				const char* sourceCodeFileName = "data/fragment.shader";
+				const char* sourceCodeFileName = s_fragmentShaderPath;
 				const D3DXMACRO defines[] =
 				{
 					{ "EAE6320_PLATFORM_D3D", "1" },
@@ -85,7 +94,7 @@ namespace eae6320
 				const DWORD noFlags = 0;
 				ID3DXBuffer* errorMessages = NULL;
 				ID3DXConstantTable** noConstants = NULL;
-				HRESULT result = D3DXCompileShaderFromFile(sourceCodeFileName, defines, noIncludes, entryPoint, profile, noFlags,
+				HRESULT result = D3DXCompileShader(i_source, static_cast<UINT>(strlen(i_source)), defines, noIncludes, entryPoint, profile, noFlags,
 					&compiledShader, &errorMessages, noConstants);
 				if (SUCCEEDED(result))
 				{
@@ -101,14 +110,14 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "Direct3D failed to compile the fragment shader from the file " << sourceCodeFileName
 							<< ":\n" << reinterpret_cast<char*>(errorMessages->GetBufferPointer());
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						errorMessages->Release();
 					}
 					else
 					{
 						std::stringstream errorMessage;
 						errorMessage << "Direct3D failed to compile the fragment shader from the file " << sourceCodeFileName;
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 					}
 					return false;
 				}
@@ -120,7 +129,7 @@ namespace eae6320
 					&s_fragmentShader);
 				if (FAILED(result))
 				{
-					eae6320::UserOutput::Print("Direct3D failed to create the fragment shader");
+					EAE6320_LOG_ERROR("Direct3D failed to create the fragment shader");
 					wereThereErrors = true;
 				}
 				compiledShader->Release();
@@ -128,15 +137,17 @@ namespace eae6320
 			return !wereThereErrors;
 		}
 		
-		bool Effect::LoadVertexShader()
+		bool Effect::LoadVertexShader(const bool i_instanced, const char* i_source)
 		{
-			// Load the source code from file and compile it
+			// Compile the source code
 			ID3DXBuffer* compiledShader;
 			{
-				const char* sourceCodeFileName = "data/vertex.shader";
+				const char* sourceCodeFileName = s_vertexShaderPath;
 				const D3DXMACRO defines[] =
 				{
 					{ "EAE6320_PLATFORM_D3D", "1" },
+					// (a NULL name ends the list early when compiling the non-instanced variant)
+					{ i_instanced ? "EAE6320_INSTANCED" : NULL, "1" },
 					{ NULL, NULL }
 				};
 				ID3DXInclude* noIncludes = NULL;
@@ -144,19 +155,16 @@ namespace eae6320
 				const char* profile = "vs_3_0";
 				const DWORD noFlags = 0;
 				ID3DXBuffer* errorMessages = NULL;
-				//ID3DXConstantTable** offsetTable = NULL;
-				HRESULT result = D3DXCompileShaderFromFile(sourceCodeFileName, defines, noIncludes, entryPoint, profile, noFlags,
-					&compiledShader, &errorMessages, &vertexShaderConstantTable);
+				// The constants are set by register (see UniformRingBuffer.h)
+				ID3DXConstantTable** noConstants = NULL;
+				HRESULT result = D3DXCompileShader(i_source, static_cast<UINT>(strlen(i_source)), defines, noIncludes, entryPoint, profile, noFlags,
+					&compiledShader, &errorMessages, noConstants);
 				if (SUCCEEDED(result))
 				{
 					if (errorMessages)
 					{
 						errorMessages->Release();
 					}
-					if (vertexShaderConstantTable)
-					{
-						positionHandle = vertexShaderConstantTable->GetConstantByName(NULL, "g_position_offset");
-					}
 				}
 				else
 				{
@@ -165,14 +173,14 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "Direct3D failed to compile the vertex shader from the file " << sourceCodeFileName
 							<< ":\n" << reinterpret_cast<char*>(errorMessages->GetBufferPointer());
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						errorMessages->Release();
 					}
 					else
 					{
 						std::stringstream errorMessage;
 						errorMessage << "Direct3D failed to compile the vertex shader from the file " << sourceCodeFileName;
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 					}
 					return false;
 				}
@@ -181,10 +189,10 @@ namespace eae6320
 			bool wereThereErrors = false;
 			{
 				HRESULT result = s_direct3dDevice->CreateVertexShader(reinterpret_cast<DWORD*>(compiledShader->GetBufferPointer()),
-					&s_vertexShader);
+					i_instanced ? &s_instancedVertexShader : &s_vertexShader);
 				if (FAILED(result))
 				{
-					eae6320::UserOutput::Print("Direct3D failed to create the vertex shader");
+					EAE6320_LOG_ERROR("Direct3D failed to create the vertex shader");
 					wereThereErrors = true;
 				}
 				compiledShader->Release();
@@ -1,35 +1,62 @@
 #include "Effect.h"
 #include <cassert>
 #include <sstream>
-#include "../UserOutput/UserOutput.h"
+#include "RenderState.h"
+#include "UniformRingBuffer.h"
+#include "../UserOutput/Log.h"
 #include "../Windows/WindowsFunctions.h"
 namespace eae6320
 {
 	namespace Graphics
 	{
-		Effect::Effect()
+		bool Effect::Initialize(const char* i_vertexShaderSource, const char* i_fragmentShaderSource)
 		{
-
-		}
-		bool Effect::Initialize()
-		{
-			if (!CreateProgram())
+			if (!CreateProgram(s_programId, false, i_vertexShaderSource, i_fragmentShaderSource))
+			{
+				ShutDown();
+				return false;
+			}
+			if (!CreateProgram(s_instancedProgramId, true, i_vertexShaderSource, i_fragmentShaderSource))
 			{
 				ShutDown();
 				return false;
 			}
-			positionOffset = glGetUniformLocation(s_programId, "g_position_offset");
+			// Point the per-draw constants at the uniform ring buffer
+			// (the instanced program uses them for the mesh's dequantization)
+			const GLuint programIds[] = { s_programId, s_instancedProgramId };
+			for (size_t i = 0; i < (sizeof(programIds) / sizeof(programIds[0])); ++i)
+			{
+				const GLuint blockIndex = glGetUniformBlockIndex(programIds[i], "DrawConstants");
+				if (blockIndex != GL_INVALID_INDEX)
+				{
+					glUniformBlockBinding(programIds[i], blockIndex, UniformRingBuffer::s_bindingPoint);
+					const GLenum errorCode = glGetError();
+					if (errorCode != GL_NO_ERROR)
+					{
+						std::stringstream errorMessage;
+						errorMessage << "OpenGL failed to bind the DrawConstants uniform block: " <<
+							reinterpret_cast<const char*>(gluErrorString(errorCode));
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
+						ShutDown();
+						return false;
+					}
+				}
+			}
+			mIsLoaded = true;
 			return true;
 		}
 		void Effect::Bind()
 		{
 			// Set the vertex and fragment shaders
 			{
-				glUseProgram(s_programId);
-				assert(glGetError() == GL_NO_ERROR);
+				RenderState::UseProgram(s_programId);
 			}
 
 		}
+		void Effect::BindInstanced()
+		{
+			RenderState::UseProgram(s_instancedProgramId);
+		}
 		void Effect::ShutDown()
 		{
 			if (s_programId != 0)
@@ -41,47 +68,59 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to delete the program: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 				}
 				s_programId = 0;
 			}
+			if (s_instancedProgramId != 0)
+			{
+				glDeleteProgram(s_instancedProgramId);
+				const GLenum errorCode = glGetError();
+				if (errorCode != GL_NO_ERROR)
+				{
+					std::stringstream errorMessage;
+					errorMessage << "OpenGL failed to delete the instanced program: " <<
+						reinterpret_cast<const char*>(gluErrorString(errorCode));
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
+				}
+				s_instancedProgramId = 0;
+			}
+			// A new program could be given the ID of a deleted one
+			RenderState::Invalidate();
+			mIsLoaded = false;
 		}
-		void Effect::SetDrawCallUniforms(float * floatArray)
-		{
-			glUniform2fv(positionOffset, 1, floatArray);
-		}
-		bool Effect::CreateProgram()
+		bool Effect::CreateProgram(GLuint& o_programId, const bool i_instanced, const char* i_vertexShaderSource, const char* i_fragmentShaderSource)
 		{
 			// Create a program
 			{
-				s_programId = glCreateProgram();
+				o_programId = glCreateProgram();
 				const GLenum errorCode = glGetError();
 				if (errorCode != GL_NO_ERROR)
 				{
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to create a program: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					return false;
 				}
-				else if (s_programId == 0)
+				else if (o_programId == 0)
 				{
-					eae6320::UserOutput::Print("OpenGL failed to create a program");
+					EAE6320_LOG_ERROR("OpenGL failed to create a program");
 					return false;
 				}
 			}
 			// Load and attach the shaders
-			if (!LoadVertexShader(s_programId))
+			if (!LoadVertexShader(o_programId, i_instanced, i_vertexShaderSource))
 			{
 				return false;
 			}
-			if (!LoadFragmentShader(s_programId))
+			if (!LoadFragmentShader(o_programId, i_fragmentShaderSource))
 			{
 				return false;
 			}
 			// Link the program
 			{
-				glLinkProgram(s_programId);
+				glLinkProgram(o_programId);
 				GLenum errorCode = glGetError();
 				if (errorCode == GL_NO_ERROR)
 				{
@@ -91,13 +130,13 @@ namespace eae6320
 					std::string linkInfo;
 					{
 						GLint infoSize;
-						glGetProgramiv(s_programId, GL_INFO_LOG_LENGTH, &infoSize);
+						glGetProgramiv(o_programId, GL_INFO_LOG_LENGTH, &infoSize);
 						errorCode = glGetError();
 						if (errorCode == GL_NO_ERROR)
 						{
 							sLogInfo info(static_cast<size_t>(infoSize));
 							GLsizei* dontReturnLength = NULL;
-							glGetProgramInfoLog(s_programId, static_cast<GLsizei>(infoSize), dontReturnLength, info.memory);
+							glGetProgramInfoLog(o_programId, static_cast<GLsizei>(infoSize), dontReturnLength, info.memory);
 							errorCode = glGetError();
 							if (errorCode == GL_NO_ERROR)
 							{
@@ -108,7 +147,7 @@ namespace eae6320
 								std::stringstream errorMessage;
 								errorMessage << "OpenGL failed to get link info of the program: " <<
 									reinterpret_cast<const char*>(gluErrorString(errorCode));
-								eae6320::UserOutput::Print(errorMessage.str());
+								EAE6320_LOG_ERROR("%s", errorMessage.str());
 								return false;
 							}
 						}
@@ -117,14 +156,14 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "OpenGL failed to get the length of the program link info: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 							return false;
 						}
 					}
 					// Check to see if there were link errors
 					GLint didLinkingSucceed;
 					{
-						glGetProgramiv(s_programId, GL_LINK_STATUS, &didLinkingSucceed);
+						glGetProgramiv(o_programId, GL_LINK_STATUS, &didLinkingSucceed);
 						errorCode = glGetError();
 						if (errorCode == GL_NO_ERROR)
 						{
@@ -132,7 +171,7 @@ namespace eae6320
 							{
 								std::stringstream errorMessage;
 								errorMessage << "The program failed to link:\n" << linkInfo;
-								eae6320::UserOutput::Print(errorMessage.str());
+								EAE6320_LOG_ERROR("%s", errorMessage.str());
 								return false;
 							}
 						}
@@ -141,7 +180,7 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "OpenGL failed to find out if linking of the program succeeded: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 							return false;
 						}
 					}
@@ -151,129 +190,14 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to link the program: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					return false;
 				}
 			}
 
 			return true;
 		}
-		bool Effect::LoadAndAllocateShaderProgram(const char* i_path, void*& o_shader, size_t& o_size, std::string* o_errorMessage)
-		{
-			bool wereThereErrors = false;
-
-			// Load the shader source from disk
-			o_shader = NULL;
-			HANDLE fileHandle = INVALID_HANDLE_VALUE;
-			{
-				// Open the file
-				{
-					const DWORD desiredAccess = FILE_GENERIC_READ;
-					const DWORD otherProgramsCanStillReadTheFile = FILE_SHARE_READ;
-					SECURITY_ATTRIBUTES* useDefaultSecurity = NULL;
-					const DWORD onlySucceedIfFileExists = OPEN_EXISTING;
-					const DWORD useDefaultAttributes = FILE_ATTRIBUTE_NORMAL;
-					const HANDLE dontUseTemplateFile = NULL;
-					fileHandle = CreateFile(i_path, desiredAccess, otherProgramsCanStillReadTheFile,
-						useDefaultSecurity, onlySucceedIfFileExists, useDefaultAttributes, dontUseTemplateFile);
-					if (fileHandle == INVALID_HANDLE_VALUE)
-					{
-						wereThereErrors = true;
-						if (o_errorMessage)
-						{
-							std::string windowsErrorMessage = eae6320::GetLastWindowsError();
-							std::stringstream errorMessage;
-							errorMessage << "Windows failed to open the shader file: " << windowsErrorMessage;
-							*o_errorMessage = errorMessage.str();
-						}
-						goto OnExit;
-					}
-				}
-				// Get the file's size
-				{
-					LARGE_INTEGER fileSize_integer;
-					if (GetFileSizeEx(fileHandle, &fileSize_integer) != FALSE)
-					{
-						assert(fileSize_integer.QuadPart <= SIZE_MAX);
-						o_size = static_cast<size_t>(fileSize_integer.QuadPart);
-					}
-					else
-					{
-						wereThereErrors = true;
-						if (o_errorMessage)
-						{
-							std::string windowsErrorMessage = eae6320::GetLastWindowsError();
-							std::stringstream errorMessage;
-							errorMessage << "Windows failed to get the size of shader: " << windowsErrorMessage;
-							*o_errorMessage = errorMessage.str();
-						}
-						goto OnExit;
-					}
-					// Add an extra byte for a NULL terminator
-					o_size += 1;
-				}
-				// Read the file's contents into temporary memory
-				o_shader = malloc(o_size);
-				if (o_shader)
-				{
-					DWORD bytesReadCount;
-					OVERLAPPED* readSynchronously = NULL;
-					if (ReadFile(fileHandle, o_shader, o_size,
-						&bytesReadCount, readSynchronously) == FALSE)
-					{
-						wereThereErrors = true;
-						if (o_errorMessage)
-						{
-							std::string windowsErrorMessage = eae6320::GetLastWindowsError();
-							std::stringstream errorMessage;
-							errorMessage << "Windows failed to read the contents of shader: " << windowsErrorMessage;
-							*o_errorMessage = errorMessage.str();
-						}
-						goto OnExit;
-					}
-				}
-				else
-				{
-					wereThereErrors = true;
-					if (o_errorMessage)
-					{
-						std::stringstream errorMessage;
-						errorMessage << "Failed to allocate " << o_size << " bytes to read in the shader program " << i_path;
-						*o_errorMessage = errorMessage.str();
-					}
-					goto OnExit;
-				}
-				// Add the NULL terminator
-				reinterpret_cast<char*>(o_shader)[o_size - 1] = '\0';
-			}
-
-		OnExit:
-
-			if (wereThereErrors && o_shader)
-			{
-				free(o_shader);
-				o_shader = NULL;
-			}
-			if (fileHandle != INVALID_HANDLE_VALUE)
-			{
-				if (CloseHandle(fileHandle) == FALSE)
-				{
-					if (!wereThereErrors && o_errorMessage)
-					{
-						std::string windowsError = eae6320::GetLastWindowsError();
-						std::stringstream errorMessage;
-						errorMessage << "Windows failed to close the shader file handle: " << windowsError;
-						*o_errorMessage = errorMessage.str();
-					}
-					wereThereErrors = true;
-				}
-				fileHandle = INVALID_HANDLE_VALUE;
-			}
-
-			return !wereThereErrors;
-		}
-
-		bool Effect::LoadFragmentShader(const GLuint i_programId)
+		bool Effect::LoadFragmentShader(const GLuint i_programId, const char* i_source)
 		{
 			// Verify that compiling shaders at run-time is supported
 			{
@@ -281,29 +205,16 @@ namespace eae6320
 				glGetBooleanv(GL_SHADER_COMPILER, &isShaderCompilingSupported);
 				if (!isShaderCompilingSupported)
 				{
-					eae6320::UserOutput::Print("Compiling shaders at run-time isn't supported on this implementation (this should never happen)");
+					EAE6320_LOG_ERROR("Compiling shaders at run-time isn't supported on this implementation (this should never happen)");
 					return false;
 				}
 			}
 
 			bool wereThereErrors = false;
 
-			// Load the source code from file and set it into a shader
+			// Set the source code into a shader
 			GLuint fragmentShaderId = 0;
-			void* shaderSource = NULL;
 			{
-				// Load the shader source code
-				size_t fileSize;
-				{
-					const char* sourceCodeFileName = "data/fragment.shader";
-					std::string errorMessage;
-					if (!LoadAndAllocateShaderProgram(sourceCodeFileName, shaderSource, fileSize, &errorMessage))
-					{
-						wereThereErrors = true;
-						eae6320::UserOutput::Print(errorMessage);
-						goto OnExit;
-					}
-				}
 				// Generate a shader
 				fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
 				{
@@ -314,13 +225,13 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "OpenGL failed to get an unused fragment shader ID: " <<
 							reinterpret_cast<const char*>(gluErrorString(errorCode));
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						goto OnExit;
 					}
 					else if (fragmentShaderId == 0)
 					{
 						wereThereErrors = true;
-						eae6320::UserOutput::Print("OpenGL failed to get an unused fragment shader ID");
+						EAE6320_LOG_ERROR("OpenGL failed to get an unused fragment shader ID");
 						goto OnExit;
 					}
 				}
@@ -331,7 +242,7 @@ namespace eae6320
 					{
 						"#version 330 // The version of GLSL to use must come first\n",
 						"#define EAE6320_PLATFORM_GL\n",
-						reinterpret_cast<GLchar*>(shaderSource)
+						reinterpret_cast<const GLchar*>(i_source)
 					};
 					const GLint* sourcesAreNullTerminated = NULL;
 					glShaderSource(fragmentShaderId, shaderSourceCount, shaderSources, sourcesAreNullTerminated);
@@ -342,7 +253,7 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "OpenGL failed to set the fragment shader source code: " <<
 							reinterpret_cast<const char*>(gluErrorString(errorCode));
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						goto OnExit;
 					}
 				}
@@ -377,7 +288,7 @@ namespace eae6320
 								std::stringstream errorMessage;
 								errorMessage << "OpenGL failed to get compilation info of the fragment shader source code: " <<
 									reinterpret_cast<const char*>(gluErrorString(errorCode));
-								eae6320::UserOutput::Print(errorMessage.str());
+								EAE6320_LOG_ERROR("%s", errorMessage.str());
 								goto OnExit;
 							}
 						}
@@ -387,7 +298,7 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "OpenGL failed to get the length of the fragment shader compilation info: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 							goto OnExit;
 						}
 					}
@@ -403,7 +314,7 @@ namespace eae6320
 								wereThereErrors = true;
 								std::stringstream errorMessage;
 								errorMessage << "The fragment shader failed to compile:\n" << compilationInfo;
-								eae6320::UserOutput::Print(errorMessage.str());
+								EAE6320_LOG_ERROR("%s", errorMessage.str());
 								goto OnExit;
 							}
 						}
@@ -413,7 +324,7 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "OpenGL failed to find out if compilation of the fragment shader source code succeeded: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 							goto OnExit;
 						}
 					}
@@ -424,7 +335,7 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to compile the fragment shader source code: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					goto OnExit;
 				}
 			}
@@ -438,7 +349,7 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to attach the fragment shader to the program: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					goto OnExit;
 				}
 			}
@@ -458,20 +369,15 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to delete the fragment shader ID: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 				}
 				fragmentShaderId = 0;
 			}
-			if (shaderSource != NULL)
-			{
-				free(shaderSource);
-				shaderSource = NULL;
-			}
 
 			return !wereThereErrors;
 		}
 
-		bool Effect::LoadVertexShader(const GLuint i_programId)
+		bool Effect::LoadVertexShader(const GLuint i_programId, const bool i_instanced, const char* i_source)
 		{
 			// Verify that compiling shaders at run-time is supported
 			{
@@ -479,29 +385,16 @@ namespace eae6320
 				glGetBooleanv(GL_SHADER_COMPILER, &isShaderCompilingSupported);
 				if (!isShaderCompilingSupported)
 				{
-					eae6320::UserOutput::Print("Compiling shaders at run-time isn't supported on this implementation (this should never happen)");
+					EAE6320_LOG_ERROR("Compiling shaders at run-time isn't supported on this implementation (this should never happen)");
 					return false;
 				}
 			}
 
 			bool wereThereErrors = false;
 
-			// Load the source code from file and set it into a shader
+			// Set the source code into a shader
 			GLuint vertexShaderId = 0;
-			void* shaderSource = NULL;
 			{
-				// Load the shader source code
-				size_t fileSize;
-				{
-					const char* sourceCodeFileName = "data/vertex.shader";
-					std::string errorMessage;
-					if (!LoadAndAllocateShaderProgram(sourceCodeFileName, shaderSource, fileSize, &errorMessage))
-					{
-						wereThereErrors = true;
-						eae6320::UserOutput::Print(errorMessage);
-						goto OnExit;
-					}
-				}
 				// Generate a shader
 				vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
 				{
@@ -512,24 +405,25 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "OpenGL failed to get an unused vertex shader ID: " <<
 							reinterpret_cast<const char*>(gluErrorString(errorCode));
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						goto OnExit;
 					}
 					else if (vertexShaderId == 0)
 					{
 						wereThereErrors = true;
-						eae6320::UserOutput::Print("OpenGL failed to get an unused vertex shader ID");
+						EAE6320_LOG_ERROR("OpenGL failed to get an unused vertex shader ID");
 						goto OnExit;
 					}
 				}
 				// Set the source code into the shader
 				{
-					const GLsizei shaderSourceCount = 3;
+					const GLsizei shaderSourceCount = 4;
 					const GLchar* shaderSources[] =
 					{
 						"#version 330 // The version of GLSL to use must come first\n",
 						"#define EAE6320_PLATFORM_GL\n",
-						reinterpret_cast<GLchar*>(shaderSource)
+						i_instanced ? "#define EAE6320_INSTANCED\n" : "",
+						reinterpret_cast<const GLchar*>(i_source)
 					};
 					const GLint* sourcesAreNullTerminated = NULL;
 					glShaderSource(vertexShaderId, shaderSourceCount, shaderSources, sourcesAreNullTerminated);
@@ -540,7 +434,7 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "OpenGL failed to set the vertex shader source code: " <<
 							reinterpret_cast<const char*>(gluErrorString(errorCode));
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						goto OnExit;
 					}
 				}
@@ -575,7 +469,7 @@ namespace eae6320
 								std::stringstream errorMessage;
 								errorMessage << "OpenGL failed to get compilation info of the vertex shader source code: " <<
 									reinterpret_cast<const char*>(gluErrorString(errorCode));
-								eae6320::UserOutput::Print(errorMessage.str());
+								EAE6320_LOG_ERROR("%s", errorMessage.str());
 								goto OnExit;
 							}
 						}
@@ -585,7 +479,7 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "OpenGL failed to get the length of the vertex shader compilation info: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 							goto OnExit;
 						}
 					}
@@ -601,7 +495,7 @@ namespace eae6320
 								wereThereErrors = true;
 								std::stringstream errorMessage;
 								errorMessage << "The vertex shader failed to compile:\n" << compilationInfo;
-								eae6320::UserOutput::Print(errorMessage.str());
+								EAE6320_LOG_ERROR("%s", errorMessage.str());
 								goto OnExit;
 							}
 						}
@@ -611,7 +505,7 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "OpenGL failed to find out if compilation of the vertex shader source code succeeded: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 							goto OnExit;
 						}
 					}
@@ -622,7 +516,7 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to compile the vertex shader source code: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					goto OnExit;
 				}
 			}
@@ -636,7 +530,7 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to attach the vertex shader to the program: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					goto OnExit;
 				}
 			}
@@ -656,15 +550,10 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to delete the vertex shader ID: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 				}
 				vertexShaderId = 0;
 			}
-			if (shaderSource != NULL)
-			{
-				free(shaderSource);
-				shaderSource = NULL;
-			}
 
 			return !wereThereErrors;
 		}
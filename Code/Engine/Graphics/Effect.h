@@ -2,6 +2,7 @@
 #define EAE6320_EFFECT_H
 
 #include <cstdint>
+#include <string>
 
 #if defined EAE6320_PLATFORM_GL
 #include "../../Externals/OpenGlExtensions/OpenGlExtensions.h"
@@ -16,24 +17,50 @@ namespace eae6320
 {
 	namespace Graphics
 	{
+		struct sDrawConstants;
+
 		class Effect
 		{
 #if defined EAE6320_PLATFORM_GL
 			// OpenGL encapsulates a matching vertex shader and fragment shader into what it calls a "program".
 			GLuint s_programId = 0;
-			GLint positionOffset = -1;
+			// The same shaders compiled with EAE6320_INSTANCED defined
+			GLuint s_instancedProgramId = 0;
 #elif defined EAE6320_PLATFORM_D3D
 			// The vertex shader is a program that operates on vertices.
 			IDirect3DVertexShader9* s_vertexShader = NULL;
 			// The fragment shader is a program that operates on fragments
 			IDirect3DPixelShader9* s_fragmentShader = NULL;
+			// The vertex shader compiled with EAE6320_INSTANCED defined
+			IDirect3DVertexShader9* s_instancedVertexShader = NULL;
 #endif //Platform Check
+			// Identifies the effect in render queue sort keys
+			uint16_t mId;
+			// False until the shaders have been compiled
+			bool mIsLoaded;
 
 		public:
+			// Every effect currently uses the same shaders
+			static const char* const s_vertexShaderPath;
+			static const char* const s_fragmentShaderPath;
+
 			Effect();
+			uint16_t GetId() const { return mId; }
+			// Reads the shader files and compiles them
 			bool Initialize();
+			// Compiles shader source code that has already been read (e.g. by the AssetLoader);
+			// the sources must be NULL-terminated
+			bool Initialize(const char* i_vertexShaderSource, const char* i_fragmentShaderSource);
+			// Recompiles an effect that is already loaded (see HotReload).
+			// The effect keeps its ID, and if the new shaders don't compile it keeps the old ones
+			bool Reload(const char* i_vertexShaderSource, const char* i_fragmentShaderSource);
+			bool IsLoaded() const { return mIsLoaded; }
 			void Bind();
-			void SetDrawCallUniforms(float * floatArray);
+			// Binds the variant that reads the position offset from per-instance data (see Mesh::DrawInstanced())
+			void BindInstanced();
+			// This goes through the UniformRingBuffer with a single slot,
+			// and so it must not be called while a RenderQueue is being drawn
+			void SetDrawCallUniforms(const sDrawConstants & i_drawConstants);
 			void ShutDown();
 #if defined EAE6320_PLATFORM_GL
 
@@ -44,20 +71,20 @@ namespace eae6320
 				~sLogInfo() { if (memory) free(memory); }
 			};
 
-			bool CreateProgram();
-			bool LoadAndAllocateShaderProgram(const char* i_path, void*& o_shader, size_t& o_size, std::string* o_errorMessage);
-			bool LoadFragmentShader(const GLuint i_programId);
-			bool LoadVertexShader(const GLuint i_programId);
+			bool CreateProgram(GLuint& o_programId, const bool i_instanced, const char* i_vertexShaderSource, const char* i_fragmentShaderSource);
+			bool LoadFragmentShader(const GLuint i_programId, const char* i_source);
+			bool LoadVertexShader(const GLuint i_programId, const bool i_instanced, const char* i_source);
 #elif defined EAE6320_PLATFORM_D3D
 			static IDirect3DDevice9* s_direct3dDevice;
 			static void SetDirect3dDevice(IDirect3DDevice9* i_direct3dDevice);
 			static void ReleaseDirect3dDevice();
-			ID3DXConstantTable * vertexShaderConstantTable;
-			D3DXHANDLE positionHandle;
-			bool LoadFragmentShader();
-			bool LoadVertexShader();
+			bool LoadFragmentShader(const char* i_source);
+			bool LoadVertexShader(const bool i_instanced, const char* i_source);
 
 #endif //Platform Check
+			// Reads a file into the calling thread's load allocator and adds a NULL terminator
+			// (the caller must scope it with a StackAllocator::cScopedMarker)
+			static bool LoadAndAllocateShaderProgram(const char* i_path, void*& o_shader, size_t& o_size, std::string* o_errorMessage);
 		};
 	}
 }
@@ -11,6 +11,8 @@
 #include "../UserOutput/UserOutput.h"
 #include "Mesh.h"
 #include "Effect.h"
+#include "RenderState.h"
+#include "UniformRingBuffer.h"
 
 // Static Data Initialization
 //===========================
@@ -59,6 +61,19 @@ bool eae6320::Graphics::Initialize( const HWND i_renderingWindow )
 	*/
 	Mesh::SetDirect3dDevice(s_direct3dDevice);
 	Effect::SetDirect3dDevice(s_direct3dDevice);
+	// Nothing is known about what a new device has set
+	RenderState::Invalidate();
+	RenderState::ResetStats();
+	if (!Mesh::InitializeInstancing())
+	{
+		// The reason has already been logged
+		UserOutput::Print("Direct3D failed to create the instance buffer (see the log for details)");
+		goto OnError;
+	}
+	if (!UniformRingBuffer::Initialize())
+	{
+		goto OnError;
+	}
 	/*void * buffer;
 	buffer = s_mesh1->LoadMesh("data/square.msh");
 	if (!s_mesh1->Initialize(buffer))
@@ -84,7 +99,13 @@ OnError:
 	return false;
 }
 
-void eae6320::Graphics::Render(eae6320::Graphics::Renderable ** i_RenderingList, const unsigned int i_RenderingListLength)
+void eae6320::Graphics::Render( RenderQueue& i_renderQueue )
+{
+	Submit( i_renderQueue );
+	Present();
+}
+
+void eae6320::Graphics::Submit( RenderQueue& i_renderQueue )
 {
 	// Every frame an entirely new image will be created.
 	// Before drawing anything, then, the previous image will be erased
@@ -111,15 +132,15 @@ void eae6320::Graphics::Render(eae6320::Graphics::Renderable ** i_RenderingList,
 		HRESULT result = s_direct3dDevice->BeginScene();
 		assert( SUCCEEDED( result ) );
 		{
-			for (unsigned int i = 0; i < i_RenderingListLength; i++)
-			{
-				i_RenderingList[i]->Draw();
-			}
+			i_renderQueue.Draw();
 		}
 		result = s_direct3dDevice->EndScene();
 		assert( SUCCEEDED( result ) );
 	}
+}
 
+void eae6320::Graphics::Present()
+{
 	// Everything has been drawn to the "back buffer", which is just an image in memory.
 	// In order to display it, the contents of the back buffer must be "presented"
 	// (to the front buffer)
@@ -133,6 +154,18 @@ void eae6320::Graphics::Render(eae6320::Graphics::Renderable ** i_RenderingList,
 	}
 }
 
+bool eae6320::Graphics::AcquireContext()
+{
+	// The device isn't created with D3DCREATE_MULTITHREADED,
+	// and so it can be used from any thread as long as only one thread uses it at a time
+	return s_direct3dDevice != NULL;
+}
+
+bool eae6320::Graphics::ReleaseContext()
+{
+	return s_direct3dDevice != NULL;
+}
+
 bool eae6320::Graphics::ShutDown()
 {
 	bool wereThereErrors = false;
@@ -148,6 +181,8 @@ bool eae6320::Graphics::ShutDown()
 			delete s_mesh1;
 			delete s_mesh2;*/
 
+			UniformRingBuffer::ShutDown();
+			Mesh::ShutDownInstancing();
 			Mesh::ReleaseDirect3dDevice();
 			Effect::ReleaseDirect3dDevice();
 			
@@ -12,6 +12,8 @@
 #include <sstream>
 #include "Mesh.h"
 #include "Effect.h"
+#include "RenderState.h"
+#include "UniformRingBuffer.h"
 #include "../UserOutput/UserOutput.h"
 #include "../Windows/WindowsFunctions.h"
 #include "../../Externals/OpenGlExtensions/OpenGlExtensions.h"
@@ -63,6 +65,20 @@ bool eae6320::Graphics::Initialize( const HWND i_renderingWindow )
 			goto OnError;
 		}
 	}
+	// Nothing is known about what a new context has bound
+	RenderState::Invalidate();
+	RenderState::ResetStats();
+	// Create the buffer that instanced draws read per-instance data from
+	if ( !Mesh::InitializeInstancing() )
+	{
+		// The reason has already been logged
+		UserOutput::Print( "OpenGL failed to create the instance buffer (see the log for details)" );
+		goto OnError;
+	}
+	if ( !UniformRingBuffer::Initialize() )
+	{
+		goto OnError;
+	}
 
 	/*s_mesh1 = Mesh::CreateMesh();
 	s_mesh2 = Mesh::CreateMesh();
@@ -86,7 +102,13 @@ OnError:
 	return false;
 }
 
-void eae6320::Graphics::Render(eae6320::Graphics::Renderable ** i_RenderingList, const unsigned int i_RenderingListLength)
+void eae6320::Graphics::Render( RenderQueue& i_renderQueue )
+{
+	Submit( i_renderQueue );
+	Present();
+}
+
+void eae6320::Graphics::Submit( RenderQueue& i_renderQueue )
 {
 	// Every frame an entirely new image will be created.
 	// Before drawing anything, then, the previous image will be erased
@@ -104,13 +126,12 @@ void eae6320::Graphics::Render(eae6320::Graphics::Renderable ** i_RenderingList,
 
 	// The actual function calls that draw geometry
 	{
-		for (unsigned int i = 0; i < i_RenderingListLength; i++)
-		{
-			i_RenderingList[i]->Draw();
-		}
-
+		i_renderQueue.Draw();
 	}
+}
 
+void eae6320::Graphics::Present()
+{
 	// Everything has been drawn to the "back buffer", which is just an image in memory.
 	// In order to display it, the contents of the back buffer must be swapped with the "front buffer"
 	// (which is what the user sees)
@@ -120,6 +141,31 @@ void eae6320::Graphics::Render(eae6320::Graphics::Renderable ** i_RenderingList,
 	}
 }
 
+bool eae6320::Graphics::AcquireContext()
+{
+	if ( wglMakeCurrent( s_deviceContext, s_openGlRenderingContext ) == FALSE )
+	{
+		std::stringstream errorMessage;
+		errorMessage << "Windows failed to set the current OpenGL rendering context: " << GetLastWindowsError();
+		UserOutput::Print( errorMessage.str() );
+		return false;
+	}
+	return true;
+}
+
+bool eae6320::Graphics::ReleaseContext()
+{
+	// A context can only be current on one thread at a time
+	if ( wglMakeCurrent( s_deviceContext, NULL ) == FALSE )
+	{
+		std::stringstream errorMessage;
+		errorMessage << "Windows failed to unset the current OpenGL rendering context: " << GetLastWindowsError();
+		UserOutput::Print( errorMessage.str() );
+		return false;
+	}
+	return true;
+}
+
 bool eae6320::Graphics::ShutDown()
 {
 	bool wereThereErrors = false;
@@ -144,6 +190,8 @@ bool eae6320::Graphics::ShutDown()
 			delete s_mesh2;
 			s_mesh2 = NULL;
 		}*/
+		UniformRingBuffer::ShutDown();
+		Mesh::ShutDownInstancing();
 		if ( wglMakeCurrent( s_deviceContext, NULL ) != FALSE )
 		{
 			if ( wglDeleteContext( s_openGlRenderingContext ) == FALSE )
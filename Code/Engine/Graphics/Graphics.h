@@ -9,7 +9,7 @@
 //=============
 
 #include "../Windows/Includes.h"
-#include "Renderable.h"
+#include "RenderQueue.h"
 
 // Interface
 //==========
@@ -19,8 +19,21 @@ namespace eae6320
 	namespace Graphics
 	{
 		bool Initialize( const HWND i_renderingWindow );
-		void Render(Renderable ** i_renderingList, const unsigned int i_RenderingListLength);
+		// The queue is sorted, drawn, and then cleared
+		// (this is Submit() followed by Present())
+		void Render( RenderQueue& i_renderQueue );
+		// Draws the queue into the back buffer
+		void Submit( RenderQueue& i_renderQueue );
+		// Shows the back buffer
+		// (this is where the CPU waits if the GPU is behind or if the display is synchronized)
+		void Present();
 		bool ShutDown();
+
+		// Only one thread can use graphics at a time.
+		// Initialize() makes it the calling thread,
+		// and another thread (e.g. the render thread, see RenderThread.h) can only take over after that thread releases it
+		bool AcquireContext();
+		bool ReleaseContext();
 	}
 }
 
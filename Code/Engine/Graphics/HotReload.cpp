@@ -0,0 +1,224 @@
+// Header Files
+//=============
+
+#include "HotReload.h"
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "AssetLoader.h"
+#include "Effect.h"
+#include "HotReloadMessage.h"
+#include "Mesh.h"
+#include "../UserOutput/Log.h"
+#include "../Windows/Includes.h"
+#include "../Windows/WindowsFunctions.h"
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	struct sTrackedAsset
+	{
+		void* target;
+		// Effects are always loaded from Effect::s_vertexShaderPath and Effect::s_fragmentShaderPath
+		bool isEffect;
+		// As it was given to TrackMesh() (the mesh is reloaded from the same path)
+		std::string path;
+	};
+}
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	HANDLE s_mailslot = INVALID_HANDLE_VALUE;
+	std::string s_builtAssetDirectory;
+	std::vector<sTrackedAsset> s_trackedAssets;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Case and the direction of slashes are ignored when paths are compared
+	std::string NormalizePath( const std::string& i_path );
+	bool Contains( const std::vector<std::string>& i_paths, const std::string& i_path );
+}
+
+// Interface
+//==========
+
+bool eae6320::Graphics::HotReload::Initialize( const char* i_builtAssetDirectory )
+{
+	if ( s_mailslot != INVALID_HANDLE_VALUE )
+	{
+		return true;
+	}
+	{
+		const DWORD maxMessageSize = static_cast<DWORD>( HotReloadMessage::s_maxSize );
+		// Update() only reads messages that are already there
+		const DWORD dontWaitForMessages = 0;
+		SECURITY_ATTRIBUTES* useDefaultSecurity = NULL;
+		s_mailslot = CreateMailslot( HotReloadMessage::s_mailslotName, maxMessageSize, dontWaitForMessages, useDefaultSecurity );
+	}
+	if ( s_mailslot == INVALID_HANDLE_VALUE )
+	{
+		// Hot reloading is only a convenience, and so this isn't shown in a message box
+		EAE6320_LOG_WARNING( "Windows failed to create the hot reload mailslot (assets won't be reloaded): %s", GetLastWindowsError() );
+		return false;
+	}
+	s_builtAssetDirectory = i_builtAssetDirectory;
+	return true;
+}
+
+bool eae6320::Graphics::HotReload::ShutDown()
+{
+	bool wereThereErrors = false;
+	if ( s_mailslot != INVALID_HANDLE_VALUE )
+	{
+		if ( CloseHandle( s_mailslot ) == FALSE )
+		{
+			wereThereErrors = true;
+		}
+		s_mailslot = INVALID_HANDLE_VALUE;
+	}
+	s_trackedAssets.clear();
+	return !wereThereErrors;
+}
+
+void eae6320::Graphics::HotReload::TrackMesh( Mesh& i_mesh, const char* i_path )
+{
+	if ( s_mailslot != INVALID_HANDLE_VALUE )
+	{
+		sTrackedAsset trackedAsset;
+		trackedAsset.target = &i_mesh;
+		trackedAsset.isEffect = false;
+		trackedAsset.path = i_path;
+		s_trackedAssets.push_back( trackedAsset );
+	}
+}
+
+void eae6320::Graphics::HotReload::TrackEffect( Effect& i_effect )
+{
+	if ( s_mailslot != INVALID_HANDLE_VALUE )
+	{
+		sTrackedAsset trackedAsset;
+		trackedAsset.target = &i_effect;
+		trackedAsset.isEffect = true;
+		s_trackedAssets.push_back( trackedAsset );
+	}
+}
+
+void eae6320::Graphics::HotReload::Untrack( const void* i_meshOrEffect )
+{
+	for ( size_t i = 0; i < s_trackedAssets.size(); )
+	{
+		if ( s_trackedAssets[i].target == i_meshOrEffect )
+		{
+			s_trackedAssets[i] = s_trackedAssets.back();
+			s_trackedAssets.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+unsigned int eae6320::Graphics::HotReload::Update()
+{
+	if ( s_mailslot == INVALID_HANDLE_VALUE )
+	{
+		return 0;
+	}
+
+	// Read every path that has been sent since the last update
+	// (a path that was sent more than once is only reloaded once)
+	std::vector<std::string> changedPaths;
+	for ( ;; )
+	{
+		DWORD nextMessageSize;
+		{
+			DWORD* const dontGetMaxMessageSize = NULL;
+			DWORD* const dontGetMessageCount = NULL;
+			DWORD* const dontGetReadTimeout = NULL;
+			if ( GetMailslotInfo( s_mailslot, dontGetMaxMessageSize, &nextMessageSize, dontGetMessageCount, dontGetReadTimeout ) == FALSE )
+			{
+				break;
+			}
+		}
+		if ( nextMessageSize == MAILSLOT_NO_MESSAGE )
+		{
+			break;
+		}
+		char message[HotReloadMessage::s_maxSize];
+		DWORD messageSize;
+		OVERLAPPED* const readSynchronously = NULL;
+		if ( ( ReadFile( s_mailslot, message, sizeof( message ), &messageSize, readSynchronously ) == FALSE ) || ( messageSize == 0 ) )
+		{
+			break;
+		}
+		const std::string changedPath = NormalizePath( s_builtAssetDirectory + std::string( message, messageSize ) );
+		if ( !Contains( changedPaths, changedPath ) )
+		{
+			changedPaths.push_back( changedPath );
+		}
+	}
+	if ( changedPaths.empty() )
+	{
+		return 0;
+	}
+
+	// Reload everything that uses the changed paths
+	const bool haveShadersChanged = Contains( changedPaths, NormalizePath( Effect::s_vertexShaderPath ) )
+		|| Contains( changedPaths, NormalizePath( Effect::s_fragmentShaderPath ) );
+	unsigned int reloadCount = 0;
+	for ( std::vector<sTrackedAsset>::const_iterator i = s_trackedAssets.begin(); i != s_trackedAssets.end(); ++i )
+	{
+		if ( i->isEffect )
+		{
+			if ( haveShadersChanged && AssetLoader::ReloadEffect( *static_cast<Effect*>( i->target ) ) )
+			{
+				++reloadCount;
+			}
+		}
+		else if ( Contains( changedPaths, NormalizePath( i->path ) ) && AssetLoader::ReloadMesh( *static_cast<Mesh*>( i->target ), i->path.c_str() ) )
+		{
+			++reloadCount;
+		}
+	}
+	return reloadCount;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	std::string NormalizePath( const std::string& i_path )
+	{
+		std::string path( i_path );
+		for ( std::string::iterator i = path.begin(); i != path.end(); ++i )
+		{
+			*i = ( *i == '\\' ) ? '/' : static_cast<char>( tolower( static_cast<unsigned char>( *i ) ) );
+		}
+		return path;
+	}
+
+	bool Contains( const std::vector<std::string>& i_paths, const std::string& i_path )
+	{
+		for ( std::vector<std::string>::const_iterator i = i_paths.begin(); i != i_paths.end(); ++i )
+		{
+			if ( *i == i_path )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
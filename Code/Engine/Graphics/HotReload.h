@@ -0,0 +1,48 @@
+/*
+	Hot reloading replaces meshes and effects while the game is running
+	when AssetBuilder rebuilds them in its watch mode ("AssetBuilder.exe -watch").
+
+	Every mesh and effect that is loaded from a file is tracked with its path,
+	and Update() reads the paths that AssetBuilder has sent (see HotReloadMessage.h)
+	and asks the AssetLoader to reload everything that uses them.
+	The AssetLoader swaps the new versions in when it finishes them,
+	and so Update() must be called at a frame boundary before AssetLoader::Update()
+	(nothing that is drawn in a frame ever changes in the middle of it).
+
+	If the mailslot can't be created (e.g. because another game is already using it)
+	Initialize() fails and nothing is tracked or reloaded.
+*/
+
+#ifndef EAE6320_HOTRELOAD_H
+#define EAE6320_HOTRELOAD_H
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class Effect;
+		class Mesh;
+
+		namespace HotReload
+		{
+			// The directory is what the built asset directory is called relative to the game (e.g. "data/"),
+			// and it is put in front of every path that AssetBuilder sends
+			bool Initialize( const char* i_builtAssetDirectory );
+			bool ShutDown();
+
+			// Nothing is tracked unless HotReload is initialized
+			void TrackMesh( Mesh& i_mesh, const char* i_path );
+			void TrackEffect( Effect& i_effect );
+			// This must be called before a tracked mesh or effect is destroyed
+			void Untrack( const void* i_meshOrEffect );
+
+			// Returns how many reloads were requested
+			unsigned int Update();
+		}
+	}
+}
+
+#endif	// EAE6320_HOTRELOAD_H
@@ -0,0 +1,36 @@
+/*
+	This file describes how AssetBuilder tells a running game that assets have been rebuilt
+	(see HotReload).
+
+	The game creates a mailslot with this name,
+	and while AssetBuilder is watching for changes it writes a message to the mailslot for every target that it builds.
+	A message is only the target's path relative to the built asset directory (e.g. "triangle.msh"),
+	without a NULL terminator.
+	If the game isn't running the mailslot doesn't exist and nothing is sent.
+*/
+
+#ifndef EAE6320_HOTRELOADMESSAGE_H
+#define EAE6320_HOTRELOADMESSAGE_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace HotReloadMessage
+		{
+			const char* const s_mailslotName = "\\\\.\\mailslot\\eae6320\\HotReload";
+			// Longer paths are never sent
+			const size_t s_maxSize = 260;
+		}
+	}
+}
+
+#endif	// EAE6320_HOTRELOADMESSAGE_H
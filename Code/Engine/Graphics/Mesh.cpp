@@ -2,8 +2,15 @@
 
 #include <cstdio>
 #include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
-#include "../UserOutput/UserOutput.h"
+#include "AssetPack.h"
+#include "MeshDecoder.h"
+#include "UniformRingBuffer.h"
+#include "../Memory/Memory.h"
+#include "../UserOutput/Log.h"
 
 namespace eae6320
 {
@@ -11,52 +18,565 @@ namespace eae6320
 	{
 		//Helper Functionss
 
+		namespace
+		{
+			uint16_t s_nextId = 0;
+
+			// The encoder and decoder work with bytes, and so they must agree with the vertex formats about their sizes
+			static_assert(sizeof(sVertex) == 12, "The mesh file's float vertex size doesn't match sVertex");
+			static_assert(sizeof(sQuantizedVertex) == 8, "The mesh file's quantized vertex size doesn't match sQuantizedVertex");
+
+			// No mesh needs anywhere near this much memory to expand its geometry,
+			// and so a file whose counts say that it does is corrupt
+			const uint64_t s_maxExpandedSize = 512 * 1024 * 1024;
+
+			// What ParseFile() finds in a loaded file
+			struct sParsedFile
+			{
+				uint32_t vertexCount, indexCount;
+				MeshFile::sBounds bounds;
+				uint32_t positionFormat;
+				float positionScale[2], positionBias[2];
+				uint32_t lodCount;
+				MeshFile::sLod lods[MeshFile::s_maxLodCount];
+				// These point into the file, and are NULL if the geometry is compressed
+				const void * vertexData;
+				const uint32_t * indexData;
+				// These are only set if the geometry is compressed
+				const void * encodedData;
+				size_t encodedSize;
+			};
+
+			// Finds the counts, bounds, and geometry in a loaded file.
+			// This doesn't touch any mesh, and so it can be called from any thread
+			bool ParseFile(const void * i_file, const size_t i_fileSize, const char * i_path, sParsedFile & o_file);
+			// The size of the scratch memory that ExpandGeometry() needs (which is 0 for uncompressed geometry)
+			size_t GetExpandScratchSize(const sParsedFile & i_file);
+			// The counts come straight from the file, and so the memory that expanding the geometry will need
+			// is checked with 64-bit math before anything calculates it in size_t
+			// (otherwise a corrupt header could wrap the size of an allocation on 32-bit builds)
+			bool IsExpandedSizeValid(const sParsedFile & i_file, const char * i_path);
+			// Decodes and dequantizes the file's geometry into a block that holds sVertex vertices followed by the indices
+			bool ExpandGeometry(const sParsedFile & i_file, const char * i_path, void * o_geometry, void * io_scratch);
+		}
+
 		Mesh::Mesh()
 		{
+			mId = s_nextId++;
 
+#if defined EAE6320_PLATFORM_GL
+			s_vertexArrayId = 0;
+#endif //Platform Check
 			mVertexData = NULL;
 			mIndexData = NULL;
 			mVertexCount = 0;
 			mIndexCount = 0;
+			mBuffer = NULL;
+			mIsLoaded = false;
+			MeshFile::CalculateBounds(NULL, sizeof(sVertex), 0, mBounds);
+			mPositionFormat = MeshFile::PositionFormat_float32;
+			mPositionScale[0] = mPositionScale[1] = 1.0f;
+			mPositionBias[0] = mPositionBias[1] = 0.0f;
+			mLodCount = 1;
+			memset(mLods, 0, sizeof(mLods));
 		}
 
 
 		void * Mesh::LoadMesh(const char * i_path)
 		{
-			FILE * iFile;
-			void * buffer;
-			size_t fileSize;
+			void * buffer = NULL;
+			size_t fileSize = 0;
+
+			// A mounted pack already has the file in memory
+			{
+				const void * packedFile;
+				size_t packedFileSize;
+				if (AssetPack::Find(i_path, packedFile, packedFileSize))
+				{
+					buffer = const_cast<void *>(packedFile);
+					fileSize = packedFileSize;
+				}
+			}
 
-			fopen_s(&iFile, i_path, "rb");
-			if (iFile != NULL)
+			if (buffer == NULL)
 			{
+				FILE * iFile;
+				fopen_s(&iFile, i_path, "rb");
+				if (iFile == NULL)
+				{
+					return NULL;
+				}
 				fseek(iFile, 0, SEEK_END);
 				fileSize = ftell(iFile);
 				rewind(iFile);
 
-				buffer = (void *)malloc(fileSize);
+				// The file is only a temporary:
+				// Initialize() copies the geometry that the mesh keeps out of it
+				buffer = eae6320::Memory::GetLoadAllocator().Allocate(fileSize);
+				if (buffer == NULL)
+				{
+					fclose(iFile);
+					return NULL;
+				}
 
 				size_t result = fread(buffer, 1, fileSize, iFile);
+				fclose(iFile);
 				if (result != fileSize)
 				{
-					eae6320::UserOutput::Print("Error reading file");
-					free(buffer);
+					EAE6320_LOG_ERROR("Error reading file");
 					return NULL;
 				}
-				char * iPointer = reinterpret_cast<char *>(buffer);
-				mVertexCount = *reinterpret_cast<uint32_t *>(iPointer);
-				iPointer += sizeof(mVertexCount);
-				mIndexCount = *reinterpret_cast<uint32_t *>(iPointer);
-				iPointer += sizeof(mIndexCount);
-				mVertexData = reinterpret_cast<sVertex *>(iPointer);
-				iPointer += sizeof(sVertex) * mVertexCount;
-				mIndexData = reinterpret_cast<uint32_t *>(iPointer);
-				iPointer += sizeof(uint32_t) * mIndexCount;
+			}
 
-				fclose(iFile);
-				return buffer;
+			sParsedFile file;
+			if (!ParseFile(buffer, fileSize, i_path, file))
+			{
+				return NULL;
+			}
+			mVertexCount = file.vertexCount;
+			mIndexCount = file.indexCount;
+			mBounds = file.bounds;
+			mPositionFormat = file.positionFormat;
+			for (size_t i = 0; i < 2; ++i)
+			{
+				mPositionScale[i] = file.positionScale[i];
+				mPositionBias[i] = file.positionBias[i];
+			}
+			mLodCount = file.lodCount;
+			memcpy(mLods, file.lods, sizeof(mLods));
+			if (file.encodedData || (file.positionFormat != MeshFile::PositionFormat_float32))
+			{
+				// Compressed or quantized geometry is expanded into the load allocator too,
+				// and Initialize() copies it out the same way as geometry that can be used directly from the file
+				const size_t geometrySize = (sizeof(sVertex) * mVertexCount) + (sizeof(uint32_t) * mIndexCount);
+				const size_t scratchSize = GetExpandScratchSize(file);
+				uint8_t * const geometry = static_cast<uint8_t *>(eae6320::Memory::GetLoadAllocator().Allocate(geometrySize + scratchSize));
+				if (geometry == NULL)
+				{
+					EAE6320_LOG_ERROR("There isn't enough memory to decode the mesh");
+					return NULL;
+				}
+				if (!ExpandGeometry(file, i_path, geometry, geometry + geometrySize))
+				{
+					return NULL;
+				}
+				mVertexData = reinterpret_cast<sVertex *>(geometry);
+				mIndexData = reinterpret_cast<uint32_t *>(geometry + (sizeof(sVertex) * mVertexCount));
+			}
+			else
+			{
+				mVertexData = const_cast<sVertex *>(static_cast<const sVertex *>(file.vertexData));
+				mIndexData = const_cast<uint32_t *>(file.indexData);
+			}
+			return buffer;
+		}
+
+		bool Mesh::Initialize(void * buffer)
+		{
+			if (!KeepGeometry())
+			{
+				return false;
+			}
+			return InitializeGpuObjects();
+		}
+
+		bool Mesh::Decode(const void * i_file, const size_t i_fileSize, const char * i_path, sDecodedMesh & o_mesh)
+		{
+			o_mesh.geometry = NULL;
+			sParsedFile file;
+			if (!ParseFile(i_file, i_fileSize, i_path, file))
+			{
+				return false;
+			}
+			o_mesh.vertexCount = file.vertexCount;
+			o_mesh.indexCount = file.indexCount;
+			o_mesh.bounds = file.bounds;
+			o_mesh.positionFormat = file.positionFormat;
+			for (size_t i = 0; i < 2; ++i)
+			{
+				o_mesh.positionScale[i] = file.positionScale[i];
+				o_mesh.positionBias[i] = file.positionBias[i];
+			}
+			o_mesh.lodCount = file.lodCount;
+			memcpy(o_mesh.lods, file.lods, sizeof(o_mesh.lods));
+			// The geometry is expanded straight into the same layout that a mesh keeps
+			const size_t vertexSize = sizeof(sVertex) * o_mesh.vertexCount;
+			const size_t indexSize = sizeof(uint32_t) * o_mesh.indexCount;
+			o_mesh.geometry = malloc(vertexSize + indexSize);
+			if (o_mesh.geometry == NULL)
+			{
+				EAE6320_LOG_ERROR("There isn't enough memory to keep the mesh's geometry");
+				return false;
+			}
+			const size_t scratchSize = GetExpandScratchSize(file);
+			void * const scratch = (scratchSize > 0) ? malloc(scratchSize) : NULL;
+			if ((scratchSize > 0) && (scratch == NULL))
+			{
+				EAE6320_LOG_ERROR("There isn't enough memory to decode the mesh");
+				ReleaseDecoded(o_mesh);
+				return false;
+			}
+			const bool wasExpanded = ExpandGeometry(file, i_path, o_mesh.geometry, scratch);
+			free(scratch);
+			if (!wasExpanded)
+			{
+				ReleaseDecoded(o_mesh);
+			}
+			return wasExpanded;
+		}
+
+		void Mesh::ReleaseDecoded(sDecodedMesh & io_mesh)
+		{
+			if (io_mesh.geometry)
+			{
+				free(io_mesh.geometry);
+				io_mesh.geometry = NULL;
+			}
+		}
+
+		bool Mesh::Initialize(sDecodedMesh & io_mesh)
+		{
+			ReleaseGeometry();
+			mVertexCount = io_mesh.vertexCount;
+			mIndexCount = io_mesh.indexCount;
+			mBounds = io_mesh.bounds;
+			mPositionFormat = io_mesh.positionFormat;
+			for (size_t i = 0; i < 2; ++i)
+			{
+				mPositionScale[i] = io_mesh.positionScale[i];
+				mPositionBias[i] = io_mesh.positionBias[i];
+			}
+			mLodCount = io_mesh.lodCount;
+			memcpy(mLods, io_mesh.lods, sizeof(mLods));
+			mBuffer = io_mesh.geometry;
+			mVertexData = reinterpret_cast<sVertex *>(mBuffer);
+			mIndexData = reinterpret_cast<uint32_t *>(reinterpret_cast<sVertex *>(mBuffer) + mVertexCount);
+			io_mesh.geometry = NULL;
+			if (mBuffer == NULL)
+			{
+				return false;
+			}
+			return InitializeGpuObjects();
+		}
+
+		bool Mesh::Reload(sDecodedMesh & io_mesh)
+		{
+			// A mesh's GPU objects are only released by ShutDown() (there is no destructor),
+			// and so the new mesh can be loaded separately and then copied over this one
+			Mesh reloaded;
+			if (!reloaded.Initialize(io_mesh))
+			{
+				return false;
+			}
+			ShutDown();
+			const uint16_t id = mId;
+			*this = reloaded;
+			mId = id;
+			return true;
+		}
+
+		bool Mesh::InitializeGpuObjects()
+		{
+			if (!CreateGpuObjects())
+			{
+				ShutDown();
+				return false;
+			}
+			mIsLoaded = true;
+			return true;
+		}
+
+		bool Mesh::KeepGeometry()
+		{
+			// Only the vertices and indices are kept (without the file's header),
+			// and they are kept in a single block
+			const size_t vertexSize = sizeof(sVertex) * mVertexCount;
+			const size_t indexSize = sizeof(uint32_t) * mIndexCount;
+			void * const geometry = malloc(vertexSize + indexSize);
+			if (geometry == NULL)
+			{
+				EAE6320_LOG_ERROR("There isn't enough memory to keep the mesh's geometry");
+				return false;
+			}
+			uint8_t * const vertexData = static_cast<uint8_t *>(geometry);
+			uint8_t * const indexData = vertexData + vertexSize;
+			memcpy(vertexData, mVertexData, vertexSize);
+			memcpy(indexData, mIndexData, indexSize);
+			mBuffer = geometry;
+			mVertexData = reinterpret_cast<sVertex *>(vertexData);
+			mIndexData = reinterpret_cast<uint32_t *>(indexData);
+			return true;
+		}
+
+		void Mesh::ReleaseGeometry()
+		{
+			if (mBuffer)
+			{
+				free(mBuffer);
+				mBuffer = NULL;
+				mVertexData = NULL;
+				mIndexData = NULL;
+			}
+		}
+
+		void Mesh::QuantizeVertices(sQuantizedVertex * o_vertices) const
+		{
+			// The CPU copy was dequantized from the file with the same scale and bias,
+			// and so the GPU ends up with exactly the same positions as the CPU copy (see MeshFile::QuantizePosition())
+			for (uint32_t i = 0; i < mVertexCount; ++i)
+			{
+				const sVertex & vertex = mVertexData[i];
+				sQuantizedVertex & quantizedVertex = o_vertices[i];
+				quantizedVertex.x = MeshFile::QuantizePosition(vertex.x, mPositionScale[0], mPositionBias[0]);
+				quantizedVertex.y = MeshFile::QuantizePosition(vertex.y, mPositionScale[1], mPositionBias[1]);
+				quantizedVertex.r = vertex.r;
+				quantizedVertex.g = vertex.g;
+				quantizedVertex.b = vertex.b;
+				quantizedVertex.a = vertex.a;
+			}
+		}
+
+		void Mesh::GetDrawConstants(const float i_offsetX, const float i_offsetY, sDrawConstants & o_drawConstants) const
+		{
+			o_drawConstants.g_position_offset[0] = i_offsetX + mPositionBias[0];
+			o_drawConstants.g_position_offset[1] = i_offsetY + mPositionBias[1];
+			o_drawConstants.g_position_scale[0] = mPositionScale[0];
+			o_drawConstants.g_position_scale[1] = mPositionScale[1];
+		}
+
+		unsigned int Mesh::SelectLod(const float i_pixelsPerUnit, const float i_maxPixelError) const
+		{
+			// The errors only get bigger as the LODs get coarser,
+			// and so the last one that is accurate enough has the fewest triangles
+			unsigned int lod = 0;
+			for (unsigned int i = 1; i < mLodCount; ++i)
+			{
+				if ((mLods[i].error * i_pixelsPerUnit) > i_maxPixelError)
+				{
+					break;
+				}
+				lod = i;
+			}
+			return lod;
+		}
+
+		void Mesh::Draw(const unsigned int i_lod)
+		{
+			Bind();
+			DrawPrimitives(i_lod);
+		}
+
+		namespace
+		{
+			bool ParseFile(const void * i_file, const size_t i_fileSize, const char * i_path, sParsedFile & o_file)
+			{
+				o_file.positionFormat = MeshFile::PositionFormat_float32;
+				for (size_t i = 0; i < 2; ++i)
+				{
+					o_file.positionScale[i] = 1.0f;
+					o_file.positionBias[i] = 0.0f;
+				}
+				o_file.vertexData = NULL;
+				o_file.indexData = NULL;
+				o_file.encodedData = NULL;
+				o_file.encodedSize = 0;
+				memset(o_file.lods, 0, sizeof(o_file.lods));
+				const uint8_t * iPointer = reinterpret_cast<const uint8_t *>(i_file);
+				const bool hasHeader = (i_fileSize >= sizeof(MeshFile::sHeader)) &&
+					(reinterpret_cast<const MeshFile::sHeader *>(iPointer)->magic == MeshFile::s_magic);
+				size_t headerSize;
+				if (hasHeader)
+				{
+					const MeshFile::sHeader * header = reinterpret_cast<const MeshFile::sHeader *>(iPointer);
+					if (header->version != MeshFile::s_version)
+					{
+						std::stringstream errorMessage;
+						errorMessage << "The mesh \"" << i_path << "\" is version " << header->version <<
+							" but version " << MeshFile::s_version << " is expected (rebuild the assets)";
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
+						return false;
+					}
+					if ((header->positionFormat != MeshFile::PositionFormat_float32) && (header->positionFormat != MeshFile::PositionFormat_unorm16))
+					{
+						std::stringstream errorMessage;
+						errorMessage << "The mesh \"" << i_path << "\" has an unknown position format (" << header->positionFormat << ")";
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
+						return false;
+					}
+					o_file.vertexCount = header->vertexCount;
+					o_file.indexCount = header->indexCount;
+					o_file.bounds = header->bounds;
+					o_file.positionFormat = header->positionFormat;
+					// Every LOD must be whole triangles inside of the index data
+					{
+						bool areLodsValid = (header->lodCount >= 1) && (header->lodCount <= MeshFile::s_maxLodCount);
+						for (uint32_t i = 0; areLodsValid && (i < header->lodCount); ++i)
+						{
+							const MeshFile::sLod & lod = header->lods[i];
+							areLodsValid = ((lod.indexCount % 3) == 0) &&
+								((static_cast<uint64_t>(lod.firstIndex) + lod.indexCount) <= header->indexCount);
+						}
+						if (!areLodsValid)
+						{
+							std::stringstream errorMessage;
+							errorMessage << "The mesh \"" << i_path << "\" has an invalid level of detail table";
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
+							return false;
+						}
+						o_file.lodCount = header->lodCount;
+						memcpy(o_file.lods, header->lods, sizeof(o_file.lods));
+					}
+					if (o_file.positionFormat == MeshFile::PositionFormat_unorm16)
+					{
+						for (size_t i = 0; i < 2; ++i)
+						{
+							o_file.positionScale[i] = header->positionScale[i];
+							o_file.positionBias[i] = header->positionBias[i];
+						}
+					}
+					headerSize = sizeof(MeshFile::sHeader);
+					if (header->flags & MeshFile::Flag_compressed)
+					{
+						if ((headerSize + static_cast<uint64_t>(header->encodedSize)) > i_fileSize)
+						{
+							std::stringstream errorMessage;
+							errorMessage << "The mesh \"" << i_path << "\" is shorter than its encoded size says it is";
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
+							return false;
+						}
+						if (!IsExpandedSizeValid(o_file, i_path))
+						{
+							return false;
+						}
+						o_file.encodedData = iPointer + headerSize;
+						o_file.encodedSize = header->encodedSize;
+						return true;
+					}
+				}
+				else
+				{
+					// Files from before the header only start with the counts
+					headerSize = sizeof(o_file.vertexCount) + sizeof(o_file.indexCount);
+					if (i_fileSize < headerSize)
+					{
+						std::stringstream errorMessage;
+						errorMessage << "The mesh \"" << i_path << "\" is too small to be a mesh";
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
+						return false;
+					}
+					o_file.vertexCount = reinterpret_cast<const uint32_t *>(iPointer)[0];
+					o_file.indexCount = reinterpret_cast<const uint32_t *>(iPointer)[1];
+					// The only level of detail is the authored triangles
+					o_file.lodCount = 1;
+					o_file.lods[0].firstIndex = 0;
+					o_file.lods[0].indexCount = o_file.indexCount;
+					o_file.lods[0].error = 0.0f;
+				}
+				const size_t vertexSize = MeshFile::GetVertexSize(o_file.positionFormat);
+				if ((headerSize + (vertexSize * static_cast<uint64_t>(o_file.vertexCount)) +
+					(sizeof(uint32_t) * static_cast<uint64_t>(o_file.indexCount))) > i_fileSize)
+				{
+					std::stringstream errorMessage;
+					errorMessage << "The mesh \"" << i_path << "\" is shorter than its vertex and index counts say it is";
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
+					return false;
+				}
+				if (!IsExpandedSizeValid(o_file, i_path))
+				{
+					return false;
+				}
+				iPointer += headerSize;
+				o_file.vertexData = iPointer;
+				iPointer += vertexSize * o_file.vertexCount;
+				o_file.indexData = reinterpret_cast<const uint32_t *>(iPointer);
+				if (!hasHeader)
+				{
+					MeshFile::CalculateBounds(o_file.vertexData, sizeof(sVertex), o_file.vertexCount, o_file.bounds);
+				}
+				return true;
+			}
+
+			size_t GetExpandScratchSize(const sParsedFile & i_file)
+			{
+				if (!i_file.encodedData)
+				{
+					return 0;
+				}
+				// Float geometry is decoded straight into the output,
+				// but quantized geometry has to be decoded somewhere before it is dequantized
+				const size_t decodedSize = MeshDecoder::GetDecodedSize(i_file.vertexCount, MeshFile::GetVertexSize(i_file.positionFormat), i_file.indexCount);
+				return (i_file.positionFormat == MeshFile::PositionFormat_float32) ? decodedSize : (decodedSize * 2);
+			}
+
+			bool IsExpandedSizeValid(const sParsedFile & i_file, const char * i_path)
+			{
+				// The sVertex vertices and the indices, plus the scratch memory that GetExpandScratchSize() asks for
+				// (which is at most twice the decoded size)
+				const uint64_t indexSize = sizeof(uint32_t) * static_cast<uint64_t>(i_file.indexCount);
+				const uint64_t geometrySize = (sizeof(sVertex) * static_cast<uint64_t>(i_file.vertexCount)) + indexSize;
+				const uint64_t decodedSize = (MeshFile::GetVertexSize(i_file.positionFormat) * static_cast<uint64_t>(i_file.vertexCount)) + indexSize;
+				const uint64_t expandedSize = geometrySize + (2 * decodedSize);
+				if ((expandedSize > s_maxExpandedSize) || (expandedSize > SIZE_MAX))
+				{
+					std::stringstream errorMessage;
+					errorMessage << "The mesh \"" << i_path << "\" has " << i_file.vertexCount << " vertices and " << i_file.indexCount <<
+						" indices, which would need more memory than any mesh can use (the file is probably corrupt)";
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
+					return false;
+				}
+				return true;
+			}
+
+			bool ExpandGeometry(const sParsedFile & i_file, const char * i_path, void * o_geometry, void * io_scratch)
+			{
+				const size_t fileVertexSize = MeshFile::GetVertexSize(i_file.positionFormat);
+				const uint8_t * vertexData = static_cast<const uint8_t *>(i_file.vertexData);
+				const uint32_t * indexData = i_file.indexData;
+				if (i_file.encodedData)
+				{
+					const size_t decodedSize = MeshDecoder::GetDecodedSize(i_file.vertexCount, fileVertexSize, i_file.indexCount);
+					uint8_t * const decoded = (i_file.positionFormat == MeshFile::PositionFormat_float32) ?
+						static_cast<uint8_t *>(o_geometry) : static_cast<uint8_t *>(io_scratch);
+					uint8_t * const scratch = (decoded == io_scratch) ? (decoded + decodedSize) : static_cast<uint8_t *>(io_scratch);
+					if (!MeshDecoder::Decode(i_file.encodedData, i_file.encodedSize, i_file.vertexCount, fileVertexSize, i_file.indexCount,
+						decoded, scratch))
+					{
+						std::stringstream errorMessage;
+						errorMessage << "The mesh \"" << i_path << "\" has corrupt compressed geometry";
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
+						return false;
+					}
+					if (decoded == o_geometry)
+					{
+						return true;
+					}
+					vertexData = decoded;
+					indexData = reinterpret_cast<const uint32_t *>(decoded + (fileVertexSize * i_file.vertexCount));
+				}
+
+				sVertex * const vertices = static_cast<sVertex *>(o_geometry);
+				if (i_file.positionFormat == MeshFile::PositionFormat_unorm16)
+				{
+					const sQuantizedVertex * const quantizedVertices = reinterpret_cast<const sQuantizedVertex *>(vertexData);
+					for (uint32_t i = 0; i < i_file.vertexCount; ++i)
+					{
+						const sQuantizedVertex & quantizedVertex = quantizedVertices[i];
+						sVertex & vertex = vertices[i];
+						vertex.x = MeshFile::DequantizePosition(quantizedVertex.x, i_file.positionScale[0], i_file.positionBias[0]);
+						vertex.y = MeshFile::DequantizePosition(quantizedVertex.y, i_file.positionScale[1], i_file.positionBias[1]);
+						vertex.r = quantizedVertex.r;
+						vertex.g = quantizedVertex.g;
+						vertex.b = quantizedVertex.b;
+						vertex.a = quantizedVertex.a;
+					}
+				}
+				else
+				{
+					memcpy(vertices, vertexData, sizeof(sVertex) * i_file.vertexCount);
+				}
+				memcpy(vertices + i_file.vertexCount, indexData, sizeof(uint32_t) * i_file.indexCount);
+				return true;
 			}
-			return NULL;
 		}
 	}
-}
\ No newline at end of file
+}
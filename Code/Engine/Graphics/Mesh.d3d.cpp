@@ -1,13 +1,17 @@
 #include "Mesh.h"
 
 #include <cassert>
-#include "../UserOutput/UserOutput.h"
+#include <cstring>
+#include "RenderState.h"
+#include "../UserOutput/Log.h"
 
 namespace eae6320
 {
 	namespace Graphics
 	{
 		IDirect3DDevice9* Mesh::s_direct3dDevice = NULL;
+		IDirect3DVertexBuffer9* Mesh::s_instanceBuffer = NULL;
+		unsigned int Mesh::s_instanceBufferCursor = 0;
 		HRESULT GetVertexProcessingUsage(DWORD& o_usage);
 		void Mesh::SetDirect3dDevice(IDirect3DDevice9* i_direct3dDevice)
 		{
@@ -17,7 +21,45 @@ namespace eae6320
 		{
 			s_direct3dDevice = NULL;
 		}
-		bool Mesh::Initialize(void * buffer)
+		bool Mesh::InitializeInstancing()
+		{
+			DWORD usage = 0;
+			{
+				const HRESULT result = GetVertexProcessingUsage(usage);
+				if (FAILED(result))
+				{
+					return false;
+				}
+				// The buffer is rewritten every frame
+				usage |= D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY;
+			}
+			{
+				const unsigned int bufferSize = s_maxInstanceCountPerDraw * sizeof(sInstance);
+				const DWORD useSeparateVertexDeclaration = 0;
+				// Dynamic buffers must be in the default pool
+				const D3DPOOL useDefaultPool = D3DPOOL_DEFAULT;
+				HANDLE* const notUsed = NULL;
+				const HRESULT result = s_direct3dDevice->CreateVertexBuffer(bufferSize, usage, useSeparateVertexDeclaration, useDefaultPool,
+					&s_instanceBuffer, notUsed);
+				if (FAILED(result))
+				{
+					EAE6320_LOG_ERROR("Direct3D failed to create the instance buffer");
+					return false;
+				}
+			}
+			s_instanceBufferCursor = 0;
+			return true;
+		}
+		void Mesh::ShutDownInstancing()
+		{
+			if (s_instanceBuffer)
+			{
+				s_instanceBuffer->Release();
+				s_instanceBuffer = NULL;
+			}
+			s_instanceBufferCursor = 0;
+		}
+		bool Mesh::CreateGpuObjects()
 		{
 			bool wereThereErrors = false;
 
@@ -33,14 +75,15 @@ namespace eae6320
 				goto OnError;
 			}
 		OnError:
-			free(buffer);
-			if (wereThereErrors)
-				ShutDown();
+			// Creating the vertex declaration sets it directly
+			RenderState::Invalidate();
 			return !wereThereErrors;
 		}
-		void Mesh::Draw()
+		void Mesh::Bind()
 		{
-			HRESULT result;
+			{
+				RenderState::SetVertexDeclaration(s_vertexDeclaration);
+			}
 			// Bind a specific vertex buffer to the device as a data source
 			{
 				// There can be multiple streams of data feeding the display adaptor at the same time
@@ -48,15 +91,18 @@ namespace eae6320
 				// It's possible to start streaming data in the middle of a vertex buffer
 				const unsigned int bufferOffset = 0;
 				// The "stride" defines how large a single vertex is in the stream of data
-				const unsigned int bufferStride = sizeof(sVertex);
-				result = s_direct3dDevice->SetStreamSource(streamIndex, s_vertexBuffer, bufferOffset, bufferStride);
-				assert(SUCCEEDED(result));
+				const unsigned int bufferStride = static_cast<unsigned int>(MeshFile::GetVertexSize(mPositionFormat));
+				RenderState::SetStreamSource(streamIndex, s_vertexBuffer, bufferOffset, bufferStride);
 			}
 			// Bind a specific index buffer to the device as a data source
 			{
-				result = s_direct3dDevice->SetIndices(s_indexBuffer);
-				assert(SUCCEEDED(result));
+				RenderState::SetIndices(s_indexBuffer);
 			}
+		}
+		void Mesh::DrawPrimitives(const unsigned int i_lod)
+		{
+			const MeshFile::sLod & lod = GetLod(i_lod);
+			HRESULT result;
 			// Render objects from the current streams
 			{
 				// We are using triangles as the "primitive" type,
@@ -65,16 +111,74 @@ namespace eae6320
 				const D3DPRIMITIVETYPE primitiveType = D3DPT_TRIANGLELIST;
 				// It's possible to start rendering primitives in the middle of the stream
 				const unsigned int indexOfFirstVertexToRender = 0;
-				const unsigned int indexOfFirstIndexToUse = 0;
-				// We are drawing a square
-				const unsigned int vertexCountToRender = 4;	// How vertices from the vertex buffer will be used?
-				const unsigned int primitiveCountToRender = 2;	// How many triangles will be drawn?
+				// (every LOD after the first one starts in the middle of the index buffer)
+				const unsigned int indexOfFirstIndexToUse = lod.firstIndex;
+				const unsigned int vertexCountToRender = mVertexCount;	// How vertices from the vertex buffer will be used?
+				const unsigned int primitiveCountToRender = lod.indexCount / 3;	// How many triangles will be drawn?
 				result = s_direct3dDevice->DrawIndexedPrimitive(primitiveType,
 					indexOfFirstVertexToRender, indexOfFirstVertexToRender, vertexCountToRender,
 					indexOfFirstIndexToUse, primitiveCountToRender);
 				assert(SUCCEEDED(result));
 			}
 		}
+		void Mesh::DrawInstanced(const sInstance * i_instances, const unsigned int i_instanceCount, const unsigned int i_lod)
+		{
+			HRESULT result;
+			// The instanced declaration reads TEXCOORD0 from stream 1
+			{
+				RenderState::SetVertexDeclaration(s_instancedVertexDeclaration);
+			}
+			for (unsigned int firstInstance = 0; firstInstance < i_instanceCount; firstInstance += s_maxInstanceCountPerDraw)
+			{
+				const unsigned int instanceCount = ((i_instanceCount - firstInstance) < s_maxInstanceCountPerDraw) ?
+					(i_instanceCount - firstInstance) : s_maxInstanceCountPerDraw;
+				// Copy the instances into the shared buffer
+				{
+					// Append to what was written earlier if there is room so that the GPU can keep reading it,
+					// otherwise ask for a fresh buffer
+					DWORD lockFlags = D3DLOCK_NOOVERWRITE;
+					if ((s_instanceBufferCursor + instanceCount) > s_maxInstanceCountPerDraw)
+					{
+						s_instanceBufferCursor = 0;
+						lockFlags = D3DLOCK_DISCARD;
+					}
+					sInstance* instanceData;
+					result = s_instanceBuffer->Lock(s_instanceBufferCursor * sizeof(sInstance), instanceCount * sizeof(sInstance),
+						reinterpret_cast<void**>(&instanceData), lockFlags);
+					if (FAILED(result))
+					{
+						assert(false);
+						break;
+					}
+					memcpy(instanceData, &i_instances[firstInstance], instanceCount * sizeof(sInstance));
+					result = s_instanceBuffer->Unlock();
+					assert(SUCCEEDED(result));
+				}
+				// Stream 0 is the mesh repeated instanceCount times,
+				// and stream 1 advances once per instance
+				{
+					result = s_direct3dDevice->SetStreamSourceFreq(0, D3DSTREAMSOURCE_INDEXEDDATA | instanceCount);
+					assert(SUCCEEDED(result));
+					const unsigned int streamIndex = 1;
+					const unsigned int bufferOffset = s_instanceBufferCursor * sizeof(sInstance);
+					const unsigned int bufferStride = sizeof(sInstance);
+					RenderState::SetStreamSource(streamIndex, s_instanceBuffer, bufferOffset, bufferStride);
+					result = s_direct3dDevice->SetStreamSourceFreq(streamIndex, D3DSTREAMSOURCE_INSTANCEDATA | 1u);
+					assert(SUCCEEDED(result));
+				}
+				s_instanceBufferCursor += instanceCount;
+				DrawPrimitives(i_lod);
+			}
+			// Restore the state that non-instanced draws expect
+			{
+				result = s_direct3dDevice->SetStreamSourceFreq(0, 1);
+				assert(SUCCEEDED(result));
+				result = s_direct3dDevice->SetStreamSourceFreq(1, 1);
+				assert(SUCCEEDED(result));
+				RenderState::SetStreamSource(1, NULL, 0, 0);
+				RenderState::SetVertexDeclaration(s_vertexDeclaration);
+			}
+		}
 		bool Mesh::ShutDown()
 		{
 			bool wereThereErrors = false;
@@ -96,7 +200,16 @@ namespace eae6320
 					s_vertexDeclaration->Release();
 					s_vertexDeclaration = NULL;
 				}
+				if (s_instancedVertexDeclaration)
+				{
+					s_instancedVertexDeclaration->Release();
+					s_instancedVertexDeclaration = NULL;
+				}
 			}
+			// A new object could be given the address of a released one
+			RenderState::Invalidate();
+			ReleaseGeometry();
+			mIsLoaded = false;
 			return !wereThereErrors;
 		}
 		bool Mesh::CreateIndexBuffer()
@@ -117,10 +230,7 @@ namespace eae6320
 			// Create an index buffer
 			unsigned int bufferSize;
 			{
-				// We are drawing a square
-				const unsigned int triangleCount = 2;
-				const unsigned int vertexCountPerTriangle = 3;
-				bufferSize = triangleCount * vertexCountPerTriangle * sizeof(uint32_t);
+				bufferSize = mIndexCount * sizeof(uint32_t);
 				// We'll use 32-bit indices in this class to keep things simple
 				// (i.e. every index will be a 32 bit unsigned integer)
 				const D3DFORMAT format = D3DFMT_INDEX32;
@@ -131,7 +241,7 @@ namespace eae6320
 					&s_indexBuffer, notUsed);
 				if (FAILED(result))
 				{
-					eae6320::UserOutput::Print("Direct3D failed to create an index buffer");
+					EAE6320_LOG_ERROR("Direct3D failed to create an index buffer");
 					return false;
 				}
 			}
@@ -146,7 +256,7 @@ namespace eae6320
 						reinterpret_cast<void**>(&indexData), useDefaultLockingBehavior);
 					if (FAILED(result))
 					{
-						eae6320::UserOutput::Print("Direct3D failed to lock the index buffer");
+						EAE6320_LOG_ERROR("Direct3D failed to lock the index buffer");
 						return false;
 					}
 				}
@@ -160,7 +270,7 @@ namespace eae6320
 					const HRESULT result = s_indexBuffer->Unlock();
 					if (FAILED(result))
 					{
-						eae6320::UserOutput::Print("Direct3D failed to unlock the index buffer");
+						EAE6320_LOG_ERROR("Direct3D failed to unlock the index buffer");
 						return false;
 					}
 				}
@@ -183,9 +293,16 @@ namespace eae6320
 				usage |= D3DUSAGE_WRITEONLY;
 			}
 
+			// Quantized meshes upload half as much position data
+			// (and the vertex shader dequantizes it with the per-draw constants)
+			const bool isQuantized = mPositionFormat == MeshFile::PositionFormat_unorm16;
+			// Normalized to [0,1] across the mesh's bounds
+			const BYTE positionType = isQuantized ? D3DDECLTYPE_USHORT2N : D3DDECLTYPE_FLOAT2;
+			const WORD colorOffset = isQuantized ? 4 : 8;
+
 			// Initialize the vertex format
 			{
-				// These elements must match the VertexFormat::sVertex layout struct exactly.
+				// These elements must match the sVertex (or sQuantizedVertex) layout struct exactly.
 				// They instruct Direct3D how to match the binary data in the vertex buffer
 				// to the input elements in a vertex shader
 				// (by using D3DDECLUSAGE enums here and semantics in the shader,
@@ -197,13 +314,14 @@ namespace eae6320
 
 					// POSITION
 					// 2 floats == 8 bytes
+					// or 2 uint16_ts == 4 bytes (quantized)
 					// Offset = 0
-					{ 0, 0, D3DDECLTYPE_FLOAT2, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_POSITION, 0 },
+					{ 0, 0, positionType, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_POSITION, 0 },
 
 					// COLOR0
 					// D3DCOLOR == 4 bytes
-					// Offset = 8
-					{ 0, 8, D3DDECLTYPE_D3DCOLOR, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_COLOR, 0 },
+					// Offset = 8 (or 4 when quantized)
+					{ 0, colorOffset, D3DDECLTYPE_D3DCOLOR, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_COLOR, 0 },
 
 					// The following marker signals the end of the vertex declaration
 					D3DDECL_END()
@@ -214,22 +332,44 @@ namespace eae6320
 					result = s_direct3dDevice->SetVertexDeclaration(s_vertexDeclaration);
 					if (FAILED(result))
 					{
-						eae6320::UserOutput::Print("Direct3D failed to set the vertex declaration");
+						EAE6320_LOG_ERROR("Direct3D failed to set the vertex declaration");
 						return false;
 					}
 				}
 				else
 				{
-					eae6320::UserOutput::Print("Direct3D failed to create a Direct3D9 vertex declaration");
+					EAE6320_LOG_ERROR("Direct3D failed to create a Direct3D9 vertex declaration");
+					return false;
+				}
+			}
+			// Initialize the instanced vertex format
+			{
+				D3DVERTEXELEMENT9 vertexElements[] =
+				{
+					// Stream 0 (the same as above)
+					{ 0, 0, positionType, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_POSITION, 0 },
+					{ 0, colorOffset, D3DDECLTYPE_D3DCOLOR, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_COLOR, 0 },
+
+					// Stream 1 (sInstance)
+
+					// TEXCOORD0
+					// 2 floats == 8 bytes
+					// Offset = 0
+					{ 1, 0, D3DDECLTYPE_FLOAT2, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_TEXCOORD, 0 },
+
+					D3DDECL_END()
+				};
+				const HRESULT result = s_direct3dDevice->CreateVertexDeclaration(vertexElements, &s_instancedVertexDeclaration);
+				if (FAILED(result))
+				{
+					EAE6320_LOG_ERROR("Direct3D failed to create the instanced vertex declaration");
 					return false;
 				}
 			}
 
 			// Create a vertex buffer
 			{
-				// We are drawing one square
-				const unsigned int vertexCount = 4;
-				const unsigned int bufferSize = vertexCount * sizeof(sVertex);
+				const unsigned int bufferSize = mVertexCount * static_cast<unsigned int>(MeshFile::GetVertexSize(mPositionFormat));
 				// We will define our own vertex format
 				const DWORD useSeparateVertexDeclaration = 0;
 				// Place the vertex buffer into memory that Direct3D thinks is the most appropriate
@@ -239,14 +379,14 @@ namespace eae6320
 					&s_vertexBuffer, notUsed);
 				if (FAILED(result))
 				{
-					eae6320::UserOutput::Print("Direct3D failed to create a vertex buffer");
+					EAE6320_LOG_ERROR("Direct3D failed to create a vertex buffer");
 					return false;
 				}
 			}
 			// Fill the vertex buffer with the triangle's vertices
 			{
 				// Before the vertex buffer can be changed it must be "locked"
-				sVertex* vertexData;
+				void* vertexData;
 				{
 					const unsigned int lockEntireBuffer = 0;
 					const DWORD useDefaultLockingBehavior = 0;
@@ -254,7 +394,7 @@ namespace eae6320
 						reinterpret_cast<void**>(&vertexData), useDefaultLockingBehavior);
 					if (FAILED(result))
 					{
-						eae6320::UserOutput::Print("Direct3D failed to lock the vertex buffer");
+						EAE6320_LOG_ERROR("Direct3D failed to lock the vertex buffer");
 						return false;
 					}
 				}
@@ -275,15 +415,21 @@ namespace eae6320
 					// To make white you should use (255, 255, 255), to make black (0, 0, 0).
 					// To make pure red you would use the max for R and nothing for G and B, so (1, 0, 0).
 					// Experiment with other values to see what happens!
-					for (unsigned int i = 0; i < mVertexCount; i++)
-						vertexData[i] = mVertexData[i];
+					if (isQuantized)
+					{
+						QuantizeVertices(static_cast<sQuantizedVertex*>(vertexData));
+					}
+					else
+					{
+						memcpy(vertexData, mVertexData, mVertexCount * sizeof(sVertex));
+					}
 				}
 				// The buffer must be "unlocked" before it can be used
 				{
 					const HRESULT result = s_vertexBuffer->Unlock();
 					if (FAILED(result))
 					{
-						eae6320::UserOutput::Print("Direct3D failed to unlock the vertex buffer");
+						EAE6320_LOG_ERROR("Direct3D failed to unlock the vertex buffer");
 						return false;
 					}
 				}
@@ -303,7 +449,7 @@ namespace eae6320
 			}
 			else
 			{
-				eae6320::UserOutput::Print("Direct3D failed to get the device's creation parameters");
+				EAE6320_LOG_ERROR("Direct3D failed to get the device's creation parameters");
 			}
 			return result;
 		}
@@ -5,30 +5,82 @@
 #include <cstdlib>
 #include <string>
 #include <sstream>
-#include "../UserOutput/UserOutput.h"
+#include <vector>
+#include "RenderState.h"
+#include "../UserOutput/Log.h"
 
 namespace eae6320
 {
 	namespace Graphics
 	{
-		bool Mesh::Initialize(void * buffer)
+		GLuint Mesh::s_instanceBufferId = 0;
+
+		bool Mesh::InitializeInstancing()
 		{
-			bool wereThereErrors = false;
-			if (!CreateVertexArray())
 			{
-				wereThereErrors = true;
+				const GLsizei bufferCount = 1;
+				glGenBuffers(bufferCount, &s_instanceBufferId);
+				const GLenum errorCode = glGetError();
+				if (errorCode != GL_NO_ERROR)
+				{
+					std::stringstream errorMessage;
+					errorMessage << "OpenGL failed to get an unused instance buffer ID: " <<
+						reinterpret_cast<const char*>(gluErrorString(errorCode));
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
+					return false;
+				}
 			}
-			free(buffer);
-			if (wereThereErrors)
-				ShutDown();
-			return !wereThereErrors;
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, s_instanceBufferId);
+				// The contents will be replaced every time an instanced draw is made
+				glBufferData(GL_ARRAY_BUFFER, s_maxInstanceCountPerDraw * sizeof(sInstance), NULL, GL_STREAM_DRAW);
+				const GLenum errorCode = glGetError();
+				glBindBuffer(GL_ARRAY_BUFFER, 0);
+				RenderState::Invalidate();
+				if (errorCode != GL_NO_ERROR)
+				{
+					std::stringstream errorMessage;
+					errorMessage << "OpenGL failed to allocate the instance buffer: " <<
+						reinterpret_cast<const char*>(gluErrorString(errorCode));
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
+					ShutDownInstancing();
+					return false;
+				}
+			}
+			return true;
 		}
-		void Mesh::Draw()
+		void Mesh::ShutDownInstancing()
 		{
+			if (s_instanceBufferId != 0)
 			{
-				glBindVertexArray(s_vertexArrayId);
-				assert(glGetError() == GL_NO_ERROR);
+				const GLsizei bufferCount = 1;
+				glDeleteBuffers(bufferCount, &s_instanceBufferId);
+				const GLenum errorCode = glGetError();
+				if (errorCode != GL_NO_ERROR)
+				{
+					std::stringstream errorMessage;
+					errorMessage << "OpenGL failed to delete the instance buffer: " <<
+						reinterpret_cast<const char*>(gluErrorString(errorCode));
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
+				}
+				s_instanceBufferId = 0;
 			}
+		}
+
+		bool Mesh::CreateGpuObjects()
+		{
+			const bool result = CreateVertexArray();
+			// Creating the vertex array binds it and its buffers directly
+			RenderState::Invalidate();
+			return result;
+		}
+		void Mesh::Bind()
+		{
+			RenderState::BindVertexArray(s_vertexArrayId);
+		}
+		void Mesh::DrawPrimitives(const unsigned int i_lod)
+		{
+			const MeshFile::sLod & lod = GetLod(i_lod);
 			// Render objects from the current streams
 			{
 				// We are using triangles as the "primitive" type,
@@ -39,15 +91,37 @@ namespace eae6320
 				// (i.e. every index will be a 32 bit unsigned integer)
 				const GLenum indexType = GL_UNSIGNED_INT;
 				// It is possible to start rendering in the middle of an index buffer
-				const GLvoid* const offset = 0;
-				// We are drawing a square
-				const GLsizei primitiveCountToRender = 2;
-				const GLsizei vertexCountPerTriangle = 3;
-				const GLsizei vertexCountToRender = primitiveCountToRender * vertexCountPerTriangle;
+				// (which is where every LOD after the first one is)
+				const GLvoid* const offset = reinterpret_cast<const GLvoid*>(lod.firstIndex * sizeof(uint32_t));
+				const GLsizei vertexCountToRender = static_cast<GLsizei>(lod.indexCount);
 				glDrawElements(mode, vertexCountToRender, indexType, offset);
 				assert(glGetError() == GL_NO_ERROR);
 			}
 		}
+		void Mesh::DrawInstanced(const sInstance * i_instances, const unsigned int i_instanceCount, const unsigned int i_lod)
+		{
+			const MeshFile::sLod & lod = GetLod(i_lod);
+			RenderState::BindArrayBuffer(s_instanceBufferId);
+			for (unsigned int firstInstance = 0; firstInstance < i_instanceCount; firstInstance += s_maxInstanceCountPerDraw)
+			{
+				const unsigned int instanceCount = ((i_instanceCount - firstInstance) < s_maxInstanceCountPerDraw) ?
+					(i_instanceCount - firstInstance) : s_maxInstanceCountPerDraw;
+				// Orphan the previous contents so that the driver doesn't have to wait for earlier draws to finish reading them
+				{
+					glBufferData(GL_ARRAY_BUFFER, s_maxInstanceCountPerDraw * sizeof(sInstance), NULL, GL_STREAM_DRAW);
+					glBufferSubData(GL_ARRAY_BUFFER, 0, instanceCount * sizeof(sInstance), &i_instances[firstInstance]);
+					assert(glGetError() == GL_NO_ERROR);
+				}
+				{
+					const GLenum mode = GL_TRIANGLES;
+					const GLenum indexType = GL_UNSIGNED_INT;
+					const GLvoid* const offset = reinterpret_cast<const GLvoid*>(lod.firstIndex * sizeof(uint32_t));
+					const GLsizei vertexCountToRender = static_cast<GLsizei>(lod.indexCount);
+					glDrawElementsInstanced(mode, vertexCountToRender, indexType, offset, static_cast<GLsizei>(instanceCount));
+					assert(glGetError() == GL_NO_ERROR);
+				}
+			}
+		}
 		bool Mesh::ShutDown()
 		{
 			const GLenum errorCode = glGetError();
@@ -61,10 +135,14 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to delete the vertex array: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 				}
 				s_vertexArrayId = 0;
 			}
+			// A new vertex array could be given the ID of a deleted one
+			RenderState::Invalidate();
+			ReleaseGeometry();
+			mIsLoaded = false;
 			return true;
 		}
 		bool Mesh::CreateVertexArray()
@@ -88,7 +166,7 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "OpenGL failed to bind the vertex array: " <<
 							reinterpret_cast<const char*>(gluErrorString(errorCode));
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						goto OnExit;
 					}
 				}
@@ -98,7 +176,7 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to get an unused vertex array ID: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					goto OnExit;
 				}
 			}
@@ -118,7 +196,7 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "OpenGL failed to bind the vertex buffer: " <<
 							reinterpret_cast<const char*>(gluErrorString(errorCode));
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						goto OnExit;
 					}
 				}
@@ -128,13 +206,24 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to get an unused vertex buffer ID: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					goto OnExit;
 				}
 			}
 			// Assign the data to the buffer
 			{
-				glBufferData(GL_ARRAY_BUFFER, mVertexCount * sizeof(sVertex), reinterpret_cast<GLvoid*>(mVertexData),
+				// Quantized meshes upload half as much position data
+				// (and the vertex shader dequantizes it with the per-draw constants)
+				const bool isQuantized = mPositionFormat == MeshFile::PositionFormat_unorm16;
+				std::vector<sQuantizedVertex> quantizedVertices;
+				if (isQuantized && (mVertexCount > 0))
+				{
+					quantizedVertices.resize(mVertexCount);
+					QuantizeVertices(&quantizedVertices[0]);
+				}
+				const GLvoid* const vertexData = isQuantized ?
+					reinterpret_cast<const GLvoid*>(quantizedVertices.empty() ? NULL : &quantizedVertices[0]) : reinterpret_cast<const GLvoid*>(mVertexData);
+				glBufferData(GL_ARRAY_BUFFER, mVertexCount * MeshFile::GetVertexSize(mPositionFormat), vertexData,
 					// Our code will only ever write to the buffer
 					GL_STATIC_DRAW);
 				const GLenum errorCode = glGetError();
@@ -144,23 +233,29 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to allocate the vertex buffer: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					goto OnExit;
 				}
 			}
 			// Initialize the vertex format
 			{
-				const GLsizei stride = sizeof(sVertex);
+				const GLsizei stride = static_cast<GLsizei>(MeshFile::GetVertexSize(mPositionFormat));
 				GLvoid* offset = 0;
 
 				// Position (0)
 				// 2 floats == 8 bytes
+				// or 2 uint16_ts == 4 bytes (quantized)
 				// Offset = 0
 				{
 					const GLuint vertexElementLocation = 0;
 					const GLint elementCount = 2;
-					const GLboolean notNormalized = GL_FALSE;	// The given floats should be used as-is
-					glVertexAttribPointer(vertexElementLocation, elementCount, GL_FLOAT, notNormalized, stride, offset);
+					const bool isQuantized = mPositionFormat == MeshFile::PositionFormat_unorm16;
+					// The given floats should be used as-is,
+					// but quantized positions are normalized to [0,1] across the mesh's bounds
+					const GLenum type = isQuantized ? GL_UNSIGNED_SHORT : GL_FLOAT;
+					const GLboolean normalized = isQuantized ? GL_TRUE : GL_FALSE;
+					const size_t elementSize = isQuantized ? sizeof(uint16_t) : sizeof(float);
+					glVertexAttribPointer(vertexElementLocation, elementCount, type, normalized, stride, offset);
 					const GLenum errorCode = glGetError();
 					if (errorCode == GL_NO_ERROR)
 					{
@@ -168,7 +263,7 @@ namespace eae6320
 						const GLenum errorCode = glGetError();
 						if (errorCode == GL_NO_ERROR)
 						{
-							offset = reinterpret_cast<GLvoid*>(reinterpret_cast<uint8_t*>(offset) + (elementCount * sizeof(float)));
+							offset = reinterpret_cast<GLvoid*>(reinterpret_cast<uint8_t*>(offset) + (elementCount * elementSize));
 						}
 						else
 						{
@@ -176,7 +271,7 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "OpenGL failed to enable the POSITION vertex attribute: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 							goto OnExit;
 						}
 					}
@@ -186,13 +281,13 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "OpenGL failed to set the POSITION vertex attribute: " <<
 							reinterpret_cast<const char*>(gluErrorString(errorCode));
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						goto OnExit;
 					}
 				}
 				// Color (1)
 				// 4 uint8_ts == 4 bytes
-				// Offset = 8
+				// Offset = 8 (or 4 when quantized)
 				{
 					const GLuint vertexElementLocation = 1;
 					const GLint elementCount = 4;
@@ -218,7 +313,7 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "OpenGL failed to enable the COLOR0 vertex attribute: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 							goto OnExit;
 						}
 					}
@@ -228,7 +323,39 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "OpenGL failed to set the COLOR0 vertex attribute: " <<
 							reinterpret_cast<const char*>(gluErrorString(errorCode));
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
+						goto OnExit;
+					}
+				}
+			}
+			// Initialize the instance format
+			// (this comes from the shared instance buffer rather than this mesh's vertex buffer,
+			// and it is only read by the instanced variant of the vertex shader)
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, s_instanceBufferId);
+				const GLsizei stride = sizeof(sInstance);
+				GLvoid* const offset = 0;
+
+				// Instance offset (2)
+				// 2 floats == 8 bytes
+				// Offset = 0
+				{
+					const GLuint vertexElementLocation = 2;
+					const GLint elementCount = 2;
+					const GLboolean notNormalized = GL_FALSE;
+					glVertexAttribPointer(vertexElementLocation, elementCount, GL_FLOAT, notNormalized, stride, offset);
+					glEnableVertexAttribArray(vertexElementLocation);
+					// Advance once per instance instead of once per vertex
+					const GLuint advancePerInstance = 1;
+					glVertexAttribDivisor(vertexElementLocation, advancePerInstance);
+					const GLenum errorCode = glGetError();
+					if (errorCode != GL_NO_ERROR)
+					{
+						wereThereErrors = true;
+						std::stringstream errorMessage;
+						errorMessage << "OpenGL failed to set the instance vertex attribute: " <<
+							reinterpret_cast<const char*>(gluErrorString(errorCode));
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						goto OnExit;
 					}
 				}
@@ -249,7 +376,7 @@ namespace eae6320
 						std::stringstream errorMessage;
 						errorMessage << "OpenGL failed to bind the index buffer: " <<
 							reinterpret_cast<const char*>(gluErrorString(errorCode));
-						eae6320::UserOutput::Print(errorMessage.str());
+						EAE6320_LOG_ERROR("%s", errorMessage.str());
 						goto OnExit;
 					}
 				}
@@ -259,7 +386,7 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to get an unused index buffer ID: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					goto OnExit;
 				}
 			}
@@ -276,7 +403,7 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to allocate the index buffer: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 					goto OnExit;
 				}
 			}
@@ -309,7 +436,7 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "OpenGL failed to delete the vertex buffer: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 						}
 						vertexBufferId = 0;
 					}
@@ -326,7 +453,7 @@ namespace eae6320
 							std::stringstream errorMessage;
 							errorMessage << "\nOpenGL failed to delete the index buffer: " <<
 								reinterpret_cast<const char*>(gluErrorString(errorCode));
-							eae6320::UserOutput::Print(errorMessage.str());
+							EAE6320_LOG_ERROR("%s", errorMessage.str());
 						}
 						indexBufferId = 0;
 					}
@@ -337,7 +464,7 @@ namespace eae6320
 					std::stringstream errorMessage;
 					errorMessage << "OpenGL failed to unbind the vertex array: " <<
 						reinterpret_cast<const char*>(gluErrorString(errorCode));
-					eae6320::UserOutput::Print(errorMessage.str());
+					EAE6320_LOG_ERROR("%s", errorMessage.str());
 				}
 			}
 
@@ -2,6 +2,7 @@
 #define EAE6320_MESH_H
 
 #include <cstdint>
+#include "MeshFile.h"
 
 #if defined EAE6320_PLATFORM_GL
 #include "../../Externals/OpenGlExtensions/OpenGlExtensions.h"
@@ -16,6 +17,8 @@ namespace eae6320
 {
 	namespace Graphics
 	{
+		struct sDrawConstants;
+
 		struct sVertex
 		{
 			// POSITION
@@ -29,16 +32,78 @@ namespace eae6320
 			uint8_t r, g, b, a;	// 8 bits [0,255] per RGBA channel (the alpha channel is unused but is present so that color uses a full 4 bytes)
 #elif defined EAE6320_PLATFORM_D3D
 			uint8_t b, g, r, a;	// Direct3D expects the byte layout of a color to be different from what you might expect
+#else
+			uint8_t r, g, b, a;	// Without a GPU platform (i.e. the software rasterizer only) the OpenGL layout is used
+#endif //Platform Check
+		};
+
+		// Meshes that were built with quantized positions are uploaded to the GPU in this format
+		// (the CPU copy of the geometry is always sVertex)
+		struct sQuantizedVertex
+		{
+			// POSITION
+			// 2 uint16_ts == 4 bytes, normalized to [0,1] across the mesh's bounds
+			// Offset = 0
+			uint16_t x, y;
+			// COLOR0
+			// 4 uint8_ts == 4 bytes
+			// Offset = 4
+#if defined EAE6320_PLATFORM_D3D
+			uint8_t b, g, r, a;
+#else
+			uint8_t r, g, b, a;
 #endif //Platform Check
 		};
 
+		// When many copies of a mesh are drawn with a single instanced draw call
+		// this is the data that changes for each copy
+		struct sInstance
+		{
+			// TEXCOORD0 (D3D) / location 2 (GL)
+			// 2 floats == 8 bytes
+			float x, y;	// The same as g_position_offset when drawing without instancing
+		};
+
 
 
 		class Mesh
 		{
+		public:
+			// A mesh file that has been decoded but doesn't have any GPU objects yet
+			// (see AssetLoader)
+			struct sDecodedMesh
+			{
+				uint32_t vertexCount, indexCount;
+				MeshFile::sBounds bounds;
+				uint32_t positionFormat;
+				float positionScale[2], positionBias[2];
+				uint32_t lodCount;
+				MeshFile::sLod lods[MeshFile::s_maxLodCount];
+				// The vertices (always sVertex) followed by the indices
+				void * geometry;
+			};
+
+		private:
 			uint32_t mVertexCount, mIndexCount;
 			sVertex * mVertexData;
 			uint32_t * mIndexData;
+			// A copy of the vertex and index data is kept for the lifetime of the mesh
+			// so that it can also be drawn on the CPU (e.g. by the SoftwareRasterizer)
+			void * mBuffer;
+			// Identifies the mesh in render queue sort keys
+			uint16_t mId;
+			// Local-space bounds for culling
+			MeshFile::sBounds mBounds;
+			// The GPU's vertex format (a MeshFile::ePositionFormat)
+			// and how the vertex shader turns quantized positions back into local space
+			uint32_t mPositionFormat;
+			float mPositionScale[2], mPositionBias[2];
+			// The ranges of the index data that each level of detail draws
+			// (LOD 0 is the authored triangles, and there is always at least one)
+			uint32_t mLodCount;
+			MeshFile::sLod mLods[MeshFile::s_maxLodCount];
+			// False until the GPU objects have been created
+			bool mIsLoaded;
 
 
 #if defined EAE6320_PLATFORM_GL
@@ -52,6 +117,17 @@ namespace eae6320
 			// An index buffer describes how to make triangles with the vertices
 			// (i.e. it defines the vertex connectivity)
 			IDirect3DIndexBuffer9* s_indexBuffer = NULL;
+			// The same as the vertex declaration but with a second stream of sInstance data
+			IDirect3DVertexDeclaration9* s_instancedVertexDeclaration = NULL;
+#endif // Platform Check
+
+			// Every mesh shares a single dynamic buffer of instance data
+#if defined EAE6320_PLATFORM_GL
+			static GLuint s_instanceBufferId;
+#elif defined EAE6320_PLATFORM_D3D
+			static IDirect3DVertexBuffer9* s_instanceBuffer;
+			// Instances are appended to the buffer until it is full, and then it is discarded and filled from the beginning again
+			static unsigned int s_instanceBufferCursor;
 #endif // Platform Check
 		
 
@@ -63,11 +139,76 @@ namespace eae6320
 			Mesh();
 			//static Mesh * CreateMesh();
 			bool Initialize(void * buffer);
-			void Draw();
+			// Draw() is the same as Bind() followed by DrawPrimitives(),
+			// but when consecutive draws use the same mesh it only needs to be bound once.
+			// Only the triangles of the given level of detail are drawn
+			void Draw(const unsigned int i_lod = 0);
+			void Bind();
+			void DrawPrimitives(const unsigned int i_lod = 0);
+			// Draws the mesh once for every instance;
+			// the instanced variant of the effect must be bound (Effect::BindInstanced())
+			// and this mesh must already be bound
+			void DrawInstanced(const sInstance * i_instances, const unsigned int i_instanceCount, const unsigned int i_lod = 0);
 			bool ShutDown();
+			uint16_t GetId() const { return mId; }
 
+			// The file is read into the calling thread's load allocator
+			// (Memory::GetLoadAllocator()), and so the returned buffer is only valid
+			// until the caller's StackAllocator::cScopedMarker rewinds it.
+			// If the file is in the mounted AssetPack the buffer points into the pack instead (and must not be written to)
 			void * LoadMesh(const char * i_path);
+			// Decode() only works with the file and the decoded mesh,
+			// and so it can be called from any thread;
+			// the decoded mesh's geometry must be passed to Initialize() or released with ReleaseDecoded()
+			static bool Decode(const void * i_file, const size_t i_fileSize, const char * i_path, sDecodedMesh & o_mesh);
+			static void ReleaseDecoded(sDecodedMesh & io_mesh);
+			// Takes ownership of the decoded geometry (even if it fails)
+			bool Initialize(sDecodedMesh & io_mesh);
+			// Replaces the geometry and GPU objects of a mesh that is already loaded (see HotReload).
+			// The mesh keeps its ID, and if the new GPU objects can't be created it keeps the old ones.
+			// Takes ownership of the decoded geometry (even if it fails)
+			bool Reload(sDecodedMesh & io_mesh);
+			bool IsLoaded() const { return mIsLoaded; }
+
+			// CPU copies of the geometry
+			const sVertex * GetVertexData() const { return mVertexData; }
+			const uint32_t * GetIndexData() const { return mIndexData; }
+			uint32_t GetVertexCount() const { return mVertexCount; }
+			uint32_t GetIndexCount() const { return mIndexCount; }
+			const MeshFile::sBounds& GetBounds() const { return mBounds; }
+			// The per-draw constants multiply positions by the scale and add the bias
+			// (which are 1 and 0 unless the mesh was built with quantized positions)
+			const float * GetPositionScale() const { return mPositionScale; }
+			const float * GetPositionBias() const { return mPositionBias; }
+			// The constants for drawing this mesh at an offset
+			void GetDrawConstants(const float i_offsetX, const float i_offsetY, sDrawConstants & o_drawConstants) const;
+
+			// Levels of detail
+			unsigned int GetLodCount() const { return mLodCount; }
+			// LODs past the last one are clamped to it
+			const MeshFile::sLod & GetLod(const unsigned int i_lod) const { return mLods[(i_lod < mLodCount) ? i_lod : (mLodCount - 1)]; }
+			// Returns the coarsest LOD whose error covers no more than i_maxPixelError pixels
+			// when one unit of the mesh's local space covers i_pixelsPerUnit pixels on screen
+			unsigned int SelectLod(const float i_pixelsPerUnit, const float i_maxPixelError) const;
 
+			// This many instances can be drawn with a single draw call
+			// (DrawInstanced() will split anything bigger into multiple draw calls)
+			static const unsigned int s_maxInstanceCountPerDraw = 1024;
+			// The shared instance buffer must be created before any meshes are initialized
+			static bool InitializeInstancing();
+			static void ShutDownInstancing();
+
+		private:
+			// Copies the vertex and index data out of the loaded file
+			bool KeepGeometry();
+			void ReleaseGeometry();
+			// Creates the platform's GPU objects from the geometry
+			bool CreateGpuObjects();
+			// Fills the GPU's vertex buffer (mVertexCount vertices) if the mesh has quantized positions
+			void QuantizeVertices(sQuantizedVertex * o_vertices) const;
+			bool InitializeGpuObjects();
+
+		public:
 #if defined EAE6320_PLATFORM_GL
 			bool CreateVertexArray();
 #elif defined EAE6320_PLATFORM_D3D
@@ -0,0 +1,334 @@
+// Header Files
+//=============
+
+#include "MeshDecoder.h"
+
+#include <cassert>
+#include <cstring>
+
+#if defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) ) || defined( __SSE2__ )
+	#define EAE6320_MESHDECODER_SSE2
+	#include <emmintrin.h>
+#endif
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	bool ReadLength( const uint8_t*& io_input, const uint8_t* const i_inputEnd, size_t& io_length );
+
+#if defined( EAE6320_MESHDECODER_SSE2 )
+	__m128i PrefixSumBytes( __m128i i_bytes );
+	__m128i BroadcastLastByte( const __m128i i_bytes );
+	// Writes 4 vertices that are made from a dword of each of the inputs
+	void InterleaveDwords( const __m128i i_x, const __m128i i_y, uint8_t* o_vertices );
+	void InterleaveDwords( const __m128i i_x, const __m128i i_y, const __m128i i_z, uint8_t* o_vertices );
+#endif
+}
+
+// Interface
+//==========
+
+bool eae6320::Graphics::MeshDecoder::Decode( const void* i_encoded, const size_t i_encodedSize, const uint32_t i_vertexCount, const size_t i_vertexSize,
+	const uint32_t i_indexCount, void* o_geometry, void* io_scratch )
+{
+	uint8_t* const planes = static_cast<uint8_t*>( io_scratch );
+	if ( !DecompressLz( static_cast<const uint8_t*>( i_encoded ), i_encodedSize, planes, GetDecodedSize( i_vertexCount, i_vertexSize, i_indexCount ) ) )
+	{
+		return false;
+	}
+	uint8_t* const vertices = static_cast<uint8_t*>( o_geometry );
+	const size_t vertexSize = static_cast<size_t>( i_vertexCount ) * i_vertexSize;
+	UnfilterVertices( planes, i_vertexCount, i_vertexSize, vertices );
+	UnfilterIndices( planes + vertexSize, i_indexCount, reinterpret_cast<uint32_t*>( vertices + vertexSize ) );
+	return true;
+}
+
+bool eae6320::Graphics::MeshDecoder::DecompressLz( const uint8_t* i_encoded, const size_t i_encodedSize, uint8_t* o_decoded, const size_t i_decodedSize )
+{
+	const uint8_t* input = i_encoded;
+	const uint8_t* const inputEnd = i_encoded + i_encodedSize;
+	uint8_t* output = o_decoded;
+	uint8_t* const outputEnd = o_decoded + i_decodedSize;
+
+	// Every length and offset is checked so that a corrupt file can't write outside of the output
+	for ( ;; )
+	{
+		if ( input >= inputEnd )
+		{
+			return false;
+		}
+		const uint8_t token = *input++;
+
+		// Literals
+		{
+			size_t literalCount = token >> 4;
+			if ( ( literalCount == 15 ) && !ReadLength( input, inputEnd, literalCount ) )
+			{
+				return false;
+			}
+			if ( ( literalCount > static_cast<size_t>( inputEnd - input ) ) || ( literalCount > static_cast<size_t>( outputEnd - output ) ) )
+			{
+				return false;
+			}
+			memcpy( output, input, literalCount );
+			input += literalCount;
+			output += literalCount;
+		}
+		// The last sequence only has literals
+		if ( input == inputEnd )
+		{
+			return output == outputEnd;
+		}
+
+		// Match
+		{
+			if ( ( inputEnd - input ) < 2 )
+			{
+				return false;
+			}
+			const size_t offset = static_cast<size_t>( input[0] ) | ( static_cast<size_t>( input[1] ) << 8 );
+			input += 2;
+			if ( ( offset == 0 ) || ( offset > static_cast<size_t>( output - o_decoded ) ) )
+			{
+				return false;
+			}
+			size_t matchLength = token & 0xf;
+			if ( ( matchLength == 15 ) && !ReadLength( input, inputEnd, matchLength ) )
+			{
+				return false;
+			}
+			matchLength += 4;
+			const size_t outputRemaining = static_cast<size_t>( outputEnd - output );
+			if ( matchLength > outputRemaining )
+			{
+				return false;
+			}
+
+			const uint8_t* match = output - offset;
+			if ( offset == 1 )
+			{
+				// Runs of a single byte are very common in the byte planes
+				memset( output, *match, matchLength );
+			}
+			else if ( ( offset >= 16 ) && ( ( matchLength + 15 ) <= outputRemaining ) )
+			{
+				// The copy can write up to 15 bytes past the end of the match
+				// (they are overwritten by whatever comes next)
+				uint8_t* const matchEnd = output + matchLength;
+				uint8_t* copy = output;
+				do
+				{
+#if defined( EAE6320_MESHDECODER_SSE2 )
+					_mm_storeu_si128( reinterpret_cast<__m128i*>( copy ), _mm_loadu_si128( reinterpret_cast<const __m128i*>( match ) ) );
+#else
+					memcpy( copy, match, 16 );
+#endif
+					copy += 16;
+					match += 16;
+				} while ( copy < matchEnd );
+			}
+			else
+			{
+				// The match overlaps the bytes that it is writing
+				for ( size_t i = 0; i < matchLength; ++i )
+				{
+					output[i] = match[i];
+				}
+			}
+			output += matchLength;
+		}
+	}
+}
+
+void eae6320::Graphics::MeshDecoder::UnfilterVertices( const uint8_t* i_planes, const uint32_t i_vertexCount, const size_t i_vertexSize,
+	uint8_t* o_vertices )
+{
+	// A vertex is never bigger than a float position and a color
+	const size_t maxVertexSize = 12;
+	assert( i_vertexSize <= maxVertexSize );
+	const size_t vertexSize = i_vertexSize;
+	uint8_t previous[maxVertexSize] = {};
+	uint32_t i = 0;
+
+#if defined( EAE6320_MESHDECODER_SSE2 )
+	// Every vertex is either two dwords (a quantized position and the color)
+	// or three dwords (the position's x, the position's y, and the color),
+	// and so sixteen vertices are 4 registers of each dword
+	const size_t dwordCount = vertexSize / 4;
+	if ( ( ( vertexSize % 4 ) == 0 ) && ( ( dwordCount == 2 ) || ( dwordCount == 3 ) ) )
+	{
+		__m128i carries[maxVertexSize];
+		for ( size_t k = 0; k < vertexSize; ++k )
+		{
+			carries[k] = _mm_setzero_si128();
+		}
+		for ( ; ( i + 16 ) <= i_vertexCount; i += 16 )
+		{
+			__m128i dwords[3][4];
+			for ( size_t dword = 0; dword < dwordCount; ++dword )
+			{
+				__m128i bytes[4];
+				for ( size_t byte = 0; byte < 4; ++byte )
+				{
+					const size_t k = ( dword * 4 ) + byte;
+					const __m128i deltas = _mm_loadu_si128( reinterpret_cast<const __m128i*>( i_planes + ( k * i_vertexCount ) + i ) );
+					bytes[byte] = _mm_add_epi8( PrefixSumBytes( deltas ), carries[k] );
+					carries[k] = BroadcastLastByte( bytes[byte] );
+				}
+				const __m128i bytes01_low = _mm_unpacklo_epi8( bytes[0], bytes[1] );
+				const __m128i bytes01_high = _mm_unpackhi_epi8( bytes[0], bytes[1] );
+				const __m128i bytes23_low = _mm_unpacklo_epi8( bytes[2], bytes[3] );
+				const __m128i bytes23_high = _mm_unpackhi_epi8( bytes[2], bytes[3] );
+				dwords[dword][0] = _mm_unpacklo_epi16( bytes01_low, bytes23_low );
+				dwords[dword][1] = _mm_unpackhi_epi16( bytes01_low, bytes23_low );
+				dwords[dword][2] = _mm_unpacklo_epi16( bytes01_high, bytes23_high );
+				dwords[dword][3] = _mm_unpackhi_epi16( bytes01_high, bytes23_high );
+			}
+			for ( size_t j = 0; j < 4; ++j )
+			{
+				uint8_t* const vertices = o_vertices + ( ( i + ( j * 4 ) ) * vertexSize );
+				if ( dwordCount == 2 )
+				{
+					InterleaveDwords( dwords[0][j], dwords[1][j], vertices );
+				}
+				else
+				{
+					InterleaveDwords( dwords[0][j], dwords[1][j], dwords[2][j], vertices );
+				}
+			}
+		}
+		for ( size_t k = 0; k < vertexSize; ++k )
+		{
+			previous[k] = static_cast<uint8_t>( _mm_cvtsi128_si32( carries[k] ) );
+		}
+	}
+#endif
+
+	for ( ; i < i_vertexCount; ++i )
+	{
+		for ( size_t k = 0; k < vertexSize; ++k )
+		{
+			previous[k] = static_cast<uint8_t>( previous[k] + i_planes[( k * i_vertexCount ) + i] );
+			o_vertices[( i * vertexSize ) + k] = previous[k];
+		}
+	}
+}
+
+void eae6320::Graphics::MeshDecoder::UnfilterIndices( const uint8_t* i_planes, const uint32_t i_indexCount, uint32_t* o_indices )
+{
+	uint32_t previous = 0;
+	uint32_t i = 0;
+
+#if defined( EAE6320_MESHDECODER_SSE2 )
+	__m128i carry = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi32( 1 );
+	for ( ; ( i + 16 ) <= i_indexCount; i += 16 )
+	{
+		__m128i bytes[4];
+		for ( size_t byte = 0; byte < 4; ++byte )
+		{
+			bytes[byte] = _mm_loadu_si128( reinterpret_cast<const __m128i*>( i_planes + ( byte * i_indexCount ) + i ) );
+		}
+		const __m128i bytes01_low = _mm_unpacklo_epi8( bytes[0], bytes[1] );
+		const __m128i bytes01_high = _mm_unpackhi_epi8( bytes[0], bytes[1] );
+		const __m128i bytes23_low = _mm_unpacklo_epi8( bytes[2], bytes[3] );
+		const __m128i bytes23_high = _mm_unpackhi_epi8( bytes[2], bytes[3] );
+		__m128i zigzags[4];
+		zigzags[0] = _mm_unpacklo_epi16( bytes01_low, bytes23_low );
+		zigzags[1] = _mm_unpackhi_epi16( bytes01_low, bytes23_low );
+		zigzags[2] = _mm_unpacklo_epi16( bytes01_high, bytes23_high );
+		zigzags[3] = _mm_unpackhi_epi16( bytes01_high, bytes23_high );
+		for ( size_t j = 0; j < 4; ++j )
+		{
+			// (z >> 1) ^ -(z & 1)
+			__m128i indices = _mm_xor_si128( _mm_srli_epi32( zigzags[j], 1 ), _mm_sub_epi32( _mm_setzero_si128(), _mm_and_si128( zigzags[j], one ) ) );
+			indices = _mm_add_epi32( indices, _mm_slli_si128( indices, 4 ) );
+			indices = _mm_add_epi32( indices, _mm_slli_si128( indices, 8 ) );
+			indices = _mm_add_epi32( indices, carry );
+			carry = _mm_shuffle_epi32( indices, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( o_indices + i + ( j * 4 ) ), indices );
+		}
+	}
+	previous = static_cast<uint32_t>( _mm_cvtsi128_si32( carry ) );
+#endif
+
+	for ( ; i < i_indexCount; ++i )
+	{
+		const uint32_t zigzag = static_cast<uint32_t>( i_planes[i] ) | ( static_cast<uint32_t>( i_planes[i_indexCount + i] ) << 8 )
+			| ( static_cast<uint32_t>( i_planes[( 2 * i_indexCount ) + i] ) << 16 ) | ( static_cast<uint32_t>( i_planes[( 3 * i_indexCount ) + i] ) << 24 );
+		previous += ( zigzag >> 1 ) ^ ( 0u - ( zigzag & 1 ) );
+		o_indices[i] = previous;
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool ReadLength( const uint8_t*& io_input, const uint8_t* const i_inputEnd, size_t& io_length )
+	{
+		uint8_t byte;
+		do
+		{
+			if ( io_input >= i_inputEnd )
+			{
+				return false;
+			}
+			byte = *io_input++;
+			io_length += byte;
+		} while ( byte == 255 );
+		return true;
+	}
+
+#if defined( EAE6320_MESHDECODER_SSE2 )
+	__m128i PrefixSumBytes( __m128i i_bytes )
+	{
+		i_bytes = _mm_add_epi8( i_bytes, _mm_slli_si128( i_bytes, 1 ) );
+		i_bytes = _mm_add_epi8( i_bytes, _mm_slli_si128( i_bytes, 2 ) );
+		i_bytes = _mm_add_epi8( i_bytes, _mm_slli_si128( i_bytes, 4 ) );
+		return _mm_add_epi8( i_bytes, _mm_slli_si128( i_bytes, 8 ) );
+	}
+
+	__m128i BroadcastLastByte( const __m128i i_bytes )
+	{
+		__m128i lastByte = _mm_srli_si128( i_bytes, 15 );
+		lastByte = _mm_unpacklo_epi8( lastByte, lastByte );
+		lastByte = _mm_unpacklo_epi16( lastByte, lastByte );
+		return _mm_shuffle_epi32( lastByte, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+	}
+
+	void InterleaveDwords( const __m128i i_x, const __m128i i_y, uint8_t* o_vertices )
+	{
+		// x0 y0 x1 y1 and x2 y2 x3 y3
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( o_vertices ), _mm_unpacklo_epi32( i_x, i_y ) );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( o_vertices + 16 ), _mm_unpackhi_epi32( i_x, i_y ) );
+	}
+
+	void InterleaveDwords( const __m128i i_x, const __m128i i_y, const __m128i i_z, uint8_t* o_vertices )
+	{
+		// x0 y0 x1 y1 and x2 y2 x3 y3
+		const __m128i xy_low = _mm_unpacklo_epi32( i_x, i_y );
+		const __m128i xy_high = _mm_unpackhi_epi32( i_x, i_y );
+		// z0 x1 z1 x2
+		const __m128i zx = _mm_unpacklo_epi32( i_z, _mm_srli_si128( i_x, 4 ) );
+		// y1 z1 y2 z2
+		const __m128i yz = _mm_unpacklo_epi32( _mm_srli_si128( i_y, 4 ), _mm_srli_si128( i_z, 4 ) );
+		// z2 z3 x3 y3
+		const __m128 zxy = _mm_shuffle_ps( _mm_castsi128_ps( i_z ), _mm_castsi128_ps( xy_high ), _MM_SHUFFLE( 3, 2, 3, 2 ) );
+
+		// x0 y0 z0 x1
+		const __m128 vertices0 = _mm_shuffle_ps( _mm_castsi128_ps( xy_low ), _mm_castsi128_ps( zx ), _MM_SHUFFLE( 1, 0, 1, 0 ) );
+		// y1 z1 x2 y2
+		const __m128 vertices1 = _mm_shuffle_ps( _mm_castsi128_ps( yz ), _mm_castsi128_ps( xy_high ), _MM_SHUFFLE( 1, 0, 1, 0 ) );
+		// z2 x3 y3 z3
+		const __m128i vertices2 = _mm_shuffle_epi32( _mm_castps_si128( zxy ), _MM_SHUFFLE( 1, 3, 2, 0 ) );
+
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( o_vertices ), _mm_castps_si128( vertices0 ) );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( o_vertices + 16 ), _mm_castps_si128( vertices1 ) );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( o_vertices + 32 ), vertices2 );
+	}
+#endif
+}
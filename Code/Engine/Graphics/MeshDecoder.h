@@ -0,0 +1,54 @@
+/*
+	The mesh decoder turns the compressed geometry of a .msh file (see MeshFile.h)
+	back into vertices followed by indices.
+
+	The LZ block is decoded into a scratch buffer of byte planes,
+	and then the planes are summed and interleaved back into vertices and indices
+	sixteen at a time with SSE2 (when it is available and the vertices are two or three dwords).
+	Decoding only uses the given buffers, and so it can be called from any thread.
+*/
+
+#ifndef EAE6320_MESHDECODER_H
+#define EAE6320_MESHDECODER_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MeshFile.h"
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace MeshDecoder
+		{
+			// The number of bytes that the byte planes take
+			// (which is also the size of the decoded vertices and indices).
+			// The vertex size is MeshFile::GetVertexSize() of the file's position format
+			inline size_t GetDecodedSize( const uint32_t i_vertexCount, const size_t i_vertexSize, const uint32_t i_indexCount )
+			{
+				return ( static_cast<size_t>( i_vertexCount ) * i_vertexSize ) + ( static_cast<size_t>( i_indexCount ) * sizeof( uint32_t ) );
+			}
+
+			// The output must be GetDecodedSize() bytes:
+			// the vertices are written first and the indices immediately after them.
+			// The scratch buffer must also be GetDecodedSize() bytes.
+			// Returns false if the encoded data is corrupt
+			bool Decode( const void* i_encoded, const size_t i_encodedSize, const uint32_t i_vertexCount, const size_t i_vertexSize,
+				const uint32_t i_indexCount, void* o_geometry, void* io_scratch );
+
+			// The parts of Decode() (exposed so that they can be measured separately)
+			bool DecompressLz( const uint8_t* i_encoded, const size_t i_encodedSize, uint8_t* o_decoded, const size_t i_decodedSize );
+			void UnfilterVertices( const uint8_t* i_planes, const uint32_t i_vertexCount, const size_t i_vertexSize, uint8_t* o_vertices );
+			void UnfilterIndices( const uint8_t* i_planes, const uint32_t i_indexCount, uint32_t* o_indices );
+		}
+	}
+}
+
+#endif	// EAE6320_MESHDECODER_H
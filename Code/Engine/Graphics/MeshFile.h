@@ -0,0 +1,197 @@
+/*
+	This file describes the binary .msh format that MeshBuilder writes and Mesh loads.
+
+	A file starts with a header (identified by a magic number and a version)
+	that is followed by the vertex data and then the index data.
+	Files that were built before the header existed start directly with the vertex count;
+	those are still loaded, but their bounds have to be calculated when they are loaded.
+
+	Positions are either two floats or two 16-bit unsigned integers that are normalized across the mesh's bounds
+	(a vertex is 12 or 8 bytes, see GetVertexSize()).
+	Quantized positions are turned back into local space with (position / 65535) * positionScale + positionBias,
+	which is done by the vertex shader (the normalization is done by the vertex fetch).
+
+	If the header has the compressed flag the geometry is encoded instead (see MeshDecoder.h),
+	and encodedSize bytes follow the header:
+		* The vertices are split into one plane per byte of a vertex
+			(all of the vertices' first bytes, then all of their second bytes, etc.),
+			and every byte is stored as the difference from the same byte of the previous vertex
+		* The indices are stored as the difference from the previous index,
+			zigzag encoded (so that small negative differences are small numbers)
+			and split into four byte planes the same way
+		* The vertex planes followed by the index planes are compressed as a single LZ block:
+			a sequence is a token (the high nibble is the literal count and the low nibble is the match length - 4,
+			with 15 meaning that more bytes of 255 follow until one that is less than 255),
+			the literals, and then a 16-bit little-endian offset back into the output;
+			the last sequence only has literals
+
+	The header also has a table of levels of detail:
+	every LOD is a range of the index data (drawn with the same vertices),
+	starting with the authored triangles at LOD 0 and getting coarser,
+	and each has the error of its simplification in the mesh's local space
+	(which the engine projects onto the screen to choose which LOD to draw)
+*/
+
+#ifndef EAE6320_MESHFILE_H
+#define EAE6320_MESHFILE_H
+
+// Header Files
+//=============
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace MeshFile
+		{
+			// "EMSH" when read as bytes
+			const uint32_t s_magic = 0x48534D45;
+			// Version 1 added the header and the bounds,
+			// version 2 added compression,
+			// version 3 added quantized positions,
+			// and version 4 added levels of detail
+			const uint32_t s_version = 4;
+
+			enum eFlags
+			{
+				Flag_compressed = 1 << 0,
+			};
+
+			enum ePositionFormat
+			{
+				PositionFormat_float32,
+				PositionFormat_unorm16,
+			};
+			// The largest quantized position
+			const float s_unorm16Max = 65535.0f;
+
+			// Every vertex is a position followed by a 4 byte color
+			inline size_t GetVertexSize( const uint32_t i_positionFormat )
+			{
+				return ( i_positionFormat == PositionFormat_unorm16 ) ? 8 : 12;
+			}
+
+			// The bounds are in the mesh's local space.
+			// Meshes are currently 2D, and so z is always 0, but storing it keeps the format usable in 3D
+			struct sBounds
+			{
+				float aabbMin[3];
+				float aabbMax[3];
+				float sphereCenter[3];
+				float sphereRadius;
+			};
+
+			// The header has room for this many LODs
+			const uint32_t s_maxLodCount = 8;
+			struct sLod
+			{
+				// The indices of the LOD's triangles within the index data
+				uint32_t firstIndex;
+				uint32_t indexCount;
+				// How far the LOD's boundary can be from the authored one (0 for LOD 0)
+				float error;
+			};
+
+			struct sHeader
+			{
+				uint32_t magic;
+				uint32_t version;
+				uint32_t vertexCount;
+				uint32_t indexCount;
+				sBounds bounds;
+				uint32_t flags;
+				// Only used if the geometry is compressed
+				uint32_t encodedSize;
+				// An ePositionFormat
+				uint32_t positionFormat;
+				// Only used if the positions are quantized
+				// (the scale is the size of the bounds in each dimension and the bias is their minimum)
+				float positionScale[2];
+				float positionBias[2];
+				// There is always at least one LOD;
+				// the ranges are all inside of the indexCount indices
+				uint32_t lodCount;
+				sLod lods[s_maxLodCount];
+			};
+
+			// The builder quantizes positions with this.
+			// Quantizing a position that was dequantized with the same scale and bias
+			// gives a value that dequantizes to exactly the same position
+			// (it is the same value unless the bias is too big for a float to tell the steps apart)
+			inline uint16_t QuantizePosition( const float i_position, const float i_scale, const float i_bias )
+			{
+				if ( i_scale <= 0.0f )
+				{
+					return 0;
+				}
+				const float normalized = ( ( i_position - i_bias ) / i_scale ) * s_unorm16Max;
+				return static_cast<uint16_t>( ( normalized <= 0.0f ) ? 0.0f :
+					( ( normalized >= s_unorm16Max ) ? s_unorm16Max : std::floor( normalized + 0.5f ) ) );
+			}
+			inline float DequantizePosition( const uint16_t i_position, const float i_scale, const float i_bias )
+			{
+				return ( ( static_cast<float>( i_position ) / s_unorm16Max ) * i_scale ) + i_bias;
+			}
+
+			// Calculates the bounds of the positions that start at the beginning of every vertex
+			// (every vertex format starts with float x, y)
+			inline void CalculateBounds( const void* i_vertices, const size_t i_vertexStride, const uint32_t i_vertexCount, sBounds& o_bounds )
+			{
+				for ( size_t i = 0; i < 3; ++i )
+				{
+					o_bounds.aabbMin[i] = o_bounds.aabbMax[i] = o_bounds.sphereCenter[i] = 0.0f;
+				}
+				o_bounds.sphereRadius = 0.0f;
+				if ( i_vertexCount == 0 )
+				{
+					return;
+				}
+
+				const uint8_t* const vertices = static_cast<const uint8_t*>( i_vertices );
+				for ( uint32_t i = 0; i < i_vertexCount; ++i )
+				{
+					const float* const position = reinterpret_cast<const float*>( vertices + ( i * i_vertexStride ) );
+					for ( size_t j = 0; j < 2; ++j )
+					{
+						if ( ( i == 0 ) || ( position[j] < o_bounds.aabbMin[j] ) )
+						{
+							o_bounds.aabbMin[j] = position[j];
+						}
+						if ( ( i == 0 ) || ( position[j] > o_bounds.aabbMax[j] ) )
+						{
+							o_bounds.aabbMax[j] = position[j];
+						}
+					}
+				}
+				// The sphere is centered on the box
+				// but its radius only reaches the farthest vertex (rather than the box's corners)
+				float radiusSquared = 0.0f;
+				for ( size_t j = 0; j < 2; ++j )
+				{
+					o_bounds.sphereCenter[j] = ( o_bounds.aabbMin[j] + o_bounds.aabbMax[j] ) * 0.5f;
+				}
+				for ( uint32_t i = 0; i < i_vertexCount; ++i )
+				{
+					const float* const position = reinterpret_cast<const float*>( vertices + ( i * i_vertexStride ) );
+					const float dx = position[0] - o_bounds.sphereCenter[0];
+					const float dy = position[1] - o_bounds.sphereCenter[1];
+					const float distanceSquared = ( dx * dx ) + ( dy * dy );
+					if ( distanceSquared > radiusSquared )
+					{
+						radiusSquared = distanceSquared;
+					}
+				}
+				o_bounds.sphereRadius = std::sqrt( radiusSquared );
+			}
+		}
+	}
+}
+
+#endif	// EAE6320_MESHFILE_H
@@ -0,0 +1,412 @@
+// Header Files
+//=============
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Renderable.h"
+#include "SoftwareRasterizer.h"
+
+static_assert( eae6320::Graphics::MeshFile::s_maxLodCount <= ( 1u << eae6320::Graphics::RenderQueue::s_lodBitCount ),
+	"Every LOD that a mesh file can have must fit in the sort key" );
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	eae6320::Graphics::RenderQueue::tParallelFor s_parallelFor = NULL;
+}
+
+// Interface
+//==========
+
+uint64_t eae6320::Graphics::RenderQueue::CreateSortKey( const uint8_t i_layer, const uint16_t i_effectId, const uint16_t i_meshId, const uint8_t i_lod,
+	const float i_depth )
+{
+	const uint32_t maxDepth = ( 1u << s_depthBitCount ) - 1;
+	uint32_t depth;
+	{
+		if ( !( i_depth > 0.0f ) )
+		{
+			// This also catches NaN
+			depth = 0;
+		}
+		else if ( i_depth >= 1.0f )
+		{
+			depth = maxDepth;
+		}
+		else
+		{
+			depth = static_cast<uint32_t>( i_depth * static_cast<float>( maxDepth ) );
+		}
+	}
+
+	const uint32_t lod = i_lod & ( ( 1u << s_lodBitCount ) - 1 );
+	return ( static_cast<uint64_t>( i_layer ) << ( s_effectBitCount + s_meshBitCount + s_lodBitCount + s_depthBitCount ) )
+		| ( static_cast<uint64_t>( i_effectId ) << ( s_meshBitCount + s_lodBitCount + s_depthBitCount ) )
+		| ( static_cast<uint64_t>( i_meshId ) << ( s_lodBitCount + s_depthBitCount ) )
+		| ( static_cast<uint64_t>( lod ) << s_depthBitCount )
+		| static_cast<uint64_t>( depth );
+}
+
+void eae6320::Graphics::RenderQueue::Submit( Renderable& i_renderable, const uint8_t i_layer, const float i_depth )
+{
+	if ( i_renderable.IsReady() )
+	{
+		m_packets.push_back( CreatePacket( i_renderable, i_layer, i_depth ) );
+		m_isRecorded = false;
+	}
+}
+
+eae6320::Graphics::sDrawPacket* eae6320::Graphics::RenderQueue::AllocatePackets( const unsigned int i_packetCount )
+{
+	const size_t firstPacket = m_packets.size();
+	m_packets.resize( firstPacket + i_packetCount );
+	m_isRecorded = false;
+	return ( i_packetCount > 0 ) ? &m_packets[firstPacket] : NULL;
+}
+
+eae6320::Graphics::sDrawPacket eae6320::Graphics::RenderQueue::CreatePacket( Renderable& i_renderable, const uint8_t i_layer, const float i_depth )
+{
+	sDrawPacket packet;
+	if ( i_renderable.IsReady() )
+	{
+		packet.sortKey = CreateSortKey( i_layer, i_renderable.Effect->GetId(), i_renderable.Mesh->GetId(),
+			static_cast<uint8_t>( i_renderable.GetLod() ), i_depth );
+		packet.mesh = i_renderable.Mesh;
+		packet.effect = i_renderable.Effect;
+		packet.x = i_renderable.Offset.x;
+		packet.y = i_renderable.Offset.y;
+	}
+	else
+	{
+		packet.sortKey = 0;
+		packet.mesh = NULL;
+		packet.effect = NULL;
+		packet.x = packet.y = 0.0f;
+	}
+	return packet;
+}
+
+void eae6320::Graphics::RenderQueue::Clear()
+{
+	m_packets.clear();
+	m_isRecorded = false;
+}
+
+void eae6320::Graphics::RenderQueue::Sort()
+{
+	// Remove the packets of renderables that weren't ready when they were created
+	{
+		size_t keptCount = 0;
+		const size_t submittedCount = m_packets.size();
+		for ( size_t i = 0; i < submittedCount; ++i )
+		{
+			if ( m_packets[i].mesh )
+			{
+				m_packets[keptCount++] = m_packets[i];
+			}
+		}
+		m_packets.resize( keptCount );
+	}
+
+	const size_t packetCount = m_packets.size();
+	if ( packetCount < 2 )
+	{
+		return;
+	}
+
+	// Find which bytes of the key actually differ between packets;
+	// most frames only use a few effects and meshes and a single layer,
+	// and so most of the eight passes can be skipped
+	uint64_t differingBits = 0;
+	{
+		const uint64_t firstKey = m_packets[0].sortKey;
+		for ( size_t i = 1; i < packetCount; ++i )
+		{
+			differingBits |= m_packets[i].sortKey ^ firstKey;
+		}
+	}
+	if ( differingBits == 0 )
+	{
+		return;
+	}
+
+	// LSD radix sort, one byte at a time
+	// (each pass is stable, and so packets with identical keys stay in submission order)
+	m_scratch.resize( packetCount );
+	sDrawPacket* source = &m_packets[0];
+	sDrawPacket* destination = &m_scratch[0];
+	for ( unsigned int shift = 0; shift < 64; shift += 8 )
+	{
+		if ( ( ( differingBits >> shift ) & 0xff ) == 0 )
+		{
+			continue;
+		}
+
+		size_t offsets[256];
+		memset( offsets, 0, sizeof( offsets ) );
+		for ( size_t i = 0; i < packetCount; ++i )
+		{
+			++offsets[( source[i].sortKey >> shift ) & 0xff];
+		}
+		{
+			size_t sum = 0;
+			for ( unsigned int i = 0; i < 256; ++i )
+			{
+				const size_t count = offsets[i];
+				offsets[i] = sum;
+				sum += count;
+			}
+		}
+		for ( size_t i = 0; i < packetCount; ++i )
+		{
+			destination[offsets[( source[i].sortKey >> shift ) & 0xff]++] = source[i];
+		}
+
+		sDrawPacket* const temp = source;
+		source = destination;
+		destination = temp;
+	}
+	if ( source != &m_packets[0] )
+	{
+		m_packets.swap( m_scratch );
+	}
+}
+
+void eae6320::Graphics::RenderQueue::SetParallelFor( const tParallelFor i_parallelFor )
+{
+	s_parallelFor = i_parallelFor;
+}
+
+void eae6320::Graphics::RenderQueue::Record()
+{
+	PrepareBatches();
+
+	// The batches are divided into jobs with about the same number of packets to record
+	const uint32_t batchCount = static_cast<uint32_t>( m_batches.size() );
+	m_recordingJobBatches.clear();
+	{
+		unsigned int packetCount = s_packetsPerRecordingJob;
+		for ( uint32_t i = 0; i < batchCount; ++i )
+		{
+			if ( packetCount >= s_packetsPerRecordingJob )
+			{
+				m_recordingJobBatches.push_back( i );
+				packetCount = 0;
+			}
+			packetCount += m_batches[i].isInstanced ? 1 : m_batches[i].packetCount;
+		}
+		m_recordingJobBatches.push_back( batchCount );
+	}
+
+	// Every job records its batches into its own buffer
+	const uint32_t bufferCount = static_cast<uint32_t>( m_recordingJobBatches.size() - 1 );
+	if ( m_commandBuffers.size() < bufferCount )
+	{
+		m_commandBuffers.resize( bufferCount );
+	}
+	for ( uint32_t i = 0; i < bufferCount; ++i )
+	{
+		m_commandBuffers[i].Clear();
+	}
+	if ( s_parallelFor )
+	{
+		s_parallelFor( bufferCount, 1, RecordBatches, this );
+	}
+	else
+	{
+		RecordBatches( 0, bufferCount, this );
+	}
+
+	// The buffers are appended in the order of their batches
+	m_commands.Clear();
+	for ( uint32_t i = 0; i < bufferCount; ++i )
+	{
+		if ( m_commandBuffers[i].GetCommandCount() > 0 )
+		{
+			m_commands.Append( m_commandBuffers[i] );
+			++m_stats.commandBufferCount;
+		}
+	}
+	m_stats.commandCount = static_cast<unsigned int>( m_commands.GetCommandCount() );
+	m_stats.commandBindsElided = m_commands.GetStats().bindsElided;
+	m_isRecorded = true;
+}
+
+void eae6320::Graphics::RenderQueue::Draw()
+{
+	if ( !m_isRecorded )
+	{
+		Record();
+	}
+	m_commands.Execute();
+	Clear();
+}
+
+void eae6320::Graphics::RenderQueue::Draw( SoftwareRasterizer& i_rasterizer )
+{
+	if ( !m_isRecorded )
+	{
+		Record();
+	}
+	i_rasterizer.Execute( m_commands );
+	Clear();
+}
+
+// Implementation
+//===============
+
+void eae6320::Graphics::RenderQueue::PrepareBatches()
+{
+	Sort();
+
+	memset( &m_stats, 0, sizeof( m_stats ) );
+	m_batches.clear();
+	m_instances.clear();
+
+	const Effect* currentEffect = NULL;
+	bool isCurrentEffectInstanced = false;
+	const Mesh* currentMesh = NULL;
+	const uint32_t packetCount = static_cast<uint32_t>( m_packets.size() );
+	for ( uint32_t i = 0; i < packetCount; )
+	{
+		const sDrawPacket& firstPacket = m_packets[i];
+		const unsigned int lod = GetLod( firstPacket );
+
+		// Find the end of the run of packets that share this effect, mesh, and LOD
+		uint32_t endPacket = i + 1;
+		while ( ( endPacket < packetCount )
+			&& ( m_packets[endPacket].effect == firstPacket.effect )
+			&& ( m_packets[endPacket].mesh == firstPacket.mesh )
+			&& ( GetLod( m_packets[endPacket] ) == lod )
+			// A run that won't be instanced is split so that its packets can be recorded by several jobs
+			&& ( m_isInstancingEnabled || ( ( endPacket - i ) < s_packetsPerRecordingJob ) ) )
+		{
+			++endPacket;
+		}
+
+		sBatch batch;
+		batch.firstPacket = i;
+		batch.packetCount = endPacket - i;
+		batch.firstInstance = 0;
+		batch.isInstanced = m_isInstancingEnabled && ( batch.packetCount >= s_minInstancedBatchSize );
+		// The instanced and non-instanced variants of an effect are different programs
+		batch.shouldBindEffect = ( firstPacket.effect != currentEffect ) || ( batch.isInstanced != isCurrentEffectInstanced );
+		// Every LOD of a mesh is in the same buffers
+		batch.shouldBindMesh = firstPacket.mesh != currentMesh;
+		currentEffect = firstPacket.effect;
+		isCurrentEffectInstanced = batch.isInstanced;
+		currentMesh = firstPacket.mesh;
+
+		// Stats
+		{
+			m_stats.drawCount += batch.packetCount;
+			m_stats.triangleCount += ( firstPacket.mesh->GetLod( lod ).indexCount / 3 ) * batch.packetCount;
+			if ( batch.shouldBindEffect )
+			{
+				++m_stats.effectBindCount;
+			}
+			if ( batch.shouldBindMesh )
+			{
+				++m_stats.meshBindCount;
+			}
+			if ( batch.isInstanced )
+			{
+				const unsigned int drawCallCount =
+					( batch.packetCount + Mesh::s_maxInstanceCountPerDraw - 1 ) / Mesh::s_maxInstanceCountPerDraw;
+				m_stats.drawCallCount += drawCallCount;
+				m_stats.instancedDrawCallCount += drawCallCount;
+				m_stats.instanceCount += batch.packetCount;
+			}
+			else
+			{
+				m_stats.drawCallCount += batch.packetCount;
+				m_stats.uniformUpdateCount += batch.packetCount;
+			}
+		}
+
+		if ( batch.isInstanced )
+		{
+			batch.firstInstance = static_cast<uint32_t>( m_instances.size() );
+			for ( uint32_t j = i; j < endPacket; ++j )
+			{
+				sInstance instance;
+				instance.x = m_packets[j].x;
+				instance.y = m_packets[j].y;
+				m_instances.push_back( instance );
+			}
+		}
+		m_batches.push_back( batch );
+
+		i = endPacket;
+	}
+	m_stats.effectBindsSkipped = m_stats.drawCount - m_stats.effectBindCount;
+	m_stats.meshBindsSkipped = m_stats.drawCount - m_stats.meshBindCount;
+}
+
+void eae6320::Graphics::RenderQueue::RecordBatches( const uint32_t i_begin, const uint32_t i_end, void* io_renderQueue )
+{
+	RenderQueue& renderQueue = *static_cast<RenderQueue*>( io_renderQueue );
+	for ( uint32_t job = i_begin; job < i_end; ++job )
+	{
+		cCommandBuffer& commands = renderQueue.m_commandBuffers[job];
+		const uint32_t firstBatch = renderQueue.m_recordingJobBatches[job];
+		const uint32_t endBatch = renderQueue.m_recordingJobBatches[job + 1];
+		for ( uint32_t i = firstBatch; i < endBatch; ++i )
+		{
+			const sBatch& batch = renderQueue.m_batches[i];
+			const sDrawPacket& firstPacket = renderQueue.m_packets[batch.firstPacket];
+			const unsigned int lod = GetLod( firstPacket );
+			// The first batch can't know what the batch before it bound
+			// (the redundant binds are left out when the buffers are merged)
+			const bool isFirstBatch = i == firstBatch;
+			if ( batch.shouldBindEffect || isFirstBatch )
+			{
+				commands.BindEffect( *firstPacket.effect, batch.isInstanced );
+			}
+			if ( batch.shouldBindMesh || isFirstBatch )
+			{
+				commands.BindMesh( *firstPacket.mesh );
+			}
+			sDrawConstants drawConstants;
+			if ( batch.isInstanced )
+			{
+				// Instanced draws only need the mesh's dequantization
+				// (the instance data has the offsets)
+				firstPacket.mesh->GetDrawConstants( 0.0f, 0.0f, drawConstants );
+				commands.SetDrawConstants( drawConstants, 0.0f, 0.0f );
+				commands.DrawInstanced( &renderQueue.m_instances[batch.firstInstance], batch.packetCount, lod );
+			}
+			else
+			{
+				const uint32_t endPacket = batch.firstPacket + batch.packetCount;
+				for ( uint32_t j = batch.firstPacket; j < endPacket; ++j )
+				{
+					const sDrawPacket& packet = renderQueue.m_packets[j];
+					packet.mesh->GetDrawConstants( packet.x, packet.y, drawConstants );
+					commands.SetDrawConstants( drawConstants, packet.x, packet.y );
+					commands.DrawPrimitives( lod );
+				}
+			}
+		}
+	}
+}
+
+unsigned int eae6320::Graphics::RenderQueue::GetLod( const sDrawPacket& i_packet )
+{
+	return static_cast<unsigned int>( ( i_packet.sortKey >> s_depthBitCount ) & ( ( 1u << s_lodBitCount ) - 1 ) );
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Graphics::RenderQueue::RenderQueue()
+{
+	memset( &m_stats, 0, sizeof( m_stats ) );
+	m_isInstancingEnabled = true;
+	m_isRecorded = false;
+}
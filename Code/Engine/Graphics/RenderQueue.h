@@ -0,0 +1,224 @@
+/*
+	A render queue collects the draw calls for a frame
+	and then issues them sorted by a 64-bit key
+	so that draws that share an effect or a mesh are next to each other
+	and redundant binds can be skipped.
+
+	The sort key is laid out (from the most significant bits to the least) as:
+		* layer (8 bits)
+		* effect ID (16 bits)
+		* mesh ID (16 bits)
+		* level of detail (3 bits)
+		* depth (21 bits)
+
+	Because packets that share an effect, a mesh, and a LOD end up next to each other after sorting
+	a run of them can be drawn with a single instanced draw call
+	instead of uploading a uniform and drawing once for every packet.
+	(Different LODs of a mesh are different ranges of its index buffer,
+	and so they are separate draw calls but don't need to bind the mesh again.)
+
+	Drawing doesn't call into the platform directly.
+	The batches are recorded into command buffers (see CommandBuffer.h) by several jobs at once
+	(through the parallel-for that the game sets with SetParallelFor(), because Graphics doesn't link Core),
+	the buffers are merged into one,
+	and then the merged buffer is executed by the platform (or by the software rasterizer).
+	Record() can be called on the game thread before the queue is handed to the render thread
+	so that the render thread only has to execute the commands.
+
+	A packet copies everything that drawing needs from the renderable when it is created
+	(its mesh, its effect, and its offset),
+	and so a queue can be drawn on the render thread while the game thread changes the renderables for the next frame
+	(see RenderThread.h).
+*/
+
+#ifndef EAE6320_RENDERQUEUE_H
+#define EAE6320_RENDERQUEUE_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CommandBuffer.h"
+#include "Mesh.h"
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class Effect;
+		class Renderable;
+		class SoftwareRasterizer;
+
+		struct sDrawPacket
+		{
+			uint64_t sortKey;
+			// These are NULL if the renderable wasn't ready
+			Mesh* mesh;
+			Effect* effect;
+			// The renderable's offset when the packet was created
+			float x, y;
+		};
+
+		// Counts from the most recent call to RenderQueue::Draw()
+		struct sRenderQueueStats
+		{
+			// The number of packets that were drawn
+			unsigned int drawCount;
+			unsigned int effectBindCount;
+			unsigned int effectBindsSkipped;
+			unsigned int meshBindCount;
+			unsigned int meshBindsSkipped;
+			// The number of draw calls that were actually issued
+			// (i.e. one for every packet that wasn't instanced plus one for every instanced batch)
+			unsigned int drawCallCount;
+			unsigned int instancedDrawCallCount;
+			unsigned int instanceCount;
+			// The number of triangles in the LODs that were drawn
+			unsigned int triangleCount;
+			// The packets that needed their own draw constants (instanced packets don't)
+			// (see UniformRingBuffer::GetStats() for how they were uploaded)
+			unsigned int uniformUpdateCount;
+			// The merged command buffer
+			unsigned int commandCount;
+			// How many command buffers were recorded separately
+			unsigned int commandBufferCount;
+			// Binds that were recorded at the start of a command buffer but were already bound by the buffer before it
+			unsigned int commandBindsElided;
+
+			// The number of effect and mesh binds that were skipped
+			// compared with binding both for every packet that was drawn
+			unsigned int GetBindsSaved() const { return effectBindsSkipped + meshBindsSkipped; }
+		};
+
+		class RenderQueue
+		{
+			// Interface
+			//==========
+
+		public:
+
+			static const unsigned int s_layerBitCount = 8;
+			static const unsigned int s_effectBitCount = 16;
+			static const unsigned int s_meshBitCount = 16;
+			static const unsigned int s_lodBitCount = 3;
+			static const unsigned int s_depthBitCount = 21;
+			// Runs of at least this many packets with the same effect, mesh, and LOD are drawn instanced
+			static const unsigned int s_minInstancedBatchSize = 2;
+			// Called with a half-open range [i_begin, i_end)
+			typedef void ( *tRangeFunction )( const uint32_t i_begin, const uint32_t i_end, void* io_userData );
+			// Must call the function for every index in [0, i_count) (in ranges of about i_grainSize)
+			// and only return once every call has returned
+			// (this matches Core::JobSystem::ParallelFor())
+			typedef void ( *tParallelFor )( const uint32_t i_count, const uint32_t i_grainSize, const tRangeFunction i_function, void* io_userData );
+
+			// Each recording job records batches with about this many packets into its own command buffer
+			// (an instanced batch only counts as one, and a run that isn't instanced is split into batches of at most this many)
+			static const unsigned int s_packetsPerRecordingJob = 1024;
+
+			// The depth should be in [0,1]; anything outside of that range is clamped
+			static uint64_t CreateSortKey( const uint8_t i_layer, const uint16_t i_effectId, const uint16_t i_meshId, const uint8_t i_lod,
+				const float i_depth );
+
+			// Submission
+			//-----------
+
+			// Lower layers are drawn first,
+			// and within a layer/effect/mesh/LOD lower depths are drawn first.
+			// The renderable is drawn with the LOD that it had when it was submitted (see Renderable::SelectLod()).
+			// Renderables that aren't ready (i.e. that are still loading) are ignored
+			void Submit( Renderable& i_renderable, const uint8_t i_layer = 0, const float i_depth = 0.0f );
+			// Adds uninitialized packets that the caller must fill in (with CreatePacket()) before Draw().
+			// This lets several jobs build parts of the queue at the same time
+			// (the returned pointer is only valid until the next Submit() or AllocatePackets())
+			sDrawPacket* AllocatePackets( const unsigned int i_packetCount );
+			// If the renderable isn't ready the packet has no mesh and Sort() removes it
+			static sDrawPacket CreatePacket( Renderable& i_renderable, const uint8_t i_layer = 0, const float i_depth = 0.0f );
+			void Clear();
+			unsigned int GetPacketCount() const { return static_cast<unsigned int>( m_packets.size() ); }
+
+			// Drawing
+			//--------
+
+			// Record() runs its recording jobs through this.
+			// Until one is set (or if it is set to NULL) the jobs are run one after another on the calling thread
+			static void SetParallelFor( const tParallelFor i_parallelFor );
+			// Sorts the submitted packets, groups them into batches,
+			// and records the batches into command buffers (see SetParallelFor()).
+			// Nothing is issued to the platform, and so this can be called on any thread that can run jobs
+			// (submitting anything afterwards means that it has to be recorded again)
+			void Record();
+			const cCommandBuffer& GetCommands() const { return m_commands; }
+			// Records the queue if it hasn't been recorded yet and executes the commands on the current platform.
+			// This must be called between Graphics' clear and present (i.e. from Graphics::Render()),
+			// and the queue is cleared afterwards
+			void Draw();
+			// Does the same thing as Draw() but with the software rasterizer as the backend,
+			// so that batching can be verified without a GPU
+			// (the rasterizer's draw call and instance counts will match the queue's stats)
+			void Draw( SoftwareRasterizer& i_rasterizer );
+			const sRenderQueueStats& GetStats() const { return m_stats; }
+			// Instancing can be turned off to compare against drawing every packet individually
+			void SetIsInstancingEnabled( const bool i_isInstancingEnabled ) { m_isInstancingEnabled = i_isInstancingEnabled; }
+
+			// Exposed so that the order can be inspected without a GPU
+			void Sort();
+			const sDrawPacket* GetPackets() const { return m_packets.empty() ? NULL : &m_packets[0]; }
+
+			// Data
+			//=====
+
+		private:
+
+			std::vector<sDrawPacket> m_packets;
+			// The radix sort ping-pongs between the packets and this buffer
+			std::vector<sDrawPacket> m_scratch;
+			sRenderQueueStats m_stats;
+			bool m_isInstancingEnabled;
+
+			// A run of sorted packets that share an effect, a mesh, and a LOD
+			// (or part of one; see s_packetsPerRecordingJob)
+			struct sBatch
+			{
+				uint32_t firstPacket;
+				uint32_t packetCount;
+				// Only used when the batch is instanced
+				uint32_t firstInstance;
+				bool isInstanced;
+				bool shouldBindEffect;
+				bool shouldBindMesh;
+			};
+			std::vector<sBatch> m_batches;
+			std::vector<sInstance> m_instances;
+			// The first batch of every recording job
+			// (with the batch count after the last one)
+			std::vector<uint32_t> m_recordingJobBatches;
+			// One for every recording job
+			std::vector<cCommandBuffer> m_commandBuffers;
+			// The recording jobs' buffers appended together
+			cCommandBuffer m_commands;
+			bool m_isRecorded;
+
+			// Implementation
+			//===============
+
+			// Sorts the packets, groups them into batches, and calculates the stats
+			void PrepareBatches();
+			// Records the batches of a range of recording jobs, each into its own command buffer
+			static void RecordBatches( const uint32_t i_begin, const uint32_t i_end, void* io_renderQueue );
+			// The LOD that a packet was submitted with
+			static unsigned int GetLod( const sDrawPacket& i_packet );
+
+		public:
+
+			RenderQueue();
+		};
+	}
+}
+
+#endif	// EAE6320_RENDERQUEUE_H
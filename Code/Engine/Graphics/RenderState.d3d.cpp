@@ -0,0 +1,142 @@
+// Header Files
+//=============
+
+#include "RenderState.h"
+
+#include <cassert>
+#include <cstring>
+#include "Effect.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	struct sStreamSource
+	{
+		IDirect3DVertexBuffer9* vertexBuffer;
+		unsigned int offset;
+		unsigned int stride;
+	};
+
+	// NULL is a valid state for every one of these,
+	// and so whether they are known is tracked separately
+	IDirect3DVertexShader9* s_vertexShader = NULL;
+	IDirect3DPixelShader9* s_pixelShader = NULL;
+	IDirect3DVertexDeclaration9* s_vertexDeclaration = NULL;
+	sStreamSource s_streamSources[eae6320::Graphics::RenderState::s_streamCount];
+	IDirect3DIndexBuffer9* s_indexBuffer = NULL;
+	bool s_isVertexShaderKnown = false;
+	bool s_isPixelShaderKnown = false;
+	bool s_isVertexDeclarationKnown = false;
+	bool s_isStreamSourceKnown[eae6320::Graphics::RenderState::s_streamCount] = {};
+	bool s_isIndexBufferKnown = false;
+	eae6320::Graphics::sRenderStateStats s_stats;
+}
+
+// Interface
+//==========
+
+void eae6320::Graphics::RenderState::Invalidate()
+{
+	s_isVertexShaderKnown = false;
+	s_isPixelShaderKnown = false;
+	s_isVertexDeclarationKnown = false;
+	for ( unsigned int i = 0; i < s_streamCount; ++i )
+	{
+		s_isStreamSourceKnown[i] = false;
+	}
+	s_isIndexBufferKnown = false;
+}
+
+const eae6320::Graphics::sRenderStateStats& eae6320::Graphics::RenderState::GetStats()
+{
+	return s_stats;
+}
+
+void eae6320::Graphics::RenderState::ResetStats()
+{
+	memset( &s_stats, 0, sizeof( s_stats ) );
+}
+
+void eae6320::Graphics::RenderState::SetVertexShader( IDirect3DVertexShader9* const i_vertexShader )
+{
+	if ( s_isVertexShaderKnown && ( i_vertexShader == s_vertexShader ) )
+	{
+		++s_stats.callsSkipped;
+		return;
+	}
+	const HRESULT result = Effect::s_direct3dDevice->SetVertexShader( i_vertexShader );
+	assert( SUCCEEDED( result ) );
+	s_vertexShader = i_vertexShader;
+	s_isVertexShaderKnown = SUCCEEDED( result );
+	++s_stats.callsIssued;
+}
+
+void eae6320::Graphics::RenderState::SetPixelShader( IDirect3DPixelShader9* const i_pixelShader )
+{
+	if ( s_isPixelShaderKnown && ( i_pixelShader == s_pixelShader ) )
+	{
+		++s_stats.callsSkipped;
+		return;
+	}
+	const HRESULT result = Effect::s_direct3dDevice->SetPixelShader( i_pixelShader );
+	assert( SUCCEEDED( result ) );
+	s_pixelShader = i_pixelShader;
+	s_isPixelShaderKnown = SUCCEEDED( result );
+	++s_stats.callsIssued;
+}
+
+void eae6320::Graphics::RenderState::SetVertexDeclaration( IDirect3DVertexDeclaration9* const i_vertexDeclaration )
+{
+	if ( s_isVertexDeclarationKnown && ( i_vertexDeclaration == s_vertexDeclaration ) )
+	{
+		++s_stats.callsSkipped;
+		return;
+	}
+	const HRESULT result = Effect::s_direct3dDevice->SetVertexDeclaration( i_vertexDeclaration );
+	assert( SUCCEEDED( result ) );
+	s_vertexDeclaration = i_vertexDeclaration;
+	s_isVertexDeclarationKnown = SUCCEEDED( result );
+	++s_stats.callsIssued;
+}
+
+void eae6320::Graphics::RenderState::SetStreamSource( const unsigned int i_streamIndex, IDirect3DVertexBuffer9* const i_vertexBuffer,
+	const unsigned int i_offset, const unsigned int i_stride )
+{
+	const bool isCached = i_streamIndex < s_streamCount;
+	if ( isCached && s_isStreamSourceKnown[i_streamIndex] )
+	{
+		const sStreamSource& streamSource = s_streamSources[i_streamIndex];
+		if ( ( i_vertexBuffer == streamSource.vertexBuffer ) && ( i_offset == streamSource.offset ) && ( i_stride == streamSource.stride ) )
+		{
+			++s_stats.callsSkipped;
+			return;
+		}
+	}
+	const HRESULT result = Effect::s_direct3dDevice->SetStreamSource( i_streamIndex, i_vertexBuffer, i_offset, i_stride );
+	assert( SUCCEEDED( result ) );
+	if ( isCached )
+	{
+		sStreamSource& streamSource = s_streamSources[i_streamIndex];
+		streamSource.vertexBuffer = i_vertexBuffer;
+		streamSource.offset = i_offset;
+		streamSource.stride = i_stride;
+		s_isStreamSourceKnown[i_streamIndex] = SUCCEEDED( result );
+	}
+	++s_stats.callsIssued;
+}
+
+void eae6320::Graphics::RenderState::SetIndices( IDirect3DIndexBuffer9* const i_indexBuffer )
+{
+	if ( s_isIndexBufferKnown && ( i_indexBuffer == s_indexBuffer ) )
+	{
+		++s_stats.callsSkipped;
+		return;
+	}
+	const HRESULT result = Effect::s_direct3dDevice->SetIndices( i_indexBuffer );
+	assert( SUCCEEDED( result ) );
+	s_indexBuffer = i_indexBuffer;
+	s_isIndexBufferKnown = SUCCEEDED( result );
+	++s_stats.callsIssued;
+}
@@ -0,0 +1,80 @@
+// Header Files
+//=============
+
+#include "RenderState.h"
+
+#include <cassert>
+#include <cstring>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Where a binding isn't known (0 can't be used because it is a valid binding)
+	const GLuint s_unknown = ~0u;
+
+	GLuint s_programId = s_unknown;
+	GLuint s_vertexArrayId = s_unknown;
+	GLuint s_arrayBufferId = s_unknown;
+	eae6320::Graphics::sRenderStateStats s_stats;
+}
+
+// Interface
+//==========
+
+void eae6320::Graphics::RenderState::Invalidate()
+{
+	s_programId = s_unknown;
+	s_vertexArrayId = s_unknown;
+	s_arrayBufferId = s_unknown;
+}
+
+const eae6320::Graphics::sRenderStateStats& eae6320::Graphics::RenderState::GetStats()
+{
+	return s_stats;
+}
+
+void eae6320::Graphics::RenderState::ResetStats()
+{
+	memset( &s_stats, 0, sizeof( s_stats ) );
+}
+
+void eae6320::Graphics::RenderState::UseProgram( const GLuint i_programId )
+{
+	if ( i_programId == s_programId )
+	{
+		++s_stats.callsSkipped;
+		return;
+	}
+	glUseProgram( i_programId );
+	assert( glGetError() == GL_NO_ERROR );
+	s_programId = i_programId;
+	++s_stats.callsIssued;
+}
+
+void eae6320::Graphics::RenderState::BindVertexArray( const GLuint i_vertexArrayId )
+{
+	if ( i_vertexArrayId == s_vertexArrayId )
+	{
+		++s_stats.callsSkipped;
+		return;
+	}
+	glBindVertexArray( i_vertexArrayId );
+	assert( glGetError() == GL_NO_ERROR );
+	s_vertexArrayId = i_vertexArrayId;
+	++s_stats.callsIssued;
+}
+
+void eae6320::Graphics::RenderState::BindArrayBuffer( const GLuint i_bufferId )
+{
+	if ( i_bufferId == s_arrayBufferId )
+	{
+		++s_stats.callsSkipped;
+		return;
+	}
+	glBindBuffer( GL_ARRAY_BUFFER, i_bufferId );
+	assert( glGetError() == GL_NO_ERROR );
+	s_arrayBufferId = i_bufferId;
+	++s_stats.callsIssued;
+}
@@ -0,0 +1,76 @@
+/*
+	The render state cache remembers what is bound to the graphics context
+	(the program and vertex array on OpenGL,
+	and the shaders, vertex declaration, streams, and index buffer on Direct3D)
+	so that binding something that is already bound can be skipped.
+
+	Consecutive draws often share an effect or a mesh (e.g. when a RenderQueue isn't drawn in one batch,
+	or when a Renderable is drawn on its own),
+	and the driver doesn't always notice that a call doesn't change anything.
+
+	Everything that binds these states while drawing must go through the cache,
+	or the cache must be told with Invalidate() (e.g. after creating or deleting GPU objects,
+	which bind things directly and whose IDs or addresses can be reused).
+	Like the rest of the platform code this must only be used on the thread that owns the graphics context.
+*/
+
+#ifndef EAE6320_GRAPHICS_RENDERSTATE_H
+#define EAE6320_GRAPHICS_RENDERSTATE_H
+
+// Header Files
+//=============
+
+#if defined EAE6320_PLATFORM_GL
+#include "../../Externals/OpenGlExtensions/OpenGlExtensions.h"
+#include <gl/GL.h>
+#include <gl/GLU.h>
+#elif defined EAE6320_PLATFORM_D3D
+#include <d3d9.h>
+#endif //Platform Check
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		// Counts since the last RenderState::ResetStats()
+		struct sRenderStateStats
+		{
+			// Calls that were made to the platform
+			unsigned int callsIssued;
+			// Calls that were left out because the state was already bound
+			unsigned int callsSkipped;
+		};
+
+		namespace RenderState
+		{
+			// Forgets everything that is bound,
+			// and so the next call for every state is issued
+			void Invalidate();
+
+			const sRenderStateStats& GetStats();
+			void ResetStats();
+
+#if defined EAE6320_PLATFORM_GL
+			void UseProgram( const GLuint i_programId );
+			void BindVertexArray( const GLuint i_vertexArrayId );
+			// Only the GL_ARRAY_BUFFER binding is cached
+			// (the element array buffer is part of the vertex array's state)
+			void BindArrayBuffer( const GLuint i_bufferId );
+#elif defined EAE6320_PLATFORM_D3D
+			void SetVertexShader( IDirect3DVertexShader9* const i_vertexShader );
+			void SetPixelShader( IDirect3DPixelShader9* const i_pixelShader );
+			void SetVertexDeclaration( IDirect3DVertexDeclaration9* const i_vertexDeclaration );
+			// The first s_streamCount streams are cached
+			const unsigned int s_streamCount = 2;
+			void SetStreamSource( const unsigned int i_streamIndex, IDirect3DVertexBuffer9* const i_vertexBuffer,
+				const unsigned int i_offset, const unsigned int i_stride );
+			void SetIndices( IDirect3DIndexBuffer9* const i_indexBuffer );
+#endif //Platform Check
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_RENDERSTATE_H
@@ -0,0 +1,404 @@
+// Header Files
+//=============
+
+#include "RenderThread.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include "Graphics.h"
+#include "RenderQueue.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const size_t s_cacheLineSize = 64;
+
+	struct sFrame
+	{
+		eae6320::Graphics::RenderQueue renderQueue;
+		// Set by the game thread before the frame is submitted
+		eae6320::Graphics::RenderThread::tFunction function;
+		void* userData;
+		bool shouldDraw;
+		// Set by the render thread before the frame is handed back
+		// (and added to the stats by the game thread when it gets the frame back)
+		double waitMilliseconds;
+		double submitMilliseconds;
+		double presentMilliseconds;
+	};
+
+	// One thread pushes frames and another thread pops them.
+	// Neither needs a lock unless the ring is empty and the popping thread has to wait
+	class cFrameRing
+	{
+	public:
+
+		void Push( sFrame* i_frame );
+		// Waits until there is a frame
+		sFrame* Pop();
+		bool TryPop( sFrame*& o_frame );
+
+		cFrameRing() : m_writePosition( 0 ), m_readPosition( 0 ), m_isConsumerWaiting( false ) {}
+
+	private:
+
+		// This is a power of two and there is room for every frame and for the request to exit,
+		// and so a push never has to wait for room
+		static const uint32_t s_capacity = 4;
+		static_assert( ( eae6320::Graphics::RenderThread::s_maxFrameCount + 1 ) <= s_capacity, "Every frame must fit in a ring" );
+
+		// The positions only ever increase and are wrapped when the ring is indexed
+		std::atomic<uint32_t> m_writePosition;
+		uint8_t m_padding0[s_cacheLineSize - sizeof( std::atomic<uint32_t> )];
+		std::atomic<uint32_t> m_readPosition;
+		uint8_t m_padding1[s_cacheLineSize - sizeof( std::atomic<uint32_t> )];
+		sFrame* m_frames[s_capacity];
+		// The pushing thread only locks the mutex if the popping thread is waiting
+		std::atomic<bool> m_isConsumerWaiting;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+	};
+
+	sFrame s_frames[eae6320::Graphics::RenderThread::s_maxFrameCount];
+	unsigned int s_frameCount = 0;
+	// Frames go to the render thread through one ring and come back through the other
+	// (a NULL frame tells the render thread to exit)
+	cFrameRing s_submittedFrames;
+	cFrameRing s_freeFrames;
+
+	std::thread s_renderThread;
+	std::thread::id s_renderThreadId;
+
+	// Only the game thread uses these
+	bool s_isInitialized = false;
+	// The frame between BeginFrame() and SubmitFrame()
+	sFrame* s_currentFrame = NULL;
+	// Frames that have come back from the render thread but aren't being used yet
+	sFrame* s_spareFrames[eae6320::Graphics::RenderThread::s_maxFrameCount];
+	unsigned int s_spareFrameCount = 0;
+	eae6320::Graphics::RenderThread::sRenderThreadStats s_stats = {};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void RenderThreadMain( std::promise<bool>* io_hasAcquiredContext );
+	// Adds what the render thread recorded in the frame to the stats
+	void CollectFrame( sFrame& io_frame );
+	// The frames that are waiting in the free ring are used before waiting for more
+	sFrame* GetFreeFrame();
+	double GetMilliseconds( const std::chrono::steady_clock::time_point i_start, const std::chrono::steady_clock::time_point i_end );
+}
+
+// Interface
+//==========
+
+bool eae6320::Graphics::RenderThread::Initialize( const unsigned int i_frameCount )
+{
+	if ( s_isInitialized )
+	{
+		return true;
+	}
+	s_frameCount = std::min( std::max( i_frameCount, s_minFrameCount ), s_maxFrameCount );
+	s_stats = sRenderThreadStats();
+	s_currentFrame = NULL;
+	// Every frame starts out on the game thread
+	for ( unsigned int i = 0; i < s_frameCount; ++i )
+	{
+		s_frames[i].renderQueue.Clear();
+		s_spareFrames[i] = &s_frames[s_frameCount - 1 - i];
+	}
+	s_spareFrameCount = s_frameCount;
+
+	// The context can only be current on one thread at a time
+	if ( !Graphics::ReleaseContext() )
+	{
+		return false;
+	}
+	{
+		std::promise<bool> hasAcquiredContext;
+		std::future<bool> result = hasAcquiredContext.get_future();
+		s_renderThread = std::thread( RenderThreadMain, &hasAcquiredContext );
+		if ( !result.get() )
+		{
+			s_renderThread.join();
+			Graphics::AcquireContext();
+			return false;
+		}
+	}
+	s_renderThreadId = s_renderThread.get_id();
+	s_isInitialized = true;
+	return true;
+}
+
+bool eae6320::Graphics::RenderThread::ShutDown()
+{
+	if ( !s_isInitialized )
+	{
+		return true;
+	}
+	// A frame that was begun but never submitted isn't drawn
+	if ( s_currentFrame )
+	{
+		s_currentFrame->renderQueue.Clear();
+		s_spareFrames[s_spareFrameCount++] = s_currentFrame;
+		s_currentFrame = NULL;
+	}
+	// The render thread exits after it has drawn everything that was submitted before this
+	s_submittedFrames.Push( NULL );
+	s_renderThread.join();
+	s_renderThreadId = std::thread::id();
+	s_isInitialized = false;
+	{
+		sFrame* frame;
+		while ( s_freeFrames.TryPop( frame ) )
+		{
+			CollectFrame( *frame );
+			s_spareFrames[s_spareFrameCount++] = frame;
+		}
+	}
+	return Graphics::AcquireContext();
+}
+
+bool eae6320::Graphics::RenderThread::IsInitialized()
+{
+	return s_isInitialized;
+}
+
+// The game thread
+//----------------
+
+eae6320::Graphics::RenderQueue& eae6320::Graphics::RenderThread::BeginFrame()
+{
+	if ( !s_currentFrame )
+	{
+		if ( s_isInitialized )
+		{
+			const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			s_currentFrame = GetFreeFrame();
+			s_stats.gameThreadWaitMilliseconds += GetMilliseconds( startTime, std::chrono::steady_clock::now() );
+		}
+		else
+		{
+			s_currentFrame = &s_frames[0];
+		}
+	}
+	return s_currentFrame->renderQueue;
+}
+
+void eae6320::Graphics::RenderThread::SubmitFrame()
+{
+	if ( !s_currentFrame )
+	{
+		return;
+	}
+	sFrame& frame = *s_currentFrame;
+	s_currentFrame = NULL;
+	if ( s_isInitialized )
+	{
+		frame.function = NULL;
+		frame.userData = NULL;
+		frame.shouldDraw = true;
+		s_submittedFrames.Push( &frame );
+	}
+	else
+	{
+		const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		Graphics::Submit( frame.renderQueue );
+		const std::chrono::steady_clock::time_point submitTime = std::chrono::steady_clock::now();
+		Graphics::Present();
+		const std::chrono::steady_clock::time_point presentTime = std::chrono::steady_clock::now();
+		++s_stats.framesDrawn;
+		s_stats.submitMilliseconds += GetMilliseconds( startTime, submitTime );
+		s_stats.presentMilliseconds += GetMilliseconds( submitTime, presentTime );
+	}
+}
+
+void eae6320::Graphics::RenderThread::RunAndWait( const tFunction i_function, void* io_userData )
+{
+	// The render thread itself can't wait for itself
+	// (this is checked first because only the game thread can use the rest of the state)
+	if ( std::this_thread::get_id() == s_renderThreadId )
+	{
+		i_function( io_userData );
+		return;
+	}
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	if ( s_isInitialized )
+	{
+		sFrame* const functionFrame = GetFreeFrame();
+		functionFrame->function = i_function;
+		functionFrame->userData = io_userData;
+		functionFrame->shouldDraw = false;
+		s_submittedFrames.Push( functionFrame );
+		// Frames come back in the order they were submitted,
+		// and so any that come back before the function's are spares
+		for ( ;; )
+		{
+			sFrame* const frame = s_freeFrames.Pop();
+			CollectFrame( *frame );
+			s_spareFrames[s_spareFrameCount++] = frame;
+			if ( frame == functionFrame )
+			{
+				break;
+			}
+		}
+	}
+	else
+	{
+		i_function( io_userData );
+	}
+	++s_stats.functionsRun;
+	s_stats.functionWaitMilliseconds += GetMilliseconds( startTime, std::chrono::steady_clock::now() );
+}
+
+eae6320::Graphics::RenderThread::sRenderThreadStats eae6320::Graphics::RenderThread::GetStats()
+{
+	return s_stats;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	// cFrameRing
+	//-----------
+
+	void cFrameRing::Push( sFrame* i_frame )
+	{
+		const uint32_t writePosition = m_writePosition.load( std::memory_order_relaxed );
+		// This can't actually happen because there are more slots than frames,
+		// but the slot can only be reused after the popping thread has finished reading it
+		while ( ( writePosition - m_readPosition.load( std::memory_order_acquire ) ) >= s_capacity )
+		{
+			std::this_thread::yield();
+		}
+		m_frames[writePosition & ( s_capacity - 1 )] = i_frame;
+		// The write position and the waiting flag are both sequentially consistent
+		// so that either this sees that the popping thread is waiting
+		// or the popping thread sees this frame before it waits
+		m_writePosition.store( writePosition + 1, std::memory_order_seq_cst );
+		if ( m_isConsumerWaiting.load( std::memory_order_seq_cst ) )
+		{
+			// Locking the mutex makes sure that the popping thread is either waiting or hasn't checked the ring yet
+			{
+				std::lock_guard<std::mutex> lock( m_mutex );
+			}
+			m_condition.notify_one();
+		}
+	}
+
+	sFrame* cFrameRing::Pop()
+	{
+		sFrame* frame;
+		if ( TryPop( frame ) )
+		{
+			return frame;
+		}
+		std::unique_lock<std::mutex> lock( m_mutex );
+		m_isConsumerWaiting.store( true, std::memory_order_seq_cst );
+		while ( !TryPop( frame ) )
+		{
+			m_condition.wait( lock );
+		}
+		m_isConsumerWaiting.store( false, std::memory_order_relaxed );
+		return frame;
+	}
+
+	bool cFrameRing::TryPop( sFrame*& o_frame )
+	{
+		const uint32_t readPosition = m_readPosition.load( std::memory_order_relaxed );
+		if ( readPosition == m_writePosition.load( std::memory_order_seq_cst ) )
+		{
+			return false;
+		}
+		o_frame = m_frames[readPosition & ( s_capacity - 1 )];
+		m_readPosition.store( readPosition + 1, std::memory_order_release );
+		return true;
+	}
+
+	// The render thread
+	//------------------
+
+	void RenderThreadMain( std::promise<bool>* io_hasAcquiredContext )
+	{
+		if ( !eae6320::Graphics::AcquireContext() )
+		{
+			io_hasAcquiredContext->set_value( false );
+			return;
+		}
+		// The promise belongs to Initialize() and can't be used after this
+		io_hasAcquiredContext->set_value( true );
+
+		for ( ;; )
+		{
+			const std::chrono::steady_clock::time_point waitStartTime = std::chrono::steady_clock::now();
+			sFrame* const frame = s_submittedFrames.Pop();
+			if ( !frame )
+			{
+				break;
+			}
+			const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			frame->waitMilliseconds = GetMilliseconds( waitStartTime, startTime );
+			if ( frame->function )
+			{
+				frame->function( frame->userData );
+			}
+			if ( frame->shouldDraw )
+			{
+				eae6320::Graphics::Submit( frame->renderQueue );
+				const std::chrono::steady_clock::time_point submitTime = std::chrono::steady_clock::now();
+				eae6320::Graphics::Present();
+				frame->submitMilliseconds = GetMilliseconds( startTime, submitTime );
+				frame->presentMilliseconds = GetMilliseconds( submitTime, std::chrono::steady_clock::now() );
+			}
+			s_freeFrames.Push( frame );
+		}
+
+		eae6320::Graphics::ReleaseContext();
+	}
+
+	// The game thread
+	//----------------
+
+	void CollectFrame( sFrame& io_frame )
+	{
+		if ( io_frame.shouldDraw )
+		{
+			++s_stats.framesDrawn;
+			s_stats.submitMilliseconds += io_frame.submitMilliseconds;
+			s_stats.presentMilliseconds += io_frame.presentMilliseconds;
+		}
+		s_stats.renderThreadWaitMilliseconds += io_frame.waitMilliseconds;
+		io_frame.function = NULL;
+		io_frame.userData = NULL;
+		io_frame.shouldDraw = false;
+		io_frame.waitMilliseconds = io_frame.submitMilliseconds = io_frame.presentMilliseconds = 0.0;
+	}
+
+	sFrame* GetFreeFrame()
+	{
+		if ( s_spareFrameCount > 0 )
+		{
+			return s_spareFrames[--s_spareFrameCount];
+		}
+		sFrame* const frame = s_freeFrames.Pop();
+		CollectFrame( *frame );
+		return frame;
+	}
+
+	double GetMilliseconds( const std::chrono::steady_clock::time_point i_start, const std::chrono::steady_clock::time_point i_end )
+	{
+		return std::chrono::duration<double, std::milli>( i_end - i_start ).count();
+	}
+}
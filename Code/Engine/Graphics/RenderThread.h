@@ -0,0 +1,97 @@
+/*
+	The render thread draws and presents frames while the game thread simulates the next one.
+
+	There are two or three frames, and each one has its own render queue.
+	The game thread fills the queue of a frame that isn't being drawn (BeginFrame())
+	and hands it to the render thread (SubmitFrame()),
+	and the render thread hands it back once it has been presented.
+	The frames are passed between the threads through lock-free rings of pointers,
+	and a thread only waits on a condition variable when its ring is empty
+	(i.e. when the game thread is too far ahead or the render thread has nothing to draw).
+
+	Once the render thread is initialized it is the only thread that can use the graphics context
+	(see Graphics::AcquireContext()).
+	Anything else that needs the context (e.g. creating or destroying GPU objects,
+	or AssetLoader::FinishLoads()) must be given to RunAndWait(),
+	which runs it on the render thread after every frame that was submitted before it
+	(and so no frame that is still waiting to be drawn can use a mesh or effect that it destroys).
+
+	If the render thread isn't initialized everything runs on the calling thread instead,
+	so code that uses it doesn't need a separate single-threaded path.
+*/
+
+#ifndef EAE6320_GRAPHICS_RENDERTHREAD_H
+#define EAE6320_GRAPHICS_RENDERTHREAD_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class RenderQueue;
+
+		namespace RenderThread
+		{
+			typedef void ( *tFunction )( void* io_userData );
+
+			// With two frames the game thread can be one frame ahead of the render thread,
+			// and with three it can be two ahead (which hides more variation but adds a frame of latency)
+			const unsigned int s_minFrameCount = 2;
+			const unsigned int s_maxFrameCount = 3;
+
+			// Counts since Initialize()
+			struct sRenderThreadStats
+			{
+				uint64_t framesDrawn;
+				// How long the game thread waited in BeginFrame() for a frame that wasn't being drawn
+				double gameThreadWaitMilliseconds;
+				// How long the render thread spent in Graphics::Submit() and Graphics::Present()
+				double submitMilliseconds;
+				double presentMilliseconds;
+				// How long the render thread waited for a frame to draw
+				double renderThreadWaitMilliseconds;
+				// Calls to RunAndWait() (and how long the calling thread waited for them)
+				uint64_t functionsRun;
+				double functionWaitMilliseconds;
+			};
+
+			// This must be called after Graphics::Initialize() on the thread that called it,
+			// and that thread gives the graphics context to the render thread
+			bool Initialize( const unsigned int i_frameCount = s_minFrameCount );
+			// Draws every frame that has been submitted
+			// and then gives the graphics context back to the calling thread
+			bool ShutDown();
+			bool IsInitialized();
+
+			// The game thread
+			//----------------
+
+			// Returns the empty queue of a frame that isn't being drawn
+			// (this waits if every other frame has been submitted and hasn't been presented yet).
+			// If the render thread isn't initialized this returns a queue that SubmitFrame() draws immediately
+			RenderQueue& BeginFrame();
+			// The queue that BeginFrame() returned is drawn and presented on the render thread,
+			// and the game thread must not use it again until BeginFrame() returns it again
+			void SubmitFrame();
+
+			// Runs the function on the render thread
+			// after every frame that has already been submitted has been presented,
+			// and returns once it has finished.
+			// (If it is called on the render thread itself the function is run immediately)
+			void RunAndWait( const tFunction i_function, void* io_userData = NULL );
+
+			// This must only be called on the thread that called Initialize()
+			sRenderThreadStats GetStats();
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_RENDERTHREAD_H
@@ -1,50 +1,179 @@
 #include "Renderable.h"
 
+#include "AssetLoader.h"
+#include "HotReload.h"
+#include "RenderThread.h"
+#include "UniformRingBuffer.h"
+#include "../Memory/Memory.h"
+
+namespace
+{
+	// Meshes and effects are only allocated when a renderable loads its own
+	// (renderables that share another renderable's don't need any)
+	eae6320::Memory::Pool<eae6320::Graphics::Mesh> s_meshPool("Meshes");
+	eae6320::Memory::Pool<eae6320::Graphics::Effect> s_effectPool("Effects");
+
+	// GPU objects can only be created and destroyed on the render thread
+	// (see RenderThread::RunAndWait())
+	struct sGpuObjects
+	{
+		eae6320::Graphics::Mesh * mesh;
+		eae6320::Graphics::Effect * effect;
+		void * meshFile;
+		bool wereThereErrors;
+	};
+	void CreateGpuObjects(void * io_gpuObjects)
+	{
+		sGpuObjects & gpuObjects = *static_cast<sGpuObjects*>(io_gpuObjects);
+		gpuObjects.wereThereErrors = !gpuObjects.mesh->Initialize(gpuObjects.meshFile) || !gpuObjects.effect->Initialize();
+	}
+	void DestroyGpuObjects(void * io_gpuObjects)
+	{
+		sGpuObjects & gpuObjects = *static_cast<sGpuObjects*>(io_gpuObjects);
+		if (gpuObjects.effect)
+		{
+			gpuObjects.effect->ShutDown();
+		}
+		if (gpuObjects.mesh)
+		{
+			gpuObjects.mesh->ShutDown();
+		}
+	}
+}
+
 eae6320::Graphics::Renderable::Renderable()
 {
-	Mesh = new eae6320::Graphics::Mesh();
-	Effect = new eae6320::Graphics::Effect();
+	Mesh = NULL;
+	Effect = NULL;
+	mOwnsMeshAndEffect = false;
+	mLod = 0;
 }
 
 bool eae6320::Graphics::Renderable::Initialize(const char * i_FilePath)
 {
+	ShutDown();
+	Mesh = s_meshPool.New();
+	Effect = s_effectPool.New();
+	mOwnsMeshAndEffect = true;
+	if (!Mesh || !Effect)
+	{
+		ShutDown();
+		return false;
+	}
+	// The file is only needed until the mesh has copied what it needs out of it
+	eae6320::Memory::StackAllocator::cScopedMarker loadMarker(eae6320::Memory::GetLoadAllocator());
 	void * buffer;
 	buffer = this->Mesh->LoadMesh(i_FilePath);
-	if (!this->Mesh->Initialize(buffer))
+	if (!buffer)
 	{
 		ShutDown();
 		return false;
 	}
-	if (!this->Effect->Initialize())
+	{
+		sGpuObjects gpuObjects = { Mesh, Effect, buffer, false };
+		RenderThread::RunAndWait(CreateGpuObjects, &gpuObjects);
+		if (gpuObjects.wereThereErrors)
+		{
+			ShutDown();
+			return false;
+		}
+	}
+	HotReload::TrackMesh(*Mesh, i_FilePath);
+	HotReload::TrackEffect(*Effect);
+	return true;
+}
+
+bool eae6320::Graphics::Renderable::InitializeAsync(const char * i_FilePath)
+{
+	if (!AssetLoader::IsInitialized())
+	{
+		return Initialize(i_FilePath);
+	}
+	ShutDown();
+	Mesh = s_meshPool.New();
+	Effect = s_effectPool.New();
+	mOwnsMeshAndEffect = true;
+	if (!Mesh || !Effect)
+	{
+		ShutDown();
+		return false;
+	}
+	if (!AssetLoader::LoadMesh(*Mesh, i_FilePath) || !AssetLoader::LoadEffect(*Effect))
 	{
 		ShutDown();
 		return false;
 	}
+	HotReload::TrackMesh(*Mesh, i_FilePath);
+	HotReload::TrackEffect(*Effect);
 	return true;
 }
 
-void eae6320::Graphics::Renderable::ShutDown()
+bool eae6320::Graphics::Renderable::Initialize(const Renderable & i_Source)
 {
-	if (Effect)
+	if (!i_Source.Mesh || !i_Source.Effect)
 	{
-		Effect->ShutDown();
-		delete Effect;
+		return false;
 	}
-	if (Mesh)
+	ShutDown();
+	Mesh = i_Source.Mesh;
+	Effect = i_Source.Effect;
+	mOwnsMeshAndEffect = false;
+	return true;
+}
+
+void eae6320::Graphics::Renderable::ShutDown()
+{
+	if (mOwnsMeshAndEffect)
 	{
-		Mesh->ShutDown();
-		delete Mesh;
+		// Any loads that haven't finished must never touch the mesh or effect after this
+		if (Effect)
+		{
+			AssetLoader::Cancel(Effect);
+			HotReload::Untrack(Effect);
+		}
+		if (Mesh)
+		{
+			AssetLoader::Cancel(Mesh);
+			HotReload::Untrack(Mesh);
+		}
+		// Any frames that were already submitted are drawn before the GPU objects are destroyed
+		{
+			sGpuObjects gpuObjects = { Mesh, Effect, NULL, false };
+			RenderThread::RunAndWait(DestroyGpuObjects, &gpuObjects);
+		}
+		if (Effect)
+		{
+			s_effectPool.Delete(Effect);
+		}
+		if (Mesh)
+		{
+			s_meshPool.Delete(Mesh);
+		}
 	}
+	Effect = NULL;
+	Mesh = NULL;
+	mOwnsMeshAndEffect = false;
+	mLod = 0;
+}
+
+bool eae6320::Graphics::Renderable::IsReady() const
+{
+	return Mesh && Effect && Mesh->IsLoaded() && Effect->IsLoaded();
 }
 
 void eae6320::Graphics::Renderable::Draw()
 {
 	Effect->Bind();
-	float floatArray[] = { 0.0f, 0.0f };
-	floatArray[0] = Offset.x;
-	floatArray[1] = Offset.y;
-	Effect->SetDrawCallUniforms(floatArray);
-	Mesh->Draw();
+	sDrawConstants drawConstants;
+	Mesh->GetDrawConstants(Offset.x, Offset.y, drawConstants);
+	Effect->SetDrawCallUniforms(drawConstants);
+	Mesh->Draw(mLod);
+}
+
+void eae6320::Graphics::Renderable::SelectLod(const sLodSettings & i_Settings)
+{
+	// A mesh that is still loading only has LOD 0
+	mLod = (Mesh && Mesh->IsLoaded()) ? Mesh->SelectLod(i_Settings.pixelsPerUnit, i_Settings.maxPixelError) : 0;
 }
 
 
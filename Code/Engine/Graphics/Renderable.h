@@ -8,19 +8,48 @@ namespace eae6320
 {
 	namespace Graphics
 	{
+		// How renderables choose their level of detail (see Renderable::SelectLod())
+		struct sLodSettings
+		{
+			// How many pixels one unit covers on screen.
+			// There is no camera yet, and so this is the same for every renderable:
+			// half of the viewport's height in pixels (because the screen is two units tall).
+			// With a perspective camera it would also be divided by each renderable's distance
+			float pixelsPerUnit;
+			// A LOD is only used if its error covers no more than this many pixels
+			float maxPixelError;
+		};
+
 		class Renderable
 		{
 		public:
 			Renderable();
 			bool Initialize(const char * i_FilePath);
+			// Loads the mesh and effect in the background with the AssetLoader
+			// (or immediately if the AssetLoader isn't initialized).
+			// The renderable isn't drawn until IsReady()
+			bool InitializeAsync(const char * i_FilePath);
+			// Shares the mesh and effect of another renderable instead of loading new ones
+			// (the source must stay initialized for as long as this one is drawn).
+			// Renderables that share a mesh and effect can be batched into a single instanced draw call by the RenderQueue
+			bool Initialize(const Renderable & i_Source);
+			// Whether the mesh and effect have finished loading
+			bool IsReady() const;
 			void Draw();
 			void ShutDown();
 
 			void SetPositionOffset(Math::cVector i_Offset);
+			// Chooses the coarsest level of detail of the mesh that is accurate enough on screen;
+			// it is used by Draw() and by the RenderQueue until this is called again
+			void SelectLod(const sLodSettings & i_Settings);
+			unsigned int GetLod() const { return mLod; }
 		public:
 			Mesh * Mesh;
 			Effect * Effect;
 			Math::cVector Offset;
+		private:
+			bool mOwnsMeshAndEffect;
+			unsigned int mLod;
 		};
 	}
 }
@@ -0,0 +1,705 @@
+// Header Files
+//=============
+
+#include "SoftwareRasterizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "CommandBuffer.h"
+#include "Renderable.h"
+#include "RenderQueue.h"
+
+#if defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) ) || defined( __SSE2__ )
+	#define EAE6320_SOFTWARERASTERIZER_SSE2
+	#include <emmintrin.h>
+#endif
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Screen positions are stored with 4 bits of sub-pixel precision
+	const int32_t s_subPixelBits = 4;
+	const int32_t s_subPixelScale = 1 << s_subPixelBits;
+	// Triangles are allowed to extend this many pixels past the edges of the framebuffer.
+	// Any triangle that goes further is rejected
+	// (there is no clipping, and with s_maxDimension this keeps every edge function value inside of 32 bits)
+	const float s_guardBand = 448.0f;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	uint32_t PackColor( const uint8_t i_r, const uint8_t i_g, const uint8_t i_b, const uint8_t i_a );
+
+	// PNG
+	uint32_t CalculateCrc( const uint8_t* i_data, const size_t i_size, uint32_t i_crc = 0 );
+	void WriteBigEndian( std::vector<uint8_t>& io_buffer, const uint32_t i_value );
+	void WritePngChunk( std::ofstream& io_file, const char* i_type, const std::vector<uint8_t>& i_data );
+}
+
+// Interface
+//==========
+
+// Drawing
+//--------
+
+void eae6320::Graphics::SoftwareRasterizer::Clear( const uint8_t i_r, const uint8_t i_g, const uint8_t i_b, const uint8_t i_a )
+{
+	std::fill( m_pixels.begin(), m_pixels.end(), PackColor( i_r, i_g, i_b, i_a ) );
+	memset( &m_stats, 0, sizeof( m_stats ) );
+}
+
+void eae6320::Graphics::SoftwareRasterizer::Draw( const sVertex* i_vertices, const uint32_t* i_indices, const uint32_t i_indexCount,
+	const Math::cVector& i_positionOffset )
+{
+	++m_stats.drawCallCount;
+	++m_stats.instanceCount;
+	m_stats.triangleCount += i_indexCount / 3;
+	BinTriangles( i_vertices, i_indices, i_indexCount, i_positionOffset.x, i_positionOffset.y );
+}
+
+void eae6320::Graphics::SoftwareRasterizer::Draw( const Renderable& i_renderable )
+{
+	const Mesh* const mesh = i_renderable.Mesh;
+	if ( mesh )
+	{
+		const MeshFile::sLod& lod = mesh->GetLod( i_renderable.GetLod() );
+		Draw( mesh->GetVertexData(), mesh->GetIndexData() + lod.firstIndex, lod.indexCount, i_renderable.Offset );
+	}
+}
+
+void eae6320::Graphics::SoftwareRasterizer::DrawInstanced( const sVertex* i_vertices, const uint32_t* i_indices, const uint32_t i_indexCount,
+	const sInstance* i_instances, const unsigned int i_instanceCount )
+{
+	++m_stats.drawCallCount;
+	m_stats.instanceCount += i_instanceCount;
+	m_stats.triangleCount += ( i_indexCount / 3 ) * i_instanceCount;
+	for ( unsigned int i = 0; i < i_instanceCount; ++i )
+	{
+		BinTriangles( i_vertices, i_indices, i_indexCount, i_instances[i].x, i_instances[i].y );
+	}
+}
+
+void eae6320::Graphics::SoftwareRasterizer::Execute( const cCommandBuffer& i_commands )
+{
+	const Mesh* mesh = NULL;
+	// The offset of the most recent draw constants
+	const sInstance* offset = NULL;
+	const cCommandBuffer::sCommand* const commands = i_commands.GetCommands();
+	const size_t commandCount = i_commands.GetCommandCount();
+	for ( size_t i = 0; i < commandCount; ++i )
+	{
+		const cCommandBuffer::sCommand& command = commands[i];
+		switch ( command.type )
+		{
+		case cCommandBuffer::Command_bindMesh:
+			mesh = command.mesh;
+			break;
+		case cCommandBuffer::Command_setDrawConstants:
+			offset = &i_commands.GetOffset( command.value );
+			break;
+		case cCommandBuffer::Command_drawPrimitives:
+			{
+				const MeshFile::sLod& lod = mesh->GetLod( command.lod );
+				Draw( mesh->GetVertexData(), mesh->GetIndexData() + lod.firstIndex, lod.indexCount,
+					offset ? Math::cVector( offset->x, offset->y ) : Math::cVector() );
+			}
+			break;
+		case cCommandBuffer::Command_drawInstanced:
+			{
+				const MeshFile::sLod& lod = mesh->GetLod( command.lod );
+				// The GPU backends split big batches into multiple draw calls, and so the rasterizer does too
+				for ( uint32_t j = 0; j < command.value; j += Mesh::s_maxInstanceCountPerDraw )
+				{
+					const uint32_t instanceCount = std::min( command.value - j, static_cast<uint32_t>( Mesh::s_maxInstanceCountPerDraw ) );
+					DrawInstanced( mesh->GetVertexData(), mesh->GetIndexData() + lod.firstIndex, lod.indexCount,
+						command.instances + j, instanceCount );
+				}
+			}
+			break;
+		}
+	}
+}
+
+void eae6320::Graphics::SoftwareRasterizer::Flush()
+{
+	if ( m_triangles.empty() )
+	{
+		return;
+	}
+
+	// Wake up the workers
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_nextTile = 0;
+		m_workersBusy = static_cast<unsigned int>( m_workers.size() );
+		++m_jobId;
+	}
+	m_workAvailable.notify_all();
+	// The calling thread helps instead of waiting idly
+	RasterizeTiles();
+	// Wait for every worker to finish before the bins can be reused
+	{
+		std::unique_lock<std::mutex> lock( m_mutex );
+		while ( m_workersBusy != 0 )
+		{
+			m_workDone.wait( lock );
+		}
+	}
+
+	m_triangles.clear();
+	for ( std::vector<std::vector<uint32_t> >::iterator i = m_tileBins.begin(); i != m_tileBins.end(); ++i )
+	{
+		i->clear();
+	}
+}
+
+void eae6320::Graphics::SoftwareRasterizer::Render( Renderable** i_renderingList, const unsigned int i_renderingListLength )
+{
+	Clear();
+	for ( unsigned int i = 0; i < i_renderingListLength; ++i )
+	{
+		Draw( *i_renderingList[i] );
+	}
+	Flush();
+}
+
+void eae6320::Graphics::SoftwareRasterizer::Render( RenderQueue& i_renderQueue )
+{
+	Clear();
+	i_renderQueue.Draw( *this );
+	Flush();
+}
+
+// Output
+//-------
+
+const uint8_t* eae6320::Graphics::SoftwareRasterizer::GetPixel( const unsigned int i_x, const unsigned int i_y ) const
+{
+	assert( ( i_x < m_width ) && ( i_y < m_height ) );
+	return reinterpret_cast<const uint8_t*>( &m_pixels[( i_y * m_stride ) + i_x] );
+}
+
+bool eae6320::Graphics::SoftwareRasterizer::WritePpm( const char* i_path, std::string* o_errorMessage ) const
+{
+	std::ofstream file( i_path, std::ios::out | std::ios::binary | std::ios::trunc );
+	if ( !file )
+	{
+		if ( o_errorMessage )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Failed to open \"" << i_path << "\" to write the framebuffer";
+			*o_errorMessage = errorMessage.str();
+		}
+		return false;
+	}
+	file << "P6\n" << m_width << " " << m_height << "\n255\n";
+	std::vector<uint8_t> row( m_width * 3 );
+	for ( unsigned int y = 0; y < m_height; ++y )
+	{
+		for ( unsigned int x = 0; x < m_width; ++x )
+		{
+			const uint8_t* const pixel = GetPixel( x, y );
+			row[( x * 3 ) + 0] = pixel[0];
+			row[( x * 3 ) + 1] = pixel[1];
+			row[( x * 3 ) + 2] = pixel[2];
+		}
+		file.write( reinterpret_cast<const char*>( &row[0] ), row.size() );
+	}
+	return static_cast<bool>( file );
+}
+
+bool eae6320::Graphics::SoftwareRasterizer::WritePng( const char* i_path, std::string* o_errorMessage ) const
+{
+	std::ofstream file( i_path, std::ios::out | std::ios::binary | std::ios::trunc );
+	if ( !file )
+	{
+		if ( o_errorMessage )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Failed to open \"" << i_path << "\" to write the framebuffer";
+			*o_errorMessage = errorMessage.str();
+		}
+		return false;
+	}
+
+	// Signature
+	{
+		const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+		file.write( reinterpret_cast<const char*>( signature ), sizeof( signature ) );
+	}
+	// Header
+	{
+		std::vector<uint8_t> header;
+		WriteBigEndian( header, m_width );
+		WriteBigEndian( header, m_height );
+		header.push_back( 8 );	// Bits per channel
+		header.push_back( 6 );	// RGBA
+		header.push_back( 0 );	// Deflate
+		header.push_back( 0 );	// Adaptive filtering
+		header.push_back( 0 );	// No interlacing
+		WritePngChunk( file, "IHDR", header );
+	}
+	// Image data
+	{
+		// Every row starts with its filter type (0 == none)
+		const size_t rowSize = 1 + ( m_width * 4 );
+		std::vector<uint8_t> image( rowSize * m_height );
+		for ( unsigned int y = 0; y < m_height; ++y )
+		{
+			image[y * rowSize] = 0;
+			memcpy( &image[( y * rowSize ) + 1], &m_pixels[y * m_stride], m_width * 4 );
+		}
+		// The image is stored with uncompressed deflate blocks
+		// (golden images are small, and this avoids a dependency on a compression library)
+		std::vector<uint8_t> zlibStream;
+		zlibStream.push_back( 0x78 );
+		zlibStream.push_back( 0x01 );
+		uint32_t adler_a = 1, adler_b = 0;
+		const size_t maxBlockSize = 0xffff;
+		size_t offset = 0;
+		do
+		{
+			const size_t blockSize = std::min( maxBlockSize, image.size() - offset );
+			const bool isFinalBlock = ( offset + blockSize ) == image.size();
+			zlibStream.push_back( isFinalBlock ? 1 : 0 );
+			zlibStream.push_back( static_cast<uint8_t>( blockSize & 0xff ) );
+			zlibStream.push_back( static_cast<uint8_t>( blockSize >> 8 ) );
+			zlibStream.push_back( static_cast<uint8_t>( ~blockSize & 0xff ) );
+			zlibStream.push_back( static_cast<uint8_t>( ( ~blockSize >> 8 ) & 0xff ) );
+			for ( size_t i = 0; i < blockSize; ++i )
+			{
+				const uint8_t byte = image[offset + i];
+				zlibStream.push_back( byte );
+				adler_a = ( adler_a + byte ) % 65521;
+				adler_b = ( adler_b + adler_a ) % 65521;
+			}
+			offset += blockSize;
+		} while ( offset < image.size() );
+		WriteBigEndian( zlibStream, ( adler_b << 16 ) | adler_a );
+		WritePngChunk( file, "IDAT", zlibStream );
+	}
+	// End
+	WritePngChunk( file, "IEND", std::vector<uint8_t>() );
+
+	return static_cast<bool>( file );
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Graphics::SoftwareRasterizer::SoftwareRasterizer()
+	:
+	m_width( 0 ), m_height( 0 ), m_tileCountX( 0 ), m_tileCountY( 0 ), m_stride( 0 ),
+	m_jobId( 0 ), m_workersBusy( 0 ), m_shouldWorkersExit( false ), m_nextTile( 0 )
+{
+	memset( &m_stats, 0, sizeof( m_stats ) );
+}
+
+eae6320::Graphics::SoftwareRasterizer::~SoftwareRasterizer()
+{
+	ShutDown();
+}
+
+bool eae6320::Graphics::SoftwareRasterizer::Initialize( const unsigned int i_width, const unsigned int i_height,
+	const unsigned int i_workerThreadCount, std::string* o_errorMessage )
+{
+	ShutDown();
+
+	if ( ( i_width == 0 ) || ( i_height == 0 ) || ( i_width > s_maxDimension ) || ( i_height > s_maxDimension ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "The software rasterizer can't create a " << i_width << "x" << i_height <<
+				" framebuffer (each dimension must be between 1 and " << s_maxDimension << ")";
+			*o_errorMessage = errorMessage.str();
+		}
+		return false;
+	}
+
+	m_width = i_width;
+	m_height = i_height;
+	m_tileCountX = ( m_width + s_tileSize - 1 ) / s_tileSize;
+	m_tileCountY = ( m_height + s_tileSize - 1 ) / s_tileSize;
+	m_stride = m_tileCountX * s_tileSize;
+	m_pixels.resize( m_stride * m_height );
+	m_tileBins.resize( m_tileCountX * m_tileCountY );
+	Clear();
+
+	// Create the worker threads
+	{
+		unsigned int threadCount = i_workerThreadCount;
+		if ( threadCount == 0 )
+		{
+			threadCount = std::max( std::thread::hardware_concurrency(), 1u );
+		}
+		// The thread that calls Flush() also rasterizes
+		m_shouldWorkersExit = false;
+		m_jobId = 0;
+		for ( unsigned int i = 1; i < threadCount; ++i )
+		{
+			m_workers.push_back( std::thread( &SoftwareRasterizer::RunWorker, this ) );
+		}
+	}
+
+	return true;
+}
+
+void eae6320::Graphics::SoftwareRasterizer::ShutDown()
+{
+	if ( !m_workers.empty() )
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_shouldWorkersExit = true;
+		}
+		m_workAvailable.notify_all();
+		for ( std::vector<std::thread>::iterator i = m_workers.begin(); i != m_workers.end(); ++i )
+		{
+			i->join();
+		}
+		m_workers.clear();
+	}
+	m_pixels.clear();
+	m_triangles.clear();
+	m_tileBins.clear();
+	m_width = m_height = 0;
+	m_tileCountX = m_tileCountY = 0;
+	m_stride = 0;
+}
+
+// Implementation
+//===============
+
+void eae6320::Graphics::SoftwareRasterizer::BinTriangles( const sVertex* i_vertices, const uint32_t* i_indices, const uint32_t i_indexCount,
+	const float i_positionOffsetX, const float i_positionOffsetY )
+{
+	if ( !i_vertices || !i_indices || ( m_width == 0 ) )
+	{
+		return;
+	}
+
+	const float width = static_cast<float>( m_width );
+	const float height = static_cast<float>( m_height );
+	for ( uint32_t i = 0; ( i + 2 ) < i_indexCount; i += 3 )
+	{
+		sTriangle triangle;
+		bool isInGuardBand = true;
+		for ( unsigned int j = 0; j < 3; ++j )
+		{
+			const sVertex& vertex = i_vertices[i_indices[i + j]];
+			// This is what vertex.shader does
+			const float x_clip = vertex.x + i_positionOffsetX;
+			const float y_clip = vertex.y + i_positionOffsetY;
+			// Viewport transform (the framebuffer's origin is at the top left)
+			const float x_screen = ( ( x_clip * 0.5f ) + 0.5f ) * width;
+			const float y_screen = ( 0.5f - ( y_clip * 0.5f ) ) * height;
+			if ( ( x_screen < -s_guardBand ) || ( x_screen > ( width + s_guardBand ) )
+				|| ( y_screen < -s_guardBand ) || ( y_screen > ( height + s_guardBand ) ) )
+			{
+				isInGuardBand = false;
+				break;
+			}
+			triangle.x[j] = static_cast<int32_t>( std::floor( ( x_screen * s_subPixelScale ) + 0.5f ) );
+			triangle.y[j] = static_cast<int32_t>( std::floor( ( y_screen * s_subPixelScale ) + 0.5f ) );
+			triangle.r[j] = static_cast<float>( vertex.r );
+			triangle.g[j] = static_cast<float>( vertex.g );
+			triangle.b[j] = static_cast<float>( vertex.b );
+			triangle.a[j] = static_cast<float>( vertex.a );
+		}
+		if ( !isInGuardBand )
+		{
+			continue;
+		}
+
+		// Both windings are drawn (neither of the GPU backends enable culling),
+		// but the rasterizer expects a positive area
+		int64_t doubleArea = ( static_cast<int64_t>( triangle.x[1] - triangle.x[0] ) * ( triangle.y[2] - triangle.y[0] ) )
+			- ( static_cast<int64_t>( triangle.y[1] - triangle.y[0] ) * ( triangle.x[2] - triangle.x[0] ) );
+		if ( doubleArea == 0 )
+		{
+			continue;
+		}
+		else if ( doubleArea < 0 )
+		{
+			std::swap( triangle.x[1], triangle.x[2] );
+			std::swap( triangle.y[1], triangle.y[2] );
+			std::swap( triangle.r[1], triangle.r[2] );
+			std::swap( triangle.g[1], triangle.g[2] );
+			std::swap( triangle.b[1], triangle.b[2] );
+			std::swap( triangle.a[1], triangle.a[2] );
+			doubleArea = -doubleArea;
+		}
+		triangle.inverseArea = static_cast<float>( 1.0 / static_cast<double>( doubleArea ) );
+
+		// Find the pixels that could be covered
+		{
+			const int32_t minX_fixed = std::min( triangle.x[0], std::min( triangle.x[1], triangle.x[2] ) );
+			const int32_t minY_fixed = std::min( triangle.y[0], std::min( triangle.y[1], triangle.y[2] ) );
+			const int32_t maxX_fixed = std::max( triangle.x[0], std::max( triangle.x[1], triangle.x[2] ) );
+			const int32_t maxY_fixed = std::max( triangle.y[0], std::max( triangle.y[1], triangle.y[2] ) );
+			triangle.minX = std::max( minX_fixed >> s_subPixelBits, 0 );
+			triangle.minY = std::max( minY_fixed >> s_subPixelBits, 0 );
+			triangle.maxX = std::min( maxX_fixed >> s_subPixelBits, static_cast<int32_t>( m_width ) - 1 );
+			triangle.maxY = std::min( maxY_fixed >> s_subPixelBits, static_cast<int32_t>( m_height ) - 1 );
+			if ( ( triangle.minX > triangle.maxX ) || ( triangle.minY > triangle.maxY ) )
+			{
+				continue;
+			}
+		}
+
+		// Bin the triangle into every tile that its bounds overlap
+		const uint32_t triangleIndex = static_cast<uint32_t>( m_triangles.size() );
+		m_triangles.push_back( triangle );
+		{
+			const unsigned int tileMinX = static_cast<unsigned int>( triangle.minX ) / s_tileSize;
+			const unsigned int tileMinY = static_cast<unsigned int>( triangle.minY ) / s_tileSize;
+			const unsigned int tileMaxX = static_cast<unsigned int>( triangle.maxX ) / s_tileSize;
+			const unsigned int tileMaxY = static_cast<unsigned int>( triangle.maxY ) / s_tileSize;
+			for ( unsigned int tileY = tileMinY; tileY <= tileMaxY; ++tileY )
+			{
+				for ( unsigned int tileX = tileMinX; tileX <= tileMaxX; ++tileX )
+				{
+					m_tileBins[( tileY * m_tileCountX ) + tileX].push_back( triangleIndex );
+				}
+			}
+		}
+	}
+}
+
+void eae6320::Graphics::SoftwareRasterizer::RunWorker()
+{
+	// Initialize() resets the job ID before any workers are created
+	unsigned int lastJobId = 0;
+	for ( ;; )
+	{
+		{
+			std::unique_lock<std::mutex> lock( m_mutex );
+			while ( ( m_jobId == lastJobId ) && !m_shouldWorkersExit )
+			{
+				m_workAvailable.wait( lock );
+			}
+			if ( m_shouldWorkersExit )
+			{
+				return;
+			}
+			lastJobId = m_jobId;
+		}
+		RasterizeTiles();
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			if ( --m_workersBusy == 0 )
+			{
+				m_workDone.notify_one();
+			}
+		}
+	}
+}
+
+void eae6320::Graphics::SoftwareRasterizer::RasterizeTiles()
+{
+	const unsigned int tileCount = m_tileCountX * m_tileCountY;
+	for ( unsigned int tileIndex = m_nextTile++; tileIndex < tileCount; tileIndex = m_nextTile++ )
+	{
+		const std::vector<uint32_t>& bin = m_tileBins[tileIndex];
+		if ( bin.empty() )
+		{
+			continue;
+		}
+		const int32_t tileMinX = static_cast<int32_t>( ( tileIndex % m_tileCountX ) * s_tileSize );
+		const int32_t tileMinY = static_cast<int32_t>( ( tileIndex / m_tileCountX ) * s_tileSize );
+		const int32_t tileMaxX = std::min( tileMinX + static_cast<int32_t>( s_tileSize ), static_cast<int32_t>( m_width ) ) - 1;
+		const int32_t tileMaxY = std::min( tileMinY + static_cast<int32_t>( s_tileSize ), static_cast<int32_t>( m_height ) ) - 1;
+		// Triangles are drawn in the order they were submitted so that overlapping triangles resolve the same way the GPU would
+		for ( std::vector<uint32_t>::const_iterator i = bin.begin(); i != bin.end(); ++i )
+		{
+			RasterizeTriangleInTile( m_triangles[*i], tileMinX, tileMinY, tileMaxX, tileMaxY );
+		}
+	}
+}
+
+void eae6320::Graphics::SoftwareRasterizer::RasterizeTriangleInTile( const sTriangle& i_triangle,
+	const int32_t i_tileMinX, const int32_t i_tileMinY, const int32_t i_tileMaxX, const int32_t i_tileMaxY )
+{
+	// Pixels are processed in groups of 4,
+	// and since tiles are a multiple of 4 wide a group never crosses into a neighboring tile
+	const int32_t minX = std::max( i_triangle.minX, i_tileMinX ) & ~3;
+	const int32_t minY = std::max( i_triangle.minY, i_tileMinY );
+	const int32_t maxX = std::min( i_triangle.maxX, i_tileMaxX );
+	const int32_t maxY = std::min( i_triangle.maxY, i_tileMaxY );
+
+	// Set up the edge functions at the center of the first pixel.
+	// Edge k goes from vertex k to vertex k+1, and is positive on the inside of the triangle.
+	int32_t edge_row[3], edge_stepX[3], edge_stepY[3];
+	{
+		const int64_t pixelCenterX = ( static_cast<int64_t>( minX ) << s_subPixelBits ) + ( s_subPixelScale / 2 );
+		const int64_t pixelCenterY = ( static_cast<int64_t>( minY ) << s_subPixelBits ) + ( s_subPixelScale / 2 );
+		for ( unsigned int k = 0; k < 3; ++k )
+		{
+			const unsigned int k_next = ( k + 1 ) % 3;
+			const int32_t dx = i_triangle.x[k_next] - i_triangle.x[k];
+			const int32_t dy = i_triangle.y[k_next] - i_triangle.y[k];
+			// Top-left fill rule:
+			// A pixel center exactly on an edge is only drawn if that edge is a top or a left edge
+			// so that pixels shared by adjacent triangles are drawn exactly once
+			const bool isTopLeftEdge = ( dy < 0 ) || ( ( dy == 0 ) && ( dx > 0 ) );
+			const int64_t bias = isTopLeftEdge ? 0 : -1;
+			edge_row[k] = static_cast<int32_t>( ( dx * ( pixelCenterY - i_triangle.y[k] ) ) - ( dy * ( pixelCenterX - i_triangle.x[k] ) ) + bias );
+			edge_stepX[k] = -dy * s_subPixelScale;
+			edge_stepY[k] = dx * s_subPixelScale;
+		}
+	}
+
+	// The color is a weighted sum of the vertex colors;
+	// the weight of a vertex is the edge function of the opposite edge divided by the area
+	// (edge 1 is opposite vertex 0, edge 2 is opposite vertex 1, and edge 0 is opposite vertex 2)
+	const float inverseArea = i_triangle.inverseArea;
+
+#if defined( EAE6320_SOFTWARERASTERIZER_SSE2 )
+	const __m128i edge_stepX4[3] =
+	{
+		_mm_set1_epi32( edge_stepX[0] * 4 ), _mm_set1_epi32( edge_stepX[1] * 4 ), _mm_set1_epi32( edge_stepX[2] * 4 )
+	};
+	const __m128 r0 = _mm_set1_ps( i_triangle.r[0] * inverseArea ), r1 = _mm_set1_ps( i_triangle.r[1] * inverseArea ), r2 = _mm_set1_ps( i_triangle.r[2] * inverseArea );
+	const __m128 g0 = _mm_set1_ps( i_triangle.g[0] * inverseArea ), g1 = _mm_set1_ps( i_triangle.g[1] * inverseArea ), g2 = _mm_set1_ps( i_triangle.g[2] * inverseArea );
+	const __m128 b0 = _mm_set1_ps( i_triangle.b[0] * inverseArea ), b1 = _mm_set1_ps( i_triangle.b[1] * inverseArea ), b2 = _mm_set1_ps( i_triangle.b[2] * inverseArea );
+	const __m128 a0 = _mm_set1_ps( i_triangle.a[0] * inverseArea ), a1 = _mm_set1_ps( i_triangle.a[1] * inverseArea ), a2 = _mm_set1_ps( i_triangle.a[2] * inverseArea );
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 maxChannel = _mm_set1_ps( 255.0f );
+	const __m128 half = _mm_set1_ps( 0.5f );
+	const __m128i minusOne = _mm_set1_epi32( -1 );
+
+	for ( int32_t y = minY; y <= maxY; ++y )
+	{
+		__m128i edge[3];
+		for ( unsigned int k = 0; k < 3; ++k )
+		{
+			edge[k] = _mm_setr_epi32( edge_row[k], edge_row[k] + edge_stepX[k],
+				edge_row[k] + ( edge_stepX[k] * 2 ), edge_row[k] + ( edge_stepX[k] * 3 ) );
+		}
+		uint32_t* pixels = &m_pixels[( y * m_stride ) + minX];
+		for ( int32_t x = minX; x <= maxX; x += 4, pixels += 4 )
+		{
+			// A pixel is inside if none of its edge functions are negative
+			const __m128i isInside = _mm_cmpgt_epi32( _mm_or_si128( _mm_or_si128( edge[0], edge[1] ), edge[2] ), minusOne );
+			if ( _mm_movemask_epi8( isInside ) != 0 )
+			{
+				const __m128 weight0 = _mm_cvtepi32_ps( edge[1] );
+				const __m128 weight1 = _mm_cvtepi32_ps( edge[2] );
+				const __m128 weight2 = _mm_cvtepi32_ps( edge[0] );
+#define EAE6320_INTERPOLATECHANNEL( i_c0, i_c1, i_c2 )	\
+				_mm_cvttps_epi32( _mm_add_ps( _mm_min_ps( _mm_max_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( weight0, i_c0 ), _mm_mul_ps( weight1, i_c1 ) ), _mm_mul_ps( weight2, i_c2 ) ), zero ), maxChannel ), half ) )
+				const __m128i r = EAE6320_INTERPOLATECHANNEL( r0, r1, r2 );
+				const __m128i g = EAE6320_INTERPOLATECHANNEL( g0, g1, g2 );
+				const __m128i b = EAE6320_INTERPOLATECHANNEL( b0, b1, b2 );
+				const __m128i a = EAE6320_INTERPOLATECHANNEL( a0, a1, a2 );
+#undef EAE6320_INTERPOLATECHANNEL
+				const __m128i color = _mm_or_si128( _mm_or_si128( r, _mm_slli_epi32( g, 8 ) ),
+					_mm_or_si128( _mm_slli_epi32( b, 16 ), _mm_slli_epi32( a, 24 ) ) );
+				// Only overwrite the pixels that are inside of the triangle
+				__m128i* const destination = reinterpret_cast<__m128i*>( pixels );
+				const __m128i previousColor = _mm_loadu_si128( destination );
+				_mm_storeu_si128( destination, _mm_or_si128( _mm_and_si128( isInside, color ), _mm_andnot_si128( isInside, previousColor ) ) );
+			}
+			edge[0] = _mm_add_epi32( edge[0], edge_stepX4[0] );
+			edge[1] = _mm_add_epi32( edge[1], edge_stepX4[1] );
+			edge[2] = _mm_add_epi32( edge[2], edge_stepX4[2] );
+		}
+		edge_row[0] += edge_stepY[0];
+		edge_row[1] += edge_stepY[1];
+		edge_row[2] += edge_stepY[2];
+	}
+#else
+	for ( int32_t y = minY; y <= maxY; ++y )
+	{
+		int32_t edge[3] = { edge_row[0], edge_row[1], edge_row[2] };
+		uint32_t* pixels = &m_pixels[( y * m_stride ) + minX];
+		for ( int32_t x = minX; x <= maxX; ++x, ++pixels )
+		{
+			if ( ( edge[0] | edge[1] | edge[2] ) >= 0 )
+			{
+				const float weight0 = static_cast<float>( edge[1] ) * inverseArea;
+				const float weight1 = static_cast<float>( edge[2] ) * inverseArea;
+				const float weight2 = static_cast<float>( edge[0] ) * inverseArea;
+#define EAE6320_INTERPOLATECHANNEL( i_channel )	\
+				static_cast<uint8_t>( std::min( std::max( ( weight0 * i_triangle.i_channel[0] ) + ( weight1 * i_triangle.i_channel[1] ) + ( weight2 * i_triangle.i_channel[2] ), 0.0f ), 255.0f ) + 0.5f )
+				*pixels = PackColor( EAE6320_INTERPOLATECHANNEL( r ), EAE6320_INTERPOLATECHANNEL( g ),
+					EAE6320_INTERPOLATECHANNEL( b ), EAE6320_INTERPOLATECHANNEL( a ) );
+#undef EAE6320_INTERPOLATECHANNEL
+			}
+			edge[0] += edge_stepX[0];
+			edge[1] += edge_stepX[1];
+			edge[2] += edge_stepX[2];
+		}
+		edge_row[0] += edge_stepY[0];
+		edge_row[1] += edge_stepY[1];
+		edge_row[2] += edge_stepY[2];
+	}
+#endif
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	uint32_t PackColor( const uint8_t i_r, const uint8_t i_g, const uint8_t i_b, const uint8_t i_a )
+	{
+		// The bytes are in RGBA order in memory (on a little-endian CPU)
+		return static_cast<uint32_t>( i_r ) | ( static_cast<uint32_t>( i_g ) << 8 )
+			| ( static_cast<uint32_t>( i_b ) << 16 ) | ( static_cast<uint32_t>( i_a ) << 24 );
+	}
+
+	uint32_t CalculateCrc( const uint8_t* i_data, const size_t i_size, uint32_t i_crc )
+	{
+		static uint32_t s_table[256] = { 0 };
+		static bool s_isTableInitialized = false;
+		if ( !s_isTableInitialized )
+		{
+			for ( uint32_t i = 0; i < 256; ++i )
+			{
+				uint32_t value = i;
+				for ( unsigned int j = 0; j < 8; ++j )
+				{
+					value = ( value & 1 ) ? ( 0xedb88320u ^ ( value >> 1 ) ) : ( value >> 1 );
+				}
+				s_table[i] = value;
+			}
+			s_isTableInitialized = true;
+		}
+		uint32_t crc = ~i_crc;
+		for ( size_t i = 0; i < i_size; ++i )
+		{
+			crc = s_table[( crc ^ i_data[i] ) & 0xff] ^ ( crc >> 8 );
+		}
+		return ~crc;
+	}
+
+	void WriteBigEndian( std::vector<uint8_t>& io_buffer, const uint32_t i_value )
+	{
+		io_buffer.push_back( static_cast<uint8_t>( i_value >> 24 ) );
+		io_buffer.push_back( static_cast<uint8_t>( i_value >> 16 ) );
+		io_buffer.push_back( static_cast<uint8_t>( i_value >> 8 ) );
+		io_buffer.push_back( static_cast<uint8_t>( i_value ) );
+	}
+
+	void WritePngChunk( std::ofstream& io_file, const char* i_type, const std::vector<uint8_t>& i_data )
+	{
+		std::vector<uint8_t> chunk;
+		WriteBigEndian( chunk, static_cast<uint32_t>( i_data.size() ) );
+		chunk.insert( chunk.end(), i_type, i_type + 4 );
+		chunk.insert( chunk.end(), i_data.begin(), i_data.end() );
+		// The CRC covers the type and the data but not the length
+		WriteBigEndian( chunk, CalculateCrc( &chunk[4], chunk.size() - 4 ) );
+		io_file.write( reinterpret_cast<const char*>( &chunk[0] ), chunk.size() );
+	}
+}
@@ -0,0 +1,161 @@
+/*
+	This class draws meshes on the CPU into an in-memory framebuffer.
+
+	It mirrors what vertex.shader and fragment.shader do on the GPU
+	(the position is offset by g_position_offset and the vertex colors are interpolated across each triangle)
+	so that the rendering path can be regression tested and profiled without a GPU.
+
+	Triangles are binned into screen tiles when they are submitted,
+	and then the tiles are rasterized in parallel by worker threads when Flush() is called.
+*/
+
+#ifndef EAE6320_SOFTWARERASTERIZER_H
+#define EAE6320_SOFTWARERASTERIZER_H
+
+// Header Files
+//=============
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Mesh.h"
+#include "../Math/cVector.h"
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cCommandBuffer;
+		class Renderable;
+		class RenderQueue;
+
+		class SoftwareRasterizer
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// The framebuffer is split into square tiles of this many pixels
+			static const unsigned int s_tileSize = 64;
+			// Fixed-point edge functions limit how big the framebuffer can be
+			static const unsigned int s_maxDimension = 1024;
+
+			// Drawing
+			//--------
+
+			// Each pixel is stored as 4 bytes in RGBA order
+			void Clear( const uint8_t i_r = 0, const uint8_t i_g = 0, const uint8_t i_b = 0, const uint8_t i_a = 255 );
+			// Triangles are only binned here; nothing is written to the framebuffer until Flush()
+			void Draw( const sVertex* i_vertices, const uint32_t* i_indices, const uint32_t i_indexCount, const Math::cVector& i_positionOffset );
+			void Draw( const Renderable& i_renderable );
+			// The mesh is drawn once for every instance, offset by the instance's position
+			// (this mirrors Mesh::DrawInstanced() and counts as a single draw call)
+			void DrawInstanced( const sVertex* i_vertices, const uint32_t* i_indices, const uint32_t i_indexCount,
+				const sInstance* i_instances, const unsigned int i_instanceCount );
+			// Draws every draw command in the buffer
+			// (binding an effect doesn't do anything because there is only one way to shade)
+			void Execute( const cCommandBuffer& i_commands );
+			void Flush();
+			// Convenience functions that do a complete frame: Clear(), Draw() everything, Flush()
+			void Render( Renderable** i_renderingList, const unsigned int i_renderingListLength );
+			void Render( RenderQueue& i_renderQueue );
+
+			// Statistics
+			//-----------
+
+			// Counts since the last Clear()
+			struct sStats
+			{
+				unsigned int drawCallCount;
+				unsigned int instanceCount;
+				unsigned int triangleCount;
+			};
+			const sStats& GetStats() const { return m_stats; }
+
+			// Output
+			//-------
+
+			const uint8_t* GetPixel( const unsigned int i_x, const unsigned int i_y ) const;
+			unsigned int GetWidth() const { return m_width; }
+			unsigned int GetHeight() const { return m_height; }
+			// Writes the framebuffer as a binary PPM (the alpha channel is dropped)
+			bool WritePpm( const char* i_path, std::string* o_errorMessage = NULL ) const;
+			// Writes the framebuffer as an RGBA PNG
+			bool WritePng( const char* i_path, std::string* o_errorMessage = NULL ) const;
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			SoftwareRasterizer();
+			~SoftwareRasterizer();
+			// A worker thread count of 0 means to use one thread per hardware core
+			bool Initialize( const unsigned int i_width, const unsigned int i_height, const unsigned int i_workerThreadCount = 0,
+				std::string* o_errorMessage = NULL );
+			void ShutDown();
+
+			// Data
+			//=====
+
+		private:
+
+			struct sTriangle
+			{
+				// Screen positions in 28.4 fixed point
+				int32_t x[3], y[3];
+				// Bounding box in pixels (inclusive)
+				int32_t minX, minY, maxX, maxY;
+				// Vertex colors in [0,255]
+				float r[3], g[3], b[3], a[3];
+				float inverseArea;
+			};
+
+			unsigned int m_width, m_height;
+			unsigned int m_tileCountX, m_tileCountY;
+			// Rows are padded to a whole number of tiles so that SIMD stores never need to be clipped
+			unsigned int m_stride;
+			std::vector<uint32_t> m_pixels;
+
+			std::vector<sTriangle> m_triangles;
+			// Every tile has a list of the triangles that overlap it, in submission order
+			std::vector<std::vector<uint32_t> > m_tileBins;
+
+			// Worker threads
+			std::vector<std::thread> m_workers;
+			std::mutex m_mutex;
+			std::condition_variable m_workAvailable;
+			std::condition_variable m_workDone;
+			unsigned int m_jobId;
+			unsigned int m_workersBusy;
+			bool m_shouldWorkersExit;
+			std::atomic<unsigned int> m_nextTile;
+
+			sStats m_stats;
+
+			// Implementation
+			//===============
+
+		private:
+
+			void BinTriangles( const sVertex* i_vertices, const uint32_t* i_indices, const uint32_t i_indexCount,
+				const float i_positionOffsetX, const float i_positionOffsetY );
+			void RunWorker();
+			void RasterizeTiles();
+			void RasterizeTriangleInTile( const sTriangle& i_triangle,
+				const int32_t i_tileMinX, const int32_t i_tileMinY, const int32_t i_tileMaxX, const int32_t i_tileMaxY );
+
+			SoftwareRasterizer( const SoftwareRasterizer& );
+			SoftwareRasterizer& operator =( const SoftwareRasterizer& );
+		};
+	}
+}
+
+#endif	// EAE6320_SOFTWARERASTERIZER_H
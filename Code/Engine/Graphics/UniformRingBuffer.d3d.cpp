@@ -0,0 +1,86 @@
+// Header Files
+//=============
+
+#include "UniformRingBuffer.h"
+
+#include <cassert>
+#include <cstring>
+#include <d3d9.h>
+#include <vector>
+#include "Effect.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// The number of float4 registers that a single sDrawConstants fills
+	const UINT s_registerCount = sizeof( eae6320::Graphics::sDrawConstants ) / ( 4 * sizeof( float ) );
+
+	std::vector<eae6320::Graphics::sDrawConstants> s_drawConstants;
+	// What the registers were last set to
+	// (the device keeps them between draw calls and shader changes)
+	eae6320::Graphics::sDrawConstants s_registers;
+	bool s_areRegistersValid = false;
+	eae6320::Graphics::sUniformRingBufferStats s_stats;
+}
+
+// Interface
+//==========
+
+bool eae6320::Graphics::UniformRingBuffer::Initialize()
+{
+	s_areRegistersValid = false;
+	Clear();
+	return Effect::s_direct3dDevice != NULL;
+}
+
+void eae6320::Graphics::UniformRingBuffer::ShutDown()
+{
+	s_drawConstants.clear();
+	s_areRegistersValid = false;
+}
+
+void eae6320::Graphics::UniformRingBuffer::Clear()
+{
+	s_drawConstants.clear();
+	memset( &s_stats, 0, sizeof( s_stats ) );
+}
+
+uint32_t eae6320::Graphics::UniformRingBuffer::Push( const sDrawConstants& i_drawConstants )
+{
+	s_drawConstants.push_back( i_drawConstants );
+	++s_stats.drawConstantsCount;
+	return static_cast<uint32_t>( s_drawConstants.size() - 1 );
+}
+
+void eae6320::Graphics::UniformRingBuffer::Upload()
+{
+	// The constants stay in system memory until Bind() sets them,
+	// because Direct3D 9 has no buffer that a shader could read them from
+}
+
+void eae6320::Graphics::UniformRingBuffer::Bind( const uint32_t i_handle )
+{
+	assert( i_handle < s_drawConstants.size() );
+	const sDrawConstants& drawConstants = s_drawConstants[i_handle];
+	if ( s_areRegistersValid && ( memcmp( &drawConstants, &s_registers, sizeof( sDrawConstants ) ) == 0 ) )
+	{
+		++s_stats.bindsSkipped;
+		return;
+	}
+	// Every register that the draw constants use is set with a single call
+	// (this copies the constants to the device, but it is counted as a bind and not as an upload
+	// because it happens once per draw)
+	const HRESULT result = Effect::s_direct3dDevice->SetVertexShaderConstantF( s_bindingPoint,
+		reinterpret_cast<const float*>( &drawConstants ), s_registerCount );
+	assert( SUCCEEDED( result ) );
+	s_registers = drawConstants;
+	s_areRegistersValid = SUCCEEDED( result );
+	++s_stats.bindCount;
+}
+
+const eae6320::Graphics::sUniformRingBufferStats& eae6320::Graphics::UniformRingBuffer::GetStats()
+{
+	return s_stats;
+}
@@ -0,0 +1,261 @@
+// Header Files
+//=============
+
+#include "UniformRingBuffer.h"
+
+#include <cassert>
+#include <cstring>
+#include <gl/GL.h>
+#include <gl/GLU.h>
+#include <sstream>
+#include <vector>
+#include "../UserOutput/Log.h"
+#include "../UserOutput/UserOutput.h"
+#include "../../Externals/OpenGlExtensions/OpenGlExtensions.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// This is enough for a few thousand draws per frame;
+	// the buffer grows if a single upload needs more
+	const GLsizeiptr s_initialCapacity = 256 * 1024;
+
+	GLuint s_bufferId = 0;
+	GLsizeiptr s_capacity = 0;
+	// Each slot must start at a multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+	GLintptr s_stride = 0;
+	// Where the next upload will be written
+	GLintptr s_cursor = 0;
+	// Where the most recent upload was written
+	GLintptr s_uploadOffset = 0;
+
+	std::vector<eae6320::Graphics::sDrawConstants> s_drawConstants;
+	const uint32_t s_invalidHandle = ~0u;
+	uint32_t s_boundHandle = s_invalidHandle;
+	// False if the constants that have been pushed since Clear() haven't been uploaded
+	// (or if uploading them failed), in which case there is nothing to bind
+	bool s_isUploaded = false;
+	eae6320::Graphics::sUniformRingBufferStats s_stats;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	bool AllocateBuffer( const GLsizeiptr i_capacity );
+}
+
+// Interface
+//==========
+
+bool eae6320::Graphics::UniformRingBuffer::Initialize()
+{
+	// Find out how the slots must be aligned
+	{
+		GLint alignment = 0;
+		glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment );
+		const GLenum errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "OpenGL failed to get the uniform buffer offset alignment: " <<
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) );
+			UserOutput::Print( errorMessage.str() );
+			return false;
+		}
+		if ( alignment < 1 )
+		{
+			alignment = 1;
+		}
+		s_stride = ( ( sizeof( sDrawConstants ) + alignment - 1 ) / alignment ) * alignment;
+	}
+	// Create the buffer
+	{
+		const GLsizei bufferCount = 1;
+		glGenBuffers( bufferCount, &s_bufferId );
+		const GLenum errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "OpenGL failed to get an unused uniform buffer ID: " <<
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) );
+			UserOutput::Print( errorMessage.str() );
+			return false;
+		}
+	}
+	if ( !AllocateBuffer( s_initialCapacity ) )
+	{
+		ShutDown();
+		return false;
+	}
+
+	Clear();
+	return true;
+}
+
+void eae6320::Graphics::UniformRingBuffer::ShutDown()
+{
+	if ( s_bufferId != 0 )
+	{
+		const GLsizei bufferCount = 1;
+		glDeleteBuffers( bufferCount, &s_bufferId );
+		const GLenum errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "OpenGL failed to delete the uniform buffer: " <<
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) );
+			UserOutput::Print( errorMessage.str() );
+		}
+		s_bufferId = 0;
+	}
+	s_capacity = 0;
+	s_cursor = 0;
+	s_drawConstants.clear();
+}
+
+void eae6320::Graphics::UniformRingBuffer::Clear()
+{
+	s_drawConstants.clear();
+	s_boundHandle = s_invalidHandle;
+	s_isUploaded = false;
+	memset( &s_stats, 0, sizeof( s_stats ) );
+}
+
+uint32_t eae6320::Graphics::UniformRingBuffer::Push( const sDrawConstants& i_drawConstants )
+{
+	s_drawConstants.push_back( i_drawConstants );
+	++s_stats.drawConstantsCount;
+	return static_cast<uint32_t>( s_drawConstants.size() - 1 );
+}
+
+void eae6320::Graphics::UniformRingBuffer::Upload()
+{
+	if ( s_drawConstants.empty() )
+	{
+		return;
+	}
+
+	const GLsizeiptr uploadSize = static_cast<GLsizeiptr>( s_drawConstants.size() ) * s_stride;
+	glBindBuffer( GL_UNIFORM_BUFFER, s_bufferId );
+	GLbitfield access = GL_MAP_WRITE_BIT;
+	if ( ( s_cursor + uploadSize ) <= s_capacity )
+	{
+		// Nothing that the GPU could still be reading is written to,
+		// and so there is no need for the driver to synchronize
+		access |= GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+	}
+	else
+	{
+		// Start over at the beginning with a fresh buffer
+		// (the driver keeps the old one alive until the GPU is done with it)
+		if ( uploadSize > s_capacity )
+		{
+			GLsizeiptr capacity = s_capacity;
+			while ( capacity < uploadSize )
+			{
+				capacity *= 2;
+			}
+			if ( !AllocateBuffer( capacity ) )
+			{
+				return;
+			}
+		}
+		access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+		s_cursor = 0;
+		++s_stats.wrapCount;
+	}
+	// If the constants can't be written the cursor isn't advanced
+	// and Bind() doesn't bind anything until the next successful upload
+	s_boundHandle = s_invalidHandle;
+	s_isUploaded = false;
+	void* const mappedMemory = glMapBufferRange( GL_UNIFORM_BUFFER, s_cursor, uploadSize, access );
+	{
+		const GLenum errorCode = glGetError();
+		if ( ( errorCode != GL_NO_ERROR ) || !mappedMemory )
+		{
+			EAE6320_LOG_ERROR( "OpenGL failed to map %lld bytes of the uniform buffer: %s", static_cast<long long>( uploadSize ),
+				( errorCode != GL_NO_ERROR ) ? reinterpret_cast<const char*>( gluErrorString( errorCode ) ) : "No memory was returned" );
+			return;
+		}
+	}
+	{
+		uint8_t* destination = reinterpret_cast<uint8_t*>( mappedMemory );
+		const size_t drawConstantsCount = s_drawConstants.size();
+		for ( size_t i = 0; i < drawConstantsCount; ++i )
+		{
+			memcpy( destination, &s_drawConstants[i], sizeof( sDrawConstants ) );
+			destination += s_stride;
+		}
+	}
+	{
+		// The contents are undefined if the buffer was corrupted while it was mapped
+		// (e.g. because of a display mode change)
+		const GLboolean wasDataCorrupted = !glUnmapBuffer( GL_UNIFORM_BUFFER );
+		const GLenum errorCode = glGetError();
+		if ( ( errorCode != GL_NO_ERROR ) || wasDataCorrupted )
+		{
+			EAE6320_LOG_ERROR( "OpenGL failed to unmap the uniform buffer: %s",
+				( errorCode != GL_NO_ERROR ) ? reinterpret_cast<const char*>( gluErrorString( errorCode ) ) : "The contents were corrupted" );
+			return;
+		}
+	}
+	s_isUploaded = true;
+	s_uploadOffset = s_cursor;
+	s_cursor += uploadSize;
+	++s_stats.uploadCount;
+	s_stats.bytesUploaded += static_cast<unsigned int>( uploadSize );
+}
+
+void eae6320::Graphics::UniformRingBuffer::Bind( const uint32_t i_handle )
+{
+	assert( i_handle < s_drawConstants.size() );
+	if ( i_handle == s_boundHandle )
+	{
+		++s_stats.bindsSkipped;
+		return;
+	}
+	if ( !s_isUploaded )
+	{
+		// The slot was never written
+		return;
+	}
+	glBindBufferRange( GL_UNIFORM_BUFFER, s_bindingPoint, s_bufferId,
+		s_uploadOffset + ( static_cast<GLintptr>( i_handle ) * s_stride ), sizeof( sDrawConstants ) );
+	assert( glGetError() == GL_NO_ERROR );
+	s_boundHandle = i_handle;
+	++s_stats.bindCount;
+}
+
+const eae6320::Graphics::sUniformRingBufferStats& eae6320::Graphics::UniformRingBuffer::GetStats()
+{
+	return s_stats;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool AllocateBuffer( const GLsizeiptr i_capacity )
+	{
+		glBindBuffer( GL_UNIFORM_BUFFER, s_bufferId );
+		// The contents are rewritten every frame
+		glBufferData( GL_UNIFORM_BUFFER, i_capacity, NULL, GL_STREAM_DRAW );
+		const GLenum errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "OpenGL failed to allocate " << i_capacity << " bytes for the uniform buffer: " <<
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) );
+			eae6320::UserOutput::Print( errorMessage.str() );
+			return false;
+		}
+		s_capacity = i_capacity;
+		s_cursor = 0;
+		return true;
+	}
+}
@@ -0,0 +1,84 @@
+/*
+	The uniform ring buffer holds the per-draw constants for a frame.
+
+	Instead of setting a uniform for every draw call
+	the constants for every draw are pushed into CPU memory,
+	uploaded to the GPU all at once,
+	and then each draw call only has to tell the shader which slot to read from.
+
+	On OpenGL the slots are in a uniform buffer that is used as a ring:
+	every upload is written after the previous one (without synchronizing)
+	until the buffer is full, and then the whole buffer is orphaned and writing starts at the beginning again.
+	Direct3D 9 doesn't have constant buffers,
+	and a shader could only be told which slot to read from by setting a register for every draw anyway,
+	and so nothing is batched there: Upload() does nothing,
+	and Bind() sets the slot's float4 registers with one SetVertexShaderConstantF() call
+	that is skipped if the registers already have the same values.
+*/
+
+#ifndef EAE6320_UNIFORMRINGBUFFER_H
+#define EAE6320_UNIFORMRINGBUFFER_H
+
+// Header Files
+//=============
+
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		// This must match the DrawConstants block (GL) and the c0 register (D3D) in vertex.shader.
+		// It is padded to a whole float4 because that's what both std140 and shader registers use
+		struct sDrawConstants
+		{
+			// The position is multiplied by the scale and then the offset is added
+			// (the offset includes the mesh's bias, see Mesh::GetPositionScale() and Mesh::GetPositionBias())
+			float g_position_offset[2];
+			float g_position_scale[2];
+		};
+
+		// Counts since the last UniformRingBuffer::Clear()
+		struct sUniformRingBufferStats
+		{
+			unsigned int drawConstantsCount;
+			// The number of times that constants were copied into the GPU buffer
+			// (these are always 0 on Direct3D, where Bind() sets the registers directly)
+			unsigned int uploadCount;
+			unsigned int bytesUploaded;
+			// The number of calls that made the next draw use different constants
+			// (glBindBufferRange() on OpenGL and SetVertexShaderConstantF() on Direct3D)
+			unsigned int bindCount;
+			unsigned int bindsSkipped;
+			// The number of times that the GPU buffer had to be orphaned because it was full
+			unsigned int wrapCount;
+		};
+
+		namespace UniformRingBuffer
+		{
+			// The uniform block binding point on OpenGL and the first constant register on Direct3D
+			const unsigned int s_bindingPoint = 0;
+
+			bool Initialize();
+			void ShutDown();
+
+			// Starts a new set of draw constants
+			// (any handles from before this call become invalid)
+			void Clear();
+			// Returns the handle to use with Bind()
+			uint32_t Push( const sDrawConstants& i_drawConstants );
+			// Copies everything that has been pushed since Clear() to the GPU
+			// (on Direct3D this does nothing, see above)
+			void Upload();
+			// Makes the next draw call use the given constants
+			void Bind( const uint32_t i_handle );
+
+			const sUniformRingBufferStats& GetStats();
+		}
+	}
+}
+
+#endif	// EAE6320_UNIFORMRINGBUFFER_H
@@ -0,0 +1,156 @@
+// Header Files
+//=============
+
+#include "cFrustum.h"
+
+#include <cmath>
+#include <cstddef>
+#include "cMatrix_transformation.h"
+#include "cVector.h"
+
+#if defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) ) || defined( __SSE2__ )
+	#define EAE6320_CFRUSTUM_SSE2
+	#include <emmintrin.h>
+#endif
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const float s_epsilon = 1.0e-9f;
+}
+
+// Interface
+//==========
+
+bool eae6320::Math::cFrustum::IsSphereVisible( const cVector& i_center, const float i_radius ) const
+{
+	for ( unsigned int i = 0; i < s_planeCount; ++i )
+	{
+		const float distance = ( m_a[i] * i_center.x ) + ( m_b[i] * i_center.y ) + ( m_c[i] * i_center.z ) + m_d[i];
+		if ( distance < -i_radius )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool eae6320::Math::cFrustum::IsBoxVisible( const cVector& i_min, const cVector& i_max ) const
+{
+	for ( unsigned int i = 0; i < s_planeCount; ++i )
+	{
+		// Only the corner that is farthest in the direction of the plane's normal has to be tested
+		const float x = ( m_a[i] >= 0.0f ) ? i_max.x : i_min.x;
+		const float y = ( m_b[i] >= 0.0f ) ? i_max.y : i_min.y;
+		const float z = ( m_c[i] >= 0.0f ) ? i_max.z : i_min.z;
+		if ( ( ( m_a[i] * x ) + ( m_b[i] * y ) + ( m_c[i] * z ) + m_d[i] ) < 0.0f )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+unsigned int eae6320::Math::cFrustum::CullSpheres( const float* i_centersX, const float* i_centersY, const float* i_centersZ,
+	const float* i_radii, const unsigned int i_count, uint8_t* o_areVisible ) const
+{
+	unsigned int visibleCount = 0;
+	unsigned int i = 0;
+#if defined( EAE6320_CFRUSTUM_SSE2 )
+	{
+		__m128 a[s_planeCount], b[s_planeCount], c[s_planeCount], d[s_planeCount];
+		for ( unsigned int j = 0; j < s_planeCount; ++j )
+		{
+			a[j] = _mm_set1_ps( m_a[j] );
+			b[j] = _mm_set1_ps( m_b[j] );
+			c[j] = _mm_set1_ps( m_c[j] );
+			d[j] = _mm_set1_ps( m_d[j] );
+		}
+		const __m128 zero = _mm_setzero_ps();
+		for ( ; ( i + 4 ) <= i_count; i += 4 )
+		{
+			const __m128 x = _mm_loadu_ps( i_centersX + i );
+			const __m128 y = _mm_loadu_ps( i_centersY + i );
+			const __m128 z = i_centersZ ? _mm_loadu_ps( i_centersZ + i ) : zero;
+			const __m128 negativeRadius = _mm_sub_ps( zero, _mm_loadu_ps( i_radii + i ) );
+			__m128 isVisible = _mm_castsi128_ps( _mm_set1_epi32( -1 ) );
+			for ( unsigned int j = 0; j < s_planeCount; ++j )
+			{
+				const __m128 distance = _mm_add_ps(
+					_mm_add_ps( _mm_mul_ps( a[j], x ), _mm_mul_ps( b[j], y ) ),
+					_mm_add_ps( _mm_mul_ps( c[j], z ), d[j] ) );
+				isVisible = _mm_and_ps( isVisible, _mm_cmpge_ps( distance, negativeRadius ) );
+			}
+			const int mask = _mm_movemask_ps( isVisible );
+			for ( unsigned int k = 0; k < 4; ++k )
+			{
+				const uint8_t isThisVisible = static_cast<uint8_t>( ( mask >> k ) & 1 );
+				o_areVisible[i + k] = isThisVisible;
+				visibleCount += isThisVisible;
+			}
+		}
+	}
+#endif
+	// Whatever is left over (or everything, without SSE2) is tested one at a time
+	for ( ; i < i_count; ++i )
+	{
+		const cVector center( i_centersX[i], i_centersY[i], i_centersZ ? i_centersZ[i] : 0.0f );
+		const bool isVisible = IsSphereVisible( center, i_radii[i] );
+		o_areVisible[i] = isVisible ? 1 : 0;
+		visibleCount += isVisible ? 1 : 0;
+	}
+	return visibleCount;
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Math::cFrustum::cFrustum( const cMatrix_transformation& i_worldToScreen )
+{
+	// A position in screen space is the world position (as a row) multiplied by the transform,
+	// and so each screen component is the dot product of the world position with one of the columns.
+	// A plane is the sum or difference of the w column and one of the others
+	const cMatrix_transformation& m = i_worldToScreen;
+	const float column_w[4] = { m.m_03, m.m_13, m.m_23, m.m_33 };
+	const float column_x[4] = { m.m_00, m.m_10, m.m_20, m.m_30 };
+	const float column_y[4] = { m.m_01, m.m_11, m.m_21, m.m_31 };
+	const float column_z[4] = { m.m_02, m.m_12, m.m_22, m.m_32 };
+	float planes[s_planeCount][4];
+	for ( size_t i = 0; i < 4; ++i )
+	{
+		planes[0][i] = column_w[i] + column_x[i];	// Left
+		planes[1][i] = column_w[i] - column_x[i];	// Right
+		planes[2][i] = column_w[i] + column_y[i];	// Bottom
+		planes[3][i] = column_w[i] - column_y[i];	// Top
+#if defined( EAE6320_PLATFORM_D3D )
+		// Direct3D's screen z goes from 0 to w
+		planes[4][i] = column_z[i];	// Near
+#else
+		// OpenGL's screen z goes from -w to w
+		planes[4][i] = column_w[i] + column_z[i];	// Near
+#endif
+		planes[5][i] = column_w[i] - column_z[i];	// Far
+	}
+
+	for ( unsigned int i = 0; i < s_planeCount; ++i )
+	{
+		// Normalizing the planes makes the distances real distances
+		// so that they can be compared with radii
+		const float length = std::sqrt( ( planes[i][0] * planes[i][0] ) + ( planes[i][1] * planes[i][1] ) + ( planes[i][2] * planes[i][2] ) );
+		if ( length > s_epsilon )
+		{
+			m_a[i] = planes[i][0] / length;
+			m_b[i] = planes[i][1] / length;
+			m_c[i] = planes[i][2] / length;
+			m_d[i] = planes[i][3] / length;
+		}
+		else
+		{
+			// A degenerate plane doesn't reject anything
+			m_a[i] = m_b[i] = m_c[i] = 0.0f;
+			m_d[i] = 1.0f;
+		}
+	}
+}
@@ -0,0 +1,74 @@
+/*
+	This class represents the volume that a camera can see,
+	as six planes that are extracted from a world-to-screen transform
+	(i.e. a world-to-view transform concatenated with a view-to-screen transform).
+
+	A point is inside of a plane if ( a * x ) + ( b * y ) + ( c * z ) + d >= 0,
+	and a bounding volume is visible unless it is completely outside of at least one plane
+	(which is conservative: a few volumes near the corners are kept even though they can't be seen).
+*/
+
+#ifndef EAE6320_MATH_CFRUSTUM_H
+#define EAE6320_MATH_CFRUSTUM_H
+
+// Header Files
+//=============
+
+#include <cstdint>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cMatrix_transformation;
+		class cVector;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cFrustum
+		{
+			// Interface
+			//==========
+
+		public:
+
+			static const unsigned int s_planeCount = 6;
+
+			bool IsSphereVisible( const cVector& i_center, const float i_radius ) const;
+			bool IsBoxVisible( const cVector& i_min, const cVector& i_max ) const;
+			// Tests many spheres at once (four at a time when SSE2 is available)
+			// and returns how many are visible.
+			// The centers are stored as separate arrays of components;
+			// i_centersZ can be NULL if every center's z is 0
+			unsigned int CullSpheres( const float* i_centersX, const float* i_centersY, const float* i_centersZ,
+				const float* i_radii, const unsigned int i_count, uint8_t* o_areVisible ) const;
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			explicit cFrustum( const cMatrix_transformation& i_worldToScreen );
+
+			// Data
+			//=====
+
+		private:
+
+			// The planes are stored as separate arrays of components
+			// so that each component can be broadcast to a SIMD register
+			// (the order is left, right, bottom, top, near, far)
+			float m_a[s_planeCount], m_b[s_planeCount], m_c[s_planeCount], m_d[s_planeCount];
+		};
+	}
+}
+
+#endif	// EAE6320_MATH_CFRUSTUM_H
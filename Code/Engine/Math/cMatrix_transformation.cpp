@@ -49,6 +49,33 @@ eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::Cre
 #endif
 }
 
+// Concatenation
+//--------------
+
+eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::operator *( const cMatrix_transformation& i_rhs ) const
+{
+	return cMatrix_transformation(
+		( m_00 * i_rhs.m_00 ) + ( m_01 * i_rhs.m_10 ) + ( m_02 * i_rhs.m_20 ) + ( m_03 * i_rhs.m_30 ),
+		( m_10 * i_rhs.m_00 ) + ( m_11 * i_rhs.m_10 ) + ( m_12 * i_rhs.m_20 ) + ( m_13 * i_rhs.m_30 ),
+		( m_20 * i_rhs.m_00 ) + ( m_21 * i_rhs.m_10 ) + ( m_22 * i_rhs.m_20 ) + ( m_23 * i_rhs.m_30 ),
+		( m_30 * i_rhs.m_00 ) + ( m_31 * i_rhs.m_10 ) + ( m_32 * i_rhs.m_20 ) + ( m_33 * i_rhs.m_30 ),
+
+		( m_00 * i_rhs.m_01 ) + ( m_01 * i_rhs.m_11 ) + ( m_02 * i_rhs.m_21 ) + ( m_03 * i_rhs.m_31 ),
+		( m_10 * i_rhs.m_01 ) + ( m_11 * i_rhs.m_11 ) + ( m_12 * i_rhs.m_21 ) + ( m_13 * i_rhs.m_31 ),
+		( m_20 * i_rhs.m_01 ) + ( m_21 * i_rhs.m_11 ) + ( m_22 * i_rhs.m_21 ) + ( m_23 * i_rhs.m_31 ),
+		( m_30 * i_rhs.m_01 ) + ( m_31 * i_rhs.m_11 ) + ( m_32 * i_rhs.m_21 ) + ( m_33 * i_rhs.m_31 ),
+
+		( m_00 * i_rhs.m_02 ) + ( m_01 * i_rhs.m_12 ) + ( m_02 * i_rhs.m_22 ) + ( m_03 * i_rhs.m_32 ),
+		( m_10 * i_rhs.m_02 ) + ( m_11 * i_rhs.m_12 ) + ( m_12 * i_rhs.m_22 ) + ( m_13 * i_rhs.m_32 ),
+		( m_20 * i_rhs.m_02 ) + ( m_21 * i_rhs.m_12 ) + ( m_22 * i_rhs.m_22 ) + ( m_23 * i_rhs.m_32 ),
+		( m_30 * i_rhs.m_02 ) + ( m_31 * i_rhs.m_12 ) + ( m_32 * i_rhs.m_22 ) + ( m_33 * i_rhs.m_32 ),
+
+		( m_00 * i_rhs.m_03 ) + ( m_01 * i_rhs.m_13 ) + ( m_02 * i_rhs.m_23 ) + ( m_03 * i_rhs.m_33 ),
+		( m_10 * i_rhs.m_03 ) + ( m_11 * i_rhs.m_13 ) + ( m_12 * i_rhs.m_23 ) + ( m_13 * i_rhs.m_33 ),
+		( m_20 * i_rhs.m_03 ) + ( m_21 * i_rhs.m_13 ) + ( m_22 * i_rhs.m_23 ) + ( m_23 * i_rhs.m_33 ),
+		( m_30 * i_rhs.m_03 ) + ( m_31 * i_rhs.m_13 ) + ( m_32 * i_rhs.m_23 ) + ( m_33 * i_rhs.m_33 ) );
+}
+
 // Initialization / Shut Down
 //---------------------------
 
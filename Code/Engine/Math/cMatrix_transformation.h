@@ -52,6 +52,10 @@ namespace eae6320
 				const float i_fieldOfView_y, const float i_aspectRatio,
 				const float i_z_nearPlane, const float i_z_farPlane );
 
+			// Concatenation
+			// (because the vectors are rows, the left transform is applied first)
+			cMatrix_transformation operator *( const cMatrix_transformation& i_rhs ) const;
+
 			// Initialization / Shut Down
 			//---------------------------
 
@@ -82,6 +86,12 @@ namespace eae6320
 				const float i_01, const float i_11, const float i_21, const float i_31,
 				const float i_02, const float i_12, const float i_22, const float i_32,
 				const float i_03, const float i_13, const float i_23, const float i_33 );
+
+			// Friend Classes
+			//===============
+
+			// Frustum planes are extracted directly from a transform's columns
+			friend class cFrustum;
 		};
 	}
 }
@@ -0,0 +1,91 @@
+// Header Files
+//=============
+
+#include "Allocator.h"
+
+#include <mutex>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Allocators can be created by static initializers in any order,
+	// and so the list's head and lock are only created when they're first needed
+	eae6320::Memory::Allocator*& GetListHead();
+	std::mutex& GetListMutex();
+}
+
+// Interface
+//==========
+
+void eae6320::Memory::GetAllocatorStats( std::vector<sAllocatorStats>& o_stats )
+{
+	std::lock_guard<std::mutex> lock( GetListMutex() );
+	for ( const Allocator* allocator = GetListHead(); allocator; allocator = allocator->m_next )
+	{
+		o_stats.push_back( allocator->m_stats );
+	}
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Memory::Allocator::~Allocator()
+{
+	std::lock_guard<std::mutex> lock( GetListMutex() );
+	if ( m_previous )
+	{
+		m_previous->m_next = m_next;
+	}
+	else
+	{
+		GetListHead() = m_next;
+	}
+	if ( m_next )
+	{
+		m_next->m_previous = m_previous;
+	}
+}
+
+// Implementation
+//===============
+
+eae6320::Memory::Allocator::Allocator( const char* i_name )
+	:
+	m_previous( NULL ), m_next( NULL )
+{
+	m_stats.name = i_name;
+	m_stats.capacity = 0;
+	m_stats.bytesInUse = 0;
+	m_stats.highWaterBytes = 0;
+	m_stats.allocationCount = 0;
+	m_stats.systemAllocationCount = 0;
+
+	std::lock_guard<std::mutex> lock( GetListMutex() );
+	Allocator*& head = GetListHead();
+	m_next = head;
+	if ( head )
+	{
+		head->m_previous = this;
+	}
+	head = this;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::Memory::Allocator*& GetListHead()
+	{
+		static eae6320::Memory::Allocator* s_head = NULL;
+		return s_head;
+	}
+
+	std::mutex& GetListMutex()
+	{
+		static std::mutex s_mutex;
+		return s_mutex;
+	}
+}
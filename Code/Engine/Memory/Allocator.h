@@ -0,0 +1,96 @@
+/*
+	Allocator is the base class of every allocator in the Memory module.
+
+	It keeps the statistics that every allocator exposes
+	and links every allocator that exists into a list,
+	so that Memory::GetAllocatorStats() can report all of them at once.
+*/
+
+#ifndef EAE6320_ALLOCATOR_H
+#define EAE6320_ALLOCATOR_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Memory
+	{
+		struct sAllocatorStats
+		{
+			const char* name;
+			// The bytes that the allocator has reserved from the system
+			size_t capacity;
+			size_t bytesInUse;
+			// The most bytes that were ever in use at once
+			size_t highWaterBytes;
+			// Since the allocator was created
+			size_t allocationCount;
+			// The number of times that the allocator itself had to allocate from the system
+			size_t systemAllocationCount;
+		};
+
+		class Allocator
+		{
+			// Interface
+			//==========
+
+		public:
+
+			const sAllocatorStats& GetStats() const { return m_stats; }
+			const char* GetName() const { return m_stats.name; }
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			virtual ~Allocator();
+
+			// Data
+			//=====
+
+		protected:
+
+			sAllocatorStats m_stats;
+
+			// Implementation
+			//===============
+
+		protected:
+
+			void OnAllocated( const size_t i_size )
+			{
+				m_stats.bytesInUse += i_size;
+				++m_stats.allocationCount;
+				if ( m_stats.bytesInUse > m_stats.highWaterBytes )
+				{
+					m_stats.highWaterBytes = m_stats.bytesInUse;
+				}
+			}
+			void OnFreed( const size_t i_size ) { m_stats.bytesInUse -= i_size; }
+
+			explicit Allocator( const char* i_name );
+
+		private:
+
+			// Every allocator is in a doubly-linked list
+			Allocator* m_previous;
+			Allocator* m_next;
+
+			friend void GetAllocatorStats( std::vector<sAllocatorStats>& o_stats );
+
+			Allocator( const Allocator& );
+			Allocator& operator =( const Allocator& );
+		};
+
+		// Appends the stats of every allocator that currently exists
+		void GetAllocatorStats( std::vector<sAllocatorStats>& o_stats );
+	}
+}
+
+#endif	// EAE6320_ALLOCATOR_H
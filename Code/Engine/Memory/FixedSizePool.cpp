@@ -0,0 +1,92 @@
+// Header Files
+//=============
+
+#include "FixedSizePool.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include "../UserOutput/UserOutput.h"
+
+// Interface
+//==========
+
+void* eae6320::Memory::FixedSizePool::Allocate()
+{
+	if ( !m_freeList && !AddChunk() )
+	{
+		return NULL;
+	}
+	sFreeBlock* const block = m_freeList;
+	m_freeList = block->next;
+	OnAllocated( m_blockSize );
+	return block;
+}
+
+void eae6320::Memory::FixedSizePool::Free( void* i_block )
+{
+	if ( i_block )
+	{
+		assert( m_stats.bytesInUse >= m_blockSize );
+		sFreeBlock* const block = static_cast<sFreeBlock*>( i_block );
+		block->next = m_freeList;
+		m_freeList = block;
+		OnFreed( m_blockSize );
+	}
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Memory::FixedSizePool::FixedSizePool( const char* i_name, const size_t i_blockSize, const size_t i_blockAlignment, const size_t i_blocksPerChunk )
+	:
+	Allocator( i_name ), m_freeList( NULL ), m_chunks( NULL ),
+	// Every block must be able to hold a free list pointer,
+	// and every block must start at the requested alignment
+	m_blockSize( ( ( ( ( i_blockSize > sizeof( sFreeBlock ) ) ? i_blockSize : sizeof( sFreeBlock ) ) + ( i_blockAlignment - 1 ) ) / i_blockAlignment ) * i_blockAlignment ),
+	m_blockAlignment( i_blockAlignment ), m_blocksPerChunk( ( i_blocksPerChunk > 0 ) ? i_blocksPerChunk : 1 )
+{
+	assert( ( i_blockAlignment != 0 ) && ( ( i_blockAlignment & ( i_blockAlignment - 1 ) ) == 0 ) );
+}
+
+eae6320::Memory::FixedSizePool::~FixedSizePool()
+{
+	assert( m_stats.bytesInUse == 0 );
+	while ( m_chunks )
+	{
+		sChunk* const previous = m_chunks->previous;
+		free( m_chunks );
+		m_chunks = previous;
+	}
+}
+
+// Implementation
+//===============
+
+bool eae6320::Memory::FixedSizePool::AddChunk()
+{
+	// The blocks start after the chunk header at the first aligned address
+	const size_t headerSize = ( ( sizeof( sChunk ) + ( m_blockAlignment - 1 ) ) / m_blockAlignment ) * m_blockAlignment;
+	const size_t chunkSize = headerSize + ( m_blockSize * m_blocksPerChunk ) + m_blockAlignment;
+	sChunk* const chunk = static_cast<sChunk*>( malloc( chunkSize ) );
+	if ( !chunk )
+	{
+		UserOutput::Print( std::string( "The system is out of memory for the pool " ) + m_stats.name );
+		return false;
+	}
+	chunk->previous = m_chunks;
+	m_chunks = chunk;
+	m_stats.capacity += m_blockSize * m_blocksPerChunk;
+	++m_stats.systemAllocationCount;
+
+	// The blocks are pushed in reverse so that they are handed out in address order
+	const uintptr_t firstBlock = ( reinterpret_cast<uintptr_t>( chunk ) + headerSize + ( m_blockAlignment - 1 ) ) & ~( m_blockAlignment - 1 );
+	for ( size_t i = m_blocksPerChunk; i > 0; --i )
+	{
+		sFreeBlock* const block = reinterpret_cast<sFreeBlock*>( firstBlock + ( ( i - 1 ) * m_blockSize ) );
+		block->next = m_freeList;
+		m_freeList = block;
+	}
+	return true;
+}
@@ -0,0 +1,76 @@
+/*
+	A fixed-size pool hands out blocks that are all the same size.
+
+	Blocks are carved out of chunks that hold many blocks each,
+	and a freed block is pushed onto a free list so that the next allocation can reuse it;
+	both allocating and freeing are O(1) and objects of the same type end up next to each other in memory.
+	Chunks are only returned to the system when the pool is destroyed.
+
+	Pool<tType> (in Pool.h) is a typed wrapper that constructs and destroys the objects.
+	A pool must only be used by one thread at a time.
+*/
+
+#ifndef EAE6320_FIXEDSIZEPOOL_H
+#define EAE6320_FIXEDSIZEPOOL_H
+
+// Header Files
+//=============
+
+#include "Allocator.h"
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Memory
+	{
+		class FixedSizePool : public Allocator
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// This only returns NULL if the system is out of memory
+			void* Allocate();
+			void Free( void* i_block );
+			size_t GetBlockSize() const { return m_blockSize; }
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			FixedSizePool( const char* i_name, const size_t i_blockSize, const size_t i_blockAlignment, const size_t i_blocksPerChunk );
+			~FixedSizePool();
+
+			// Data
+			//=====
+
+		private:
+
+			// A free block stores the next free block in itself
+			struct sFreeBlock
+			{
+				sFreeBlock* next;
+			};
+			struct sChunk
+			{
+				sChunk* previous;
+			};
+			sFreeBlock* m_freeList;
+			sChunk* m_chunks;
+			const size_t m_blockSize;
+			const size_t m_blockAlignment;
+			const size_t m_blocksPerChunk;
+
+			// Implementation
+			//===============
+
+		private:
+
+			bool AddChunk();
+		};
+	}
+}
+
+#endif	// EAE6320_FIXEDSIZEPOOL_H
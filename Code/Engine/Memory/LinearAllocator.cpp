@@ -0,0 +1,100 @@
+// Header Files
+//=============
+
+#include "LinearAllocator.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include "../UserOutput/UserOutput.h"
+
+// Interface
+//==========
+
+void* eae6320::Memory::LinearAllocator::Allocate( const size_t i_size, const size_t i_alignment )
+{
+	assert( ( i_alignment != 0 ) && ( ( i_alignment & ( i_alignment - 1 ) ) == 0 ) );
+
+	uintptr_t address = ( reinterpret_cast<uintptr_t>( m_cursor ) + ( i_alignment - 1 ) ) & ~( i_alignment - 1 );
+	if ( ( address + i_size ) > reinterpret_cast<uintptr_t>( m_end ) )
+	{
+		// The new block is big enough for this allocation even if it needs the most padding
+		const size_t minimumSize = i_size + i_alignment;
+		if ( !AddBlock( ( minimumSize > m_stats.capacity ) ? minimumSize : m_stats.capacity ) )
+		{
+			return NULL;
+		}
+		address = ( reinterpret_cast<uintptr_t>( m_cursor ) + ( i_alignment - 1 ) ) & ~( i_alignment - 1 );
+	}
+	uint8_t* const memory = reinterpret_cast<uint8_t*>( address );
+	OnAllocated( static_cast<size_t>( ( memory + i_size ) - m_cursor ) );
+	m_cursor = memory + i_size;
+	return memory;
+}
+
+void eae6320::Memory::LinearAllocator::Reset()
+{
+	if ( m_block && m_block->previous )
+	{
+		// Everything that was needed since the last reset will fit in a single block from now on
+		const size_t capacity = m_stats.capacity;
+		FreeBlocks();
+		AddBlock( capacity );
+	}
+	if ( m_block )
+	{
+		m_cursor = reinterpret_cast<uint8_t*>( m_block + 1 );
+	}
+	m_stats.bytesInUse = 0;
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Memory::LinearAllocator::LinearAllocator( const char* i_name, const size_t i_capacity )
+	:
+	Allocator( i_name ), m_block( NULL ), m_cursor( NULL ), m_end( NULL )
+{
+	if ( i_capacity > 0 )
+	{
+		AddBlock( i_capacity );
+	}
+}
+
+eae6320::Memory::LinearAllocator::~LinearAllocator()
+{
+	FreeBlocks();
+}
+
+// Implementation
+//===============
+
+bool eae6320::Memory::LinearAllocator::AddBlock( const size_t i_size )
+{
+	sBlock* const block = static_cast<sBlock*>( malloc( sizeof( sBlock ) + i_size ) );
+	if ( !block )
+	{
+		UserOutput::Print( std::string( "The system is out of memory for the allocator " ) + m_stats.name );
+		return false;
+	}
+	block->previous = m_block;
+	block->size = i_size;
+	m_block = block;
+	m_cursor = reinterpret_cast<uint8_t*>( block + 1 );
+	m_end = m_cursor + i_size;
+	m_stats.capacity += i_size;
+	++m_stats.systemAllocationCount;
+	return true;
+}
+
+void eae6320::Memory::LinearAllocator::FreeBlocks()
+{
+	while ( m_block )
+	{
+		sBlock* const previous = m_block->previous;
+		free( m_block );
+		m_block = previous;
+	}
+	m_cursor = m_end = NULL;
+	m_stats.capacity = 0;
+}
@@ -0,0 +1,93 @@
+/*
+	A linear allocator hands out memory by advancing a cursor through a block,
+	and everything that it has handed out is freed at once by Reset().
+
+	It is meant for data that only lives for one frame:
+	Reset() is called at the beginning of every frame,
+	and so allocating is only a pointer bump and freeing costs nothing.
+	If the block runs out another one is allocated from the system,
+	and then the next Reset() replaces all of the blocks with a single one that is big enough for all of them
+	(so that after the first few frames there is only ever a single block).
+*/
+
+#ifndef EAE6320_LINEARALLOCATOR_H
+#define EAE6320_LINEARALLOCATOR_H
+
+// Header Files
+//=============
+
+#include "Allocator.h"
+
+#include <cstdint>
+#include <new>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Memory
+	{
+		class LinearAllocator : public Allocator
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// The alignment must be a power of two.
+			// This only returns NULL if the system is out of memory
+			void* Allocate( const size_t i_size, const size_t i_alignment = s_defaultAlignment );
+			// The constructors of the objects are called but their destructors never are
+			template<typename tType> tType* AllocateArray( const size_t i_count )
+			{
+				void* const memory = Allocate( i_count * sizeof( tType ), __alignof( tType ) );
+				if ( !memory )
+				{
+					return NULL;
+				}
+				tType* const objects = static_cast<tType*>( memory );
+				for ( size_t i = 0; i < i_count; ++i )
+				{
+					new ( objects + i ) tType;
+				}
+				return objects;
+			}
+			// Frees everything at once
+			void Reset();
+
+			static const size_t s_defaultAlignment = 16;
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			LinearAllocator( const char* i_name, const size_t i_capacity );
+			~LinearAllocator();
+
+			// Data
+			//=====
+
+		private:
+
+			// Blocks are chained together from the most recent one
+			struct sBlock
+			{
+				sBlock* previous;
+				size_t size;
+			};
+			sBlock* m_block;
+			uint8_t* m_cursor;
+			uint8_t* m_end;
+
+			// Implementation
+			//===============
+
+		private:
+
+			bool AddBlock( const size_t i_size );
+			void FreeBlocks();
+		};
+	}
+}
+
+#endif	// EAE6320_LINEARALLOCATOR_H
@@ -0,0 +1,30 @@
+// Header Files
+//=============
+
+#include "Memory.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// These are big enough for the current assets;
+	// if they run out the allocators grow (and the high-water stats show by how much)
+	const size_t s_frameAllocatorCapacity = 1024 * 1024;
+	const size_t s_loadAllocatorCapacity = 256 * 1024;
+}
+
+// Interface
+//==========
+
+eae6320::Memory::LinearAllocator& eae6320::Memory::GetFrameAllocator()
+{
+	static LinearAllocator s_frameAllocator( "Frame", s_frameAllocatorCapacity );
+	return s_frameAllocator;
+}
+
+eae6320::Memory::StackAllocator& eae6320::Memory::GetLoadAllocator()
+{
+	thread_local StackAllocator s_loadAllocator( "Load", s_loadAllocatorCapacity );
+	return s_loadAllocator;
+}
@@ -0,0 +1,35 @@
+/*
+	The engine's shared allocators.
+
+	The frame allocator is for data that is only needed until the end of the current frame;
+	the game loop resets it at the beginning of every frame.
+	The load allocator is for temporary memory that is only needed while an asset is loading;
+	every thread has its own, and allocations should be scoped with a StackAllocator::cScopedMarker.
+	Objects that are created and destroyed individually should come from a Pool<tType> instead.
+*/
+
+#ifndef EAE6320_MEMORY_H
+#define EAE6320_MEMORY_H
+
+// Header Files
+//=============
+
+#include "Allocator.h"
+#include "LinearAllocator.h"
+#include "Pool.h"
+#include "StackAllocator.h"
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Memory
+	{
+		// Only the game loop's thread may use the frame allocator
+		LinearAllocator& GetFrameAllocator();
+		StackAllocator& GetLoadAllocator();
+	}
+}
+
+#endif	// EAE6320_MEMORY_H
@@ -0,0 +1,63 @@
+/*
+	A pool of objects of a single type.
+
+	New() and Delete() replace new and delete for types that are created and destroyed often
+	(e.g. the engine's meshes, effects, and renderables):
+	the objects come from a FixedSizePool and so they don't go through the system allocator.
+*/
+
+#ifndef EAE6320_POOL_H
+#define EAE6320_POOL_H
+
+// Header Files
+//=============
+
+#include "FixedSizePool.h"
+
+#include <new>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Memory
+	{
+		template<typename tType>
+		class Pool : public FixedSizePool
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Returns a default-constructed object, or NULL if the system is out of memory
+			tType* New()
+			{
+				void* const memory = Allocate();
+				return memory ? new ( memory ) tType : NULL;
+			}
+			// The object must have come from this pool
+			void Delete( tType* i_object )
+			{
+				if ( i_object )
+				{
+					i_object->~tType();
+					Free( i_object );
+				}
+			}
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			explicit Pool( const char* i_name, const size_t i_objectsPerChunk = 64 )
+				:
+				FixedSizePool( i_name, sizeof( tType ), __alignof( tType ), i_objectsPerChunk )
+			{
+
+			}
+		};
+	}
+}
+
+#endif	// EAE6320_POOL_H
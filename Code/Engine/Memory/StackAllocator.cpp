@@ -0,0 +1,112 @@
+// Header Files
+//=============
+
+#include "StackAllocator.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include "../UserOutput/UserOutput.h"
+
+// Interface
+//==========
+
+void* eae6320::Memory::StackAllocator::Allocate( const size_t i_size, const size_t i_alignment )
+{
+	assert( ( i_alignment != 0 ) && ( ( i_alignment & ( i_alignment - 1 ) ) == 0 ) );
+
+	uintptr_t address = ( reinterpret_cast<uintptr_t>( m_cursor ) + ( i_alignment - 1 ) ) & ~( i_alignment - 1 );
+	if ( !m_block || ( ( address + i_size ) > reinterpret_cast<uintptr_t>( m_end ) ) )
+	{
+		// The first block is sized by the capacity that the allocator was created with,
+		// and any extra blocks are only as big as they need to be
+		const size_t minimumSize = i_size + i_alignment;
+		if ( !AddBlock( ( m_block || ( minimumSize > m_firstBlockSize ) ) ? minimumSize : m_firstBlockSize ) )
+		{
+			return NULL;
+		}
+		address = ( reinterpret_cast<uintptr_t>( m_cursor ) + ( i_alignment - 1 ) ) & ~( i_alignment - 1 );
+	}
+	uint8_t* const memory = reinterpret_cast<uint8_t*>( address );
+	OnAllocated( static_cast<size_t>( ( memory + i_size ) - m_cursor ) );
+	m_cursor = memory + i_size;
+	return memory;
+}
+
+eae6320::Memory::StackAllocator::sMarker eae6320::Memory::StackAllocator::GetMarker() const
+{
+	sMarker marker;
+	{
+		marker.block = m_block;
+		marker.cursor = m_cursor;
+		marker.bytesInUse = m_stats.bytesInUse;
+	}
+	return marker;
+}
+
+void eae6320::Memory::StackAllocator::Rewind( const sMarker& i_marker )
+{
+	// Free any blocks that were added after the marker
+	// (but always keep the first one)
+	while ( m_block && ( m_block != i_marker.block ) && m_block->previous )
+	{
+		sBlock* const previous = m_block->previous;
+		m_stats.capacity -= m_block->size;
+		free( m_block );
+		m_block = previous;
+		m_end = reinterpret_cast<uint8_t*>( m_block + 1 ) + m_block->size;
+	}
+	if ( m_block == i_marker.block )
+	{
+		m_cursor = i_marker.cursor;
+	}
+	else if ( m_block )
+	{
+		// The marker was gotten before the first block existed
+		m_cursor = reinterpret_cast<uint8_t*>( m_block + 1 );
+	}
+	m_stats.bytesInUse = i_marker.bytesInUse;
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Memory::StackAllocator::StackAllocator( const char* i_name, const size_t i_capacity )
+	:
+	Allocator( i_name ), m_block( NULL ), m_cursor( NULL ), m_end( NULL ), m_firstBlockSize( i_capacity )
+{
+	// The first block isn't allocated until it is needed
+	// (most threads never load anything)
+}
+
+eae6320::Memory::StackAllocator::~StackAllocator()
+{
+	assert( m_stats.bytesInUse == 0 );
+	while ( m_block )
+	{
+		sBlock* const previous = m_block->previous;
+		free( m_block );
+		m_block = previous;
+	}
+}
+
+// Implementation
+//===============
+
+bool eae6320::Memory::StackAllocator::AddBlock( const size_t i_size )
+{
+	sBlock* const block = static_cast<sBlock*>( malloc( sizeof( sBlock ) + i_size ) );
+	if ( !block )
+	{
+		UserOutput::Print( std::string( "The system is out of memory for the allocator " ) + m_stats.name );
+		return false;
+	}
+	m_stats.capacity += i_size;
+	block->previous = m_block;
+	block->size = i_size;
+	m_block = block;
+	m_cursor = reinterpret_cast<uint8_t*>( block + 1 );
+	m_end = m_cursor + i_size;
+	++m_stats.systemAllocationCount;
+	return true;
+}
@@ -0,0 +1,102 @@
+/*
+	A stack allocator hands out memory by advancing a cursor like a linear allocator,
+	but it can be rewound to any earlier point instead of only being reset.
+
+	It is meant for temporary memory that is needed while something is loading
+	(e.g. the contents of a file that are only needed until they have been copied somewhere else):
+	a cScopedMarker remembers where the stack was when it was created
+	and rewinds it back there when it goes out of scope,
+	and so everything that was allocated in the scope is freed at once.
+	If the first block runs out another one is allocated from the system,
+	and it is freed again when the stack is rewound past it.
+
+	A stack allocator must only be used by one thread at a time
+	(Memory::GetLoadAllocator() returns a separate one for every thread).
+*/
+
+#ifndef EAE6320_STACKALLOCATOR_H
+#define EAE6320_STACKALLOCATOR_H
+
+// Header Files
+//=============
+
+#include "Allocator.h"
+
+#include <cstdint>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Memory
+	{
+		class StackAllocator : public Allocator
+		{
+			// Interface
+			//==========
+
+		public:
+
+			struct sMarker
+			{
+				void* block;
+				uint8_t* cursor;
+				size_t bytesInUse;
+			};
+
+			// Rewinds the stack when it goes out of scope
+			class cScopedMarker
+			{
+			public:
+				explicit cScopedMarker( StackAllocator& io_allocator ) : m_allocator( io_allocator ), m_marker( io_allocator.GetMarker() ) {}
+				~cScopedMarker() { m_allocator.Rewind( m_marker ); }
+			private:
+				StackAllocator& m_allocator;
+				const sMarker m_marker;
+
+				cScopedMarker( const cScopedMarker& );
+				cScopedMarker& operator =( const cScopedMarker& );
+			};
+
+			// The alignment must be a power of two.
+			// This only returns NULL if the system is out of memory
+			void* Allocate( const size_t i_size, const size_t i_alignment = s_defaultAlignment );
+			sMarker GetMarker() const;
+			// Frees everything that was allocated after the marker was gotten
+			void Rewind( const sMarker& i_marker );
+
+			static const size_t s_defaultAlignment = 16;
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			StackAllocator( const char* i_name, const size_t i_capacity );
+			~StackAllocator();
+
+			// Data
+			//=====
+
+		private:
+
+			struct sBlock
+			{
+				sBlock* previous;
+				size_t size;
+			};
+			sBlock* m_block;
+			uint8_t* m_cursor;
+			uint8_t* m_end;
+			const size_t m_firstBlockSize;
+
+			// Implementation
+			//===============
+
+		private:
+
+			bool AddBlock( const size_t i_size );
+		};
+	}
+}
+
+#endif	// EAE6320_STACKALLOCATOR_H
@@ -0,0 +1,267 @@
+// Header Files
+//=============
+
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// The mean isn't meaningful until there have been a few frames
+	// (and the first frames are usually slow because of loading)
+	const size_t s_minFrameCountForHitches = 10;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Sorts the values
+	void CalculateDistribution( std::vector<float>& io_milliseconds, eae6320::Time::cFrameStats::sDistribution& o_distribution );
+	void WriteDistribution( std::ostream& io_file, const eae6320::Time::cFrameStats::sDistribution& i_distribution );
+}
+
+// Interface
+//==========
+
+const char* eae6320::Time::cFrameStats::GetPhaseName( const ePhase i_phase )
+{
+	switch ( i_phase )
+	{
+	case Phase_update: return "update";
+	case Phase_submit: return "submit";
+	case Phase_present: return "present";
+	default: return "?";
+	}
+}
+
+// Frames
+//-------
+
+void eae6320::Time::cFrameStats::BeginFrame()
+{
+	const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+	if ( m_isFrameInProgress )
+	{
+		EndFrame( time );
+	}
+	memset( &m_currentFrame, 0, sizeof( m_currentFrame ) );
+	m_frameStartTime = m_phaseStartTime = time;
+	m_isFrameInProgress = true;
+}
+
+void eae6320::Time::cFrameStats::EndPhase( const ePhase i_phase )
+{
+	if ( !m_isFrameInProgress )
+	{
+		return;
+	}
+	const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+	m_currentFrame.phaseMilliseconds[i_phase] += std::chrono::duration<float, std::milli>( time - m_phaseStartTime ).count();
+	m_phaseStartTime = time;
+}
+
+void eae6320::Time::cFrameStats::Reset()
+{
+	m_nextFrameIndex = 0;
+	m_frameCount = 0;
+	m_frameMillisecondsSum = 0.0;
+	m_totalFrameCount = 0;
+	m_totalHitchCount = 0;
+	m_isFrameInProgress = false;
+}
+
+// Statistics
+//-----------
+
+bool eae6320::Time::cFrameStats::GetSummary( sSummary& o_summary ) const
+{
+	if ( m_frameCount == 0 )
+	{
+		return false;
+	}
+	o_summary.frameCount = m_frameCount;
+	o_summary.hitchCount = 0;
+	o_summary.totalFrameCount = m_totalFrameCount;
+	o_summary.totalHitchCount = m_totalHitchCount;
+	std::vector<float> milliseconds( m_frameCount );
+	for ( size_t i = 0; i < m_frameCount; ++i )
+	{
+		milliseconds[i] = m_frames[i].milliseconds;
+		if ( m_frames[i].isHitch )
+		{
+			++o_summary.hitchCount;
+		}
+	}
+	CalculateDistribution( milliseconds, o_summary.frame );
+	for ( int phase = 0; phase < Phase_count; ++phase )
+	{
+		for ( size_t i = 0; i < m_frameCount; ++i )
+		{
+			milliseconds[i] = m_frames[i].phaseMilliseconds[phase];
+		}
+		CalculateDistribution( milliseconds, o_summary.phases[phase] );
+	}
+	return true;
+}
+
+double eae6320::Time::cFrameStats::GetMeanFrameTime() const
+{
+	return ( m_frameCount > 0 ) ? ( m_frameMillisecondsSum / static_cast<double>( m_frameCount ) ) : 0.0;
+}
+
+bool eae6320::Time::cFrameStats::WriteCsv( const char* i_path, std::string* o_errorMessage ) const
+{
+	std::ofstream file( i_path, std::ios::out | std::ios::trunc );
+	if ( !file )
+	{
+		if ( o_errorMessage )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Failed to open \"" << i_path << "\" to write the frame statistics";
+			*o_errorMessage = errorMessage.str();
+		}
+		return false;
+	}
+	file << "frame,milliseconds";
+	for ( int phase = 0; phase < Phase_count; ++phase )
+	{
+		file << "," << GetPhaseName( static_cast<ePhase>( phase ) ) << "Milliseconds";
+	}
+	file << ",isHitch\n";
+	// The first frame that is kept is numbered by how many frames there have been before it
+	const uint64_t firstFrameNumber = m_totalFrameCount - m_frameCount;
+	for ( size_t i = 0; i < m_frameCount; ++i )
+	{
+		const sFrame& frame = GetFrame( i );
+		file << ( firstFrameNumber + i ) << "," << frame.milliseconds;
+		for ( int phase = 0; phase < Phase_count; ++phase )
+		{
+			file << "," << frame.phaseMilliseconds[phase];
+		}
+		file << "," << ( frame.isHitch ? 1 : 0 ) << "\n";
+	}
+	return static_cast<bool>( file );
+}
+
+bool eae6320::Time::cFrameStats::WriteJson( const char* i_path, std::string* o_errorMessage ) const
+{
+	std::ofstream file( i_path, std::ios::out | std::ios::trunc );
+	if ( !file )
+	{
+		if ( o_errorMessage )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Failed to open \"" << i_path << "\" to write the frame statistics";
+			*o_errorMessage = errorMessage.str();
+		}
+		return false;
+	}
+	sSummary summary;
+	if ( !GetSummary( summary ) )
+	{
+		memset( &summary, 0, sizeof( summary ) );
+	}
+	file << "{\n";
+	file << "\t\"frameCount\": " << summary.frameCount << ",\n";
+	file << "\t\"hitchCount\": " << summary.hitchCount << ",\n";
+	file << "\t\"totalFrameCount\": " << summary.totalFrameCount << ",\n";
+	file << "\t\"totalHitchCount\": " << summary.totalHitchCount << ",\n";
+	file << "\t\"hitchMultiple\": " << m_hitchMultiple << ",\n";
+	file << "\t\"frameMilliseconds\": ";
+	WriteDistribution( file, summary.frame );
+	file << ",\n\t\"phaseMilliseconds\": {\n";
+	for ( int phase = 0; phase < Phase_count; ++phase )
+	{
+		file << "\t\t\"" << GetPhaseName( static_cast<ePhase>( phase ) ) << "\": ";
+		WriteDistribution( file, summary.phases[phase] );
+		file << ( ( ( phase + 1 ) < Phase_count ) ? ",\n" : "\n" );
+	}
+	file << "\t}\n}\n";
+	return static_cast<bool>( file );
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Time::cFrameStats::cFrameStats( const size_t i_maxFrameCount, const float i_hitchMultiple )
+	:
+	m_frames( std::max<size_t>( i_maxFrameCount, 1 ) ), m_hitchMultiple( i_hitchMultiple )
+{
+	Reset();
+}
+
+// Implementation
+//===============
+
+void eae6320::Time::cFrameStats::EndFrame( const std::chrono::steady_clock::time_point i_time )
+{
+	m_currentFrame.milliseconds = std::chrono::duration<float, std::milli>( i_time - m_frameStartTime ).count();
+	// The frame is compared with the frames before it (and so it doesn't raise the mean that it's compared with)
+	m_currentFrame.isHitch = ( m_frameCount >= s_minFrameCountForHitches ) &&
+		( m_currentFrame.milliseconds > ( m_hitchMultiple * GetMeanFrameTime() ) );
+	if ( m_currentFrame.isHitch )
+	{
+		++m_totalHitchCount;
+	}
+	if ( m_frameCount == m_frames.size() )
+	{
+		m_frameMillisecondsSum -= m_frames[m_nextFrameIndex].milliseconds;
+	}
+	else
+	{
+		++m_frameCount;
+	}
+	m_frames[m_nextFrameIndex] = m_currentFrame;
+	m_frameMillisecondsSum += m_currentFrame.milliseconds;
+	m_nextFrameIndex = ( m_nextFrameIndex + 1 ) % m_frames.size();
+	++m_totalFrameCount;
+}
+
+const eae6320::Time::cFrameStats::sFrame& eae6320::Time::cFrameStats::GetFrame( const size_t i_index ) const
+{
+	// Until the ring is full the oldest frame is the first one
+	const size_t oldestIndex = ( m_frameCount == m_frames.size() ) ? m_nextFrameIndex : 0;
+	return m_frames[( oldestIndex + i_index ) % m_frames.size()];
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void CalculateDistribution( std::vector<float>& io_milliseconds, eae6320::Time::cFrameStats::sDistribution& o_distribution )
+	{
+		std::sort( io_milliseconds.begin(), io_milliseconds.end() );
+		double sum = 0.0;
+		for ( std::vector<float>::const_iterator i = io_milliseconds.begin(); i != io_milliseconds.end(); ++i )
+		{
+			sum += *i;
+		}
+		const size_t count = io_milliseconds.size();
+		o_distribution.mean = sum / static_cast<double>( count );
+		// The nearest rank (the smallest value that the percentage of values are less than or equal to)
+		const double percentiles[] = { 50.0, 95.0, 99.0 };
+		double* const results[] = { &o_distribution.p50, &o_distribution.p95, &o_distribution.p99 };
+		for ( size_t i = 0; i < ( sizeof( percentiles ) / sizeof( percentiles[0] ) ); ++i )
+		{
+			const size_t rank = static_cast<size_t>( std::ceil( ( percentiles[i] / 100.0 ) * static_cast<double>( count ) ) );
+			*results[i] = io_milliseconds[std::max<size_t>( rank, 1 ) - 1];
+		}
+		o_distribution.max = io_milliseconds.back();
+	}
+
+	void WriteDistribution( std::ostream& io_file, const eae6320::Time::cFrameStats::sDistribution& i_distribution )
+	{
+		io_file << "{ \"mean\": " << i_distribution.mean << ", \"p50\": " << i_distribution.p50 << ", \"p95\": " << i_distribution.p95
+			<< ", \"p99\": " << i_distribution.p99 << ", \"max\": " << i_distribution.max << " }";
+	}
+}
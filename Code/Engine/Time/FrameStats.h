@@ -0,0 +1,142 @@
+/*
+	This class keeps the duration of the most recent frames (and of the phases of each frame)
+	so that a run can be judged by its worst frames and not only by its average.
+
+	Every frame is timed from one BeginFrame() to the next with the real clock
+	(even if Time is being given fixed frame times, see Time::OnNewFrame( const float )),
+	and the phases are timed from one phase's end to the next.
+
+	A frame is counted as a hitch if it takes more than a multiple of the average of the frames before it,
+	and so a single slow frame stands out even if the average doesn't change much.
+
+	The statistics can be exported at any time:
+	the CSV has a row for every frame that is kept, and the JSON has the summary.
+*/
+
+#ifndef EAE6320_TIME_FRAMESTATS_H
+#define EAE6320_TIME_FRAMESTATS_H
+
+// Header Files
+//=============
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Time
+	{
+		class cFrameStats
+		{
+			// Interface
+			//==========
+
+		public:
+
+			enum ePhase
+			{
+				// Everything before the render queue is built (input, simulation, loading)
+				Phase_update,
+				// Building the render queue and drawing it
+				// (or handing it to the render thread)
+				Phase_submit,
+				// Graphics::Present()
+				// (or, with the render thread, waiting for it to finish with a frame)
+				Phase_present,
+
+				Phase_count
+			};
+			static const char* GetPhaseName( const ePhase i_phase );
+
+			struct sDistribution
+			{
+				// All of these are in milliseconds
+				double mean;
+				double p50, p95, p99;
+				double max;
+			};
+			struct sSummary
+			{
+				// The frames that the distributions are from (the most recent ones that are kept)
+				size_t frameCount;
+				size_t hitchCount;
+				sDistribution frame;
+				sDistribution phases[Phase_count];
+				// Since the statistics were created or reset
+				uint64_t totalFrameCount;
+				uint64_t totalHitchCount;
+			};
+
+			// Frames
+			//-------
+
+			// Ends the previous frame (if there was one) and starts a new one
+			void BeginFrame();
+			// The time since the previous phase ended (or since the frame began) is added to the phase
+			void EndPhase( const ePhase i_phase );
+			void Reset();
+
+			// Statistics
+			//-----------
+
+			// Returns false if no frames have ended yet
+			bool GetSummary( sSummary& o_summary ) const;
+			// Milliseconds for the rolling mean of the frames that are kept
+			double GetMeanFrameTime() const;
+
+			bool WriteCsv( const char* i_path, std::string* o_errorMessage = NULL ) const;
+			bool WriteJson( const char* i_path, std::string* o_errorMessage = NULL ) const;
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			// A frame is a hitch if it is longer than the hitch multiple times the mean of the frames before it
+			cFrameStats( const size_t i_maxFrameCount = 4096, const float i_hitchMultiple = 2.0f );
+
+			// Data
+			//=====
+
+		private:
+
+			struct sFrame
+			{
+				float milliseconds;
+				float phaseMilliseconds[Phase_count];
+				bool isHitch;
+			};
+
+			// The most recent frames, which are overwritten in a ring
+			std::vector<sFrame> m_frames;
+			size_t m_nextFrameIndex;
+			size_t m_frameCount;
+			// So that the mean doesn't have to be recalculated every frame
+			double m_frameMillisecondsSum;
+			uint64_t m_totalFrameCount;
+			uint64_t m_totalHitchCount;
+			const float m_hitchMultiple;
+
+			// The frame that is in progress
+			sFrame m_currentFrame;
+			std::chrono::steady_clock::time_point m_frameStartTime;
+			std::chrono::steady_clock::time_point m_phaseStartTime;
+			bool m_isFrameInProgress;
+
+			// Implementation
+			//===============
+
+		private:
+
+			void EndFrame( const std::chrono::steady_clock::time_point i_time );
+			// The frames in the order that they happened
+			const sFrame& GetFrame( const size_t i_index ) const;
+		};
+	}
+}
+
+#endif	// EAE6320_TIME_FRAMESTATS_H
@@ -18,6 +18,12 @@ namespace
 	LARGE_INTEGER s_totalCountsElapsed_atInitializion = { 0 };
 	LARGE_INTEGER s_totalCountsElapsed_duringRun = { 0 };
 	LARGE_INTEGER s_totalCountsElapsed_previousFrame = { 0 };
+
+	// When the time is advanced by a given amount these are used instead of the counter
+	// (the frame's time is stored exactly as it was given so that it is the same on every machine)
+	bool s_isTimeFixed = false;
+	float s_fixedSecondsElapsed_thisFrame = 0.0f;
+	double s_fixedSecondsElapsed_total = 0.0;
 }
 
 // Helper Function Declarations
@@ -41,6 +47,10 @@ float eae6320::Time::GetTotalSecondsElapsed()
 		assert( result );
 	}
 
+	if ( s_isTimeFixed )
+	{
+		return static_cast<float>( s_fixedSecondsElapsed_total );
+	}
 	return static_cast<float>( static_cast<double>( s_totalCountsElapsed_duringRun.QuadPart ) * s_secondsPerCount );
 }
 
@@ -51,6 +61,10 @@ float eae6320::Time::GetSecondsElapsedThisFrame()
 		assert( result );
 	}
 
+	if ( s_isTimeFixed )
+	{
+		return s_fixedSecondsElapsed_thisFrame;
+	}
 	return static_cast<float>(
 		static_cast<double>( s_totalCountsElapsed_duringRun.QuadPart - s_totalCountsElapsed_previousFrame.QuadPart )
 		* s_secondsPerCount );
@@ -74,6 +88,14 @@ void eae6320::Time::OnNewFrame()
 		assert( result != FALSE );
 		s_totalCountsElapsed_duringRun.QuadPart = totalCountsElapsed.QuadPart - s_totalCountsElapsed_atInitializion.QuadPart;
 	}
+	s_isTimeFixed = false;
+}
+
+void eae6320::Time::OnNewFrame( const float i_secondsElapsed )
+{
+	s_isTimeFixed = true;
+	s_fixedSecondsElapsed_thisFrame = i_secondsElapsed;
+	s_fixedSecondsElapsed_total += i_secondsElapsed;
 }
 
 // Initialization / Shut Down
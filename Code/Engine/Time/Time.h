@@ -24,6 +24,10 @@ namespace eae6320
 		float GetSecondsElapsedThisFrame();
 
 		void OnNewFrame();
+		// Advances the time by exactly the given amount instead of by how much real time has passed
+		// (e.g. to replay recorded frames with the same timestep that they were recorded with).
+		// A program should only use one of the two versions of OnNewFrame()
+		void OnNewFrame( const float i_secondsElapsed );
 
 		// Initialization / Shut Down
 		//---------------------------
@@ -0,0 +1,257 @@
+// Header Files
+//=============
+
+#include "InputRecording.h"
+
+#include <cstring>
+#include <sstream>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const char s_fileSignature[4] = { 'E', 'A', 'I', 'R' };
+	const uint32_t s_fileVersion = 1;
+
+	// Every bitset word and every mouse value is a separate field,
+	// and each one has a bit in a frame's mask
+	const unsigned int s_bitsetFieldCount = eae6320::UserInput::sSnapshot::s_wordCount * 3;
+	const unsigned int s_fieldCount = s_bitsetFieldCount + 4;
+	typedef uint16_t tFieldMask;
+	static_assert( s_fieldCount <= ( sizeof( tFieldMask ) * 8 ), "Every field of a snapshot needs a bit in the mask" );
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	uint8_t* GetField( eae6320::UserInput::sSnapshot& i_snapshot, const unsigned int i_fieldIndex, size_t& o_size );
+}
+
+// Interface
+//==========
+
+// cInputRecorder
+//---------------
+
+bool eae6320::UserInput::cInputRecorder::Start( const char* i_path, std::string* o_errorMessage )
+{
+	Stop();
+	m_file.open( i_path, std::ios::out | std::ios::binary | std::ios::trunc );
+	if ( !m_file )
+	{
+		if ( o_errorMessage )
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Failed to open \"" << i_path << "\" to record input";
+			*o_errorMessage = errorMessage.str();
+		}
+		m_file.close();
+		return false;
+	}
+	m_file.write( s_fileSignature, sizeof( s_fileSignature ) );
+	m_file.write( reinterpret_cast<const char*>( &s_fileVersion ), sizeof( s_fileVersion ) );
+	memset( &m_previousSnapshot, 0, sizeof( m_previousSnapshot ) );
+	m_frameCount = 0;
+	return static_cast<bool>( m_file );
+}
+
+bool eae6320::UserInput::cInputRecorder::RecordFrame( const sSnapshot& i_snapshot, const float i_secondsElapsed )
+{
+	if ( !m_file.is_open() )
+	{
+		return false;
+	}
+	// Each field is compared with the previous frame's
+	// and only the ones that changed are written after the mask
+	uint8_t record[sizeof( tFieldMask ) + sizeof( float ) + sizeof( sSnapshot )];
+	size_t recordSize = sizeof( tFieldMask );
+	memcpy( record + recordSize, &i_secondsElapsed, sizeof( float ) );
+	recordSize += sizeof( float );
+	tFieldMask changedFields = 0;
+	{
+		sSnapshot snapshot = i_snapshot;
+		for ( unsigned int i = 0; i < s_fieldCount; ++i )
+		{
+			size_t fieldSize;
+			const uint8_t* const field = GetField( snapshot, i, fieldSize );
+			const uint8_t* const previousField = GetField( m_previousSnapshot, i, fieldSize );
+			if ( memcmp( field, previousField, fieldSize ) != 0 )
+			{
+				changedFields |= static_cast<tFieldMask>( 1u << i );
+				memcpy( record + recordSize, field, fieldSize );
+				recordSize += fieldSize;
+			}
+		}
+	}
+	memcpy( record, &changedFields, sizeof( changedFields ) );
+	m_file.write( reinterpret_cast<const char*>( record ), recordSize );
+	m_previousSnapshot = i_snapshot;
+	++m_frameCount;
+	return static_cast<bool>( m_file );
+}
+
+bool eae6320::UserInput::cInputRecorder::Stop( std::string* o_errorMessage )
+{
+	if ( !m_file.is_open() )
+	{
+		return true;
+	}
+	m_file.close();
+	if ( !m_file )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = "Failed to write the input recording";
+		}
+		m_file.clear();
+		return false;
+	}
+	return true;
+}
+
+// cInputReplayer
+//---------------
+
+bool eae6320::UserInput::cInputReplayer::Load( const char* i_path, std::string* o_errorMessage )
+{
+	m_data.clear();
+	m_position = 0;
+	memset( &m_previousSnapshot, 0, sizeof( m_previousSnapshot ) );
+	m_frameIndex = 0;
+	m_hasFailed = false;
+
+	std::stringstream errorMessage;
+	{
+		std::ifstream file( i_path, std::ios::in | std::ios::binary | std::ios::ate );
+		if ( !file )
+		{
+			errorMessage << "Failed to open the input recording \"" << i_path << "\"";
+			goto OnError;
+		}
+		const std::streamoff fileSize = file.tellg();
+		file.seekg( 0, std::ios::beg );
+		m_data.resize( static_cast<size_t>( fileSize ) );
+		if ( !m_data.empty() && !file.read( reinterpret_cast<char*>( &m_data[0] ), fileSize ) )
+		{
+			errorMessage << "Failed to read the input recording \"" << i_path << "\"";
+			goto OnError;
+		}
+	}
+	{
+		const size_t headerSize = sizeof( s_fileSignature ) + sizeof( s_fileVersion );
+		uint32_t version;
+		if ( ( m_data.size() < headerSize ) || ( memcmp( &m_data[0], s_fileSignature, sizeof( s_fileSignature ) ) != 0 ) )
+		{
+			errorMessage << "\"" << i_path << "\" isn't an input recording";
+			goto OnError;
+		}
+		memcpy( &version, &m_data[sizeof( s_fileSignature )], sizeof( version ) );
+		if ( version != s_fileVersion )
+		{
+			errorMessage << "The input recording \"" << i_path << "\" is version " << version << " (only version " << s_fileVersion << " can be replayed)";
+			goto OnError;
+		}
+		m_position = headerSize;
+	}
+	return true;
+
+OnError:
+
+	if ( o_errorMessage )
+	{
+		*o_errorMessage = errorMessage.str();
+	}
+	m_data.clear();
+	m_position = 0;
+	m_hasFailed = true;
+	return false;
+}
+
+bool eae6320::UserInput::cInputReplayer::ReadFrame( sSnapshot& o_snapshot, float& o_secondsElapsed )
+{
+	if ( m_hasFailed || IsFinished() )
+	{
+		return false;
+	}
+	const uint8_t* const end = &m_data[0] + m_data.size();
+	const uint8_t* data = &m_data[m_position];
+	tFieldMask changedFields;
+	if ( static_cast<size_t>( end - data ) < ( sizeof( changedFields ) + sizeof( o_secondsElapsed ) ) )
+	{
+		m_hasFailed = true;
+		return false;
+	}
+	memcpy( &changedFields, data, sizeof( changedFields ) );
+	data += sizeof( changedFields );
+	memcpy( &o_secondsElapsed, data, sizeof( o_secondsElapsed ) );
+	data += sizeof( o_secondsElapsed );
+	sSnapshot snapshot = m_previousSnapshot;
+	for ( unsigned int i = 0; i < s_fieldCount; ++i )
+	{
+		if ( ( changedFields & ( 1u << i ) ) != 0 )
+		{
+			size_t fieldSize;
+			uint8_t* const field = GetField( snapshot, i, fieldSize );
+			if ( static_cast<size_t>( end - data ) < fieldSize )
+			{
+				m_hasFailed = true;
+				return false;
+			}
+			memcpy( field, data, fieldSize );
+			data += fieldSize;
+		}
+	}
+	m_position = static_cast<size_t>( data - &m_data[0] );
+	m_previousSnapshot = snapshot;
+	o_snapshot = snapshot;
+	++m_frameIndex;
+	return true;
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::UserInput::cInputRecorder::cInputRecorder()
+	:
+	m_frameCount( 0 )
+{
+	memset( &m_previousSnapshot, 0, sizeof( m_previousSnapshot ) );
+}
+
+eae6320::UserInput::cInputRecorder::~cInputRecorder()
+{
+	Stop();
+}
+
+eae6320::UserInput::cInputReplayer::cInputReplayer()
+	:
+	m_position( 0 ), m_frameIndex( 0 ), m_hasFailed( false )
+{
+	memset( &m_previousSnapshot, 0, sizeof( m_previousSnapshot ) );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	uint8_t* GetField( eae6320::UserInput::sSnapshot& i_snapshot, const unsigned int i_fieldIndex, size_t& o_size )
+	{
+		const unsigned int wordCount = eae6320::UserInput::sSnapshot::s_wordCount;
+		if ( i_fieldIndex < s_bitsetFieldCount )
+		{
+			uint64_t* const bitsets[] = { i_snapshot.keysDown, i_snapshot.keysPressed, i_snapshot.keysReleased };
+			o_size = sizeof( uint64_t );
+			return reinterpret_cast<uint8_t*>( &bitsets[i_fieldIndex / wordCount][i_fieldIndex % wordCount] );
+		}
+		else
+		{
+			int32_t* const values[] = { &i_snapshot.mouseX, &i_snapshot.mouseY, &i_snapshot.mouseDeltaX, &i_snapshot.mouseDeltaY };
+			o_size = sizeof( int32_t );
+			return reinterpret_cast<uint8_t*>( values[i_fieldIndex - s_bitsetFieldCount] );
+		}
+	}
+}
@@ -0,0 +1,112 @@
+/*
+	These classes record the input snapshot and the frame time of every frame to a file
+	and read them back so that a run of the game can be replayed exactly.
+
+	Replaying a recording gives the simulation the same input and the same timestep on every frame
+	(see UserInput::OnNewFrame( const sSnapshot& ) and Time::OnNewFrame( const float )),
+	and so it ends up in the same state no matter how fast the frames are actually run.
+
+	The file is a header followed by one record per frame.
+	Each record is a mask of which fields of the snapshot changed since the previous frame,
+	the frame's seconds elapsed, and then only the fields that changed
+	(a frame where nothing changed is 6 bytes).
+*/
+
+#ifndef EAE6320_USERINPUT_INPUTRECORDING_H
+#define EAE6320_USERINPUT_INPUTRECORDING_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "UserInput.h"
+
+// Class Declarations
+//===================
+
+namespace eae6320
+{
+	namespace UserInput
+	{
+		class cInputRecorder
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Any existing file is replaced
+			bool Start( const char* i_path, std::string* o_errorMessage = NULL );
+			bool RecordFrame( const sSnapshot& i_snapshot, const float i_secondsElapsed );
+			bool Stop( std::string* o_errorMessage = NULL );
+
+			bool IsRecording() const { return m_file.is_open(); }
+			uint32_t GetFrameCount() const { return m_frameCount; }
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			cInputRecorder();
+			~cInputRecorder();
+
+			// Data
+			//=====
+
+		private:
+
+			std::ofstream m_file;
+			// Each frame only records what is different from this
+			sSnapshot m_previousSnapshot;
+			uint32_t m_frameCount;
+
+			// Implementation
+			//===============
+
+		private:
+
+			cInputRecorder( const cInputRecorder& );
+			cInputRecorder& operator =( const cInputRecorder& );
+		};
+
+		class cInputReplayer
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// The whole file is read at once so that replaying doesn't wait for the disk
+			bool Load( const char* i_path, std::string* o_errorMessage = NULL );
+			// Returns false once every frame has been read
+			// (or if the rest of the file is corrupt, in which case HasFailed() is true)
+			bool ReadFrame( sSnapshot& o_snapshot, float& o_secondsElapsed );
+
+			uint32_t GetFrameIndex() const { return m_frameIndex; }
+			bool IsFinished() const { return m_position >= m_data.size(); }
+			bool HasFailed() const { return m_hasFailed; }
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			cInputReplayer();
+
+			// Data
+			//=====
+
+		private:
+
+			std::vector<uint8_t> m_data;
+			size_t m_position;
+			sSnapshot m_previousSnapshot;
+			uint32_t m_frameIndex;
+			bool m_hasFailed;
+		};
+	}
+}
+
+#endif	// EAE6320_USERINPUT_INPUTRECORDING_H
@@ -3,27 +3,131 @@
 
 #include "UserInput.h"
 
-#include "../Windows/Includes.h"
+#include <cstring>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// The snapshot that every query during the current frame reads
+	eae6320::UserInput::sSnapshot s_snapshot;
+	// The events since the last snapshot are accumulated here
+	// (keysDown is always up to date, and the edges and movement are cleared every frame)
+	eae6320::UserInput::sSnapshot s_pendingSnapshot;
+	bool s_hasMousePosition = false;
+}
 
 // Helper Function Declarations
 //=============================
 
 namespace
 {
-	bool IsVirtualKeyPressed( const int i_virtualKeyCode );
+	bool IsBitSet( const uint64_t* const i_bits, const int i_virtualKeyCode );
+	void SetBit( uint64_t* const io_bits, const int i_virtualKeyCode, const bool i_isSet );
 }
 
 // Interface
 //==========
 
+// Queries
+//--------
+
 bool eae6320::UserInput::IsKeyPressed( const int i_virtualKeyCode )
 {
-	return IsVirtualKeyPressed( i_virtualKeyCode );
+	return IsBitSet( s_snapshot.keysDown, i_virtualKeyCode );
 }
 
 bool eae6320::UserInput::IsMouseButtonPressed( const int i_virtualButtonCode )
 {
-	return IsVirtualKeyPressed( i_virtualButtonCode );
+	return IsBitSet( s_snapshot.keysDown, i_virtualButtonCode );
+}
+
+bool eae6320::UserInput::WasKeyPressedThisFrame( const int i_virtualKeyCode )
+{
+	return IsBitSet( s_snapshot.keysPressed, i_virtualKeyCode );
+}
+
+bool eae6320::UserInput::WasKeyReleasedThisFrame( const int i_virtualKeyCode )
+{
+	return IsBitSet( s_snapshot.keysReleased, i_virtualKeyCode );
+}
+
+void eae6320::UserInput::GetMousePosition( int& o_x, int& o_y )
+{
+	o_x = s_snapshot.mouseX;
+	o_y = s_snapshot.mouseY;
+}
+
+void eae6320::UserInput::GetMouseDelta( int& o_deltaX, int& o_deltaY )
+{
+	o_deltaX = s_snapshot.mouseDeltaX;
+	o_deltaY = s_snapshot.mouseDeltaY;
+}
+
+const eae6320::UserInput::sSnapshot& eae6320::UserInput::GetSnapshot()
+{
+	return s_snapshot;
+}
+
+// Frames
+//-------
+
+void eae6320::UserInput::OnNewFrame()
+{
+	s_snapshot = s_pendingSnapshot;
+	memset( s_pendingSnapshot.keysPressed, 0, sizeof( s_pendingSnapshot.keysPressed ) );
+	memset( s_pendingSnapshot.keysReleased, 0, sizeof( s_pendingSnapshot.keysReleased ) );
+	s_pendingSnapshot.mouseDeltaX = s_pendingSnapshot.mouseDeltaY = 0;
+}
+
+void eae6320::UserInput::OnNewFrame( const sSnapshot& i_snapshot )
+{
+	s_snapshot = i_snapshot;
+	// Which keys are actually down is still tracked
+	// so that the events are correct again if the snapshots stop being given
+	memset( s_pendingSnapshot.keysPressed, 0, sizeof( s_pendingSnapshot.keysPressed ) );
+	memset( s_pendingSnapshot.keysReleased, 0, sizeof( s_pendingSnapshot.keysReleased ) );
+	s_pendingSnapshot.mouseDeltaX = s_pendingSnapshot.mouseDeltaY = 0;
+}
+
+// Events
+//-------
+
+void eae6320::UserInput::SubmitKeyEvent( const int i_virtualKeyCode, const bool i_isDown )
+{
+	if ( ( i_virtualKeyCode < 0 ) || ( i_virtualKeyCode >= s_keyCodeCount ) )
+	{
+		return;
+	}
+	if ( IsBitSet( s_pendingSnapshot.keysDown, i_virtualKeyCode ) != i_isDown )
+	{
+		SetBit( s_pendingSnapshot.keysDown, i_virtualKeyCode, i_isDown );
+		SetBit( i_isDown ? s_pendingSnapshot.keysPressed : s_pendingSnapshot.keysReleased, i_virtualKeyCode, true );
+	}
+}
+
+void eae6320::UserInput::SubmitMouseMoveEvent( const int i_x, const int i_y )
+{
+	if ( s_hasMousePosition )
+	{
+		s_pendingSnapshot.mouseDeltaX += i_x - s_pendingSnapshot.mouseX;
+		s_pendingSnapshot.mouseDeltaY += i_y - s_pendingSnapshot.mouseY;
+	}
+	s_pendingSnapshot.mouseX = i_x;
+	s_pendingSnapshot.mouseY = i_y;
+	s_hasMousePosition = true;
+}
+
+void eae6320::UserInput::ReleaseAllKeys()
+{
+	for ( int i = 0; i < sSnapshot::s_wordCount; ++i )
+	{
+		s_pendingSnapshot.keysReleased[i] |= s_pendingSnapshot.keysDown[i];
+		s_pendingSnapshot.keysDown[i] = 0;
+	}
+	// The mouse might be somewhere else when the window gets focus again
+	s_hasMousePosition = false;
 }
 
 // Helper Function Definitions
@@ -31,10 +135,25 @@ bool eae6320::UserInput::IsMouseButtonPressed( const int i_virtualButtonCode )
 
 namespace
 {
-	bool IsVirtualKeyPressed( const int i_virtualKeyCode )
+	bool IsBitSet( const uint64_t* const i_bits, const int i_virtualKeyCode )
+	{
+		if ( ( i_virtualKeyCode < 0 ) || ( i_virtualKeyCode >= eae6320::UserInput::s_keyCodeCount ) )
+		{
+			return false;
+		}
+		return ( i_bits[i_virtualKeyCode >> 6] & ( uint64_t( 1 ) << ( i_virtualKeyCode & 63 ) ) ) != 0;
+	}
+
+	void SetBit( uint64_t* const io_bits, const int i_virtualKeyCode, const bool i_isSet )
 	{
-		short keyState = GetAsyncKeyState( i_virtualKeyCode );
-		const short isKeyDownMask = ~1;
-		return ( keyState & isKeyDownMask ) != 0;
+		const uint64_t mask = uint64_t( 1 ) << ( i_virtualKeyCode & 63 );
+		if ( i_isSet )
+		{
+			io_bits[i_virtualKeyCode >> 6] |= mask;
+		}
+		else
+		{
+			io_bits[i_virtualKeyCode >> 6] &= ~mask;
+		}
 	}
 }
@@ -1,10 +1,27 @@
 /*
 	This file manages user input from the keyboard or mouse
+
+	Input isn't read from the system when it is queried.
+	Instead the platform submits every key and mouse event as it happens,
+	and OnNewFrame() turns the events since the previous frame into a snapshot.
+	Every query during a frame reads that snapshot,
+	and so a frame always sees the same input no matter when it asks
+	and presses that are shorter than a frame are never missed.
+
+	Because nothing here depends on the platform
+	events can also be submitted by something other than Windows
+	(e.g. a tool or a test that runs without a window).
+	Events must be submitted on the same thread that calls OnNewFrame().
 */
 
 #ifndef EAE6320_USERINPUT_H
 #define EAE6320_USERINPUT_H
 
+// Header Files
+//=============
+
+#include <cstdint>
+
 // Interface
 //==========
 
@@ -19,8 +36,61 @@ namespace eae6320
 		// For standard letter or number keys, the representative ascii char can be used:
 		// IsKeyPressed( 'A' ) or IsKeyPressed( '6' )
 
+		// Mouse buttons use the same codes (e.g. VK_LBUTTON),
+		// and so they are stored with the keys
+		const int s_keyCodeCount = 256;
+
+		// Everything that happened during a single frame
+		struct sSnapshot
+		{
+			// One bit per key code
+			static const int s_wordCount = s_keyCodeCount / 64;
+			// Whether each key was down at the end of the frame
+			uint64_t keysDown[s_wordCount];
+			// Whether each key went down or up at any time during the frame
+			// (a key that was tapped quickly has both without being down)
+			uint64_t keysPressed[s_wordCount];
+			uint64_t keysReleased[s_wordCount];
+			// In the window's client area at the end of the frame
+			int32_t mouseX, mouseY;
+			// How far the mouse moved during the frame
+			int32_t mouseDeltaX, mouseDeltaY;
+		};
+
+		// Queries
+		//--------
+
+		// Whether the key is down in this frame's snapshot
 		bool IsKeyPressed( const int i_virtualKeyCode );
 		bool IsMouseButtonPressed( const int i_virtualButtonCode );
+		// Whether the key went down (or up) at any time since the previous frame
+		bool WasKeyPressedThisFrame( const int i_virtualKeyCode );
+		bool WasKeyReleasedThisFrame( const int i_virtualKeyCode );
+		void GetMousePosition( int& o_x, int& o_y );
+		void GetMouseDelta( int& o_deltaX, int& o_deltaY );
+
+		const sSnapshot& GetSnapshot();
+
+		// Frames
+		//-------
+
+		// Makes a new snapshot from the events that were submitted since the last time this was called
+		void OnNewFrame();
+		// Uses the given snapshot instead (e.g. one that was recorded, see InputRecording.h)
+		// and ignores any events that were submitted during the previous frame
+		void OnNewFrame( const sSnapshot& i_snapshot );
+
+		// Events
+		//-------
+
+		// Repeated key downs while a key is held are ignored
+		void SubmitKeyEvent( const int i_virtualKeyCode, const bool i_isDown );
+		// The position is in the window's client area
+		// (the first position that is submitted doesn't cause any movement)
+		void SubmitMouseMoveEvent( const int i_x, const int i_y );
+		// This should be called when the window loses focus
+		// (otherwise any keys that were down would stay down because their key ups go to a different window)
+		void ReleaseAllKeys();
 	}
 }
 
@@ -0,0 +1,481 @@
+// Header Files
+//=============
+
+#include "Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../Windows/Includes.h"
+
+// Static Data Initialization
+//===========================
+
+const char* const eae6320::UserOutput::Log::Implementation::sStringArgument::s_nullString = "(null)";
+
+namespace
+{
+	// Each thread's buffer must be a power of two
+	const size_t s_threadBufferSize = 64 * 1024;
+	// A message can't use more than this much of a buffer
+	const size_t s_maxMessageSize = s_threadBufferSize / 4;
+	// Formatted messages that are longer than this are cut off
+	const size_t s_maxFormattedSize = 1024;
+	// The writer wakes up this often even if nothing asks it to
+	// (errors, flushes, and buffers that are more than half full wake it up immediately)
+	const unsigned int s_writeIntervalMilliseconds = 10;
+	const size_t s_cacheLineSize = 64;
+
+	// Every message in a buffer starts with this
+	struct sMessageHeader
+	{
+		// The size of the header and the arguments,
+		// rounded up so that the next header is aligned
+		uint32_t size;
+		uint32_t severity;
+		std::chrono::steady_clock::rep time;
+		const char* format;
+		// This is NULL if the rest of the buffer is unused
+		// (a message is never split between the end of the buffer and its beginning)
+		eae6320::UserOutput::Log::Implementation::tFormatFunction formatFunction;
+	};
+
+	// Only the thread that owns a buffer writes messages to it,
+	// and only the writer thread reads them
+	// (the positions only ever increase and are wrapped when the buffer is indexed)
+	struct sThreadBuffer
+	{
+		std::atomic<uint64_t> writePosition;
+		uint8_t padding0[s_cacheLineSize - sizeof( std::atomic<uint64_t> )];
+		std::atomic<uint64_t> readPosition;
+		uint8_t padding1[s_cacheLineSize - sizeof( std::atomic<uint64_t> )];
+		std::atomic<uint64_t> droppedMessageCount;
+		// These are only used by the owning thread:
+		// The read position the last time it was loaded (so that it isn't loaded for every message)
+		uint64_t knownReadPosition;
+		// Where the message that is being written ends
+		uint64_t pendingWritePosition;
+		// Whether the writer has been woken up since the buffer became half full
+		bool hasRequestedWrite;
+		// The messages themselves (uint64_t keeps the headers aligned)
+		uint64_t data[s_threadBufferSize / sizeof( uint64_t )];
+
+		sThreadBuffer() : writePosition( 0 ), readPosition( 0 ), droppedMessageCount( 0 ), knownReadPosition( 0 ), pendingWritePosition( 0 ),
+			hasRequestedWrite( false ) {}
+		uint8_t* GetData( const uint64_t i_position )
+		{
+			return reinterpret_cast<uint8_t*>( data ) + ( i_position & ( s_threadBufferSize - 1 ) );
+		}
+	};
+
+	// A message that the writer has read but not written yet
+	struct sPendingMessage
+	{
+		const sMessageHeader* header;
+		// Messages from different threads are written in the order they were logged
+		bool operator <( const sPendingMessage& i_other ) const { return header->time < i_other.header->time; }
+	};
+
+	std::atomic<bool> s_isInitialized( false );
+	// Every Initialize() makes a new generation,
+	// and a thread gets a new buffer if its buffer is from an older one
+	std::atomic<unsigned int> s_generation( 0 );
+	std::chrono::steady_clock::time_point s_startTime;
+	FILE* s_logFile = NULL;
+
+	std::mutex s_threadBuffersMutex;
+	std::vector<sThreadBuffer*> s_threadBuffers;
+	thread_local sThreadBuffer* s_threadBuffer = NULL;
+	thread_local unsigned int s_threadBufferGeneration = 0;
+	// Messages that are logged when the log isn't initialized are built here and written immediately
+	thread_local std::vector<uint64_t> s_unbufferedMessage;
+	thread_local bool s_isMessageUnbuffered = false;
+	thread_local bool s_isPendingMessageAnError = false;
+
+	std::thread s_writerThread;
+	std::mutex s_writerMutex;
+	std::condition_variable s_writerCondition;
+	// Protected by the mutex
+	bool s_shouldWriterExit = false;
+	bool s_isWriteRequested = false;
+	uint64_t s_flushRequestCount = 0;
+	uint64_t s_flushCompletedCount = 0;
+
+	// Only the writer thread uses these
+	std::atomic<uint64_t> s_messagesWritten( 0 );
+	uint64_t s_reportedDroppedMessageCount = 0;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	sThreadBuffer* GetThreadBuffer();
+	// Appends a formatted line (with the time and the severity) to the output
+	void AppendFormattedMessage( const sMessageHeader& i_header, std::string& io_output );
+	void WriteOutput( const std::string& i_output );
+
+	void WriterThread();
+	// Writes every message that has been logged so far
+	void WritePendingMessages();
+}
+
+// Interface
+//==========
+
+bool eae6320::UserOutput::Log::Initialize( const char* i_path_logFile )
+{
+	if ( s_isInitialized )
+	{
+		return false;
+	}
+	bool wereThereErrors = false;
+	s_startTime = std::chrono::steady_clock::now();
+	if ( i_path_logFile )
+	{
+		if ( fopen_s( &s_logFile, i_path_logFile, "w" ) != 0 )
+		{
+			s_logFile = NULL;
+			// The log still works without the file
+			wereThereErrors = true;
+		}
+	}
+	s_shouldWriterExit = false;
+	s_isWriteRequested = false;
+	s_flushRequestCount = s_flushCompletedCount = 0;
+	s_messagesWritten = 0;
+	s_reportedDroppedMessageCount = 0;
+	++s_generation;
+	s_writerThread = std::thread( WriterThread );
+	s_isInitialized = true;
+	if ( wereThereErrors )
+	{
+		EAE6320_LOG_WARNING( "The log file \"%s\" couldn't be opened, and so the log is only written to the debugger", i_path_logFile );
+	}
+	return !wereThereErrors;
+}
+
+bool eae6320::UserOutput::Log::ShutDown()
+{
+	if ( !s_isInitialized )
+	{
+		return true;
+	}
+	// Anything that is logged after this is written immediately
+	s_isInitialized = false;
+	{
+		std::lock_guard<std::mutex> lock( s_writerMutex );
+		s_shouldWriterExit = true;
+	}
+	s_writerCondition.notify_all();
+	s_writerThread.join();
+	bool wereThereErrors = false;
+	if ( s_logFile )
+	{
+		wereThereErrors = fclose( s_logFile ) != 0;
+		s_logFile = NULL;
+	}
+	{
+		std::lock_guard<std::mutex> lock( s_threadBuffersMutex );
+		for ( std::vector<sThreadBuffer*>::iterator i = s_threadBuffers.begin(); i != s_threadBuffers.end(); ++i )
+		{
+			delete *i;
+		}
+		s_threadBuffers.clear();
+	}
+	return !wereThereErrors;
+}
+
+void eae6320::UserOutput::Log::Flush()
+{
+	if ( !s_isInitialized )
+	{
+		return;
+	}
+	std::unique_lock<std::mutex> lock( s_writerMutex );
+	const uint64_t flushCount = ++s_flushRequestCount;
+	s_writerCondition.notify_all();
+	while ( s_flushCompletedCount < flushCount )
+	{
+		s_writerCondition.wait( lock );
+	}
+}
+
+eae6320::UserOutput::Log::sStats eae6320::UserOutput::Log::GetStats()
+{
+	sStats stats;
+	stats.messagesWritten = s_messagesWritten;
+	stats.messagesDropped = 0;
+	std::lock_guard<std::mutex> lock( s_threadBuffersMutex );
+	for ( std::vector<sThreadBuffer*>::const_iterator i = s_threadBuffers.begin(); i != s_threadBuffers.end(); ++i )
+	{
+		stats.messagesDropped += ( *i )->droppedMessageCount.load( std::memory_order_relaxed );
+	}
+	return stats;
+}
+
+// Implementation
+//===============
+
+uint8_t* eae6320::UserOutput::Log::Implementation::BeginMessage( const eSeverity i_severity, const char* const i_format,
+	const tFormatFunction i_formatFunction, const size_t i_argumentsSize )
+{
+	const size_t headerAlignment = sizeof( uint64_t );
+	const size_t messageSize = ( sizeof( sMessageHeader ) + i_argumentsSize + ( headerAlignment - 1 ) ) & ~( headerAlignment - 1 );
+	sMessageHeader* header;
+	sThreadBuffer* const buffer = GetThreadBuffer();
+	if ( buffer )
+	{
+		if ( messageSize > s_maxMessageSize )
+		{
+			buffer->droppedMessageCount.fetch_add( 1, std::memory_order_relaxed );
+			return NULL;
+		}
+		// If the message doesn't fit before the end of the buffer it starts at the beginning
+		uint64_t position = buffer->writePosition.load( std::memory_order_relaxed );
+		const size_t sizeBeforeEnd = s_threadBufferSize - static_cast<size_t>( position & ( s_threadBufferSize - 1 ) );
+		const size_t skippedSize = ( sizeBeforeEnd < messageSize ) ? sizeBeforeEnd : 0;
+		if ( ( position + skippedSize + messageSize - buffer->knownReadPosition ) > s_threadBufferSize )
+		{
+			buffer->knownReadPosition = buffer->readPosition.load( std::memory_order_acquire );
+			if ( ( position + skippedSize + messageSize - buffer->knownReadPosition ) > s_threadBufferSize )
+			{
+				buffer->droppedMessageCount.fetch_add( 1, std::memory_order_relaxed );
+				return NULL;
+			}
+		}
+		if ( skippedSize > 0 )
+		{
+			// The writer skips the end of the buffer if there isn't room for a header there
+			if ( skippedSize >= sizeof( sMessageHeader ) )
+			{
+				sMessageHeader* const unusedHeader = reinterpret_cast<sMessageHeader*>( buffer->GetData( position ) );
+				unusedHeader->size = static_cast<uint32_t>( skippedSize );
+				unusedHeader->formatFunction = NULL;
+			}
+			position += skippedSize;
+		}
+		header = reinterpret_cast<sMessageHeader*>( buffer->GetData( position ) );
+		buffer->pendingWritePosition = position + messageSize;
+		s_isPendingMessageAnError = i_severity >= Severity_error;
+	}
+	else
+	{
+		s_unbufferedMessage.resize( messageSize / sizeof( uint64_t ) );
+		header = reinterpret_cast<sMessageHeader*>( &s_unbufferedMessage[0] );
+		s_isMessageUnbuffered = true;
+	}
+	header->size = static_cast<uint32_t>( messageSize );
+	header->severity = static_cast<uint32_t>( i_severity );
+	header->time = std::chrono::steady_clock::now().time_since_epoch().count();
+	header->format = i_format;
+	header->formatFunction = i_formatFunction;
+	return reinterpret_cast<uint8_t*>( header + 1 );
+}
+
+void eae6320::UserOutput::Log::Implementation::EndMessage()
+{
+	if ( !s_isMessageUnbuffered )
+	{
+		sThreadBuffer& buffer = *s_threadBuffer;
+		buffer.writePosition.store( buffer.pendingWritePosition, std::memory_order_release );
+		// Errors are written right away,
+		// and a buffer that is filling up is emptied before it starts dropping messages
+		// (other messages wait until the writer wakes up on its own)
+		bool shouldWakeWriter = s_isPendingMessageAnError;
+		if ( ( buffer.pendingWritePosition - buffer.knownReadPosition ) > ( s_threadBufferSize / 2 ) )
+		{
+			buffer.knownReadPosition = buffer.readPosition.load( std::memory_order_acquire );
+			if ( ( buffer.pendingWritePosition - buffer.knownReadPosition ) > ( s_threadBufferSize / 2 ) )
+			{
+				shouldWakeWriter = shouldWakeWriter || !buffer.hasRequestedWrite;
+				buffer.hasRequestedWrite = true;
+			}
+			else
+			{
+				buffer.hasRequestedWrite = false;
+			}
+		}
+		if ( shouldWakeWriter )
+		{
+			{
+				std::lock_guard<std::mutex> lock( s_writerMutex );
+				s_isWriteRequested = true;
+			}
+			s_writerCondition.notify_all();
+		}
+	}
+	else
+	{
+		s_isMessageUnbuffered = false;
+		std::string output;
+		AppendFormattedMessage( *reinterpret_cast<const sMessageHeader*>( &s_unbufferedMessage[0] ), output );
+		WriteOutput( output );
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	sThreadBuffer* GetThreadBuffer()
+	{
+		if ( !s_isInitialized.load( std::memory_order_acquire ) )
+		{
+			return NULL;
+		}
+		const unsigned int generation = s_generation.load( std::memory_order_relaxed );
+		if ( s_threadBufferGeneration != generation )
+		{
+			// This only happens the first time a thread logs a message
+			sThreadBuffer* const buffer = new sThreadBuffer;
+			{
+				std::lock_guard<std::mutex> lock( s_threadBuffersMutex );
+				s_threadBuffers.push_back( buffer );
+			}
+			s_threadBuffer = buffer;
+			s_threadBufferGeneration = generation;
+		}
+		return s_threadBuffer;
+	}
+
+	void AppendFormattedMessage( const sMessageHeader& i_header, std::string& io_output )
+	{
+		const char* const severityNames[] = { "Verbose", "Info", "Warning", "Error" };
+		const double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::time_point( std::chrono::steady_clock::duration( i_header.time ) ) - s_startTime ).count();
+		char prefix[64];
+		snprintf( prefix, sizeof( prefix ), "[%10.4f] %s: ", seconds,
+			( i_header.severity < ( sizeof( severityNames ) / sizeof( severityNames[0] ) ) ) ? severityNames[i_header.severity] : "?" );
+		io_output += prefix;
+		char formatted[s_maxFormattedSize];
+		const int formattedLength = i_header.formatFunction( i_header.format, reinterpret_cast<const uint8_t*>( &i_header + 1 ),
+			formatted, sizeof( formatted ) );
+		if ( formattedLength >= 0 )
+		{
+			io_output.append( formatted, std::min( static_cast<size_t>( formattedLength ), sizeof( formatted ) - 1 ) );
+		}
+		else
+		{
+			io_output += "(the message couldn't be formatted)";
+		}
+		io_output += '\n';
+	}
+
+	void WriteOutput( const std::string& i_output )
+	{
+		OutputDebugString( i_output.c_str() );
+		if ( s_logFile )
+		{
+			fwrite( i_output.data(), 1, i_output.size(), s_logFile );
+			fflush( s_logFile );
+		}
+	}
+
+	void WriterThread()
+	{
+		for ( ;; )
+		{
+			bool shouldExit;
+			uint64_t flushCount;
+			{
+				std::unique_lock<std::mutex> lock( s_writerMutex );
+				const std::chrono::steady_clock::time_point wakeTime =
+					std::chrono::steady_clock::now() + std::chrono::milliseconds( s_writeIntervalMilliseconds );
+				while ( !s_shouldWriterExit && !s_isWriteRequested && ( s_flushCompletedCount == s_flushRequestCount ) )
+				{
+					if ( s_writerCondition.wait_until( lock, wakeTime ) == std::cv_status::timeout )
+					{
+						break;
+					}
+				}
+				shouldExit = s_shouldWriterExit;
+				flushCount = s_flushRequestCount;
+				s_isWriteRequested = false;
+			}
+			WritePendingMessages();
+			{
+				std::lock_guard<std::mutex> lock( s_writerMutex );
+				s_flushCompletedCount = flushCount;
+			}
+			s_writerCondition.notify_all();
+			if ( shouldExit )
+			{
+				break;
+			}
+		}
+	}
+
+	void WritePendingMessages()
+	{
+		// Threads that start logging while this is running are written next time
+		std::vector<sThreadBuffer*> threadBuffers;
+		{
+			std::lock_guard<std::mutex> lock( s_threadBuffersMutex );
+			threadBuffers = s_threadBuffers;
+		}
+
+		// Find every message that has been logged
+		std::vector<sPendingMessage> messages;
+		std::vector<uint64_t> endPositions( threadBuffers.size() );
+		uint64_t droppedMessageCount = 0;
+		for ( size_t i = 0; i < threadBuffers.size(); ++i )
+		{
+			sThreadBuffer& buffer = *threadBuffers[i];
+			const uint64_t endPosition = buffer.writePosition.load( std::memory_order_acquire );
+			uint64_t position = buffer.readPosition.load( std::memory_order_relaxed );
+			while ( position < endPosition )
+			{
+				const size_t sizeBeforeEnd = s_threadBufferSize - static_cast<size_t>( position & ( s_threadBufferSize - 1 ) );
+				if ( sizeBeforeEnd < sizeof( sMessageHeader ) )
+				{
+					position += sizeBeforeEnd;
+					continue;
+				}
+				const sMessageHeader* const header = reinterpret_cast<const sMessageHeader*>( buffer.GetData( position ) );
+				if ( header->formatFunction )
+				{
+					sPendingMessage message;
+					message.header = header;
+					messages.push_back( message );
+				}
+				position += header->size;
+			}
+			endPositions[i] = endPosition;
+			droppedMessageCount += buffer.droppedMessageCount.load( std::memory_order_relaxed );
+		}
+
+		// Write them
+		std::stable_sort( messages.begin(), messages.end() );
+		std::string output;
+		for ( std::vector<sPendingMessage>::const_iterator i = messages.begin(); i != messages.end(); ++i )
+		{
+			AppendFormattedMessage( *i->header, output );
+		}
+		if ( droppedMessageCount != s_reportedDroppedMessageCount )
+		{
+			char message[128];
+			snprintf( message, sizeof( message ), "(%llu messages were dropped because a thread logged faster than the log could write)\n",
+				static_cast<unsigned long long>( droppedMessageCount - s_reportedDroppedMessageCount ) );
+			output += message;
+			s_reportedDroppedMessageCount = droppedMessageCount;
+		}
+		if ( !output.empty() )
+		{
+			WriteOutput( output );
+		}
+		s_messagesWritten.fetch_add( messages.size(), std::memory_order_relaxed );
+
+		// The space can only be reused once the messages have been formatted
+		for ( size_t i = 0; i < threadBuffers.size(); ++i )
+		{
+			threadBuffers[i]->readPosition.store( endPositions[i], std::memory_order_release );
+		}
+	}
+}
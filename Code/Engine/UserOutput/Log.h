@@ -0,0 +1,273 @@
+/*
+	The log records messages with a severity without making the thread that logs them wait for any output.
+
+	Logging a message only copies a pointer to its format string and its arguments
+	into a lock-free ring buffer that belongs to the calling thread.
+	A background thread formats the messages (with the same rules as printf()),
+	sorts them by the time they were logged,
+	and writes them to the debugger's output and (optionally) to a file.
+	If a thread's buffer is full its messages are dropped instead of waiting,
+	and the log reports how many were dropped.
+
+	Messages are logged with the macros at the bottom of this file.
+	Severities below EAE6320_LOG_MINSEVERITY are compiled out entirely
+	(by default that is verbose messages in release builds).
+
+	Before Initialize() and after ShutDown() messages are formatted and written immediately
+	so that nothing is lost.
+*/
+
+#ifndef EAE6320_USEROUTPUT_LOG_H
+#define EAE6320_USEROUTPUT_LOG_H
+
+// Header Files
+//=============
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Compile-Time Filtering
+//=======================
+
+// 0 is verbose, 1 is info, 2 is warning, and 3 is error
+#ifndef EAE6320_LOG_MINSEVERITY
+	#ifdef _DEBUG
+		#define EAE6320_LOG_MINSEVERITY 0
+	#else
+		#define EAE6320_LOG_MINSEVERITY 1
+	#endif
+#endif
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace UserOutput
+	{
+		namespace Log
+		{
+			// These match the values of EAE6320_LOG_MINSEVERITY
+			enum eSeverity
+			{
+				Severity_verbose = 0,
+				Severity_info = 1,
+				Severity_warning = 2,
+				Severity_error = 3,
+			};
+
+			struct sStats
+			{
+				uint64_t messagesWritten;
+				// Messages that were logged when their thread's buffer was full
+				uint64_t messagesDropped;
+			};
+
+			// If there is a path the messages are also written to that file (replacing whatever was in it)
+			bool Initialize( const char* i_path_logFile = NULL );
+			// Every message that has been logged is written before this returns.
+			// No other thread can be logging while the log shuts down
+			bool ShutDown();
+
+			// Returns once every message that was logged before it was called has been written
+			void Flush();
+			sStats GetStats();
+
+			// The format must be a string literal (or some other string that is never freed)
+			// because only a pointer to it is kept until the message is formatted.
+			// Arguments can be numbers, pointers, or strings (C strings and std::strings are copied).
+			// Use the macros below instead of calling this directly
+			template<typename... tArguments>
+			void Write( const eSeverity i_severity, const char* const i_format, const tArguments&... i_arguments );
+		}
+	}
+}
+
+// Implementation
+//===============
+
+namespace eae6320
+{
+	namespace UserOutput
+	{
+		namespace Log
+		{
+			namespace Implementation
+			{
+				// Formats a message from the bytes that its arguments were copied into
+				typedef int ( *tFormatFunction )( const char* const i_format, const uint8_t* i_arguments, char* o_buffer, const size_t i_bufferSize );
+
+				// Returns where the arguments should be copied to,
+				// or NULL if the message must be dropped (in which case EndMessage() isn't called).
+				// The message isn't visible to the background thread until EndMessage() is called
+				uint8_t* BeginMessage( const eSeverity i_severity, const char* const i_format, const tFormatFunction i_formatFunction,
+					const size_t i_argumentsSize );
+				void EndMessage();
+
+				// Numbers and pointers are copied as they are
+				template<typename tArgument>
+				struct sArgument
+				{
+					static_assert( std::is_arithmetic<tArgument>::value || std::is_enum<tArgument>::value || std::is_pointer<tArgument>::value,
+						"Only numbers, pointers, and strings can be logged" );
+					typedef tArgument tValue;
+
+					static size_t GetSize( const tArgument& )
+					{
+						return sizeof( tArgument );
+					}
+					static uint8_t* Encode( const tArgument& i_argument, uint8_t* o_data )
+					{
+						memcpy( o_data, &i_argument, sizeof( tArgument ) );
+						return o_data + sizeof( tArgument );
+					}
+					static tValue Decode( const uint8_t*& io_data )
+					{
+						tArgument argument;
+						memcpy( &argument, io_data, sizeof( tArgument ) );
+						io_data += sizeof( tArgument );
+						return argument;
+					}
+				};
+				// Strings are copied with their NULL terminator
+				// (the caller's string might not exist anymore when the message is formatted)
+				struct sStringArgument
+				{
+					typedef const char* tValue;
+
+					static size_t GetSize( const char* const i_string )
+					{
+						return ( i_string ? strlen( i_string ) : strlen( s_nullString ) ) + 1;
+					}
+					static uint8_t* Encode( const char* const i_string, uint8_t* o_data )
+					{
+						const size_t size = GetSize( i_string );
+						memcpy( o_data, i_string ? i_string : s_nullString, size );
+						return o_data + size;
+					}
+					static tValue Decode( const uint8_t*& io_data )
+					{
+						const char* const string = reinterpret_cast<const char*>( io_data );
+						io_data += strlen( string ) + 1;
+						return string;
+					}
+
+				private:
+
+					static const char* const s_nullString;
+				};
+				template<> struct sArgument<const char*> : public sStringArgument {};
+				template<> struct sArgument<char*> : public sStringArgument {};
+				template<>
+				struct sArgument<std::string> : public sStringArgument
+				{
+					static size_t GetSize( const std::string& i_string )
+					{
+						return i_string.size() + 1;
+					}
+					static uint8_t* Encode( const std::string& i_string, uint8_t* o_data )
+					{
+						memcpy( o_data, i_string.c_str(), i_string.size() + 1 );
+						return o_data + i_string.size() + 1;
+					}
+				};
+
+				inline size_t GetArgumentsSize()
+				{
+					return 0;
+				}
+				template<typename tArgument, typename... tRemainingArguments>
+				size_t GetArgumentsSize( const tArgument& i_argument, const tRemainingArguments&... i_remainingArguments )
+				{
+					return sArgument<typename std::decay<tArgument>::type>::GetSize( i_argument ) + GetArgumentsSize( i_remainingArguments... );
+				}
+
+				inline void EncodeArguments( uint8_t* )
+				{
+
+				}
+				template<typename tArgument, typename... tRemainingArguments>
+				void EncodeArguments( uint8_t* o_data, const tArgument& i_argument, const tRemainingArguments&... i_remainingArguments )
+				{
+					EncodeArguments( sArgument<typename std::decay<tArgument>::type>::Encode( i_argument, o_data ), i_remainingArguments... );
+				}
+
+				// Each argument is decoded in order and added to the ones before it,
+				// and once they have all been decoded they are formatted
+				template<typename... tRemainingArguments>
+				struct sDecoder;
+				template<>
+				struct sDecoder<>
+				{
+					template<typename... tValues>
+					static int Format( const char* const i_format, const uint8_t*, char* o_buffer, const size_t i_bufferSize, const tValues... i_values )
+					{
+						return snprintf( o_buffer, i_bufferSize, i_format, i_values... );
+					}
+				};
+				template<typename tArgument, typename... tRemainingArguments>
+				struct sDecoder<tArgument, tRemainingArguments...>
+				{
+					template<typename... tValues>
+					static int Format( const char* const i_format, const uint8_t* i_arguments, char* o_buffer, const size_t i_bufferSize,
+						const tValues... i_values )
+					{
+						const typename sArgument<tArgument>::tValue value = sArgument<tArgument>::Decode( i_arguments );
+						return sDecoder<tRemainingArguments...>::Format( i_format, i_arguments, o_buffer, i_bufferSize, i_values..., value );
+					}
+				};
+				template<typename... tArguments>
+				int FormatArguments( const char* const i_format, const uint8_t* i_arguments, char* o_buffer, const size_t i_bufferSize )
+				{
+					return sDecoder<tArguments...>::Format( i_format, i_arguments, o_buffer, i_bufferSize );
+				}
+			}
+
+			template<typename... tArguments>
+			void Write( const eSeverity i_severity, const char* const i_format, const tArguments&... i_arguments )
+			{
+				using namespace Implementation;
+				const size_t argumentsSize = GetArgumentsSize( i_arguments... );
+				uint8_t* const arguments = BeginMessage( i_severity, i_format,
+					&FormatArguments<typename std::decay<tArguments>::type...>, argumentsSize );
+				if ( arguments )
+				{
+					EncodeArguments( arguments, i_arguments... );
+					EndMessage();
+				}
+			}
+		}
+	}
+}
+
+// Macros
+//=======
+
+// Each macro takes a format string followed by its arguments, like printf()
+// (a newline is added to every message)
+
+#if EAE6320_LOG_MINSEVERITY <= 0
+	#define EAE6320_LOG_VERBOSE( ... ) eae6320::UserOutput::Log::Write( eae6320::UserOutput::Log::Severity_verbose, __VA_ARGS__ )
+#else
+	#define EAE6320_LOG_VERBOSE( ... ) ( (void)0 )
+#endif
+#if EAE6320_LOG_MINSEVERITY <= 1
+	#define EAE6320_LOG_INFO( ... ) eae6320::UserOutput::Log::Write( eae6320::UserOutput::Log::Severity_info, __VA_ARGS__ )
+#else
+	#define EAE6320_LOG_INFO( ... ) ( (void)0 )
+#endif
+#if EAE6320_LOG_MINSEVERITY <= 2
+	#define EAE6320_LOG_WARNING( ... ) eae6320::UserOutput::Log::Write( eae6320::UserOutput::Log::Severity_warning, __VA_ARGS__ )
+#else
+	#define EAE6320_LOG_WARNING( ... ) ( (void)0 )
+#endif
+#if EAE6320_LOG_MINSEVERITY <= 3
+	#define EAE6320_LOG_ERROR( ... ) eae6320::UserOutput::Log::Write( eae6320::UserOutput::Log::Severity_error, __VA_ARGS__ )
+#else
+	#define EAE6320_LOG_ERROR( ... ) ( (void)0 )
+#endif
+
+#endif	// EAE6320_USEROUTPUT_LOG_H
@@ -2,14 +2,17 @@
 
 #include "UserOutput.h"
 
+#include "Log.h"
+
 #include "../Windows/Includes.h"
 namespace eae6320
 {
 	namespace UserOutput
 	{
-		void Print(std::string i_pMsg)
+		void Print(const std::string& i_pMsg)
 		{
-			OutputDebugString(i_pMsg.c_str());
+			// The log copies the message and writes it to the debugger on its own thread
+			EAE6320_LOG_ERROR("%s", i_pMsg);
 			MessageBox(NULL, i_pMsg.c_str(), NULL, MB_OK);
 		}
 	}
@@ -6,7 +6,11 @@ namespace eae6320
 {
 	namespace UserOutput
 	{
-		void Print(std::string);
+		// Logs the message as an error (see Log.h) and shows it in a message box.
+		// The message box blocks the calling thread until the user closes it,
+		// and so this is only for initialization or fatal errors that the user must see
+		// (anything that can happen while the game is running should use EAE6320_LOG_ERROR instead)
+		void Print(const std::string& i_message);
 	}
 }
 #endif
\ No newline at end of file
@@ -23,8 +23,10 @@ namespace
 PFNGLACTIVETEXTUREPROC glActiveTexture = NULL;
 PFNGLATTACHSHADERPROC glAttachShader = NULL;
 PFNGLBINDBUFFERPROC glBindBuffer = NULL;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRange = NULL;
 PFNGLBINDVERTEXARRAYPROC glBindVertexArray = NULL;
 PFNGLBUFFERDATAPROC glBufferData = NULL;
+PFNGLBUFFERSUBDATAPROC glBufferSubData = NULL;
 PFNGLCOMPILESHADERPROC glCompileShader = NULL;
 PFNGLCREATEPROGRAMPROC glCreateProgram = NULL;
 PFNGLCREATESHADERPROC glCreateShader = NULL;
@@ -32,6 +34,7 @@ PFNGLDELETEBUFFERSPROC glDeleteBuffers = NULL;
 PFNGLDELETEPROGRAMPROC glDeleteProgram = NULL;
 PFNGLDELETESHADERPROC glDeleteShader = NULL;
 PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays = NULL;
+PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced = NULL;
 PFNGLENABLEVERTEXATTRIBARRAYARBPROC glEnableVertexAttribArray = NULL;
 PFNGLGENBUFFERSPROC glGenBuffers = NULL;
 PFNGLGENVERTEXARRAYSPROC glGenVertexArrays = NULL;
@@ -39,15 +42,20 @@ PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog = NULL;
 PFNGLGETPROGRAMIVPROC glGetProgramiv = NULL;
 PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog = NULL;
 PFNGLGETSHADERIVPROC glGetShaderiv = NULL;
+PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex = NULL;
 PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = NULL;
 PFNGLLINKPROGRAMPROC glLinkProgram = NULL;
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange = NULL;
 PFNGLSHADERSOURCEPROC glShaderSource = NULL;
+PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding = NULL;
+PFNGLUNMAPBUFFERPROC glUnmapBuffer = NULL;
 PFNGLUSEPROGRAMPROC glUseProgram = NULL;
 PFNGLUNIFORM1FVPROC glUniform1fv = NULL;
 PFNGLUNIFORM2FVPROC glUniform2fv = NULL;
 PFNGLUNIFORM3FVPROC glUniform3fv = NULL;
 PFNGLUNIFORM4FVPROC glUniform4fv = NULL;
 PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv = NULL;
+PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor = NULL;
 PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = NULL;
 
 // Initialization
@@ -76,8 +84,10 @@ bool eae6320::OpenGlExtensions::Load( std::string* o_errorMessage )
 	EAE6320_LOADGLFUNCTION( glActiveTexture, PFNGLACTIVETEXTUREPROC );
 	EAE6320_LOADGLFUNCTION( glAttachShader, PFNGLATTACHSHADERPROC );
 	EAE6320_LOADGLFUNCTION( glBindBuffer, PFNGLBINDBUFFERPROC );
+	EAE6320_LOADGLFUNCTION( glBindBufferRange, PFNGLBINDBUFFERRANGEPROC );
 	EAE6320_LOADGLFUNCTION( glBindVertexArray, PFNGLBINDVERTEXARRAYPROC );
 	EAE6320_LOADGLFUNCTION( glBufferData, PFNGLBUFFERDATAPROC );
+	EAE6320_LOADGLFUNCTION( glBufferSubData, PFNGLBUFFERSUBDATAPROC );
 	EAE6320_LOADGLFUNCTION( glCompileShader, PFNGLCOMPILESHADERPROC );
 	EAE6320_LOADGLFUNCTION( glCreateProgram, PFNGLCREATEPROGRAMPROC );
 	EAE6320_LOADGLFUNCTION( glCreateShader, PFNGLCREATESHADERPROC );
@@ -85,6 +95,7 @@ bool eae6320::OpenGlExtensions::Load( std::string* o_errorMessage )
 	EAE6320_LOADGLFUNCTION( glDeleteProgram, PFNGLDELETEPROGRAMPROC );
 	EAE6320_LOADGLFUNCTION( glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC );
 	EAE6320_LOADGLFUNCTION( glDeleteShader, PFNGLDELETESHADERPROC );
+	EAE6320_LOADGLFUNCTION( glDrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC );
 	EAE6320_LOADGLFUNCTION( glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYARBPROC );
 	EAE6320_LOADGLFUNCTION( glGenBuffers, PFNGLGENBUFFERSPROC );
 	EAE6320_LOADGLFUNCTION( glGenVertexArrays, PFNGLGENVERTEXARRAYSPROC );
@@ -92,15 +103,20 @@ bool eae6320::OpenGlExtensions::Load( std::string* o_errorMessage )
 	EAE6320_LOADGLFUNCTION( glGetProgramiv, PFNGLGETPROGRAMIVPROC );
 	EAE6320_LOADGLFUNCTION( glGetShaderInfoLog, PFNGLGETSHADERINFOLOGPROC );
 	EAE6320_LOADGLFUNCTION( glGetShaderiv, PFNGLGETSHADERIVPROC );
+	EAE6320_LOADGLFUNCTION( glGetUniformBlockIndex, PFNGLGETUNIFORMBLOCKINDEXPROC );
 	EAE6320_LOADGLFUNCTION( glGetUniformLocation, PFNGLGETUNIFORMLOCATIONPROC );
 	EAE6320_LOADGLFUNCTION( glLinkProgram, PFNGLLINKPROGRAMPROC );
+	EAE6320_LOADGLFUNCTION( glMapBufferRange, PFNGLMAPBUFFERRANGEPROC );
 	EAE6320_LOADGLFUNCTION( glShaderSource, PFNGLSHADERSOURCEPROC );
 	EAE6320_LOADGLFUNCTION( glUniform1fv, PFNGLUNIFORM1FVPROC );
 	EAE6320_LOADGLFUNCTION( glUniform2fv, PFNGLUNIFORM2FVPROC );
 	EAE6320_LOADGLFUNCTION( glUniform3fv, PFNGLUNIFORM3FVPROC );
 	EAE6320_LOADGLFUNCTION( glUniform4fv, PFNGLUNIFORM4FVPROC );
+	EAE6320_LOADGLFUNCTION( glUniformBlockBinding, PFNGLUNIFORMBLOCKBINDINGPROC );
 	EAE6320_LOADGLFUNCTION( glUniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC );
+	EAE6320_LOADGLFUNCTION( glUnmapBuffer, PFNGLUNMAPBUFFERPROC );
 	EAE6320_LOADGLFUNCTION( glUseProgram, PFNGLUSEPROGRAMPROC );
+	EAE6320_LOADGLFUNCTION( glVertexAttribDivisor, PFNGLVERTEXATTRIBDIVISORPROC );
 	EAE6320_LOADGLFUNCTION( glVertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC );
 
 #undef EAE6320_LOADGLFUNCTION
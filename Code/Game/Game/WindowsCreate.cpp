@@ -13,10 +13,26 @@
 // WindowsFunctions.h contains convenience functionality for Windows features;
 // in this example program we just use it to get error messages
 #include "../../Engine/Windows/WindowsFunctions.h"
+#include "../../Engine/Graphics/AssetLoader.h"
+#include "../../Engine/Graphics/AssetPack.h"
 #include "../../Engine/Graphics/Graphics.h"
-#include "../../Engine/Core/GameObject.h"
+#include "../../Engine/Graphics/HotReload.h"
+#include "../../Engine/Graphics/RenderState.h"
+#include "../../Engine/Graphics/RenderThread.h"
+#include "../../Engine/Core/EntityStore.h"
+#include "../../Engine/Core/JobSystem.h"
+#include "../../Engine/Math/cFrustum.h"
+#include "../../Engine/Math/cMatrix_transformation.h"
+#include "../../Engine/Memory/Memory.h"
+#include "../../Engine/Time/FrameStats.h"
 #include "../../Engine/Time/Time.h"
+#include "../../Engine/UserInput/InputRecording.h"
 #include "../../Engine/UserInput/UserInput.h"
+#include "../../Engine/UserOutput/Log.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <vector>
 
 // Static Data Initialization
 //===========================
@@ -39,25 +55,136 @@ namespace
 	// your program could have problems when it is run at the same time on the same computer
 	// as one of your classmate's
 	const char* s_mainWindowClass_name = "Saurabh's Main Window Class";
+
+	// These are set from the command line:
+	//	-record <path>	Records every frame's input and frame time to the file
+	//	-replay <path>	Replays a recording instead of using the real input and time
+	//	-headless	Doesn't show the window or render anything
+	//		(with -replay this runs the recording as fast as possible)
+	//	-norenderthread	Draws on the same thread as the simulation
+	//	-renderframes <count>	How many frames the render thread has (2 or 3)
+	std::string s_path_inputRecording;
+	std::string s_path_inputReplay;
+	bool s_isHeadless = false;
+	bool s_shouldUseRenderThread = true;
+	unsigned int s_renderFrameCount = eae6320::Graphics::RenderThread::s_minFrameCount;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void ParseCommandLine( const char* i_commandLineArguments )
+	{
+		// Split the arguments at spaces
+		// (a path with spaces in it can be put in quotes)
+		std::vector<std::string> arguments;
+		if ( i_commandLineArguments )
+		{
+			std::string argument;
+			bool isArgumentStarted = false;
+			bool isInQuotes = false;
+			for ( const char* c = i_commandLineArguments; *c != '\0'; ++c )
+			{
+				if ( *c == '"' )
+				{
+					isInQuotes = !isInQuotes;
+					isArgumentStarted = true;
+				}
+				else if ( ( ( *c == ' ' ) || ( *c == '\t' ) ) && !isInQuotes )
+				{
+					if ( isArgumentStarted )
+					{
+						arguments.push_back( argument );
+						argument.clear();
+						isArgumentStarted = false;
+					}
+				}
+				else
+				{
+					argument += *c;
+					isArgumentStarted = true;
+				}
+			}
+			if ( isArgumentStarted )
+			{
+				arguments.push_back( argument );
+			}
+		}
+
+		for ( size_t i = 0; i < arguments.size(); ++i )
+		{
+			const bool hasValue = ( i + 1 ) < arguments.size();
+			if ( ( arguments[i] == "-record" ) && hasValue )
+			{
+				s_path_inputRecording = arguments[++i];
+			}
+			else if ( ( arguments[i] == "-replay" ) && hasValue )
+			{
+				s_path_inputReplay = arguments[++i];
+			}
+			else if ( arguments[i] == "-headless" )
+			{
+				s_isHeadless = true;
+			}
+			else if ( arguments[i] == "-norenderthread" )
+			{
+				s_shouldUseRenderThread = false;
+			}
+			else if ( ( arguments[i] == "-renderframes" ) && hasValue )
+			{
+				s_renderFrameCount = static_cast<unsigned int>( atoi( arguments[++i].c_str() ) );
+			}
+			else
+			{
+				EAE6320_LOG_WARNING( "The command line argument \"%s\" isn't recognized and will be ignored", arguments[i] );
+			}
+		}
+		if ( s_isHeadless && s_path_inputReplay.empty() )
+		{
+			// There would be no way to close the game
+			EAE6320_LOG_WARNING( "-headless is only used with -replay and will be ignored" );
+			s_isHeadless = false;
+		}
+	}
+
+	void DecodeAssetOnJobSystem( const eae6320::Graphics::AssetLoader::tDecodeFunction i_function, void* io_request );
+	// This is run on the render thread (see RenderThread::RunAndWait())
+	void FinishAssetLoads( void* );
+	void ParseCommandLine( const char* i_commandLineArguments );
+	// Logs a summary and writes FrameStats.csv and FrameStats.json
+	void WriteFrameStats( const eae6320::Time::cFrameStats& i_frameStats );
 }
 
 // Main Function
 //==============
 
-int CreateMainWindowAndReturnExitCodeWhenItCloses( const HINSTANCE i_thisInstanceOfTheProgram, const int i_initialWindowDisplayState )
+int CreateMainWindowAndReturnExitCodeWhenItCloses( const HINSTANCE i_thisInstanceOfTheProgram, const int i_initialWindowDisplayState,
+	const char* i_commandLineArguments )
 {
+	// The log is started before anything else so that every system can write to it
+	// (if it can't be started messages are still written, just synchronously)
+	eae6320::UserOutput::Log::Initialize( "Game.log" );
+	ParseCommandLine( i_commandLineArguments );
+
+	int exitCode;
 	// Try to create the main window
-	if ( CreateMainWindow( i_thisInstanceOfTheProgram, i_initialWindowDisplayState ) )
+	// (a headless run still needs a window for the graphics device, but it is never shown)
+	if ( CreateMainWindow( i_thisInstanceOfTheProgram, s_isHeadless ? SW_HIDE : i_initialWindowDisplayState ) )
 	{
 		// If the main window was successfully created wait for it to be closed
-		const int exitCode = WaitForMainWindowToCloseAndReturnExitCode( i_thisInstanceOfTheProgram );
-		return exitCode;
+		exitCode = WaitForMainWindowToCloseAndReturnExitCode( i_thisInstanceOfTheProgram );
 	}
 	else
 	{
 		// If the main window wasn't created return a made-up error code
-		return -1;
+		exitCode = -1;
 	}
+
+	// Every message that is still buffered is written before the program exits
+	eae6320::UserOutput::Log::ShutDown();
+	return exitCode;
 }
 
 // Helper Functions
@@ -411,6 +538,72 @@ LRESULT CALLBACK OnMessageReceived( HWND i_window, UINT i_message, WPARAM i_wPar
 			// If the key press wasn't handled pass it on to Windows to process in the default way
 			break;
 		}
+	// Every key and mouse event is given to UserInput,
+	// which makes a snapshot of them at the start of every frame
+	// (the system key messages are for keys that are pressed while Alt is held,
+	// and they are still passed on so that e.g. Alt+F4 works)
+	case WM_KEYDOWN:
+	case WM_SYSKEYDOWN:
+		{
+			eae6320::UserInput::SubmitKeyEvent( static_cast<int>( i_wParam ), true );
+			break;
+		}
+	case WM_KEYUP:
+	case WM_SYSKEYUP:
+		{
+			eae6320::UserInput::SubmitKeyEvent( static_cast<int>( i_wParam ), false );
+			break;
+		}
+	case WM_LBUTTONDOWN:
+	case WM_LBUTTONUP:
+	case WM_RBUTTONDOWN:
+	case WM_RBUTTONUP:
+	case WM_MBUTTONDOWN:
+	case WM_MBUTTONUP:
+		{
+			const bool isDown = ( i_message == WM_LBUTTONDOWN ) || ( i_message == WM_RBUTTONDOWN ) || ( i_message == WM_MBUTTONDOWN );
+			int virtualButtonCode;
+			if ( ( i_message == WM_LBUTTONDOWN ) || ( i_message == WM_LBUTTONUP ) )
+			{
+				virtualButtonCode = VK_LBUTTON;
+			}
+			else if ( ( i_message == WM_RBUTTONDOWN ) || ( i_message == WM_RBUTTONUP ) )
+			{
+				virtualButtonCode = VK_RBUTTON;
+			}
+			else
+			{
+				virtualButtonCode = VK_MBUTTON;
+			}
+			eae6320::UserInput::SubmitKeyEvent( virtualButtonCode, isDown );
+			// The mouse is captured while any button is down
+			// so that the button up is received even if it happens outside of the window
+			// (the WPARAM has the state of every button after this one changed)
+			if ( isDown )
+			{
+				SetCapture( i_window );
+			}
+			else if ( ( i_wParam & ( MK_LBUTTON | MK_RBUTTON | MK_MBUTTON ) ) == 0 )
+			{
+				ReleaseCapture();
+			}
+			return 0;
+		}
+	case WM_MOUSEMOVE:
+		{
+			// The coordinates are signed
+			// (they can be negative when the mouse is captured and outside of the window)
+			const int x = static_cast<short>( LOWORD( i_lParam ) );
+			const int y = static_cast<short>( HIWORD( i_lParam ) );
+			eae6320::UserInput::SubmitMouseMoveEvent( x, y );
+			return 0;
+		}
+	// The key ups for any keys that are down will go to a different window
+	case WM_KILLFOCUS:
+		{
+			eae6320::UserInput::ReleaseAllKeys();
+			break;
+		}
 	// The window's nonclient area is being destroyed
 	case WM_NCDESTROY:
 		{
@@ -463,27 +656,88 @@ bool WaitForMainWindowToClose( int& o_exitCode )   // **** GAME LOOP
 
 	// Enter an infinite loop that will continue until a quit message (WM_QUIT) is received from Windows
 	eae6320::Graphics::Initialize(s_mainWindow);
+	// The entity systems and building the render queue are split across every core
+	eae6320::Core::JobSystem::Initialize();
+	// Built assets are found in the pack if there is one
+	// (otherwise they are loaded from the loose files in data/)
+	eae6320::Graphics::AssetPack::Mount("data/assets.pak");
+	// Meshes and effects are read on a background thread and decoded on the job system
+	// while the game keeps running
+	eae6320::Graphics::AssetLoader::Initialize();
+	eae6320::Graphics::AssetLoader::SetDecodeDispatcher(DecodeAssetOnJobSystem);
+	// Render queues record their command buffers on the job system too
+	eae6320::Graphics::RenderQueue::SetParallelFor(eae6320::Core::JobSystem::ParallelFor);
+	// Assets that "AssetBuilder.exe -watch" rebuilds are swapped in while the game is running
+	eae6320::Graphics::HotReload::Initialize("data/");
 
-	eae6320::Core::GameObject ** gameObjectList = new eae6320::Core::GameObject * [3];
-	eae6320::Core::GameObject * object_tri1 = gameObjectList[0] = new eae6320::Core::GameObject();
-	eae6320::Core::GameObject * object_tri2 = gameObjectList[1] = new eae6320::Core::GameObject();
-	eae6320::Core::GameObject * object_rect = gameObjectList[2] = new eae6320::Core::GameObject();
+	// Every game object's components are stored together in the entity store
+	// so that updating and submitting them walks contiguous arrays
+	eae6320::Core::EntityStore entities;
+	// (entities aren't drawn until their assets have finished loading)
+	const eae6320::Core::sEntityHandle entity_tri1 = entities.CreateAsync("data/triangle.msh");
+	const eae6320::Core::sEntityHandle entity_tri2 = entities.Create(entity_tri1);
+	const eae6320::Core::sEntityHandle entity_rect = entities.CreateAsync("data/rectangle.msh");
 
-	object_tri1->Initialize("data/triangle.msh");
-	object_tri2->Initialize("data/triangle.msh");
-	object_rect->Initialize("data/rectangle.msh");
+	if (entities.IsAlive(entity_tri1))
+	{
+		*entities.GetPositionX(entity_tri1) = 0.5f;
+		*entities.GetPositionY(entity_tri1) = 0.5f;
+	}
+	if (entities.IsAlive(entity_tri2))
+	{
+		*entities.GetPositionX(entity_tri2) = -0.5f;
+		*entities.GetPositionY(entity_tri2) = -0.5f;
+	}
 
-	object_tri1->Position.x = 0.5f;
-	object_tri1->Position.y = 0.5f;
-	object_tri1->Update();
-	object_tri2->Position.x = -0.5f;
-	object_tri2->Position.y = -0.5f;
-	object_tri2->Update();
+	// This is only used without the render thread
+	// (which has a queue for every frame that it can be drawing)
+	eae6320::Graphics::RenderQueue renderQueue;
+	// There is no camera yet: the vertex shader uses positions as screen positions directly,
+	// and so the world-to-screen transform is the identity
+	// (with a camera it would be CreateWorldToViewTransform() * CreateViewToScreenTransform())
+	const eae6320::Math::cFrustum frustum((eae6320::Math::cMatrix_transformation()));
+	// Every visible renderable draws the coarsest level of detail whose error would cover at most a pixel
+	// (the pixels per unit are updated every frame from the size of the window)
+	eae6320::Graphics::sLodSettings lodSettings;
+	lodSettings.pixelsPerUnit = 0.0f;
+	lodSettings.maxPixelError = 1.0f;
 
-	eae6320::Graphics::Renderable ** renderableList = new eae6320::Graphics::Renderable *[3];
-	renderableList[0] = gameObjectList[0]->Renderable;
-	renderableList[1] = gameObjectList[1]->Renderable;
-	renderableList[2] = gameObjectList[2]->Renderable;
+	// A replay gives every frame the input and the frame time that were recorded,
+	// and so the simulation ends up in exactly the same state every time
+	eae6320::UserInput::cInputRecorder inputRecorder;
+	eae6320::UserInput::cInputReplayer inputReplayer;
+	const bool isReplaying = !s_path_inputReplay.empty();
+	{
+		std::string errorMessage;
+		if ( isReplaying )
+		{
+			// If the recording can't be loaded the replay ends on the first frame
+			if ( !inputReplayer.Load( s_path_inputReplay.c_str(), &errorMessage ) )
+			{
+				EAE6320_LOG_ERROR( "%s", errorMessage );
+			}
+		}
+		else if ( !s_path_inputRecording.empty() )
+		{
+			if ( !inputRecorder.Start( s_path_inputRecording.c_str(), &errorMessage ) )
+			{
+				EAE6320_LOG_ERROR( "%s", errorMessage );
+			}
+		}
+	}
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	// Every frame's time and the time of each phase of the frame are kept
+	// and are written to FrameStats.csv and FrameStats.json when the game exits (or when F5 is pressed)
+	eae6320::Time::cFrameStats frameStats;
+	// Frames are drawn on the render thread while the next frame is simulated
+	// (from here on the render thread is the only one that can use the graphics context)
+	if ( !s_isHeadless && s_shouldUseRenderThread )
+	{
+		if ( !eae6320::Graphics::RenderThread::Initialize( s_renderFrameCount ) )
+		{
+			EAE6320_LOG_ERROR( "The render thread couldn't be started, and so frames will be drawn on the main thread" );
+		}
+	}
 
 	MSG message = { 0 };
 	do
@@ -505,7 +759,54 @@ bool WaitForMainWindowToClose( int& o_exitCode )   // **** GAME LOOP
 		}
 		if ( !hasWindowsSentAMessage )
 		{
-			eae6320::Time::OnNewFrame();
+			frameStats.BeginFrame();
+			if ( isReplaying )
+			{
+				eae6320::UserInput::sSnapshot snapshot;
+				float secondsElapsed;
+				if ( !inputReplayer.ReadFrame( snapshot, secondsElapsed ) )
+				{
+					// The final position can be compared between runs to make sure that the replay was deterministic
+					const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count();
+					const float* const position_x = entities.GetPositionX( entity_rect );
+					const float* const position_y = entities.GetPositionY( entity_rect );
+					EAE6320_LOG_INFO( "Replayed %u frames of \"%s\" in %.3f seconds (%.1f frames per second); the rectangle ended at (%.9g, %.9g)",
+						inputReplayer.GetFrameIndex(), s_path_inputReplay, seconds, ( seconds > 0.0 ) ? ( inputReplayer.GetFrameIndex() / seconds ) : 0.0,
+						position_x ? *position_x : 0.0f, position_y ? *position_y : 0.0f );
+					if ( inputReplayer.HasFailed() )
+					{
+						EAE6320_LOG_ERROR( "The input recording \"%s\" couldn't be replayed completely", s_path_inputReplay );
+					}
+					PostQuitMessage( inputReplayer.HasFailed() ? -1 : 0 );
+					// The quit message is received the next time through the loop
+					continue;
+				}
+				eae6320::Time::OnNewFrame( secondsElapsed );
+				eae6320::UserInput::OnNewFrame( snapshot );
+			}
+			else
+			{
+				eae6320::Time::OnNewFrame();
+				// Every input query during the frame reads the events that were received before it started
+				eae6320::UserInput::OnNewFrame();
+				if ( inputRecorder.IsRecording() )
+				{
+					inputRecorder.RecordFrame( eae6320::UserInput::GetSnapshot(), eae6320::Time::GetSecondsElapsedThisFrame() );
+				}
+			}
+			// Everything that was allocated for the previous frame is freed at once
+			eae6320::Memory::GetFrameAllocator().Reset();
+			// Reload any assets that have been rebuilt
+			// and create the GPU objects for any assets that have finished loading
+			// (this is the only place that meshes and effects change, and so they never change in the middle of a frame).
+			// Finishing loads has to wait for the render thread,
+			// but only on the frames where there are loads to finish
+			eae6320::Graphics::HotReload::Update();
+			eae6320::Graphics::AssetLoader::DispatchDecodes();
+			if (eae6320::Graphics::AssetLoader::HasLoadsToFinish())
+			{
+				eae6320::Graphics::RenderThread::RunAndWait(FinishAssetLoads);
+			}
 			eae6320::Math::cVector offset(0.0f, 0.0f);
 			{
 				// Get the direction
@@ -533,9 +834,63 @@ bool WaitForMainWindowToClose( int& o_exitCode )   // **** GAME LOOP
 				// Normalize the offset
 				offset *= unitsToMove;
 			}
-			object_rect->Position += offset;
-			object_rect->Update();
-			eae6320::Graphics::Render(renderableList,3);
+			if (entities.IsAlive(entity_rect))
+			{
+				*entities.GetPositionX(entity_rect) += offset.x;
+				*entities.GetPositionY(entity_rect) += offset.y;
+			}
+			entities.UpdateRenderables();
+			// The screen is two units tall
+			{
+				RECT clientDimensions;
+				if (GetClientRect(s_mainWindow, &clientDimensions) != FALSE)
+				{
+					lodSettings.pixelsPerUnit = static_cast<float>(clientDimensions.bottom - clientDimensions.top) * 0.5f;
+				}
+			}
+			if (eae6320::UserInput::WasKeyPressedThisFrame(VK_F5))
+			{
+				WriteFrameStats(frameStats);
+			}
+			frameStats.EndPhase(eae6320::Time::cFrameStats::Phase_update);
+			// Only entities that are on screen reach the render queue
+			// (a render queue's GetStats() has how many triangles the chosen LODs had the last time it was drawn)
+			if (s_isHeadless)
+			{
+				// A headless run still does all of the work to build the render queue and record its commands
+				// but doesn't wait for the GPU (or for the display to refresh)
+				entities.SubmitVisibleRenderables(renderQueue, frustum, lodSettings);
+				renderQueue.Record();
+				renderQueue.Clear();
+				frameStats.EndPhase(eae6320::Time::cFrameStats::Phase_submit);
+			}
+			else if (eae6320::Graphics::RenderThread::IsInitialized())
+			{
+				// The only time the game waits for the GPU (or for the display to refresh)
+				// is when the render thread hasn't finished with any of the other frames yet
+				eae6320::Graphics::RenderQueue& frameRenderQueue = eae6320::Graphics::RenderThread::BeginFrame();
+				frameStats.EndPhase(eae6320::Time::cFrameStats::Phase_present);
+				entities.SubmitVisibleRenderables(frameRenderQueue, frustum, lodSettings);
+				// The commands are recorded on the job system here
+				// so that the render thread only has to execute them
+				frameRenderQueue.Record();
+				eae6320::Graphics::RenderThread::SubmitFrame();
+				frameStats.EndPhase(eae6320::Time::cFrameStats::Phase_submit);
+			}
+			else
+			{
+				entities.SubmitVisibleRenderables(renderQueue, frustum, lodSettings);
+				eae6320::Graphics::Submit(renderQueue);
+				frameStats.EndPhase(eae6320::Time::cFrameStats::Phase_submit);
+				eae6320::Graphics::Present();
+				frameStats.EndPhase(eae6320::Time::cFrameStats::Phase_present);
+			}
+			// Verbose messages are only logged in debug builds (see EAE6320_LOG_MINSEVERITY)
+			{
+				const eae6320::Core::sCullingStats& cullingStats = entities.GetCullingStats();
+				EAE6320_LOG_VERBOSE("%u of %u entities were visible and %u were culled (%u of them a whole grid cell at a time)",
+					cullingStats.visibleCount, cullingStats.entityCount, cullingStats.culledCount, cullingStats.culledByGridCount);
+			}
 
 			// Usually there will be no messages in the queue, and the game can run
 
@@ -564,17 +919,111 @@ bool WaitForMainWindowToClose( int& o_exitCode )   // **** GAME LOOP
 			DispatchMessage( &message );
 		}
 	} while ( message.message != WM_QUIT );
-	gameObjectList[0]->ShutDown();
-	gameObjectList[1]->ShutDown();
-	gameObjectList[2]->ShutDown();
-	delete gameObjectList[0];
-	delete gameObjectList[1];
-	delete gameObjectList[2];
-	delete renderableList;
-	delete gameObjectList;
+	if ( inputRecorder.IsRecording() )
+	{
+		const uint32_t frameCount = inputRecorder.GetFrameCount();
+		std::string errorMessage;
+		if ( inputRecorder.Stop( &errorMessage ) )
+		{
+			EAE6320_LOG_INFO( "Recorded %u frames of input to \"%s\"", frameCount, s_path_inputRecording );
+		}
+		else
+		{
+			EAE6320_LOG_ERROR( "%s", errorMessage );
+		}
+	}
+	// Every frame that was submitted is drawn,
+	// and the graphics context comes back to this thread so that everything can be shut down
+	if ( eae6320::Graphics::RenderThread::IsInitialized() )
+	{
+		eae6320::Graphics::RenderThread::ShutDown();
+		const eae6320::Graphics::RenderThread::sRenderThreadStats stats = eae6320::Graphics::RenderThread::GetStats();
+		const double frameCount = ( stats.framesDrawn > 0 ) ? static_cast<double>( stats.framesDrawn ) : 1.0;
+		EAE6320_LOG_INFO( "The render thread drew %llu frames (%.3f ms submitting and %.3f ms presenting per frame);"
+			" it waited %.3f ms per frame for the game thread, and the game thread waited %.3f ms per frame for it"
+			" (plus %.3f ms in %llu synchronous calls)",
+			static_cast<unsigned long long>( stats.framesDrawn ), stats.submitMilliseconds / frameCount, stats.presentMilliseconds / frameCount,
+			stats.renderThreadWaitMilliseconds / frameCount, stats.gameThreadWaitMilliseconds / frameCount,
+			stats.functionWaitMilliseconds, static_cast<unsigned long long>( stats.functionsRun ) );
+	}
+	{
+		const eae6320::Graphics::sRenderStateStats& stats = eae6320::Graphics::RenderState::GetStats();
+		const unsigned int callCount = stats.callsIssued + stats.callsSkipped;
+		if ( callCount > 0 )
+		{
+			EAE6320_LOG_INFO( "The render state cache issued %u of %u bind calls (%u were skipped because the state was already bound)",
+				stats.callsIssued, callCount, stats.callsSkipped );
+		}
+	}
+	WriteFrameStats( frameStats );
+	entities.DestroyAll();
+	eae6320::Graphics::HotReload::ShutDown();
+	// Any decode jobs that are still running must finish before the job system shuts down
+	eae6320::Graphics::AssetLoader::ShutDown();
+	eae6320::Graphics::RenderQueue::SetParallelFor(NULL);
+	eae6320::Core::JobSystem::ShutDown();
 	eae6320::Graphics::ShutDown();
+	eae6320::Graphics::AssetPack::Unmount();
+	// Report how much memory each allocator needed
+	// so that their initial capacities can be tuned
+	{
+		std::vector<eae6320::Memory::sAllocatorStats> allocatorStats;
+		eae6320::Memory::GetAllocatorStats(allocatorStats);
+		for (std::vector<eae6320::Memory::sAllocatorStats>::const_iterator i = allocatorStats.begin(); i != allocatorStats.end(); ++i)
+		{
+			EAE6320_LOG_INFO("Allocator \"%s\": %zu allocations, %zu bytes at most (%zu reserved in %zu system allocations)",
+				i->name, i->allocationCount, i->highWaterBytes, i->capacity, i->systemAllocationCount);
+		}
+	}
 	// The exit code for the application is stored in the WPARAM of a WM_QUIT message
 	o_exitCode = static_cast<int>( message.wParam );
 
 	return true;
 }
+
+namespace
+{
+	void WriteFrameStats( const eae6320::Time::cFrameStats& i_frameStats )
+	{
+		eae6320::Time::cFrameStats::sSummary summary;
+		if ( !i_frameStats.GetSummary( summary ) )
+		{
+			return;
+		}
+		EAE6320_LOG_INFO( "The last %zu frames took %.3f ms on average (p50 %.3f, p95 %.3f, p99 %.3f, max %.3f) with %zu hitches "
+			"(%llu hitches in %llu frames in total)",
+			summary.frameCount, summary.frame.mean, summary.frame.p50, summary.frame.p95, summary.frame.p99, summary.frame.max, summary.hitchCount,
+			static_cast<unsigned long long>( summary.totalHitchCount ), static_cast<unsigned long long>( summary.totalFrameCount ) );
+		for ( int i = 0; i < eae6320::Time::cFrameStats::Phase_count; ++i )
+		{
+			const eae6320::Time::cFrameStats::ePhase phase = static_cast<eae6320::Time::cFrameStats::ePhase>( i );
+			const eae6320::Time::cFrameStats::sDistribution& distribution = summary.phases[i];
+			EAE6320_LOG_INFO( "\t%s: %.3f ms on average (p50 %.3f, p95 %.3f, p99 %.3f, max %.3f)", eae6320::Time::cFrameStats::GetPhaseName( phase ),
+				distribution.mean, distribution.p50, distribution.p95, distribution.p99, distribution.max );
+		}
+		std::string errorMessage;
+		if ( !i_frameStats.WriteCsv( "FrameStats.csv", &errorMessage ) || !i_frameStats.WriteJson( "FrameStats.json", &errorMessage ) )
+		{
+			EAE6320_LOG_ERROR( "%s", errorMessage );
+		}
+	}
+
+	void FinishAssetLoads( void* )
+	{
+		eae6320::Graphics::AssetLoader::FinishLoads();
+	}
+
+	void DecodeAssetOnJobSystem( const eae6320::Graphics::AssetLoader::tDecodeFunction i_function, void* io_request )
+	{
+		// Jobs that the main thread submits wait in its own deque until a worker steals them,
+		// and so without any workers they would only run the next time the main thread waits
+		if ( eae6320::Core::JobSystem::GetThreadCount() > 1 )
+		{
+			eae6320::Core::JobSystem::Run( i_function, io_request );
+		}
+		else
+		{
+			i_function( io_request );
+		}
+	}
+}
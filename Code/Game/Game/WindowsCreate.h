@@ -14,7 +14,9 @@
 // Main Function
 //==============
 
-int CreateMainWindowAndReturnExitCodeWhenItCloses( const HINSTANCE i_thisInstanceOfTheProgram, const int i_initialWindowDisplayState );
+// The command line arguments are described in WindowsCreate.cpp
+int CreateMainWindowAndReturnExitCodeWhenItCloses( const HINSTANCE i_thisInstanceOfTheProgram, const int i_initialWindowDisplayState,
+	const char* i_commandLineArguments );
 
 // Helper Functions
 //=================
@@ -3,9 +3,17 @@
 
 #include "AssetBuilder.h"
 
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <vector>
+#include "AssetPackWriter.h"
+#include "CommandRunner.h"
+#include "../BuilderHelper/cDirectoryWatcher.h"
+#include "../BuilderHelper/cLuaAllocator.h"
 #include "../BuilderHelper/UtilityFunctions.h"
+#include "../../Engine/Graphics/HotReloadMessage.h"
 #include "../../Engine/Windows/WindowsFunctions.h"
 #include "../../Externals/Lua/Includes.h"
 
@@ -14,6 +22,9 @@
 
 namespace
 {
+	// The state's memory comes from the allocator,
+	// and it is all freed at once when the build is finished
+	eae6320::cLuaAllocator* s_luaAllocator = NULL;
 	lua_State* s_luaState = NULL;
 }
 
@@ -28,15 +39,27 @@ namespace
 	bool Initialize();
 	bool ShutDown();
 
+	// Build
+	//------
+
+	// Runs BuildAssets.lua with the asset list
+	bool RunBuildScript( const std::string& i_scriptDir, const bool i_isWatching );
+	// Returns false if there isn't a running game to tell
+	bool SendHotReloadMessage( const char* i_relativePath );
+
 	// Lua Wrapper Functions
 	//----------------------
 
+	int luaBuildAssetPack( lua_State* io_luaState );
 	int luaCopyFile( lua_State* io_luaState );
 	int luaCreateDirectoryIfNecessary( lua_State* io_luaState );
 	int luaDoesFileExist( lua_State* io_luaState );
 	int luaGetEnvironmentVariable( lua_State* io_luaState );
 	int luaGetLastWriteTime( lua_State* io_luaState );
+	int luaGetTime( lua_State* io_luaState );
+	int luaNotifyRunningGame( lua_State* io_luaState );
 	int luaOutputErrorMessage( lua_State* io_luaState );
+	int luaRunCommands( lua_State* io_luaState );
 }
 
 // Interface
@@ -64,50 +87,86 @@ bool eae6320::AssetBuilder::BuildAssets()
 		}
 	}
 	// Load and execute the build script
+	if ( !RunBuildScript( scriptDir, false ) )
 	{
-		// Load the script
-		const std::string path_buildScript = scriptDir + "BuildAssets.lua";
-		const int result = luaL_loadfile( s_luaState, path_buildScript.c_str() );
-		if ( result == LUA_OK )
+		wereThereErrors = true;
+	}
+
+OnExit:
+
+	if ( !ShutDown() )
+	{
+		wereThereErrors = true;
+	}
+
+	return !wereThereErrors;
+}
+
+bool eae6320::AssetBuilder::WatchAssets()
+{
+	bool wereThereErrors = false;
+	std::string scriptDir, authoredAssetDir;
+	cDirectoryWatcher watcher;
+
+	if ( !Initialize() )
+	{
+		wereThereErrors = true;
+		goto OnExit;
+	}
+
+	// Get $(ScriptDir) and $(AuthoredAssetDir)
+	{
+		std::string errorMessage;
+		if ( !GetEnvironmentVariable( "ScriptDir", scriptDir, &errorMessage )
+			|| !GetEnvironmentVariable( "AuthoredAssetDir", authoredAssetDir, &errorMessage ) )
 		{
-			// Execute it with the asset list path as an argument
-			const int argumentCount = 1;
-			{
-				const std::string path_assetsToBuild = scriptDir + "AssetsToBuild.lua";
-				lua_pushstring( s_luaState, path_assetsToBuild.c_str() );
-			}
-			// The return value should be true (on success) or false (on failure)
-			const int returnValueCount = 1;
-			const int noMessageHandler = 0;
-			if ( lua_pcall( s_luaState, argumentCount, returnValueCount, noMessageHandler ) == LUA_OK )
-			{
-				// Note that lua_toboolean() follows the same rules as if something then statements in Lua:
-				// false or nil will evaluate to false, and anything else will evaluate to true
-				// (this means that if the script doesn't return anything it will result in a build failure)
-				wereThereErrors = !lua_toboolean( s_luaState, -1 );
-				lua_pop( s_luaState, returnValueCount );
-			}
-			else
+			wereThereErrors = true;
+			OutputErrorMessage( errorMessage.c_str(), __FILE__ );
+			goto OnExit;
+		}
+	}
+	// Start watching before the first build so that nothing that changes while it runs is missed
+	{
+		std::string errorMessage;
+		if ( !watcher.Start( authoredAssetDir.c_str(), &errorMessage ) )
+		{
+			wereThereErrors = true;
+			OutputErrorMessage( errorMessage.c_str(), __FILE__ );
+			goto OnExit;
+		}
+	}
+	// A build that fails doesn't stop the watching
+	// (the errors have already been output, and the next change may fix them)
+	RunBuildScript( scriptDir, true );
+	std::cout << "Watching \"" << authoredAssetDir << "\" for changes" << std::endl;
+	for ( ;; )
+	{
+		std::vector<std::string> changedPaths;
+		bool haveChangesBeenLost;
+		{
+			std::string errorMessage;
+			if ( !watcher.WaitForChanges( changedPaths, haveChangesBeenLost, &errorMessage ) )
 			{
 				wereThereErrors = true;
-
-				const char* errorMessage = lua_tostring( s_luaState, -1 );
-				std::cerr << errorMessage << "\n";
-				lua_pop( s_luaState, 1 );
-
+				OutputErrorMessage( errorMessage.c_str(), __FILE__ );
 				goto OnExit;
 			}
 		}
-		else
+		if ( haveChangesBeenLost )
 		{
-			wereThereErrors = true;
-
-			const char* errorMessage = lua_tostring( s_luaState, -1 );
-			std::cerr << errorMessage << "\n";
-			lua_pop( s_luaState, 1 );
-
-			goto OnExit;
+			std::cout << "Some changes weren't reported, and so every asset will be checked\n";
 		}
+		for ( std::vector<std::string>::const_iterator i = changedPaths.begin(); i != changedPaths.end(); ++i )
+		{
+			std::cout << "Changed " << *i << "\n";
+		}
+		// The build script only builds targets that are older than something in their build graph
+		// (their source, anything else their builder read, or an asset they were built from),
+		// and so only the assets that are affected by the changes are rebuilt
+		const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		const bool wasBuildSuccessful = RunBuildScript( scriptDir, true );
+		const double milliseconds = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - startTime ).count();
+		std::cout << ( wasBuildSuccessful ? "Rebuilt" : "Failed to rebuild" ) << " the changed assets in " << milliseconds << " ms" << std::endl;
 	}
 
 OnExit:
@@ -132,7 +191,8 @@ namespace
 	{
 		// Create a new Lua state
 		{
-			s_luaState = luaL_newstate();
+			s_luaAllocator = new eae6320::cLuaAllocator;
+			s_luaState = s_luaAllocator->NewState();
 			if ( !s_luaState )
 			{
 				eae6320::OutputErrorMessage( "Memory allocation error creating Lua state", __FILE__ );
@@ -143,12 +203,16 @@ namespace
 		luaL_openlibs( s_luaState );
 		// Register custom functions
 		{
+			lua_register( s_luaState, "BuildAssetPack", luaBuildAssetPack );
 			lua_register( s_luaState, "CopyFile", luaCopyFile );
 			lua_register( s_luaState, "CreateDirectoryIfNecessary", luaCreateDirectoryIfNecessary );
 			lua_register( s_luaState, "DoesFileExist", luaDoesFileExist );
 			lua_register( s_luaState, "GetEnvironmentVariable", luaGetEnvironmentVariable );
 			lua_register( s_luaState, "GetLastWriteTime", luaGetLastWriteTime );
+			lua_register( s_luaState, "GetTime", luaGetTime );
+			lua_register( s_luaState, "NotifyRunningGame", luaNotifyRunningGame );
 			lua_register( s_luaState, "OutputErrorMessage", luaOutputErrorMessage );
+			lua_register( s_luaState, "RunCommands", luaRunCommands );
 		}
 
 		return true;
@@ -163,13 +227,160 @@ namespace
 			lua_close( s_luaState );
 			s_luaState = NULL;
 		}
+		if ( s_luaAllocator )
+		{
+			std::cout << "AssetBuilder: " << s_luaAllocator->GetStatsSummary() << "\n";
+			delete s_luaAllocator;
+			s_luaAllocator = NULL;
+		}
 
 		return !wereThereErrors;
 	}
 
+	// Build
+	//------
+
+	bool RunBuildScript( const std::string& i_scriptDir, const bool i_isWatching )
+	{
+		// Load the script
+		const std::string path_buildScript = i_scriptDir + "BuildAssets.lua";
+		const int result = luaL_loadfile( s_luaState, path_buildScript.c_str() );
+		if ( result == LUA_OK )
+		{
+			// Execute it with the asset list path and whether assets are being watched as arguments
+			const int argumentCount = 2;
+			{
+				const std::string path_assetsToBuild = i_scriptDir + "AssetsToBuild.lua";
+				lua_pushstring( s_luaState, path_assetsToBuild.c_str() );
+				lua_pushboolean( s_luaState, i_isWatching );
+			}
+			// The return value should be true (on success) or false (on failure)
+			const int returnValueCount = 1;
+			const int noMessageHandler = 0;
+			if ( lua_pcall( s_luaState, argumentCount, returnValueCount, noMessageHandler ) == LUA_OK )
+			{
+				// Note that lua_toboolean() follows the same rules as if something then statements in Lua:
+				// false or nil will evaluate to false, and anything else will evaluate to true
+				// (this means that if the script doesn't return anything it will result in a build failure)
+				const bool wereThereErrors = !lua_toboolean( s_luaState, -1 );
+				lua_pop( s_luaState, returnValueCount );
+				return !wereThereErrors;
+			}
+		}
+
+		const char* errorMessage = lua_tostring( s_luaState, -1 );
+		std::cerr << errorMessage << "\n";
+		lua_pop( s_luaState, 1 );
+		return false;
+	}
+
+	bool SendHotReloadMessage( const char* i_relativePath )
+	{
+		const size_t messageSize = strlen( i_relativePath );
+		if ( ( messageSize == 0 ) || ( messageSize > eae6320::Graphics::HotReloadMessage::s_maxSize ) )
+		{
+			return false;
+		}
+		// The mailslot only exists while a game is running
+		HANDLE mailslot;
+		{
+			const DWORD desiredAccess = GENERIC_WRITE;
+			const DWORD otherProgramsCanStillReadTheMailslot = FILE_SHARE_READ;
+			SECURITY_ATTRIBUTES* useDefaultSecurity = NULL;
+			const DWORD onlySucceedIfMailslotExists = OPEN_EXISTING;
+			const DWORD useDefaultAttributes = FILE_ATTRIBUTE_NORMAL;
+			const HANDLE dontUseTemplateFile = NULL;
+			mailslot = CreateFile( eae6320::Graphics::HotReloadMessage::s_mailslotName, desiredAccess, otherProgramsCanStillReadTheMailslot,
+				useDefaultSecurity, onlySucceedIfMailslotExists, useDefaultAttributes, dontUseTemplateFile );
+			if ( mailslot == INVALID_HANDLE_VALUE )
+			{
+				return false;
+			}
+		}
+		DWORD bytesWrittenCount;
+		OVERLAPPED* writeSynchronously = NULL;
+		const bool wasMessageSent = ( WriteFile( mailslot, i_relativePath, static_cast<DWORD>( messageSize ), &bytesWrittenCount, writeSynchronously ) != FALSE )
+			&& ( bytesWrittenCount == messageSize );
+		CloseHandle( mailslot );
+		return wasMessageSent;
+	}
+
 	// Lua Wrapper Functions
 	//----------------------
 
+	int luaBuildAssetPack( lua_State* io_luaState )
+	{
+		// Argument #1: The pack's path
+		const char* i_path_pack;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_path_pack = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+		// Argument #2: The directory that the assets are in
+		const char* i_directory;
+		if ( lua_isstring( io_luaState, 2 ) )
+		{
+			i_directory = lua_tostring( io_luaState, 2 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #2 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 2 ) );
+		}
+		// Argument #3: An array of the assets' paths relative to the directory
+		std::vector<std::string> relativePaths;
+		if ( lua_istable( io_luaState, 3 ) )
+		{
+			const int pathCount = luaL_len( io_luaState, 3 );
+			for ( int i = 1; i <= pathCount; ++i )
+			{
+				lua_rawgeti( io_luaState, 3, i );
+				if ( lua_isstring( io_luaState, -1 ) )
+				{
+					relativePaths.push_back( lua_tostring( io_luaState, -1 ) );
+					lua_pop( io_luaState, 1 );
+				}
+				else
+				{
+					return luaL_error( io_luaState,
+						"Argument #3 must only contain strings (instead of a %s at index %d)",
+						luaL_typename( io_luaState, -1 ), i );
+				}
+			}
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #3 must be a table (instead of a %s)",
+				luaL_typename( io_luaState, 3 ) );
+		}
+
+		// Write the pack
+		{
+			std::string errorMessage;
+			if ( eae6320::AssetBuilder::WriteAssetPack( i_path_pack, i_directory, relativePaths, &errorMessage ) )
+			{
+				lua_pushboolean( io_luaState, true );
+				const int returnValueCount = 1;
+				return returnValueCount;
+			}
+			else
+			{
+				lua_pushboolean( io_luaState, false );
+				lua_pushstring( io_luaState, errorMessage.c_str() );
+				const int returnValueCount = 2;
+				return returnValueCount;
+			}
+		}
+	}
+
 	int luaCopyFile( lua_State* io_luaState )
 	{
 		// Argument #1: The source path
@@ -356,6 +567,37 @@ namespace
 		}
 	}
 
+	int luaGetTime( lua_State* io_luaState )
+	{
+		// The time is in seconds and is only meaningful compared to another time
+		// (os.clock() is the processor time that AssetBuilder has used, which doesn't include waiting for builders)
+		const std::chrono::steady_clock::duration time = std::chrono::steady_clock::now().time_since_epoch();
+		lua_pushnumber( io_luaState, std::chrono::duration<lua_Number>( time ).count() );
+		const int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	int luaNotifyRunningGame( lua_State* io_luaState )
+	{
+		// Argument #1: The target's path relative to the built asset directory
+		const char* i_path_target;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_path_target = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+
+		// It isn't an error if there's no game running
+		lua_pushboolean( io_luaState, SendHotReloadMessage( i_path_target ) );
+		const int returnValueCount = 1;
+		return returnValueCount;
+	}
+
 	int luaOutputErrorMessage( lua_State* io_luaState )
 	{
 		// Argument #1: The error message
@@ -392,4 +634,65 @@ namespace
 		const int returnValueCount = 0;
 		return returnValueCount;
 	}
+
+	int luaRunCommands( lua_State* io_luaState )
+	{
+		// Argument #1: An array of command lines
+		std::vector<std::string> commandLines;
+		if ( lua_istable( io_luaState, 1 ) )
+		{
+			const int commandCount = luaL_len( io_luaState, 1 );
+			for ( int i = 1; i <= commandCount; ++i )
+			{
+				lua_rawgeti( io_luaState, 1, i );
+				if ( lua_isstring( io_luaState, -1 ) )
+				{
+					commandLines.push_back( lua_tostring( io_luaState, -1 ) );
+					lua_pop( io_luaState, 1 );
+				}
+				else
+				{
+					return luaL_error( io_luaState,
+						"Argument #1 must only contain strings (instead of a %s at index %d)",
+						luaL_typename( io_luaState, -1 ), i );
+				}
+			}
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a table (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+
+		// Run the commands
+		std::vector<eae6320::AssetBuilder::sCommandResult> results;
+		const DWORD maxProcessCount = eae6320::AssetBuilder::RunCommands( commandLines, results );
+
+		// Return an array with a table for each command
+		// (it has the exit code and how long the command ran if the command was run
+		// and an error message if it wasn't)
+		// and how many commands could run at once
+		lua_createtable( io_luaState, static_cast<int>( results.size() ), 0 );
+		for ( size_t i = 0; i < results.size(); ++i )
+		{
+			lua_newtable( io_luaState );
+			if ( results[i].wasRun )
+			{
+				lua_pushnumber( io_luaState, static_cast<lua_Number>( results[i].exitCode ) );
+				lua_setfield( io_luaState, -2, "exitCode" );
+				lua_pushnumber( io_luaState, static_cast<lua_Number>( results[i].milliseconds ) );
+				lua_setfield( io_luaState, -2, "milliseconds" );
+			}
+			else
+			{
+				lua_pushstring( io_luaState, results[i].errorMessage.c_str() );
+				lua_setfield( io_luaState, -2, "errorMessage" );
+			}
+			lua_rawseti( io_luaState, -2, static_cast<int>( i + 1 ) );
+		}
+		lua_pushnumber( io_luaState, static_cast<lua_Number>( maxProcessCount ) );
+		const int returnValueCount = 2;
+		return returnValueCount;
+	}
 }
@@ -1,5 +1,8 @@
 /*
 	These functions are responsible for building assets
+
+	They need the same environment variables as the BuildAssets project
+	(ScriptDir, AuthoredAssetDir, BuiltAssetDir, and BinDir).
 */
 
 #ifndef EAE6320_ASSETBUILDER_HELPERFUNCTIONS_H
@@ -13,6 +16,11 @@ namespace eae6320
 	namespace AssetBuilder
 	{
 		bool BuildAssets();
+		// Builds every asset and then waits for authored assets to change and rebuilds them
+		// until the program is closed or something goes wrong.
+		// The asset pack isn't rebuilt while watching (a running game reads the rebuilt loose files),
+		// and a running game is told about every asset that is rebuilt (see HotReloadMessage.h)
+		bool WatchAssets();
 	}
 }
 
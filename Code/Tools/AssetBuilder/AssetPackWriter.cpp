@@ -0,0 +1,200 @@
+// Header Files
+//=============
+
+#include "AssetPackWriter.h"
+
+#include <cstdio>
+#include <sstream>
+#include "../../Engine/Graphics/AssetPackFile.h"
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	uint64_t Align( const uint64_t i_offset );
+	bool ReadFile( const std::string& i_path, std::vector<char>& o_contents, std::string* o_errorMessage );
+}
+
+// Interface
+//==========
+
+bool eae6320::AssetBuilder::WriteAssetPack( const std::string& i_path_pack, const std::string& i_directory, const std::vector<std::string>& i_relativePaths,
+	std::string* o_errorMessage )
+{
+	using namespace eae6320::Graphics;
+
+	bool wereThereErrors = false;
+	FILE* packFile = NULL;
+
+	// Lay out the table of contents
+	const uint32_t entryCount = static_cast<uint32_t>( i_relativePaths.size() );
+	// The table is kept at most half full so that lookups rarely need more than one probe
+	// (and so that there is always an empty slot to end a search)
+	uint32_t slotCount = 1;
+	while ( slotCount < ( entryCount * 2 ) )
+	{
+		slotCount *= 2;
+	}
+	std::vector<AssetPackFile::sEntry> tableOfContents( slotCount );
+	for ( uint32_t i = 0; i < slotCount; ++i )
+	{
+		tableOfContents[i].pathHash = AssetPackFile::s_emptyHash;
+		tableOfContents[i].offset = tableOfContents[i].size = 0;
+	}
+	std::vector<uint32_t> slots( entryCount );
+	for ( uint32_t i = 0; i < entryCount; ++i )
+	{
+		const uint64_t hash = AssetPackFile::HashPath( i_relativePaths[i].c_str() );
+		uint32_t slot = static_cast<uint32_t>( hash ) & ( slotCount - 1 );
+		while ( tableOfContents[slot].pathHash != AssetPackFile::s_emptyHash )
+		{
+			if ( tableOfContents[slot].pathHash == hash )
+			{
+				wereThereErrors = true;
+				if ( o_errorMessage )
+				{
+					std::stringstream errorMessage;
+					errorMessage << "\"" << i_relativePaths[i] << "\" has the same path hash as another asset in the pack"
+						" (either it is listed twice or the path needs to be renamed)";
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+			slot = ( slot + 1 ) & ( slotCount - 1 );
+		}
+		tableOfContents[slot].pathHash = hash;
+		slots[i] = slot;
+	}
+
+	// Write the pack
+	{
+		if ( fopen_s( &packFile, i_path_pack.c_str(), "wb" ) != 0 )
+		{
+			packFile = NULL;
+			wereThereErrors = true;
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = "The asset pack couldn't be opened for writing";
+			}
+			goto OnExit;
+		}
+
+		AssetPackFile::sHeader header;
+		header.magic = AssetPackFile::s_magic;
+		header.version = AssetPackFile::s_version;
+		header.entryCount = entryCount;
+		header.slotCount = slotCount;
+		header.tableOfContentsOffset = Align( sizeof( header ) );
+		const uint64_t contentsOffset = Align( header.tableOfContentsOffset + ( sizeof( AssetPackFile::sEntry ) * slotCount ) );
+
+		// The assets are written first, and the header and table of contents afterwards once the offsets are known
+		if ( fseek( packFile, static_cast<long>( contentsOffset ), SEEK_SET ) != 0 )
+		{
+			wereThereErrors = true;
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = "Failed to seek in the asset pack";
+			}
+			goto OnExit;
+		}
+		uint64_t offset = contentsOffset;
+		std::vector<char> contents;
+		for ( uint32_t i = 0; i < entryCount; ++i )
+		{
+			if ( !ReadFile( i_directory + i_relativePaths[i], contents, o_errorMessage ) )
+			{
+				wereThereErrors = true;
+				goto OnExit;
+			}
+			AssetPackFile::sEntry& entry = tableOfContents[slots[i]];
+			entry.offset = offset;
+			entry.size = contents.size();
+			// Every asset is followed by at least one zero byte and then padded to the alignment
+			const uint64_t nextOffset = Align( offset + entry.size + 1 );
+			contents.resize( static_cast<size_t>( nextOffset - offset ), '\0' );
+			if ( fwrite( &contents[0], 1, contents.size(), packFile ) != contents.size() )
+			{
+				wereThereErrors = true;
+				if ( o_errorMessage )
+				{
+					*o_errorMessage = std::string( "Failed to write \"" ) + i_relativePaths[i] + "\" into the asset pack";
+				}
+				goto OnExit;
+			}
+			offset = nextOffset;
+		}
+
+		const std::vector<char> padding( static_cast<size_t>( header.tableOfContentsOffset - sizeof( header ) ), '\0' );
+		if ( ( fseek( packFile, 0, SEEK_SET ) != 0 )
+			|| ( fwrite( &header, sizeof( header ), 1, packFile ) != 1 )
+			|| ( !padding.empty() && ( fwrite( &padding[0], 1, padding.size(), packFile ) != padding.size() ) )
+			|| ( fwrite( &tableOfContents[0], sizeof( AssetPackFile::sEntry ), slotCount, packFile ) != slotCount ) )
+		{
+			wereThereErrors = true;
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = "Failed to write the asset pack's table of contents";
+			}
+			goto OnExit;
+		}
+	}
+
+OnExit:
+
+	if ( packFile )
+	{
+		if ( fclose( packFile ) != 0 )
+		{
+			if ( !wereThereErrors && o_errorMessage )
+			{
+				*o_errorMessage = "Failed to close the asset pack";
+			}
+			wereThereErrors = true;
+		}
+		// A partial pack would be mounted (and fail) the next time the game runs
+		if ( wereThereErrors )
+		{
+			remove( i_path_pack.c_str() );
+		}
+	}
+
+	return !wereThereErrors;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	uint64_t Align( const uint64_t i_offset )
+	{
+		const uint64_t alignment = eae6320::Graphics::AssetPackFile::s_entryAlignment;
+		return ( i_offset + ( alignment - 1 ) ) & ~( alignment - 1 );
+	}
+
+	bool ReadFile( const std::string& i_path, std::vector<char>& o_contents, std::string* o_errorMessage )
+	{
+		FILE* file;
+		if ( fopen_s( &file, i_path.c_str(), "rb" ) != 0 )
+		{
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = std::string( "The built asset \"" ) + i_path + "\" couldn't be opened to be packed";
+			}
+			return false;
+		}
+		fseek( file, 0, SEEK_END );
+		const long fileSize = ftell( file );
+		rewind( file );
+		o_contents.resize( ( fileSize > 0 ) ? static_cast<size_t>( fileSize ) : 0 );
+		const bool wasReadSuccessful = o_contents.empty()
+			|| ( fread( &o_contents[0], 1, o_contents.size(), file ) == o_contents.size() );
+		fclose( file );
+		if ( !wasReadSuccessful && o_errorMessage )
+		{
+			*o_errorMessage = std::string( "The built asset \"" ) + i_path + "\" couldn't be read to be packed";
+		}
+		return wasReadSuccessful;
+	}
+}
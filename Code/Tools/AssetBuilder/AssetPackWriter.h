@@ -0,0 +1,29 @@
+/*
+	This file writes built assets into a single pack file
+	(the format is described in Engine/Graphics/AssetPackFile.h)
+*/
+
+#ifndef EAE6320_ASSETBUILDER_ASSETPACKWRITER_H
+#define EAE6320_ASSETBUILDER_ASSETPACKWRITER_H
+
+// Header Files
+//=============
+
+#include <string>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace AssetBuilder
+	{
+		// The paths are relative to the directory
+		// (which should be the directory that the pack is written to, since that's what the engine looks them up relative to)
+		bool WriteAssetPack( const std::string& i_path_pack, const std::string& i_directory, const std::vector<std::string>& i_relativePaths,
+			std::string* o_errorMessage = NULL );
+	}
+}
+
+#endif	// EAE6320_ASSETBUILDER_ASSETPACKWRITER_H
@@ -0,0 +1,142 @@
+// Header Files
+//=============
+
+#include "CommandRunner.h"
+
+#include <chrono>
+#include "../../Engine/Windows/WindowsFunctions.h"
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Waits for the process to finish and then closes it
+	void FinishProcess( const HANDLE i_process, const bool i_hasProcessFinished, const std::chrono::steady_clock::time_point i_startTime,
+		eae6320::AssetBuilder::sCommandResult& o_result );
+}
+
+// Interface
+//==========
+
+DWORD eae6320::AssetBuilder::RunCommands( const std::vector<std::string>& i_commandLines, std::vector<sCommandResult>& o_results )
+{
+	const size_t commandCount = i_commandLines.size();
+	o_results.assign( commandCount, sCommandResult() );
+
+	// Running more builders than there are processors would only make them take turns
+	DWORD maxProcessCount;
+	{
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo( &systemInfo );
+		maxProcessCount = systemInfo.dwNumberOfProcessors;
+		if ( maxProcessCount < 1 )
+		{
+			maxProcessCount = 1;
+		}
+		else if ( maxProcessCount > MAXIMUM_WAIT_OBJECTS )
+		{
+			maxProcessCount = MAXIMUM_WAIT_OBJECTS;
+		}
+	}
+
+	std::vector<HANDLE> runningProcesses;
+	std::vector<size_t> runningCommandIndices;
+	std::vector<std::chrono::steady_clock::time_point> runningStartTimes;
+	size_t nextCommandIndex = 0;
+	while ( ( nextCommandIndex < commandCount ) || !runningProcesses.empty() )
+	{
+		// Start as many commands as can run at once
+		while ( ( nextCommandIndex < commandCount ) && ( runningProcesses.size() < maxProcessCount ) )
+		{
+			const size_t commandIndex = nextCommandIndex++;
+			// CreateProcess() can modify the command line, and so it must be copied into a non-const buffer
+			std::vector<char> commandLine( i_commandLines[commandIndex].begin(), i_commandLines[commandIndex].end() );
+			commandLine.push_back( '\0' );
+			const char* commandLineHasProgram = NULL;
+			SECURITY_ATTRIBUTES* useDefaultAttributes = NULL;
+			// The builders write to the same console as AssetBuilder
+			const BOOL inheritHandles = TRUE;
+			const DWORD createDefaultProcess = 0;
+			void* useCallingProcessEnvironment = NULL;
+			const char* useCallingProcessCurrentDirectory = NULL;
+			STARTUPINFO startupInfo = { 0 };
+			{
+				startupInfo.cb = sizeof( startupInfo );
+			}
+			PROCESS_INFORMATION processInformation = { 0 };
+			const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			if ( CreateProcess( commandLineHasProgram, &commandLine[0], useDefaultAttributes, useDefaultAttributes,
+				inheritHandles, createDefaultProcess, useCallingProcessEnvironment, useCallingProcessCurrentDirectory,
+				&startupInfo, &processInformation ) != FALSE )
+			{
+				CloseHandle( processInformation.hThread );
+				runningProcesses.push_back( processInformation.hProcess );
+				runningCommandIndices.push_back( commandIndex );
+				runningStartTimes.push_back( startTime );
+			}
+			else
+			{
+				o_results[commandIndex].errorMessage = "Windows failed to start the process: " + GetLastWindowsError();
+			}
+		}
+		if ( runningProcesses.empty() )
+		{
+			continue;
+		}
+
+		// Wait for any of the running commands to finish
+		const DWORD runningProcessCount = static_cast<DWORD>( runningProcesses.size() );
+		const BOOL waitForAnyProcess = FALSE;
+		const DWORD result = WaitForMultipleObjects( runningProcessCount, &runningProcesses[0], waitForAnyProcess, INFINITE );
+		if ( ( result >= WAIT_OBJECT_0 ) && ( result < ( WAIT_OBJECT_0 + runningProcessCount ) ) )
+		{
+			const size_t finishedIndex = result - WAIT_OBJECT_0;
+			const bool hasProcessFinished = true;
+			FinishProcess( runningProcesses[finishedIndex], hasProcessFinished, runningStartTimes[finishedIndex],
+				o_results[runningCommandIndices[finishedIndex]] );
+			runningProcesses.erase( runningProcesses.begin() + finishedIndex );
+			runningCommandIndices.erase( runningCommandIndices.begin() + finishedIndex );
+			runningStartTimes.erase( runningStartTimes.begin() + finishedIndex );
+		}
+		else
+		{
+			// If waiting for all of them at once fails they are waited for one at a time
+			const bool hasProcessFinished = false;
+			for ( size_t i = 0; i < runningProcesses.size(); ++i )
+			{
+				FinishProcess( runningProcesses[i], hasProcessFinished, runningStartTimes[i], o_results[runningCommandIndices[i]] );
+			}
+			runningProcesses.clear();
+			runningCommandIndices.clear();
+			runningStartTimes.clear();
+		}
+	}
+
+	return maxProcessCount;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void FinishProcess( const HANDLE i_process, const bool i_hasProcessFinished, const std::chrono::steady_clock::time_point i_startTime,
+		eae6320::AssetBuilder::sCommandResult& o_result )
+	{
+		if ( !i_hasProcessFinished && ( WaitForSingleObject( i_process, INFINITE ) == WAIT_FAILED ) )
+		{
+			o_result.errorMessage = "Windows failed to wait for the process to finish: " + eae6320::GetLastWindowsError();
+		}
+		else if ( GetExitCodeProcess( i_process, &o_result.exitCode ) != FALSE )
+		{
+			o_result.wasRun = true;
+			o_result.milliseconds = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - i_startTime ).count();
+		}
+		else
+		{
+			o_result.errorMessage = "Windows failed to get the exit code of the process: " + eae6320::GetLastWindowsError();
+		}
+		CloseHandle( i_process );
+	}
+}
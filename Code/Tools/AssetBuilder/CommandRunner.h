@@ -0,0 +1,45 @@
+/*
+	This file runs builders in separate processes at the same time
+	(BuildAssets.lua uses it to build every asset whose dependencies have already been built at once)
+*/
+
+#ifndef EAE6320_ASSETBUILDER_COMMANDRUNNER_H
+#define EAE6320_ASSETBUILDER_COMMANDRUNNER_H
+
+// Header Files
+//=============
+
+#include <string>
+#include <vector>
+#include "../../Engine/Windows/Includes.h"
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace AssetBuilder
+	{
+		struct sCommandResult
+		{
+			// The exit code is only valid if the command was run
+			// (otherwise the error message says why it wasn't)
+			bool wasRun;
+			DWORD exitCode;
+			std::string errorMessage;
+			// How long the process ran for (including starting it)
+			double milliseconds;
+
+			sCommandResult() : wasRun( false ), exitCode( 0 ), milliseconds( 0.0 ) {}
+		};
+
+		// Each command line is the quoted path of a program followed by its arguments.
+		// As many commands are run at once as there are processors,
+		// and this returns when all of them have finished
+		// (the results are in the same order as the commands).
+		// The return value is how many commands can run at once
+		DWORD RunCommands( const std::vector<std::string>& i_commandLines, std::vector<sCommandResult>& o_results );
+	}
+}
+
+#endif	// EAE6320_ASSETBUILDER_COMMANDRUNNER_H
@@ -7,13 +7,16 @@
 
 #include "AssetBuilder.h"
 #include <cstdlib>
+#include <cstring>
 
 // Entry Point
 //============
 
 int main( int i_argumentCount, char** i_arguments )
 {
-	if ( eae6320::AssetBuilder::BuildAssets() )
+	// "-watch" keeps rebuilding assets as they change
+	const bool shouldWatch = ( i_argumentCount > 1 ) && ( strcmp( i_arguments[1], "-watch" ) == 0 );
+	if ( shouldWatch ? eae6320::AssetBuilder::WatchAssets() : eae6320::AssetBuilder::BuildAssets() )
 	{
 		return EXIT_SUCCESS;
 	}
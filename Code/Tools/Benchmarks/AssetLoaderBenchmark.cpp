@@ -0,0 +1,241 @@
+/*
+	This compares loading hundreds of meshes synchronously on the calling thread
+	with loading them in the background with the AssetLoader
+
+	A synchronous load stalls the thread until every mesh has been read and decoded,
+	and so what matters for the AssetLoader is not only how long it takes to finish
+	but also how long the calling thread is busy in any one Update() (which is what a frame would stall for)
+*/
+
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../Engine/Core/JobSystem.h"
+#include "../../Engine/Graphics/AssetLoader.h"
+#include "../../Engine/Graphics/Renderable.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const unsigned int s_assetCount = 400;
+	// The shipped meshes are copied to this many different files
+	// so that each load reads its own file
+	const char* const s_sourceMeshPaths[] = { "data/triangle.msh", "data/rectangle.msh" };
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	bool CopyMeshes( std::vector<std::string>& o_paths );
+	void DeleteMeshes( const std::vector<std::string>& i_paths );
+	bool TimeSynchronousLoads( const std::vector<std::string>& i_paths, double& o_milliseconds );
+	bool TimeAsynchronousLoads( const std::vector<std::string>& i_paths,
+		double& o_millisecondsToRequest, double& o_millisecondsToFinish, double& o_longestUpdateMilliseconds, unsigned int& o_updateCount );
+	void ShutDown( std::vector<eae6320::Graphics::Renderable>& io_renderables );
+	// This is the same as the game's dispatcher
+	void DecodeAssetOnJobSystem( const eae6320::Graphics::AssetLoader::tDecodeFunction i_function, void* io_request );
+}
+
+// Interface
+//==========
+
+bool eae6320::Benchmarks::AssetLoaderVersusSynchronousLoads()
+{
+	if ( !InitializeGraphics() )
+	{
+		return false;
+	}
+
+	bool wereThereErrors = false;
+
+	std::vector<std::string> paths;
+	double synchronousMilliseconds;
+	double millisecondsToRequest, millisecondsToFinish, longestUpdateMilliseconds;
+	unsigned int updateCount;
+	if ( !CopyMeshes( paths ) )
+	{
+		wereThereErrors = true;
+		goto OnExit;
+	}
+	if ( !TimeSynchronousLoads( paths, synchronousMilliseconds )
+		|| !TimeAsynchronousLoads( paths, millisecondsToRequest, millisecondsToFinish, longestUpdateMilliseconds, updateCount ) )
+	{
+		wereThereErrors = true;
+		goto OnExit;
+	}
+	std::cout << s_assetCount << " meshes\n"
+		<< "\tSynchronous:\t" << synchronousMilliseconds << " ms, all of it on the calling thread\n"
+		<< "\tAssetLoader:\t" << millisecondsToFinish << " ms until every mesh was loaded"
+		<< " (" << millisecondsToRequest << " ms to request the loads and then "
+		<< updateCount << " calls to Update() that took at most " << longestUpdateMilliseconds << " ms each)\n";
+
+OnExit:
+
+	DeleteMeshes( paths );
+
+	return !wereThereErrors;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool CopyMeshes( std::vector<std::string>& o_paths )
+	{
+		const unsigned int sourceMeshCount = sizeof( s_sourceMeshPaths ) / sizeof( s_sourceMeshPaths[0] );
+		std::string sourceMeshes[sourceMeshCount];
+		for ( unsigned int i = 0; i < sourceMeshCount; ++i )
+		{
+			std::ifstream file( s_sourceMeshPaths[i], std::ios::binary );
+			if ( !file )
+			{
+				std::cerr << "The mesh " << s_sourceMeshPaths[i] << " couldn't be opened (is the benchmark running from the game directory?)\n";
+				return false;
+			}
+			std::ostringstream contents;
+			contents << file.rdbuf();
+			sourceMeshes[i] = contents.str();
+		}
+		for ( unsigned int i = 0; i < s_assetCount; ++i )
+		{
+			std::ostringstream path;
+			path << "data/AssetLoaderBenchmark" << i << ".msh";
+			std::ofstream file( path.str().c_str(), std::ios::binary );
+			if ( !file )
+			{
+				std::cerr << "The mesh " << path.str() << " couldn't be created\n";
+				return false;
+			}
+			o_paths.push_back( path.str() );
+			const std::string& sourceMesh = sourceMeshes[i % sourceMeshCount];
+			if ( !file.write( sourceMesh.data(), sourceMesh.size() ) )
+			{
+				std::cerr << "The mesh " << path.str() << " couldn't be written\n";
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void DeleteMeshes( const std::vector<std::string>& i_paths )
+	{
+		for ( std::vector<std::string>::const_iterator i = i_paths.begin(); i != i_paths.end(); ++i )
+		{
+			std::remove( i->c_str() );
+		}
+	}
+
+	bool TimeSynchronousLoads( const std::vector<std::string>& i_paths, double& o_milliseconds )
+	{
+		std::vector<eae6320::Graphics::Renderable> renderables( i_paths.size() );
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for ( size_t i = 0; i < i_paths.size(); ++i )
+		{
+			if ( !renderables[i].Initialize( i_paths[i].c_str() ) )
+			{
+				std::cerr << "The mesh " << i_paths[i] << " couldn't be loaded\n";
+				ShutDown( renderables );
+				return false;
+			}
+		}
+		o_milliseconds = eae6320::Benchmarks::GetMillisecondsSince( start );
+		ShutDown( renderables );
+		return true;
+	}
+
+	bool TimeAsynchronousLoads( const std::vector<std::string>& i_paths,
+		double& o_millisecondsToRequest, double& o_millisecondsToFinish, double& o_longestUpdateMilliseconds, unsigned int& o_updateCount )
+	{
+		bool wereThereErrors = false;
+
+		std::vector<eae6320::Graphics::Renderable> renderables( i_paths.size() );
+		// The loader is set up the same way that the game sets it up
+		if ( !eae6320::Core::JobSystem::Initialize() )
+		{
+			std::cerr << "The job system couldn't be initialized\n";
+			return false;
+		}
+		if ( !eae6320::Graphics::AssetLoader::Initialize() )
+		{
+			std::cerr << "The asset loader couldn't be initialized\n";
+			eae6320::Core::JobSystem::ShutDown();
+			return false;
+		}
+		eae6320::Graphics::AssetLoader::SetDecodeDispatcher( DecodeAssetOnJobSystem );
+
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for ( size_t i = 0; i < i_paths.size(); ++i )
+			{
+				if ( !renderables[i].InitializeAsync( i_paths[i].c_str() ) )
+				{
+					std::cerr << "The mesh " << i_paths[i] << " couldn't be requested\n";
+					wereThereErrors = true;
+					goto OnExit;
+				}
+			}
+			o_millisecondsToRequest = eae6320::Benchmarks::GetMillisecondsSince( start );
+
+			o_longestUpdateMilliseconds = 0.0;
+			o_updateCount = 0;
+			while ( eae6320::Graphics::AssetLoader::GetPendingLoadCount() > 0 )
+			{
+				const std::chrono::steady_clock::time_point updateStart = std::chrono::steady_clock::now();
+				eae6320::Graphics::AssetLoader::Update();
+				o_longestUpdateMilliseconds = std::max( o_longestUpdateMilliseconds, eae6320::Benchmarks::GetMillisecondsSince( updateStart ) );
+				++o_updateCount;
+				// A game would do the rest of its frame here
+				std::this_thread::yield();
+			}
+			o_millisecondsToFinish = eae6320::Benchmarks::GetMillisecondsSince( start );
+		}
+		if ( eae6320::Graphics::AssetLoader::GetStats().loadsFailed > 0 )
+		{
+			std::cerr << eae6320::Graphics::AssetLoader::GetStats().loadsFailed << " of the meshes couldn't be loaded (see the log for details)\n";
+			wereThereErrors = true;
+		}
+
+	OnExit:
+
+		ShutDown( renderables );
+		eae6320::Graphics::AssetLoader::ShutDown();
+		eae6320::Core::JobSystem::ShutDown();
+
+		return !wereThereErrors;
+	}
+
+	void ShutDown( std::vector<eae6320::Graphics::Renderable>& io_renderables )
+	{
+		for ( std::vector<eae6320::Graphics::Renderable>::iterator i = io_renderables.begin(); i != io_renderables.end(); ++i )
+		{
+			i->ShutDown();
+		}
+	}
+
+	void DecodeAssetOnJobSystem( const eae6320::Graphics::AssetLoader::tDecodeFunction i_function, void* io_request )
+	{
+		if ( eae6320::Core::JobSystem::GetThreadCount() > 1 )
+		{
+			eae6320::Core::JobSystem::Run( i_function, io_request );
+		}
+		else
+		{
+			i_function( io_request );
+		}
+	}
+}
@@ -0,0 +1,130 @@
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+
+#include <iostream>
+#include <random>
+#include "../../Engine/Core/EntityStore.h"
+#include "../../Engine/Graphics/Graphics.h"
+#include "../../Engine/Windows/WindowsFunctions.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const char* const s_windowClassName = "EAE6320 Benchmarks";
+	HWND s_window = NULL;
+	bool s_isGraphicsInitialized = false;
+	const char* const s_entityMeshPath = "data/triangle.msh";
+}
+
+// Interface
+//==========
+
+// Helpers
+//--------
+
+bool eae6320::Benchmarks::InitializeGraphics()
+{
+	if ( s_isGraphicsInitialized )
+	{
+		return true;
+	}
+
+	const HINSTANCE thisInstanceOfTheProgram = GetModuleHandle( NULL );
+	if ( !s_window )
+	{
+		WNDCLASSEXA windowClass = { 0 };
+		windowClass.cbSize = sizeof( WNDCLASSEXA );
+		windowClass.lpfnWndProc = DefWindowProcA;
+		windowClass.hInstance = thisInstanceOfTheProgram;
+		windowClass.lpszClassName = s_windowClassName;
+		if ( RegisterClassExA( &windowClass ) == NULL )
+		{
+			std::cerr << "Windows failed to register the window class: " << GetLastWindowsError() << "\n";
+			return false;
+		}
+		// The window is only needed for the graphics context, and so it is never shown
+		s_window = CreateWindowExA( 0, s_windowClassName, s_windowClassName, WS_OVERLAPPEDWINDOW,
+			CW_USEDEFAULT, CW_USEDEFAULT, 512, 512, NULL, NULL, thisInstanceOfTheProgram, NULL );
+		if ( !s_window )
+		{
+			std::cerr << "Windows failed to create the window: " << GetLastWindowsError() << "\n";
+			UnregisterClassA( s_windowClassName, thisInstanceOfTheProgram );
+			return false;
+		}
+	}
+	if ( !Graphics::Initialize( s_window ) )
+	{
+		std::cerr << "The graphics context couldn't be created\n";
+		return false;
+	}
+	s_isGraphicsInitialized = true;
+	return true;
+}
+
+bool eae6320::Benchmarks::ShutDownGraphics()
+{
+	bool wereThereErrors = false;
+
+	if ( s_isGraphicsInitialized )
+	{
+		if ( !Graphics::ShutDown() )
+		{
+			wereThereErrors = true;
+		}
+		s_isGraphicsInitialized = false;
+	}
+	if ( s_window )
+	{
+		if ( DestroyWindow( s_window ) == FALSE )
+		{
+			std::cerr << "Windows failed to destroy the window: " << GetLastWindowsError() << "\n";
+			wereThereErrors = true;
+		}
+		s_window = NULL;
+		UnregisterClassA( s_windowClassName, GetModuleHandle( NULL ) );
+	}
+
+	return !wereThereErrors;
+}
+
+double eae6320::Benchmarks::GetMillisecondsSince( const std::chrono::steady_clock::time_point& i_start )
+{
+	return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - i_start ).count();
+}
+
+bool eae6320::Benchmarks::PopulateEntityStore( Core::EntityStore& io_entityStore, const unsigned int i_entityCount )
+{
+	io_entityStore.Reserve( i_entityCount );
+	const Core::sEntityHandle source = io_entityStore.Create( s_entityMeshPath );
+	if ( source == Core::InvalidEntity )
+	{
+		std::cerr << "The mesh " << s_entityMeshPath << " couldn't be loaded (is the benchmark running from the game directory?)\n";
+		return false;
+	}
+	for ( unsigned int i = 1; i < i_entityCount; ++i )
+	{
+		if ( io_entityStore.Create( source ) == Core::InvalidEntity )
+		{
+			return false;
+		}
+	}
+
+	std::mt19937 randomNumbers( 0 );
+	std::uniform_real_distribution<float> distribution( -1.0f, 1.0f );
+	float* const positionsX = io_entityStore.GetPositionsX();
+	float* const positionsY = io_entityStore.GetPositionsY();
+	float* const velocitiesX = io_entityStore.GetVelocitiesX();
+	float* const velocitiesY = io_entityStore.GetVelocitiesY();
+	for ( size_t i = 0; i < io_entityStore.GetCount(); ++i )
+	{
+		positionsX[i] = distribution( randomNumbers );
+		positionsY[i] = distribution( randomNumbers );
+		velocitiesX[i] = distribution( randomNumbers );
+		velocitiesY[i] = distribution( randomNumbers );
+	}
+	return true;
+}
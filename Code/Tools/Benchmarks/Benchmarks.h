@@ -0,0 +1,78 @@
+/*
+	The benchmarks measure the engine's systems
+	so that a change to one of them can be compared with what it replaced on the same machine
+
+	Every benchmark is a function that prints its results.
+	EntryPoint.cpp lists them,
+	and the program runs the ones that are named on its command line (or all of them if none are).
+	Benchmarks that load meshes must be run from the game directory so that the built assets in data/ are found.
+*/
+
+#ifndef EAE6320_BENCHMARKS_H
+#define EAE6320_BENCHMARKS_H
+
+// Header Files
+//=============
+
+#include <chrono>
+
+namespace eae6320
+{
+	namespace Core
+	{
+		class EntityStore;
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Benchmarks
+	{
+		// Returns false if the benchmark couldn't be run
+		typedef bool ( *tBenchmark )();
+
+		// Helpers
+		//--------
+
+		// Meshes and effects can't be loaded without a graphics context,
+		// and so this creates a window that is never shown and initializes graphics with it.
+		// It only does anything the first time that it's called;
+		// graphics stays initialized until ShutDownGraphics()
+		bool InitializeGraphics();
+		bool ShutDownGraphics();
+
+		double GetMillisecondsSince( const std::chrono::steady_clock::time_point& i_start );
+
+		// Creates i_entityCount entities that share one renderable
+		// at random positions with random velocities (the same ones every time)
+		bool PopulateEntityStore( Core::EntityStore& io_entityStore, const unsigned int i_entityCount );
+
+		// Benchmarks
+		//-----------
+
+		// Moves 100,000 entities and updates their renderables,
+		// both in the EntityStore and as a graph of individually allocated GameObjects
+		bool EntityStoreVersusGameObjects();
+		// Moves the same entities with the job system running inline
+		// and then with 1, 2, 4, ... worker threads up to one per core
+		bool JobSystemScaling();
+		// Parses a big generated mesh source file in Lua states from luaL_newstate() and from cLuaAllocator
+		bool LuaAllocatorVersusCrt();
+		// Measures how long logging a message takes with the asynchronous log and with fprintf()
+		bool LogLatency();
+		// Loads 400 meshes synchronously and then in the background with the AssetLoader
+		bool AssetLoaderVersusSynchronousLoads();
+		// Reads and decodes a big mesh that isn't in the file cache, both uncompressed and compressed
+		bool CompressedVersusRawMeshes();
+		// Sorts, records, and executes 20,000 draw packets with the software rasterizer as the backend
+		bool RenderQueueRecording();
+		// Executes 10,000 draws with their constants uploaded through the UniformRingBuffer
+		// and then with each draw's constants set on their own by Effect::SetDrawCallUniforms()
+		bool UniformRingBufferVersusPerDrawUniforms();
+	}
+}
+
+#endif	// EAE6320_BENCHMARKS_H
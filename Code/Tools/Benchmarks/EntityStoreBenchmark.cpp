@@ -0,0 +1,152 @@
+/*
+	This compares moving entities in the EntityStore's dense arrays
+	with moving the same number of GameObjects that were each allocated on their own
+
+	The GameObjects are visited in a shuffled order
+	so that following the pointers jumps around memory the way that it does in a game
+	where objects are created and destroyed at different times
+*/
+
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../../Engine/Core/EntityStore.h"
+#include "../../Engine/Core/GameObject.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const unsigned int s_entityCount = 100000;
+	const unsigned int s_frameCount = 200;
+	const float s_secondsPerFrame = 1.0f / 60.0f;
+	const char* const s_meshPath = "data/triangle.msh";
+
+	// GameObject doesn't have a velocity,
+	// and so it is kept next to the pointer the way that a game's own object would keep it
+	struct sMovingGameObject
+	{
+		eae6320::Core::GameObject* gameObject;
+		eae6320::Math::cVector velocity;
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	bool TimeGameObjects( double& o_millisecondsPerFrame );
+	bool TimeEntityStore( double& o_millisecondsPerFrame );
+}
+
+// Interface
+//==========
+
+bool eae6320::Benchmarks::EntityStoreVersusGameObjects()
+{
+	if ( !InitializeGraphics() )
+	{
+		return false;
+	}
+
+	double gameObjectMilliseconds, entityStoreMilliseconds;
+	if ( !TimeGameObjects( gameObjectMilliseconds ) || !TimeEntityStore( entityStoreMilliseconds ) )
+	{
+		return false;
+	}
+	std::cout << s_entityCount << " entities, " << s_frameCount << " frames\n"
+		<< "\tGameObjects:\t" << gameObjectMilliseconds << " ms/frame\n"
+		<< "\tEntityStore:\t" << entityStoreMilliseconds << " ms/frame\n"
+		<< "\tThe EntityStore is " << ( gameObjectMilliseconds / entityStoreMilliseconds ) << "x as fast\n";
+	return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool TimeGameObjects( double& o_millisecondsPerFrame )
+	{
+		bool wereThereErrors = false;
+
+		std::mt19937 randomNumbers( 0 );
+		std::uniform_real_distribution<float> distribution( -1.0f, 1.0f );
+		eae6320::Core::GameObject source;
+		std::vector<sMovingGameObject> gameObjects;
+		if ( !source.Initialize( s_meshPath ) )
+		{
+			std::cerr << "The mesh " << s_meshPath << " couldn't be loaded (is the benchmark running from the game directory?)\n";
+			return false;
+		}
+		gameObjects.reserve( s_entityCount );
+		for ( unsigned int i = 0; i < s_entityCount; ++i )
+		{
+			sMovingGameObject movingGameObject;
+			movingGameObject.gameObject = new eae6320::Core::GameObject;
+			if ( !movingGameObject.gameObject->Initialize( source ) )
+			{
+				delete movingGameObject.gameObject;
+				wereThereErrors = true;
+				goto OnExit;
+			}
+			movingGameObject.gameObject->Position = eae6320::Math::cVector( distribution( randomNumbers ), distribution( randomNumbers ) );
+			movingGameObject.velocity = eae6320::Math::cVector( distribution( randomNumbers ), distribution( randomNumbers ) );
+			gameObjects.push_back( movingGameObject );
+		}
+		std::shuffle( gameObjects.begin(), gameObjects.end(), randomNumbers );
+
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for ( unsigned int frame = 0; frame < s_frameCount; ++frame )
+			{
+				for ( size_t i = 0; i < gameObjects.size(); ++i )
+				{
+					sMovingGameObject& movingGameObject = gameObjects[i];
+					movingGameObject.gameObject->Position += movingGameObject.velocity * s_secondsPerFrame;
+					movingGameObject.gameObject->Update();
+				}
+			}
+			o_millisecondsPerFrame = eae6320::Benchmarks::GetMillisecondsSince( start ) / s_frameCount;
+		}
+
+	OnExit:
+
+		// The objects that share the source's renderable must be shut down before it is
+		for ( size_t i = 0; i < gameObjects.size(); ++i )
+		{
+			gameObjects[i].gameObject->ShutDown();
+			delete gameObjects[i].gameObject;
+		}
+		source.ShutDown();
+
+		return !wereThereErrors;
+	}
+
+	bool TimeEntityStore( double& o_millisecondsPerFrame )
+	{
+		eae6320::Core::EntityStore entityStore;
+		if ( !eae6320::Benchmarks::PopulateEntityStore( entityStore, s_entityCount ) )
+		{
+			return false;
+		}
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for ( unsigned int frame = 0; frame < s_frameCount; ++frame )
+		{
+			entityStore.Integrate( s_secondsPerFrame );
+			entityStore.UpdateRenderables();
+		}
+		o_millisecondsPerFrame = eae6320::Benchmarks::GetMillisecondsSince( start ) / s_frameCount;
+
+		return true;
+	}
+}
@@ -0,0 +1,88 @@
+/*
+	The main() function is where the program starts execution
+
+	Usage (from the game directory):
+		Benchmarks.exe [benchmark name...]
+*/
+
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "../../Engine/UserOutput/Log.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	struct sBenchmark
+	{
+		// What the benchmark is called on the command line
+		const char* name;
+		eae6320::Benchmarks::tBenchmark function;
+	};
+	const sBenchmark s_benchmarks[] =
+	{
+		{ "assets", eae6320::Benchmarks::AssetLoaderVersusSynchronousLoads },
+		{ "entities", eae6320::Benchmarks::EntityStoreVersusGameObjects },
+		{ "jobs", eae6320::Benchmarks::JobSystemScaling },
+		{ "log", eae6320::Benchmarks::LogLatency },
+		{ "lua", eae6320::Benchmarks::LuaAllocatorVersusCrt },
+		{ "meshes", eae6320::Benchmarks::CompressedVersusRawMeshes },
+		{ "recording", eae6320::Benchmarks::RenderQueueRecording },
+		{ "uniforms", eae6320::Benchmarks::UniformRingBufferVersusPerDrawUniforms },
+	};
+	const unsigned int s_benchmarkCount = sizeof( s_benchmarks ) / sizeof( s_benchmarks[0] );
+}
+
+// Entry Point
+//============
+
+int main( int i_argumentCount, char** i_arguments )
+{
+	// Errors about loading assets are written to the log
+	eae6320::UserOutput::Log::Initialize( "Benchmarks.log" );
+
+	bool wereThereErrors = false;
+	unsigned int runCount = 0;
+	for ( unsigned int i = 0; i < s_benchmarkCount; ++i )
+	{
+		const sBenchmark& benchmark = s_benchmarks[i];
+		bool shouldRun = i_argumentCount < 2;
+		for ( int j = 1; ( j < i_argumentCount ) && !shouldRun; ++j )
+		{
+			shouldRun = strcmp( i_arguments[j], benchmark.name ) == 0;
+		}
+		if ( shouldRun )
+		{
+			std::cout << "== " << benchmark.name << " ==\n";
+			if ( !benchmark.function() )
+			{
+				std::cerr << benchmark.name << " couldn't be run\n";
+				wereThereErrors = true;
+			}
+			++runCount;
+		}
+	}
+	if ( runCount == 0 )
+	{
+		std::cerr << "None of the benchmarks were run. They are:\n";
+		for ( unsigned int i = 0; i < s_benchmarkCount; ++i )
+		{
+			std::cerr << "\t" << s_benchmarks[i].name << "\n";
+		}
+		wereThereErrors = true;
+	}
+
+	if ( !eae6320::Benchmarks::ShutDownGraphics() )
+	{
+		wereThereErrors = true;
+	}
+	eae6320::UserOutput::Log::ShutDown();
+
+	return wereThereErrors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
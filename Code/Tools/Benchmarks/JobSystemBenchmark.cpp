@@ -0,0 +1,105 @@
+/*
+	This measures how the EntityStore's systems scale with the number of job system threads
+
+	The same entities are moved with the job system uninitialized (so that everything runs inline)
+	and then initialized with 1, 2, 4, ... threads up to one per hardware core
+*/
+
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include "../../Engine/Core/EntityStore.h"
+#include "../../Engine/Core/JobSystem.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const unsigned int s_entityCount = 100000;
+	const unsigned int s_frameCount = 200;
+	const float s_secondsPerFrame = 1.0f / 60.0f;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	double TimeFrames( eae6320::Core::EntityStore& io_entityStore );
+}
+
+// Interface
+//==========
+
+bool eae6320::Benchmarks::JobSystemScaling()
+{
+	if ( !InitializeGraphics() )
+	{
+		return false;
+	}
+
+	Core::EntityStore entityStore;
+	if ( !PopulateEntityStore( entityStore, s_entityCount ) )
+	{
+		return false;
+	}
+
+	std::cout << s_entityCount << " entities, " << s_frameCount << " frames of Integrate() and UpdateRenderables()\n";
+	const double inlineMilliseconds = TimeFrames( entityStore );
+	std::cout << "\tinline:\t\t" << inlineMilliseconds << " ms/frame\n";
+
+	// hardware_concurrency() is allowed to return 0 if it doesn't know
+	const unsigned int coreCount = std::max( std::thread::hardware_concurrency(), 1u );
+	for ( unsigned int threadCount = 1; ; threadCount = std::min( threadCount * 2, coreCount ) )
+	{
+		if ( !Core::JobSystem::Initialize( threadCount ) )
+		{
+			std::cerr << "The job system couldn't be initialized with " << threadCount << " threads\n";
+			return false;
+		}
+		Core::JobSystem::ResetStats();
+		const double milliseconds = TimeFrames( entityStore );
+		const Core::JobSystem::sJobSystemStats stats = Core::JobSystem::GetStats();
+		if ( !Core::JobSystem::ShutDown() )
+		{
+			return false;
+		}
+		std::cout << "\t" << threadCount << ( threadCount == 1 ? " thread:\t" : " threads:\t" ) << milliseconds << " ms/frame"
+			<< " (" << ( inlineMilliseconds / milliseconds ) << "x inline";
+		// ParallelFor() runs everything on the calling thread when there is only one thread
+		if ( stats.jobsRun > 0 )
+		{
+			std::cout << ", " << stats.jobsStolen << " of " << stats.jobsRun << " jobs stolen";
+		}
+		std::cout << ")\n";
+		if ( threadCount == coreCount )
+		{
+			break;
+		}
+	}
+
+	return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	double TimeFrames( eae6320::Core::EntityStore& io_entityStore )
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for ( unsigned int frame = 0; frame < s_frameCount; ++frame )
+		{
+			io_entityStore.Integrate( s_secondsPerFrame );
+			io_entityStore.UpdateRenderables();
+		}
+		return eae6320::Benchmarks::GetMillisecondsSince( start ) / s_frameCount;
+	}
+}
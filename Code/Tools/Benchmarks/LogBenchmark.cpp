@@ -0,0 +1,116 @@
+/*
+	This measures how long the thread that logs a message is kept busy by it,
+	both with the asynchronous log and with a message that is formatted and written immediately
+
+	Messages are logged in small batches and the log is flushed between them
+	so that the thread's buffer never fills up (a full buffer would drop messages, which is faster than logging them).
+	The logged messages end up in Benchmarks.log
+*/
+
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../Engine/UserOutput/Log.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const unsigned int s_batchCount = 200;
+	const unsigned int s_messagesPerBatch = 64;
+	// The arguments are the kinds that the engine logs: a number, a floating point number, and a std::string
+	const std::string s_frameDescription( "benchmark" );
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// These output the nanoseconds per message of every batch, sorted
+	void TimeAsynchronousMessages( std::vector<double>& o_nanosecondsPerMessage );
+	bool TimeSynchronousMessages( std::vector<double>& o_nanosecondsPerMessage );
+	double GetPercentile( const std::vector<double>& i_sortedValues, const double i_percentile );
+}
+
+// Interface
+//==========
+
+bool eae6320::Benchmarks::LogLatency()
+{
+	const UserOutput::Log::sStats statsBefore = UserOutput::Log::GetStats();
+	std::vector<double> asynchronousNanoseconds;
+	TimeAsynchronousMessages( asynchronousNanoseconds );
+	const UserOutput::Log::sStats statsAfter = UserOutput::Log::GetStats();
+	std::vector<double> synchronousNanoseconds;
+	if ( !TimeSynchronousMessages( synchronousNanoseconds ) )
+	{
+		return false;
+	}
+	std::cout << ( s_batchCount * s_messagesPerBatch ) << " messages like \"frame %d took %f ms (%s)\"\n"
+		<< "\tLog:\t\t" << GetPercentile( asynchronousNanoseconds, 0.5 ) << " ns/message (the median batch), "
+		<< GetPercentile( asynchronousNanoseconds, 0.99 ) << " ns/message (the 99th percentile batch), "
+		<< ( statsAfter.messagesDropped - statsBefore.messagesDropped ) << " dropped\n"
+		<< "\tfprintf():\t" << GetPercentile( synchronousNanoseconds, 0.5 ) << " ns/message (the median batch), "
+		<< GetPercentile( synchronousNanoseconds, 0.99 ) << " ns/message (the 99th percentile batch)\n";
+	return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void TimeAsynchronousMessages( std::vector<double>& o_nanosecondsPerMessage )
+	{
+		for ( unsigned int batch = 0; batch < s_batchCount; ++batch )
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for ( unsigned int i = 0; i < s_messagesPerBatch; ++i )
+			{
+				EAE6320_LOG_INFO( "frame %d took %f ms (%s)", static_cast<int>( ( batch * s_messagesPerBatch ) + i ), 16.6, s_frameDescription );
+			}
+			o_nanosecondsPerMessage.push_back( ( eae6320::Benchmarks::GetMillisecondsSince( start ) * 1000000.0 ) / s_messagesPerBatch );
+			eae6320::UserOutput::Log::Flush();
+		}
+		std::sort( o_nanosecondsPerMessage.begin(), o_nanosecondsPerMessage.end() );
+	}
+
+	bool TimeSynchronousMessages( std::vector<double>& o_nanosecondsPerMessage )
+	{
+		// The file is deleted when it is closed
+		FILE* const file = std::tmpfile();
+		if ( !file )
+		{
+			std::cerr << "A temporary file couldn't be created\n";
+			return false;
+		}
+		for ( unsigned int batch = 0; batch < s_batchCount; ++batch )
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for ( unsigned int i = 0; i < s_messagesPerBatch; ++i )
+			{
+				// A synchronous log has to flush every message so that nothing is lost if the program crashes
+				fprintf( file, "frame %d took %f ms (%s)\n", static_cast<int>( ( batch * s_messagesPerBatch ) + i ), 16.6, s_frameDescription.c_str() );
+				fflush( file );
+			}
+			o_nanosecondsPerMessage.push_back( ( eae6320::Benchmarks::GetMillisecondsSince( start ) * 1000000.0 ) / s_messagesPerBatch );
+		}
+		fclose( file );
+		std::sort( o_nanosecondsPerMessage.begin(), o_nanosecondsPerMessage.end() );
+		return true;
+	}
+
+	double GetPercentile( const std::vector<double>& i_sortedValues, const double i_percentile )
+	{
+		return i_sortedValues[static_cast<size_t>( i_percentile * ( i_sortedValues.size() - 1 ) )];
+	}
+}
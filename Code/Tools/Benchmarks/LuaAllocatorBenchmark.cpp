@@ -0,0 +1,138 @@
+/*
+	This compares parsing a big mesh source file in a Lua state from luaL_newstate()
+	with parsing it in a state that gets its memory from cLuaAllocator
+
+	The source is generated in the same layout as the meshes in the Assets directory
+	so that Lua allocates the same kinds of tables and strings that MeshBuilder makes it allocate
+*/
+
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../BuilderHelper/cLuaAllocator.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const unsigned int s_vertexCount = 250000;
+	// Each allocator parses the source this many times and the median is reported
+	const unsigned int s_runCount = 5;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	std::string GenerateMeshSource();
+	// Loads and runs the source in a new state every run and returns the median number of milliseconds.
+	// If the allocator should be used each run's state gets a new cLuaAllocator
+	bool TimeParsing( const std::string& i_source, const bool i_shouldUseAllocator, double& o_milliseconds,
+		eae6320::cLuaAllocator::sStats& o_allocatorStats );
+}
+
+// Interface
+//==========
+
+bool eae6320::Benchmarks::LuaAllocatorVersusCrt()
+{
+	const std::string source = GenerateMeshSource();
+
+	double crtMilliseconds, allocatorMilliseconds;
+	cLuaAllocator::sStats allocatorStats;
+	if ( !TimeParsing( source, false, crtMilliseconds, allocatorStats )
+		|| !TimeParsing( source, true, allocatorMilliseconds, allocatorStats ) )
+	{
+		return false;
+	}
+	std::cout << "A " << ( source.size() / ( 1024 * 1024 ) ) << " MB mesh source with " << s_vertexCount << " vertices"
+		<< " (the median of " << s_runCount << " runs)\n"
+		<< "\tluaL_newstate():\t" << crtMilliseconds << " ms\n"
+		<< "\tcLuaAllocator:\t\t" << allocatorMilliseconds << " ms\n"
+		<< "\tcLuaAllocator is " << ( crtMilliseconds / allocatorMilliseconds ) << "x as fast\n"
+		<< "\tLua made " << allocatorStats.allocationCount << " allocations (" << allocatorStats.largeAllocationCount
+		<< " too big for the pool) with at most " << allocatorStats.peakBytesInUse << " bytes in use\n";
+	return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	std::string GenerateMeshSource()
+	{
+		// The vertices are in rows of quads, like a subdivided rectangle
+		const unsigned int verticesPerRow = 500;
+		const unsigned int rowCount = s_vertexCount / verticesPerRow;
+		std::ostringstream source;
+		source << "return\n{\n\tvertices = \n\t{\n";
+		for ( unsigned int row = 0; row < rowCount; ++row )
+		{
+			for ( unsigned int column = 0; column < verticesPerRow; ++column )
+			{
+				source << "\t\t{\n"
+					"\t\t\tposition = { " << ( column / static_cast<float>( verticesPerRow ) ) << ", " << ( row / static_cast<float>( rowCount ) ) << " },\n"
+					"\t\t\tcolor = { " << ( ( column % 4 ) * 0.25f ) << ", " << ( ( row % 4 ) * 0.25f ) << ", 1, 1}\n"
+					"\t\t},\n";
+			}
+		}
+		source << "\t},\n\tindices = \n\t{\n";
+		for ( unsigned int row = 0; ( row + 1 ) < rowCount; ++row )
+		{
+			for ( unsigned int column = 0; ( column + 1 ) < verticesPerRow; ++column )
+			{
+				const unsigned int vertex = ( row * verticesPerRow ) + column;
+				source << "\t\t" << vertex << ", " << ( vertex + 1 ) << ", " << ( vertex + verticesPerRow + 1 ) << ",\n"
+					"\t\t" << vertex << ", " << ( vertex + verticesPerRow + 1 ) << ", " << ( vertex + verticesPerRow ) << ",\n";
+			}
+		}
+		source << "\t}\n}\n";
+		return source.str();
+	}
+
+	bool TimeParsing( const std::string& i_source, const bool i_shouldUseAllocator, double& o_milliseconds,
+		eae6320::cLuaAllocator::sStats& o_allocatorStats )
+	{
+		std::vector<double> milliseconds;
+		for ( unsigned int i = 0; i < s_runCount; ++i )
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			{
+				eae6320::cLuaAllocator allocator;
+				lua_State* const luaState = i_shouldUseAllocator ? allocator.NewState() : luaL_newstate();
+				if ( !luaState )
+				{
+					std::cerr << "Lua failed to create a new state\n";
+					return false;
+				}
+				if ( ( luaL_loadbuffer( luaState, i_source.c_str(), i_source.size(), "=mesh" ) != LUA_OK )
+					|| ( lua_pcall( luaState, 0, 1, 0 ) != LUA_OK ) )
+				{
+					std::cerr << "The generated mesh source couldn't be run: " << lua_tostring( luaState, -1 ) << "\n";
+					lua_close( luaState );
+					return false;
+				}
+				// Closing the state is included because it is when all of the memory is freed
+				lua_close( luaState );
+				if ( i_shouldUseAllocator )
+				{
+					o_allocatorStats = allocator.GetStats();
+				}
+			}
+			milliseconds.push_back( eae6320::Benchmarks::GetMillisecondsSince( start ) );
+		}
+		std::sort( milliseconds.begin(), milliseconds.end() );
+		o_milliseconds = milliseconds[milliseconds.size() / 2];
+		return true;
+	}
+}
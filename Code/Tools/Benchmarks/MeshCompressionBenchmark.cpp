@@ -0,0 +1,259 @@
+/*
+	This compares loading an uncompressed mesh file with loading the same mesh compressed by MeshEncoder
+	when the file isn't in the system's file cache
+
+	The files are read with FILE_FLAG_NO_BUFFERING so that every read comes from the disk
+	(the way that the first load after a reboot does)
+	and then decoded with Mesh::Decode(), which is what the AssetLoader does with a file that it has read
+*/
+
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../../Engine/Graphics/Mesh.h"
+#include "../../Engine/Graphics/MeshFile.h"
+#include "../../Engine/Windows/Includes.h"
+#include "../../Engine/Windows/WindowsFunctions.h"
+#include "../MeshBuilder/MeshEncoder.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// The mesh is a grid of this many vertices on each side
+	const uint32_t s_gridSize = 512;
+	// Each file is loaded this many times and the median is reported
+	const unsigned int s_runCount = 5;
+	const char* const s_rawPath = "data/MeshCompressionBenchmarkRaw.msh";
+	const char* const s_compressedPath = "data/MeshCompressionBenchmarkCompressed.msh";
+	// Unbuffered reads must be a multiple of the disk's sector size into memory that is aligned to it,
+	// and no disk has sectors bigger than a page
+	const DWORD s_unbufferedAlignment = 4096;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	bool WriteMeshes();
+	bool TimeLoading( const char* const i_path, size_t& o_fileSize, double& o_readMilliseconds, double& o_decodeMilliseconds );
+	bool ReadUncached( const char* const i_path, void*& o_file, size_t& o_fileSize );
+}
+
+// Interface
+//==========
+
+bool eae6320::Benchmarks::CompressedVersusRawMeshes()
+{
+	bool wereThereErrors = false;
+
+	size_t rawSize, compressedSize;
+	double rawReadMilliseconds, rawDecodeMilliseconds, compressedReadMilliseconds, compressedDecodeMilliseconds;
+	if ( !WriteMeshes()
+		|| !TimeLoading( s_rawPath, rawSize, rawReadMilliseconds, rawDecodeMilliseconds )
+		|| !TimeLoading( s_compressedPath, compressedSize, compressedReadMilliseconds, compressedDecodeMilliseconds ) )
+	{
+		wereThereErrors = true;
+		goto OnExit;
+	}
+	std::cout << ( s_gridSize * s_gridSize ) << " vertices read without the file cache (the median of " << s_runCount << " runs)\n"
+		<< "\tRaw:\t\t" << rawSize << " bytes, " << ( rawReadMilliseconds + rawDecodeMilliseconds ) << " ms"
+		<< " (" << rawReadMilliseconds << " ms reading and " << rawDecodeMilliseconds << " ms decoding)\n"
+		<< "\tCompressed:\t" << compressedSize << " bytes, " << ( compressedReadMilliseconds + compressedDecodeMilliseconds ) << " ms"
+		<< " (" << compressedReadMilliseconds << " ms reading and " << compressedDecodeMilliseconds << " ms decoding at "
+		<< ( ( ( rawSize - sizeof( Graphics::MeshFile::sHeader ) ) / ( 1024.0 * 1024.0 * 1024.0 ) ) / ( compressedDecodeMilliseconds / 1000.0 ) )
+		<< " GB/s)\n";
+
+OnExit:
+
+	std::remove( s_rawPath );
+	std::remove( s_compressedPath );
+
+	return !wereThereErrors;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool WriteMeshes()
+	{
+		// The grid's vertices are moved randomly within their cells
+		// so that the positions don't compress any better than an authored mesh's would,
+		// and it is colored with smooth gradients like an authored mesh would be
+		std::mt19937 randomNumbers( 0 );
+		const float cellSize = 2.0f / ( s_gridSize - 1 );
+		std::uniform_real_distribution<float> jitter( -0.25f * cellSize, 0.25f * cellSize );
+		std::vector<eae6320::Graphics::sVertex> vertices( s_gridSize * s_gridSize );
+		for ( uint32_t y = 0; y < s_gridSize; ++y )
+		{
+			for ( uint32_t x = 0; x < s_gridSize; ++x )
+			{
+				eae6320::Graphics::sVertex& vertex = vertices[( y * s_gridSize ) + x];
+				vertex.x = ( x * cellSize ) - 1.0f + jitter( randomNumbers );
+				vertex.y = ( y * cellSize ) - 1.0f + jitter( randomNumbers );
+				vertex.r = static_cast<uint8_t>( ( x * 255 ) / ( s_gridSize - 1 ) );
+				vertex.g = static_cast<uint8_t>( ( y * 255 ) / ( s_gridSize - 1 ) );
+				vertex.b = 255;
+				vertex.a = 255;
+			}
+		}
+		std::vector<uint32_t> indices;
+		indices.reserve( ( s_gridSize - 1 ) * ( s_gridSize - 1 ) * 6 );
+		for ( uint32_t y = 0; ( y + 1 ) < s_gridSize; ++y )
+		{
+			for ( uint32_t x = 0; ( x + 1 ) < s_gridSize; ++x )
+			{
+				const uint32_t vertex = ( y * s_gridSize ) + x;
+				indices.push_back( vertex );
+				indices.push_back( vertex + 1 );
+				indices.push_back( vertex + s_gridSize + 1 );
+				indices.push_back( vertex );
+				indices.push_back( vertex + s_gridSize + 1 );
+				indices.push_back( vertex + s_gridSize );
+			}
+		}
+
+		// The header is filled in the same way that MeshBuilder fills it in
+		eae6320::Graphics::MeshFile::sHeader header;
+		header.magic = eae6320::Graphics::MeshFile::s_magic;
+		header.version = eae6320::Graphics::MeshFile::s_version;
+		header.vertexCount = static_cast<uint32_t>( vertices.size() );
+		header.indexCount = static_cast<uint32_t>( indices.size() );
+		eae6320::Graphics::MeshFile::CalculateBounds( &vertices[0], sizeof( eae6320::Graphics::sVertex ), header.vertexCount, header.bounds );
+		header.flags = 0;
+		header.encodedSize = 0;
+		header.positionFormat = eae6320::Graphics::MeshFile::PositionFormat_float32;
+		for ( size_t j = 0; j < 2; ++j )
+		{
+			header.positionScale[j] = 1.0f;
+			header.positionBias[j] = 0.0f;
+		}
+		memset( header.lods, 0, sizeof( header.lods ) );
+		header.lodCount = 1;
+		header.lods[0].indexCount = header.indexCount;
+
+		std::vector<uint8_t> encoded;
+		eae6320::MeshEncoder::Encode( &vertices[0], header.vertexCount, sizeof( eae6320::Graphics::sVertex ), &indices[0], header.indexCount, encoded );
+
+		FILE* rawFile;
+		FILE* compressedFile;
+		fopen_s( &rawFile, s_rawPath, "wb" );
+		fopen_s( &compressedFile, s_compressedPath, "wb" );
+		bool wereThereErrors = !rawFile || !compressedFile;
+		if ( !wereThereErrors )
+		{
+			fwrite( &header, sizeof( header ), 1, rawFile );
+			fwrite( &vertices[0], sizeof( eae6320::Graphics::sVertex ), vertices.size(), rawFile );
+			fwrite( &indices[0], sizeof( uint32_t ), indices.size(), rawFile );
+			header.flags |= eae6320::Graphics::MeshFile::Flag_compressed;
+			header.encodedSize = static_cast<uint32_t>( encoded.size() );
+			fwrite( &header, sizeof( header ), 1, compressedFile );
+			fwrite( &encoded[0], 1, encoded.size(), compressedFile );
+			wereThereErrors = ferror( rawFile ) || ferror( compressedFile );
+		}
+		if ( rawFile )
+		{
+			fclose( rawFile );
+		}
+		if ( compressedFile )
+		{
+			fclose( compressedFile );
+		}
+		if ( wereThereErrors )
+		{
+			std::cerr << "The benchmark meshes couldn't be written (is the benchmark running from the game directory?)\n";
+		}
+		return !wereThereErrors;
+	}
+
+	bool TimeLoading( const char* const i_path, size_t& o_fileSize, double& o_readMilliseconds, double& o_decodeMilliseconds )
+	{
+		std::vector<double> readMilliseconds, decodeMilliseconds;
+		for ( unsigned int i = 0; i < s_runCount; ++i )
+		{
+			void* file;
+			const std::chrono::steady_clock::time_point readStart = std::chrono::steady_clock::now();
+			if ( !ReadUncached( i_path, file, o_fileSize ) )
+			{
+				return false;
+			}
+			readMilliseconds.push_back( eae6320::Benchmarks::GetMillisecondsSince( readStart ) );
+
+			eae6320::Graphics::Mesh::sDecodedMesh decodedMesh;
+			const std::chrono::steady_clock::time_point decodeStart = std::chrono::steady_clock::now();
+			const bool wasDecoded = eae6320::Graphics::Mesh::Decode( file, o_fileSize, i_path, decodedMesh );
+			decodeMilliseconds.push_back( eae6320::Benchmarks::GetMillisecondsSince( decodeStart ) );
+			eae6320::Graphics::Mesh::ReleaseDecoded( decodedMesh );
+			VirtualFree( file, 0, MEM_RELEASE );
+			if ( !wasDecoded )
+			{
+				std::cerr << "The mesh " << i_path << " couldn't be decoded (see the log for details)\n";
+				return false;
+			}
+		}
+		std::sort( readMilliseconds.begin(), readMilliseconds.end() );
+		std::sort( decodeMilliseconds.begin(), decodeMilliseconds.end() );
+		o_readMilliseconds = readMilliseconds[s_runCount / 2];
+		o_decodeMilliseconds = decodeMilliseconds[s_runCount / 2];
+		return true;
+	}
+
+	bool ReadUncached( const char* const i_path, void*& o_file, size_t& o_fileSize )
+	{
+		o_file = NULL;
+		const HANDLE file = CreateFileA( i_path, FILE_GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING, NULL );
+		if ( file == INVALID_HANDLE_VALUE )
+		{
+			std::cerr << "The mesh " << i_path << " couldn't be opened: " << eae6320::GetLastWindowsError() << "\n";
+			return false;
+		}
+		bool wereThereErrors = false;
+		LARGE_INTEGER fileSize;
+		if ( GetFileSizeEx( file, &fileSize ) == FALSE )
+		{
+			std::cerr << "The size of the mesh " << i_path << " couldn't be found: " << eae6320::GetLastWindowsError() << "\n";
+			wereThereErrors = true;
+			goto OnExit;
+		}
+		o_fileSize = static_cast<size_t>( fileSize.QuadPart );
+		{
+			// The end of the file is read in a whole sector too
+			const DWORD alignedSize = static_cast<DWORD>( ( ( o_fileSize + s_unbufferedAlignment - 1 ) / s_unbufferedAlignment ) * s_unbufferedAlignment );
+			// VirtualAlloc() returns memory that is aligned to a page
+			o_file = VirtualAlloc( NULL, alignedSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE );
+			if ( !o_file )
+			{
+				std::cerr << "There isn't enough memory to read the mesh " << i_path << "\n";
+				wereThereErrors = true;
+				goto OnExit;
+			}
+			DWORD bytesRead;
+			if ( ( ReadFile( file, o_file, alignedSize, &bytesRead, NULL ) == FALSE ) || ( bytesRead != o_fileSize ) )
+			{
+				std::cerr << "The mesh " << i_path << " couldn't be read: " << eae6320::GetLastWindowsError() << "\n";
+				VirtualFree( o_file, 0, MEM_RELEASE );
+				o_file = NULL;
+				wereThereErrors = true;
+				goto OnExit;
+			}
+		}
+
+	OnExit:
+
+		CloseHandle( file );
+		return !wereThereErrors;
+	}
+}
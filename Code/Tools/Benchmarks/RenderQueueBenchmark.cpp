@@ -0,0 +1,191 @@
+/*
+	This measures what each draw packet costs the RenderQueue
+	when the commands are executed by the software rasterizer instead of a GPU
+
+	Record() sorts the packets before it batches and records them,
+	and so the sort is also timed on its own to show how much of Record() it is.
+	Recording is timed both on the calling thread and with the job system
+*/
+
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../Engine/Core/JobSystem.h"
+#include "../../Engine/Graphics/Renderable.h"
+#include "../../Engine/Graphics/RenderQueue.h"
+#include "../../Engine/Graphics/SoftwareRasterizer.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const unsigned int s_packetCount = 20000;
+	const unsigned int s_frameCount = 50;
+	const unsigned int s_imageSize = 256;
+	// Each of these is loaded twice so that there are four different meshes and effects to sort and batch
+	const char* const s_meshPaths[] = { "data/triangle.msh", "data/rectangle.msh", "data/triangle.msh", "data/rectangle.msh" };
+	const unsigned int s_sourceCount = sizeof( s_meshPaths ) / sizeof( s_meshPaths[0] );
+	const uint8_t s_layerCount = 3;
+
+	// Nanoseconds per packet
+	struct sTimes
+	{
+		double sort;
+		// Including the sort
+		double record;
+		double execute;
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void TimeFrames( std::vector<eae6320::Graphics::Renderable>& io_renderables, const bool i_isInstancingEnabled,
+		eae6320::Graphics::SoftwareRasterizer& io_rasterizer, sTimes& o_times );
+	void Submit( std::vector<eae6320::Graphics::Renderable>& io_renderables, std::mt19937& io_randomNumbers,
+		eae6320::Graphics::RenderQueue& io_renderQueue );
+}
+
+// Interface
+//==========
+
+bool eae6320::Benchmarks::RenderQueueRecording()
+{
+	if ( !InitializeGraphics() )
+	{
+		return false;
+	}
+
+	bool wereThereErrors = false;
+
+	Graphics::Renderable sources[s_sourceCount];
+	std::vector<Graphics::Renderable> renderables( s_packetCount );
+	Graphics::SoftwareRasterizer rasterizer;
+	{
+		std::string errorMessage;
+		if ( !rasterizer.Initialize( s_imageSize, s_imageSize, 0, &errorMessage ) )
+		{
+			std::cerr << "The software rasterizer couldn't be initialized: " << errorMessage << "\n";
+			return false;
+		}
+	}
+	for ( unsigned int i = 0; i < s_sourceCount; ++i )
+	{
+		if ( !sources[i].Initialize( s_meshPaths[i] ) )
+		{
+			std::cerr << "The mesh " << s_meshPaths[i] << " couldn't be loaded (is the benchmark running from the game directory?)\n";
+			wereThereErrors = true;
+			goto OnExit;
+		}
+	}
+	{
+		std::mt19937 randomNumbers( 0 );
+		std::uniform_real_distribution<float> position( -1.0f, 1.0f );
+		for ( unsigned int i = 0; i < s_packetCount; ++i )
+		{
+			if ( !renderables[i].Initialize( sources[randomNumbers() % s_sourceCount] ) )
+			{
+				wereThereErrors = true;
+				goto OnExit;
+			}
+			renderables[i].SetPositionOffset( Math::cVector( position( randomNumbers ), position( randomNumbers ) ) );
+		}
+	}
+
+	std::cout << s_packetCount << " packets, " << s_frameCount << " frames (ns/packet)\n";
+	for ( int i = 0; i < 2; ++i )
+	{
+		const bool isInstancingEnabled = i == 0;
+		sTimes inlineTimes, jobTimes;
+		Graphics::RenderQueue::SetParallelFor( NULL );
+		TimeFrames( renderables, isInstancingEnabled, rasterizer, inlineTimes );
+		if ( !Core::JobSystem::Initialize() )
+		{
+			std::cerr << "The job system couldn't be initialized\n";
+			wereThereErrors = true;
+			goto OnExit;
+		}
+		Graphics::RenderQueue::SetParallelFor( Core::JobSystem::ParallelFor );
+		TimeFrames( renderables, isInstancingEnabled, rasterizer, jobTimes );
+		Graphics::RenderQueue::SetParallelFor( NULL );
+		Core::JobSystem::ShutDown();
+		std::cout << "\tInstancing " << ( isInstancingEnabled ? "on" : "off" ) << ":\t"
+			<< "sort " << inlineTimes.sort << ", record " << inlineTimes.record << " including the sort"
+			<< " (" << jobTimes.record << " with the job system), execute " << inlineTimes.execute << "\n";
+	}
+
+OnExit:
+
+	for ( std::vector<Graphics::Renderable>::iterator i = renderables.begin(); i != renderables.end(); ++i )
+	{
+		i->ShutDown();
+	}
+	for ( unsigned int i = 0; i < s_sourceCount; ++i )
+	{
+		sources[i].ShutDown();
+	}
+	rasterizer.ShutDown();
+
+	return !wereThereErrors;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void TimeFrames( std::vector<eae6320::Graphics::Renderable>& io_renderables, const bool i_isInstancingEnabled,
+		eae6320::Graphics::SoftwareRasterizer& io_rasterizer, sTimes& o_times )
+	{
+		double sortMilliseconds = 0.0, recordMilliseconds = 0.0, executeMilliseconds = 0.0;
+		std::mt19937 randomNumbers( 0 );
+		eae6320::Graphics::RenderQueue renderQueue;
+		renderQueue.SetIsInstancingEnabled( i_isInstancingEnabled );
+		for ( unsigned int frame = 0; frame < s_frameCount; ++frame )
+		{
+			Submit( io_renderables, randomNumbers, renderQueue );
+			{
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				renderQueue.Sort();
+				sortMilliseconds += eae6320::Benchmarks::GetMillisecondsSince( start );
+			}
+			renderQueue.Clear();
+
+			Submit( io_renderables, randomNumbers, renderQueue );
+			{
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				renderQueue.Record();
+				recordMilliseconds += eae6320::Benchmarks::GetMillisecondsSince( start );
+			}
+			{
+				// The queue has already been recorded, and so this only executes the commands
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				renderQueue.Draw( io_rasterizer );
+				executeMilliseconds += eae6320::Benchmarks::GetMillisecondsSince( start );
+			}
+		}
+		const double nanosecondsPerMillisecondPerPacket = 1000000.0 / ( static_cast<double>( s_frameCount ) * s_packetCount );
+		o_times.sort = sortMilliseconds * nanosecondsPerMillisecondPerPacket;
+		o_times.record = recordMilliseconds * nanosecondsPerMillisecondPerPacket;
+		o_times.execute = executeMilliseconds * nanosecondsPerMillisecondPerPacket;
+	}
+
+	void Submit( std::vector<eae6320::Graphics::Renderable>& io_renderables, std::mt19937& io_randomNumbers,
+		eae6320::Graphics::RenderQueue& io_renderQueue )
+	{
+		std::uniform_real_distribution<float> depth( 0.0f, 1.0f );
+		for ( std::vector<eae6320::Graphics::Renderable>::iterator i = io_renderables.begin(); i != io_renderables.end(); ++i )
+		{
+			io_renderQueue.Submit( *i, static_cast<uint8_t>( io_randomNumbers() % s_layerCount ), depth( io_randomNumbers ) );
+		}
+	}
+}
@@ -0,0 +1,174 @@
+/*
+	This compares executing a command buffer, which uploads every draw's constants through the UniformRingBuffer at once,
+	with setting each draw's constants with Effect::SetDrawCallUniforms() the way that every draw used to
+
+	Both run on the platform that the benchmark was built for (OpenGL for Win32 and Direct3D for x64).
+	The driver calls that set draw constants are counted from UniformRingBuffer::GetStats():
+	on OpenGL an upload is one map and unmap of the buffer and a bind is one glBindBufferRange(),
+	and on Direct3D there are no uploads and a bind is one SetVertexShaderConstantF()
+*/
+
+// Header Files
+//=============
+
+#include "Benchmarks.h"
+
+#include <iostream>
+#include <random>
+#include "../../Engine/Graphics/CommandBuffer.h"
+#include "../../Engine/Graphics/Graphics.h"
+#include "../../Engine/Graphics/Renderable.h"
+#include "../../Engine/Graphics/UniformRingBuffer.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const unsigned int s_drawCount = 10000;
+	const unsigned int s_frameCount = 50;
+	// The draws are split evenly between these, the way that the render queue batches them
+	const char* const s_meshPaths[] = { "data/triangle.msh", "data/rectangle.msh" };
+	const unsigned int s_sourceCount = sizeof( s_meshPaths ) / sizeof( s_meshPaths[0] );
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void RecordDraws( eae6320::Graphics::Renderable* i_sources, eae6320::Graphics::cCommandBuffer& o_commandBuffer );
+	// Executes the commands the way that cCommandBuffer::Execute() does
+	// except that each draw's constants are set on their own with Effect::SetDrawCallUniforms()
+	void ExecutePerDraw( const eae6320::Graphics::cCommandBuffer& i_commandBuffer, unsigned int& o_driverCallCount );
+	unsigned int GetDriverCallCount( const eae6320::Graphics::sUniformRingBufferStats& i_stats );
+}
+
+// Interface
+//==========
+
+bool eae6320::Benchmarks::UniformRingBufferVersusPerDrawUniforms()
+{
+	if ( !InitializeGraphics() )
+	{
+		return false;
+	}
+
+	bool wereThereErrors = false;
+
+	Graphics::Renderable sources[s_sourceCount];
+	Graphics::cCommandBuffer commandBuffer;
+	for ( unsigned int i = 0; i < s_sourceCount; ++i )
+	{
+		if ( !sources[i].Initialize( s_meshPaths[i] ) )
+		{
+			std::cerr << "The mesh " << s_meshPaths[i] << " couldn't be loaded (is the benchmark running from the game directory?)\n";
+			wereThereErrors = true;
+			goto OnExit;
+		}
+	}
+	RecordDraws( sources, commandBuffer );
+
+	{
+		double ringBufferMilliseconds = 0.0, perDrawMilliseconds = 0.0;
+		unsigned int ringBufferDriverCallCount = 0, perDrawDriverCallCount = 0;
+		for ( unsigned int frame = 0; frame < s_frameCount; ++frame )
+		{
+			{
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				commandBuffer.Execute();
+				ringBufferMilliseconds += GetMillisecondsSince( start );
+				ringBufferDriverCallCount = GetDriverCallCount( Graphics::UniformRingBuffer::GetStats() );
+			}
+			// Presenting keeps the GPU from falling more than a few frames behind,
+			// and it isn't timed because it is the same for both
+			Graphics::Present();
+			{
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				ExecutePerDraw( commandBuffer, perDrawDriverCallCount );
+				perDrawMilliseconds += GetMillisecondsSince( start );
+			}
+			Graphics::Present();
+		}
+		const double ringBufferDrawsPerSecond = ( static_cast<double>( s_drawCount ) * s_frameCount ) / ( ringBufferMilliseconds / 1000.0 );
+		const double perDrawDrawsPerSecond = ( static_cast<double>( s_drawCount ) * s_frameCount ) / ( perDrawMilliseconds / 1000.0 );
+		std::cout << s_drawCount << " draws, " << s_frameCount << " frames (the driver calls are the ones that set draw constants in a frame)\n"
+			<< "\tRing buffer:\t" << ringBufferDrawsPerSecond << " draws/s, " << ringBufferDriverCallCount << " driver calls\n"
+			<< "\tPer draw:\t" << perDrawDrawsPerSecond << " draws/s, " << perDrawDriverCallCount << " driver calls\n"
+			<< "\tThe ring buffer is " << ( ringBufferDrawsPerSecond / perDrawDrawsPerSecond ) << "x as fast\n";
+	}
+
+OnExit:
+
+	for ( unsigned int i = 0; i < s_sourceCount; ++i )
+	{
+		sources[i].ShutDown();
+	}
+
+	return !wereThereErrors;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void RecordDraws( eae6320::Graphics::Renderable* i_sources, eae6320::Graphics::cCommandBuffer& o_commandBuffer )
+	{
+		std::mt19937 randomNumbers( 0 );
+		std::uniform_real_distribution<float> position( -1.0f, 1.0f );
+		for ( unsigned int i = 0; i < s_sourceCount; ++i )
+		{
+			eae6320::Graphics::Renderable& source = i_sources[i];
+			o_commandBuffer.BindEffect( *source.Effect );
+			o_commandBuffer.BindMesh( *source.Mesh );
+			for ( unsigned int j = 0; j < ( s_drawCount / s_sourceCount ); ++j )
+			{
+				// Every draw has different constants so that Direct3D can't skip setting any of them
+				const float offsetX = position( randomNumbers );
+				const float offsetY = position( randomNumbers );
+				eae6320::Graphics::sDrawConstants drawConstants;
+				source.Mesh->GetDrawConstants( offsetX, offsetY, drawConstants );
+				o_commandBuffer.SetDrawConstants( drawConstants, offsetX, offsetY );
+				o_commandBuffer.DrawPrimitives();
+			}
+		}
+	}
+
+	void ExecutePerDraw( const eae6320::Graphics::cCommandBuffer& i_commandBuffer, unsigned int& o_driverCallCount )
+	{
+		o_driverCallCount = 0;
+		eae6320::Graphics::Effect* effect = NULL;
+		eae6320::Graphics::Mesh* mesh = NULL;
+		const eae6320::Graphics::cCommandBuffer::sCommand* const commands = i_commandBuffer.GetCommands();
+		const size_t commandCount = i_commandBuffer.GetCommandCount();
+		for ( size_t i = 0; i < commandCount; ++i )
+		{
+			const eae6320::Graphics::cCommandBuffer::sCommand& command = commands[i];
+			switch ( command.type )
+			{
+			case eae6320::Graphics::cCommandBuffer::Command_bindEffect:
+				effect = command.effect;
+				effect->Bind();
+				break;
+			case eae6320::Graphics::cCommandBuffer::Command_bindMesh:
+				mesh = command.mesh;
+				mesh->Bind();
+				break;
+			case eae6320::Graphics::cCommandBuffer::Command_setDrawConstants:
+				effect->SetDrawCallUniforms( i_commandBuffer.GetDrawConstants( command.value ) );
+				// SetDrawCallUniforms() starts over with a single slot every time
+				o_driverCallCount += GetDriverCallCount( eae6320::Graphics::UniformRingBuffer::GetStats() );
+				break;
+			case eae6320::Graphics::cCommandBuffer::Command_drawPrimitives:
+				mesh->DrawPrimitives( command.lod );
+				break;
+			}
+		}
+	}
+
+	unsigned int GetDriverCallCount( const eae6320::Graphics::sUniformRingBufferStats& i_stats )
+	{
+		return i_stats.uploadCount + i_stats.bindCount;
+	}
+}
@@ -0,0 +1,427 @@
+// Header Files
+//=============
+
+#include "cDirectoryWatcher.h"
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+#if defined( _WIN32 )
+	#include "../../Engine/Windows/WindowsFunctions.h"
+#else
+	#include <cerrno>
+	#include <dirent.h>
+	#include <poll.h>
+	#include <sys/inotify.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void AddChangedPath( const std::string& i_relativePath, std::vector<std::string>& io_relativePaths );
+}
+
+// Interface
+//==========
+
+bool eae6320::cDirectoryWatcher::WaitForChanges( std::vector<std::string>& o_relativePaths, bool& o_haveChangesBeenLost,
+	std::string* o_errorMessage )
+{
+	o_relativePaths.clear();
+	o_haveChangesBeenLost = false;
+	bool didTimeOut;
+	// Wait for the first change
+	if ( !ReadChanges( s_waitForever, o_relativePaths, o_haveChangesBeenLost, didTimeOut, o_errorMessage ) )
+	{
+		return false;
+	}
+	// Wait for the directory to settle
+	do
+	{
+		if ( !ReadChanges( s_settleMilliseconds, o_relativePaths, o_haveChangesBeenLost, didTimeOut, o_errorMessage ) )
+		{
+			return false;
+		}
+	} while ( !didTimeOut );
+	return true;
+}
+
+#if defined( _WIN32 )
+
+bool eae6320::cDirectoryWatcher::Start( const char* i_directory, std::string* o_errorMessage )
+{
+	Stop();
+
+	// Open the directory
+	{
+		const DWORD desiredAccess = FILE_LIST_DIRECTORY;
+		// Other programs must still be able to do anything with the files
+		const DWORD shareEverything = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+		SECURITY_ATTRIBUTES* useDefaultSecurity = NULL;
+		const DWORD onlySucceedIfDirectoryExists = OPEN_EXISTING;
+		// A directory can only be opened with backup semantics,
+		// and the changes are read asynchronously so that the wait can time out
+		const DWORD openAsynchronousDirectory = FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED;
+		const HANDLE dontUseTemplateFile = NULL;
+		m_directory = CreateFile( i_directory, desiredAccess, shareEverything,
+			useDefaultSecurity, onlySucceedIfDirectoryExists, openAsynchronousDirectory, dontUseTemplateFile );
+		if ( m_directory == INVALID_HANDLE_VALUE )
+		{
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to open the directory \"" << i_directory << "\" to watch it: " << GetLastWindowsError();
+				*o_errorMessage = errorMessage.str();
+			}
+			return false;
+		}
+	}
+	// Create the event that is signaled when changes have been read
+	{
+		SECURITY_ATTRIBUTES* useDefaultSecurity = NULL;
+		const BOOL resetManually = TRUE;
+		const BOOL startUnsignaled = FALSE;
+		const char* const noName = NULL;
+		m_event = CreateEvent( useDefaultSecurity, resetManually, startUnsignaled, noName );
+		if ( m_event == NULL )
+		{
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = "Windows failed to create an event to watch a directory with: " + GetLastWindowsError();
+			}
+			Stop();
+			return false;
+		}
+	}
+	if ( !RequestChanges( o_errorMessage ) )
+	{
+		Stop();
+		return false;
+	}
+	return true;
+}
+
+void eae6320::cDirectoryWatcher::Stop()
+{
+	if ( m_directory != INVALID_HANDLE_VALUE )
+	{
+		// Any pending read must finish before its buffer can be reused
+		if ( CancelIo( m_directory ) != FALSE )
+		{
+			DWORD byteCount;
+			const BOOL waitForTheReadToFinish = TRUE;
+			GetOverlappedResult( m_directory, &m_overlapped, &byteCount, waitForTheReadToFinish );
+		}
+		CloseHandle( m_directory );
+		m_directory = INVALID_HANDLE_VALUE;
+	}
+	if ( m_event != NULL )
+	{
+		CloseHandle( m_event );
+		m_event = NULL;
+	}
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::cDirectoryWatcher::cDirectoryWatcher()
+	:
+	m_directory( INVALID_HANDLE_VALUE ), m_event( NULL )
+{
+	memset( &m_overlapped, 0, sizeof( m_overlapped ) );
+}
+
+eae6320::cDirectoryWatcher::~cDirectoryWatcher()
+{
+	Stop();
+}
+
+// Implementation
+//===============
+
+bool eae6320::cDirectoryWatcher::ReadChanges( const unsigned int i_timeoutMilliseconds, std::vector<std::string>& io_relativePaths,
+	bool& io_haveChangesBeenLost, bool& o_didTimeOut, std::string* o_errorMessage )
+{
+	o_didTimeOut = false;
+	const DWORD result = WaitForSingleObject( m_event, ( i_timeoutMilliseconds == s_waitForever ) ? INFINITE : i_timeoutMilliseconds );
+	if ( result == WAIT_TIMEOUT )
+	{
+		o_didTimeOut = true;
+		return true;
+	}
+	DWORD byteCount;
+	const BOOL dontWait = FALSE;
+	if ( ( result != WAIT_OBJECT_0 ) || ( GetOverlappedResult( m_directory, &m_overlapped, &byteCount, dontWait ) == FALSE ) )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = "Windows failed to read the changes in a watched directory: " + GetLastWindowsError();
+		}
+		return false;
+	}
+
+	// If the buffer wasn't big enough to hold every change then none of them are returned
+	if ( byteCount == 0 )
+	{
+		io_haveChangesBeenLost = true;
+	}
+	else
+	{
+		const uint8_t* notification = reinterpret_cast<const uint8_t*>( m_buffer );
+		for ( ;; )
+		{
+			const FILE_NOTIFY_INFORMATION& information = *reinterpret_cast<const FILE_NOTIFY_INFORMATION*>( notification );
+			// The name isn't NULL-terminated, and it's in UTF-16
+			{
+				const int wideCharacterCount = static_cast<int>( information.FileNameLength / sizeof( WCHAR ) );
+				const DWORD noFlags = 0;
+				const int characterCount = WideCharToMultiByte( CP_ACP, noFlags, information.FileName, wideCharacterCount, NULL, 0, NULL, NULL );
+				if ( characterCount > 0 )
+				{
+					std::string relativePath( static_cast<size_t>( characterCount ), '\0' );
+					WideCharToMultiByte( CP_ACP, noFlags, information.FileName, wideCharacterCount, &relativePath[0], characterCount, NULL, NULL );
+					for ( std::string::iterator i = relativePath.begin(); i != relativePath.end(); ++i )
+					{
+						if ( *i == '\\' )
+						{
+							*i = '/';
+						}
+					}
+					AddChangedPath( relativePath, io_relativePaths );
+				}
+			}
+			if ( information.NextEntryOffset == 0 )
+			{
+				break;
+			}
+			notification += information.NextEntryOffset;
+		}
+	}
+
+	// Windows keeps track of changes while the directory is open,
+	// and so nothing is missed before the next request
+	return RequestChanges( o_errorMessage );
+}
+
+bool eae6320::cDirectoryWatcher::RequestChanges( std::string* o_errorMessage )
+{
+	memset( &m_overlapped, 0, sizeof( m_overlapped ) );
+	m_overlapped.hEvent = m_event;
+	ResetEvent( m_event );
+	const BOOL watchSubdirectories = TRUE;
+	// Saving a file changes its last write time, and creating, deleting, or renaming a file changes its name
+	const DWORD changesToWatch = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE;
+	LPOVERLAPPED_COMPLETION_ROUTINE noCompletionRoutine = NULL;
+	if ( ReadDirectoryChangesW( m_directory, m_buffer, sizeof( m_buffer ), watchSubdirectories, changesToWatch,
+		NULL, &m_overlapped, noCompletionRoutine ) == FALSE )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = "Windows failed to watch a directory for changes: " + GetLastWindowsError();
+		}
+		return false;
+	}
+	return true;
+}
+
+#else
+
+bool eae6320::cDirectoryWatcher::Start( const char* i_directory, std::string* o_errorMessage )
+{
+	Stop();
+
+	m_inotify = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+	if ( m_inotify < 0 )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = std::string( "inotify failed to initialize: " ) + strerror( errno );
+		}
+		return false;
+	}
+	m_directory = i_directory;
+	if ( !m_directory.empty() && ( m_directory[m_directory.size() - 1] != '/' ) )
+	{
+		m_directory += '/';
+	}
+	if ( !WatchDirectory( "", o_errorMessage ) )
+	{
+		Stop();
+		return false;
+	}
+	return true;
+}
+
+void eae6320::cDirectoryWatcher::Stop()
+{
+	if ( m_inotify >= 0 )
+	{
+		// Closing the instance removes every watch
+		close( m_inotify );
+		m_inotify = -1;
+	}
+	m_watchedDirectories.clear();
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::cDirectoryWatcher::cDirectoryWatcher()
+	:
+	m_inotify( -1 )
+{
+
+}
+
+eae6320::cDirectoryWatcher::~cDirectoryWatcher()
+{
+	Stop();
+}
+
+// Implementation
+//===============
+
+bool eae6320::cDirectoryWatcher::ReadChanges( const unsigned int i_timeoutMilliseconds, std::vector<std::string>& io_relativePaths,
+	bool& io_haveChangesBeenLost, bool& o_didTimeOut, std::string* o_errorMessage )
+{
+	o_didTimeOut = false;
+	{
+		pollfd descriptor;
+		descriptor.fd = m_inotify;
+		descriptor.events = POLLIN;
+		descriptor.revents = 0;
+		const int result = poll( &descriptor, 1, ( i_timeoutMilliseconds == s_waitForever ) ? -1 : static_cast<int>( i_timeoutMilliseconds ) );
+		if ( result == 0 )
+		{
+			o_didTimeOut = true;
+			return true;
+		}
+		else if ( ( result < 0 ) && ( errno != EINTR ) )
+		{
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = std::string( "Failed to wait for changes in a watched directory: " ) + strerror( errno );
+			}
+			return false;
+		}
+	}
+
+	// Read every event that is waiting
+	alignas( inotify_event ) char buffer[16 * 1024];
+	for ( ;; )
+	{
+		const ssize_t byteCount = read( m_inotify, buffer, sizeof( buffer ) );
+		if ( byteCount <= 0 )
+		{
+			if ( ( byteCount < 0 ) && ( errno != EAGAIN ) && ( errno != EINTR ) )
+			{
+				if ( o_errorMessage )
+				{
+					*o_errorMessage = std::string( "Failed to read the changes in a watched directory: " ) + strerror( errno );
+				}
+				return false;
+			}
+			return true;
+		}
+		for ( ssize_t offset = 0; offset < byteCount; )
+		{
+			const inotify_event& event = *reinterpret_cast<const inotify_event*>( buffer + offset );
+			offset += sizeof( inotify_event ) + event.len;
+			if ( event.mask & IN_Q_OVERFLOW )
+			{
+				io_haveChangesBeenLost = true;
+				continue;
+			}
+			const std::map<int, std::string>::const_iterator directory = m_watchedDirectories.find( event.wd );
+			if ( ( directory == m_watchedDirectories.end() ) || ( event.len == 0 ) )
+			{
+				continue;
+			}
+			const std::string relativePath = directory->second + event.name;
+			if ( event.mask & IN_ISDIR )
+			{
+				// A new directory (and anything that was put in it before it was watched) is watched too
+				if ( event.mask & ( IN_CREATE | IN_MOVED_TO ) )
+				{
+					if ( !WatchDirectory( relativePath + "/", o_errorMessage ) )
+					{
+						return false;
+					}
+					io_haveChangesBeenLost = true;
+				}
+			}
+			else
+			{
+				AddChangedPath( relativePath, io_relativePaths );
+			}
+		}
+	}
+}
+
+bool eae6320::cDirectoryWatcher::WatchDirectory( const std::string& i_relativePath, std::string* o_errorMessage )
+{
+	const std::string path = m_directory + i_relativePath;
+	// A file has finished changing when it is closed after being written to (or when it is renamed or deleted)
+	const uint32_t changesToWatch = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+	const int watch = inotify_add_watch( m_inotify, path.c_str(), changesToWatch );
+	if ( watch < 0 )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = "inotify failed to watch \"" + path + "\": " + strerror( errno );
+		}
+		return false;
+	}
+	m_watchedDirectories[watch] = i_relativePath;
+
+	// Watch every subdirectory
+	DIR* const directory = opendir( path.c_str() );
+	if ( directory )
+	{
+		bool wereThereErrors = false;
+		while ( const dirent* const entry = readdir( directory ) )
+		{
+			if ( ( strcmp( entry->d_name, "." ) == 0 ) || ( strcmp( entry->d_name, ".." ) == 0 ) )
+			{
+				continue;
+			}
+			const std::string relativePath = i_relativePath + entry->d_name;
+			struct stat status;
+			if ( ( stat( ( m_directory + relativePath ).c_str(), &status ) == 0 ) && S_ISDIR( status.st_mode )
+				&& !WatchDirectory( relativePath + "/", o_errorMessage ) )
+			{
+				wereThereErrors = true;
+				break;
+			}
+		}
+		closedir( directory );
+		return !wereThereErrors;
+	}
+	return true;
+}
+
+#endif
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void AddChangedPath( const std::string& i_relativePath, std::vector<std::string>& io_relativePaths )
+	{
+		for ( std::vector<std::string>::const_iterator i = io_relativePaths.begin(); i != io_relativePaths.end(); ++i )
+		{
+			if ( *i == i_relativePath )
+			{
+				return;
+			}
+		}
+		io_relativePaths.push_back( i_relativePath );
+	}
+}
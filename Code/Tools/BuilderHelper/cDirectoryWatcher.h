@@ -0,0 +1,98 @@
+/*
+	This class waits for files in a directory (or any of its subdirectories) to change
+
+	It uses ReadDirectoryChangesW() on Windows and inotify on Linux,
+	and so waiting doesn't use any CPU time.
+	Editors often save a file in several steps (e.g. by writing a temporary file and then renaming it),
+	and so WaitForChanges() keeps collecting changes until nothing has changed for a short time
+	and then reports every file that changed at once.
+*/
+
+#ifndef EAE6320_CDIRECTORYWATCHER_H
+#define EAE6320_CDIRECTORYWATCHER_H
+
+// Header Files
+//=============
+
+#include <string>
+#include <vector>
+
+#if defined( _WIN32 )
+	#include "../../Engine/Windows/Includes.h"
+#else
+	#include <map>
+#endif
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cDirectoryWatcher
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Only changes that happen after this are reported
+		bool Start( const char* i_directory, std::string* o_errorMessage = NULL );
+		void Stop();
+
+		// Blocks until something changes.
+		// The paths are relative to the directory and use forward slashes.
+		// If the system couldn't keep track of every change (e.g. because too many happened at once)
+		// o_haveChangesBeenLost is true and anything in the directory may have changed
+		bool WaitForChanges( std::vector<std::string>& o_relativePaths, bool& o_haveChangesBeenLost, std::string* o_errorMessage = NULL );
+
+		// Initialization / Shut Down
+		//---------------------------
+
+		cDirectoryWatcher();
+		~cDirectoryWatcher();
+
+		// Data
+		//=====
+
+	private:
+
+		// Changes that are this close together are reported together
+		static const unsigned int s_settleMilliseconds = 50;
+		static const unsigned int s_waitForever = ~0u;
+
+#if defined( _WIN32 )
+		HANDLE m_directory;
+		// This is signaled when the pending ReadDirectoryChangesW() finishes
+		HANDLE m_event;
+		OVERLAPPED m_overlapped;
+		// ReadDirectoryChangesW() needs its buffer to be DWORD aligned
+		DWORD m_buffer[16 * 1024];
+#else
+		int m_inotify;
+		// The path of every watched directory relative to the watched root
+		// (inotify doesn't watch subdirectories, and so each one is watched separately)
+		std::map<int, std::string> m_watchedDirectories;
+		std::string m_directory;
+#endif
+
+		// Implementation
+		//===============
+
+	private:
+
+		// Adds the changes that happen within the timeout to the paths
+		// (o_didTimeOut is true if nothing changed)
+		bool ReadChanges( const unsigned int i_timeoutMilliseconds, std::vector<std::string>& io_relativePaths, bool& io_haveChangesBeenLost,
+			bool& o_didTimeOut, std::string* o_errorMessage );
+#if defined( _WIN32 )
+		bool RequestChanges( std::string* o_errorMessage );
+#else
+		bool WatchDirectory( const std::string& i_relativePath, std::string* o_errorMessage );
+#endif
+
+		cDirectoryWatcher( const cDirectoryWatcher& );
+		cDirectoryWatcher& operator =( const cDirectoryWatcher& );
+	};
+}
+
+#endif	// EAE6320_CDIRECTORYWATCHER_H
@@ -0,0 +1,217 @@
+// Header Files
+//=============
+
+#include "cLuaAllocator.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "UtilityFunctions.h"
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// luaL_newstate() sets a panic function that reports the error,
+	// but lua_newstate() doesn't, and so this does the same thing
+	int OnPanic( lua_State* io_luaState );
+}
+
+// Interface
+//==========
+
+lua_State* eae6320::cLuaAllocator::NewState()
+{
+	lua_State* const luaState = lua_newstate( Allocate, this );
+	if ( luaState )
+	{
+		lua_atpanic( luaState, OnPanic );
+	}
+	return luaState;
+}
+
+std::string eae6320::cLuaAllocator::GetStatsSummary() const
+{
+	std::ostringstream summary;
+	summary << "Lua made " << m_stats.allocationCount << " allocations (" << m_stats.largeAllocationCount <<
+		" too big for the pool) with at most " << m_stats.peakBytesInUse << " bytes in use and " <<
+		m_stats.arenaBytes << " bytes of arenas";
+	return summary.str();
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::cLuaAllocator::cLuaAllocator()
+	:
+	m_arenas( NULL ), m_cursor( NULL ), m_end( NULL )
+{
+	for ( size_t i = 0; i < s_sizeClassCount; ++i )
+	{
+		m_freeLists[i] = NULL;
+	}
+	m_stats.allocationCount = 0;
+	m_stats.largeAllocationCount = 0;
+	m_stats.bytesInUse = 0;
+	m_stats.peakBytesInUse = 0;
+	m_stats.arenaBytes = 0;
+}
+
+eae6320::cLuaAllocator::~cLuaAllocator()
+{
+	// Blocks that came from the arenas don't have to be freed individually;
+	// Lua frees everything when its state is closed
+	// (and so the big blocks that came from the CRT have already been freed)
+	assert( m_stats.bytesInUse == 0 );
+	while ( m_arenas )
+	{
+		sArena* const previous = m_arenas->previous;
+		free( m_arenas );
+		m_arenas = previous;
+	}
+}
+
+// Implementation
+//===============
+
+void* eae6320::cLuaAllocator::Allocate( void* io_userData, void* io_pointer, size_t i_oldSize, size_t i_newSize )
+{
+	cLuaAllocator& allocator = *static_cast<cLuaAllocator*>( io_userData );
+	// When there is no existing block Lua passes the type of object in the old size instead
+	if ( !io_pointer )
+	{
+		i_oldSize = 0;
+	}
+
+	if ( i_newSize == 0 )
+	{
+		allocator.FreeBlock( io_pointer, i_oldSize );
+		return NULL;
+	}
+
+	++allocator.m_stats.allocationCount;
+	if ( io_pointer )
+	{
+		// A block that stays in the same size class (or stays too big for the pool) can be reused
+		const bool wasPooled = i_oldSize <= s_biggestSizeClass;
+		const bool isPooled = i_newSize <= s_biggestSizeClass;
+		if ( wasPooled && isPooled && ( GetSizeClassIndex( i_oldSize ) == GetSizeClassIndex( i_newSize ) ) )
+		{
+			allocator.m_stats.bytesInUse = allocator.m_stats.bytesInUse - i_oldSize + i_newSize;
+		}
+		else if ( !wasPooled && !isPooled )
+		{
+			void* const block = realloc( io_pointer, i_newSize );
+			if ( !block )
+			{
+				return NULL;
+			}
+			++allocator.m_stats.largeAllocationCount;
+			allocator.m_stats.bytesInUse = allocator.m_stats.bytesInUse - i_oldSize + i_newSize;
+			io_pointer = block;
+		}
+		else
+		{
+			void* const block = allocator.AllocateBlock( i_newSize );
+			if ( !block )
+			{
+				// Lua requires that the old block is unchanged if this fails
+				return NULL;
+			}
+			memcpy( block, io_pointer, ( i_oldSize < i_newSize ) ? i_oldSize : i_newSize );
+			allocator.FreeBlock( io_pointer, i_oldSize );
+			io_pointer = block;
+		}
+	}
+	else
+	{
+		io_pointer = allocator.AllocateBlock( i_newSize );
+	}
+	if ( allocator.m_stats.bytesInUse > allocator.m_stats.peakBytesInUse )
+	{
+		allocator.m_stats.peakBytesInUse = allocator.m_stats.bytesInUse;
+	}
+	return io_pointer;
+}
+
+void* eae6320::cLuaAllocator::AllocateBlock( const size_t i_size )
+{
+	void* block;
+	if ( i_size <= s_biggestSizeClass )
+	{
+		const size_t sizeClassIndex = GetSizeClassIndex( i_size );
+		sFreeBlock*& freeList = m_freeLists[sizeClassIndex];
+		if ( freeList )
+		{
+			block = freeList;
+			freeList = freeList->next;
+		}
+		else
+		{
+			const size_t blockSize = ( sizeClassIndex + 1 ) * s_sizeClassGranularity;
+			if ( ( m_cursor + blockSize ) > m_end )
+			{
+				// Whatever is left at the end of the current arena is wasted
+				sArena* const arena = static_cast<sArena*>( malloc( s_arenaSize ) );
+				if ( !arena )
+				{
+					return NULL;
+				}
+				arena->previous = m_arenas;
+				m_arenas = arena;
+				m_stats.arenaBytes += s_arenaSize;
+				// Blocks are aligned to the size class granularity
+				m_cursor = reinterpret_cast<uint8_t*>( arena ) + s_sizeClassGranularity;
+				m_end = reinterpret_cast<uint8_t*>( arena ) + s_arenaSize;
+			}
+			block = m_cursor;
+			m_cursor += blockSize;
+		}
+	}
+	else
+	{
+		block = malloc( i_size );
+		if ( !block )
+		{
+			return NULL;
+		}
+		++m_stats.largeAllocationCount;
+	}
+	m_stats.bytesInUse += i_size;
+	return block;
+}
+
+void eae6320::cLuaAllocator::FreeBlock( void* i_block, const size_t i_size )
+{
+	if ( i_block )
+	{
+		if ( i_size <= s_biggestSizeClass )
+		{
+			sFreeBlock* const block = static_cast<sFreeBlock*>( i_block );
+			sFreeBlock*& freeList = m_freeLists[GetSizeClassIndex( i_size )];
+			block->next = freeList;
+			freeList = block;
+		}
+		else
+		{
+			free( i_block );
+		}
+		m_stats.bytesInUse -= i_size;
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	int OnPanic( lua_State* io_luaState )
+	{
+		const char* const errorMessage = lua_tostring( io_luaState, -1 );
+		eae6320::OutputErrorMessage( errorMessage ? errorMessage : "An unprotected error occurred in a Lua state" );
+		return 0;
+	}
+}
@@ -0,0 +1,108 @@
+/*
+	This class is a memory allocator for Lua states
+
+	luaL_newstate() makes Lua allocate every table, string, and closure with the CRT's realloc(),
+	and parsing a big asset file allocates a very large number of small blocks.
+	A state that is created with NewState() instead gets its memory from this allocator:
+	small blocks are rounded up to a size class
+	and carved out of big arenas, and a freed block goes onto its size class's free list to be reused.
+	Nothing is returned to the system until the allocator itself is destroyed,
+	and then every arena is freed at once
+	(and so the allocator should live exactly as long as the asset that it is used for).
+*/
+
+#ifndef EAE6320_CLUAALLOCATOR_H
+#define EAE6320_CLUAALLOCATOR_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../../Externals/Lua/Includes.h"
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cLuaAllocator
+	{
+		// Interface
+		//==========
+
+	public:
+
+		struct sStats
+		{
+			// Every allocation and reallocation that Lua asked for
+			size_t allocationCount;
+			// Allocations that were too big for a size class and came from the CRT instead
+			size_t largeAllocationCount;
+			size_t bytesInUse;
+			size_t peakBytesInUse;
+			// The memory that was allocated from the system for the arenas
+			size_t arenaBytes;
+		};
+
+		// Creates a Lua state whose memory all comes from this allocator
+		// (the state must be closed before the allocator is destroyed).
+		// Returns NULL if the state couldn't be created
+		lua_State* NewState();
+		const sStats& GetStats() const { return m_stats; }
+		// A one line summary of the stats for the build output
+		std::string GetStatsSummary() const;
+
+		// Initialization / Shut Down
+		//---------------------------
+
+		cLuaAllocator();
+		~cLuaAllocator();
+
+		// Data
+		//=====
+
+	private:
+
+		// Size classes are 16 bytes apart up to the biggest one
+		// (that covers Lua's strings, table nodes, and closures for typical asset files)
+		static const size_t s_sizeClassGranularity = 16;
+		static const size_t s_sizeClassCount = 32;
+		static const size_t s_biggestSizeClass = s_sizeClassGranularity * s_sizeClassCount;
+		static const size_t s_arenaSize = 256 * 1024;
+
+		// A freed block stores the next free block of its size class in itself
+		struct sFreeBlock
+		{
+			sFreeBlock* next;
+		};
+		struct sArena
+		{
+			sArena* previous;
+		};
+
+		sFreeBlock* m_freeLists[s_sizeClassCount];
+		sArena* m_arenas;
+		uint8_t* m_cursor;
+		uint8_t* m_end;
+		sStats m_stats;
+
+		// Implementation
+		//===============
+
+	private:
+
+		// This is the lua_Alloc function
+		static void* Allocate( void* io_userData, void* io_pointer, size_t i_oldSize, size_t i_newSize );
+		void* AllocateBlock( const size_t i_size );
+		void FreeBlock( void* i_block, const size_t i_size );
+		static size_t GetSizeClassIndex( const size_t i_size ) { return ( i_size - 1 ) / s_sizeClassGranularity; }
+
+		cLuaAllocator( const cLuaAllocator& );
+		cLuaAllocator& operator =( const cLuaAllocator& );
+	};
+}
+
+#endif	// EAE6320_CLUAALLOCATOR_H
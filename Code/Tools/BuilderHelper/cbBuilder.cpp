@@ -3,8 +3,16 @@
 
 #include "cbBuilder.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <sstream>
 
+// Static Data Initialization
+//===========================
+
+const char* const eae6320::cbBuilder::s_dependencyFileExtension = ".d";
+const char* const eae6320::cbBuilder::s_timingFileExtension = ".timing";
+
 // Interface
 //==========
 
@@ -26,7 +34,13 @@ bool eae6320::cbBuilder::ParseCommandArgumentsAndBuild( char** i_arguments, cons
 		{
 			optionalArguments.push_back( i_arguments[i] );
 		}
-		return Build( optionalArguments );
+		m_phaseStartTime = std::chrono::steady_clock::now();
+		if ( !Build( optionalArguments ) )
+		{
+			return false;
+		}
+		EndPhase( m_phases.empty() ? "build" : "other" );
+		return WriteDependencyFile() && WriteTimingFile();
 	}
 	else
 	{
@@ -59,3 +73,72 @@ eae6320::cbBuilder::cbBuilder()
 {
 
 }
+
+// Inheritable Implementation
+//===========================
+
+void eae6320::cbBuilder::AddDependency( const std::string& i_path )
+{
+	// A file that is read more than once is only listed once
+	if ( std::find( m_dependencies.begin(), m_dependencies.end(), i_path ) == m_dependencies.end() )
+	{
+		m_dependencies.push_back( i_path );
+	}
+}
+
+void eae6320::cbBuilder::EndPhase( const char* i_name )
+{
+	const std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+	sPhase phase;
+	phase.name = i_name;
+	phase.milliseconds = std::chrono::duration<double, std::milli>( endTime - m_phaseStartTime ).count();
+	m_phases.push_back( phase );
+	m_phaseStartTime = endTime;
+}
+
+// Implementation
+//===============
+
+bool eae6320::cbBuilder::WriteDependencyFile() const
+{
+	const std::string path_dependencyFile = std::string( m_path_target ) + s_dependencyFileExtension;
+	FILE* dependencyFile;
+	if ( fopen_s( &dependencyFile, path_dependencyFile.c_str(), "w" ) != 0 )
+	{
+		eae6320::OutputErrorMessage( "The dependency file couldn't be opened for writing", path_dependencyFile.c_str() );
+		return false;
+	}
+	bool wereThereErrors = fprintf( dependencyFile, "%s\n", m_path_source ) < 0;
+	for ( std::vector<std::string>::const_iterator i = m_dependencies.begin(); !wereThereErrors && ( i != m_dependencies.end() ); ++i )
+	{
+		wereThereErrors = fprintf( dependencyFile, "%s\n", i->c_str() ) < 0;
+	}
+	if ( ( fclose( dependencyFile ) != 0 ) || wereThereErrors )
+	{
+		eae6320::OutputErrorMessage( "The dependency file couldn't be written", path_dependencyFile.c_str() );
+		return false;
+	}
+	return true;
+}
+
+bool eae6320::cbBuilder::WriteTimingFile() const
+{
+	const std::string path_timingFile = std::string( m_path_target ) + s_timingFileExtension;
+	FILE* timingFile;
+	if ( fopen_s( &timingFile, path_timingFile.c_str(), "w" ) != 0 )
+	{
+		eae6320::OutputErrorMessage( "The timing file couldn't be opened for writing", path_timingFile.c_str() );
+		return false;
+	}
+	bool wereThereErrors = false;
+	for ( std::vector<sPhase>::const_iterator i = m_phases.begin(); !wereThereErrors && ( i != m_phases.end() ); ++i )
+	{
+		wereThereErrors = fprintf( timingFile, "%s %f\n", i->name.c_str(), i->milliseconds ) < 0;
+	}
+	if ( ( fclose( timingFile ) != 0 ) || wereThereErrors )
+	{
+		eae6320::OutputErrorMessage( "The timing file couldn't be written", path_timingFile.c_str() );
+		return false;
+	}
+	return true;
+}
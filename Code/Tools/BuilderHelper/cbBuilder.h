@@ -10,6 +10,7 @@
 // Header Files
 //=============
 
+#include <chrono>
 #include <cstdlib>
 #include <string>
 #include <vector>
@@ -51,6 +52,16 @@ namespace eae6320
 		// and then call this function in the derived class with any remaining (optional) arguments:
 		virtual bool Build( const std::vector<std::string>& i_optionalArguments ) = 0;
 
+		// After a successful build a dependency file is written next to the target
+		// (like a compiler's .d file):
+		// it has the path of every file that the target was built from, one per line,
+		// starting with the source.
+		// BuildAssets.lua adds it to the build graph so that the target is rebuilt if any of them change
+		static const char* const s_dependencyFileExtension;
+		// A timing file is also written with how long each phase of the build took, one "name milliseconds" per line,
+		// and BuildAssets.lua adds it to the build report
+		static const char* const s_timingFileExtension;
+
 		// Initialization / Shut Down
 		//---------------------------
 
@@ -63,6 +74,41 @@ namespace eae6320
 
 		const char* m_path_source;
 		const char* m_path_target;
+
+		// Inheritable Implementation
+		//===========================
+
+	protected:
+
+		// A derived builder must call this for every file other than the source that it reads
+		void AddDependency( const std::string& i_path );
+		// A derived builder can call this to split its time into phases:
+		// each phase starts when the previous one ended (or when the build started),
+		// and whatever happens after the last phase is reported as "other"
+		void EndPhase( const char* i_name );
+
+		// Data
+		//=====
+
+	private:
+
+		struct sPhase
+		{
+			std::string name;
+			double milliseconds;
+		};
+
+		std::vector<std::string> m_dependencies;
+		std::vector<sPhase> m_phases;
+		std::chrono::steady_clock::time_point m_phaseStartTime;
+
+		// Implementation
+		//===============
+
+	private:
+
+		bool WriteDependencyFile() const;
+		bool WriteTimingFile() const;
 	};
 }
 
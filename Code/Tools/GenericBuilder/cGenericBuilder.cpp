@@ -3,20 +3,76 @@
 
 #include "cGenericBuilder.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <sstream>
 #include "../../Engine/Windows/WindowsFunctions.h"
 
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Returns true if the line is an #include directive
+	// (o_includedPath is empty if the directive isn't in the supported #include "path" form)
+	bool ParseInclude( const std::string& i_line, std::string& o_includedPath );
+}
+
 // Interface
 //==========
 
 // Build
 //------
 
-bool eae6320::cGenericBuilder::Build( const std::vector<std::string>& )
+bool eae6320::cGenericBuilder::Build( const std::vector<std::string>& i_arguments )
 {
 	bool wereThereErrors = false;
 
+	bool shouldIncludesBeExpanded = false;
+	for ( std::vector<std::string>::const_iterator i = i_arguments.begin(); i != i_arguments.end(); ++i )
+	{
+		if ( *i == "-expandIncludes" )
+		{
+			shouldIncludesBeExpanded = true;
+		}
+		else
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\"" << *i << "\" isn't a valid argument (the only optional argument is -expandIncludes)";
+			eae6320::OutputErrorMessage( errorMessage.str().c_str(), m_path_source );
+			return false;
+		}
+	}
+
+	if ( shouldIncludesBeExpanded )
+	{
+		std::string expandedText;
+		{
+			std::vector<std::string> includeStack;
+			if ( !ExpandIncludes( m_path_source, includeStack, expandedText ) )
+			{
+				return false;
+			}
+			EndPhase( "expand" );
+		}
+		FILE* targetFile;
+		if ( fopen_s( &targetFile, m_path_target, "wb" ) != 0 )
+		{
+			eae6320::OutputErrorMessage( "The target couldn't be opened for writing", m_path_target );
+			return false;
+		}
+		const bool wasTextWritten = fwrite( expandedText.data(), 1, expandedText.size(), targetFile ) == expandedText.size();
+		if ( ( fclose( targetFile ) != 0 ) || !wasTextWritten )
+		{
+			wereThereErrors = true;
+			eae6320::OutputErrorMessage( "The target couldn't be written", m_path_target );
+		}
+		EndPhase( "write" );
+	}
 	// Copy the source to the target
+	else
 	{
 		const bool dontFailIfTargetAlreadyExists = false;
 		const bool updateTheTargetFileTime = true;
@@ -28,7 +84,123 @@ bool eae6320::cGenericBuilder::Build( const std::vector<std::string>& )
 			decoratedErrorMessage << "Windows failed to copy \"" << m_path_source << "\" to \"" << m_path_target << "\": " << errorMessage;
 			eae6320::OutputErrorMessage( decoratedErrorMessage.str().c_str(), __FILE__ );
 		}
+		EndPhase( "copy" );
 	}
 	
 	return !wereThereErrors;
 }
+
+// Implementation
+//===============
+
+bool eae6320::cGenericBuilder::ExpandIncludes( const std::string& i_path, std::vector<std::string>& io_includeStack, std::string& io_expandedText )
+{
+	if ( std::find( io_includeStack.begin(), io_includeStack.end(), i_path ) != io_includeStack.end() )
+	{
+		eae6320::OutputErrorMessage( "The file includes itself", i_path.c_str() );
+		return false;
+	}
+	std::ifstream file( i_path.c_str(), std::ios::binary );
+	if ( !file )
+	{
+		std::stringstream errorMessage;
+		errorMessage << "The file couldn't be opened";
+		if ( !io_includeStack.empty() )
+		{
+			errorMessage << " (it is included by \"" << io_includeStack.back() << "\")";
+		}
+		eae6320::OutputErrorMessage( errorMessage.str().c_str(), i_path.c_str() );
+		return false;
+	}
+	io_includeStack.push_back( i_path );
+
+	// Included paths are relative to the directory of the file that includes them
+	std::string directory;
+	{
+		const size_t lastSlash = i_path.find_last_of( "/\\" );
+		if ( lastSlash != std::string::npos )
+		{
+			directory = i_path.substr( 0, lastSlash + 1 );
+		}
+	}
+	std::string line;
+	unsigned int lineNumber = 0;
+	while ( std::getline( file, line ) )
+	{
+		++lineNumber;
+		std::string includedPath;
+		if ( ParseInclude( line, includedPath ) )
+		{
+			if ( includedPath.empty() )
+			{
+				std::stringstream errorMessage;
+				errorMessage << "Line " << lineNumber << " has an #include that isn't in the form #include \"path\"";
+				eae6320::OutputErrorMessage( errorMessage.str().c_str(), i_path.c_str() );
+				return false;
+			}
+			const std::string path_include = directory + includedPath;
+			// The dependency is added even if the file doesn't exist
+			// so that the target is rebuilt when it is created
+			AddDependency( path_include );
+			if ( !ExpandIncludes( path_include, io_includeStack, io_expandedText ) )
+			{
+				return false;
+			}
+			// The last line of an included file might not end with a newline
+			if ( !io_expandedText.empty() && ( *io_expandedText.rbegin() != '\n' ) )
+			{
+				io_expandedText += '\n';
+			}
+		}
+		else
+		{
+			io_expandedText += line;
+			if ( !file.eof() )
+			{
+				io_expandedText += '\n';
+			}
+		}
+	}
+	if ( file.bad() )
+	{
+		eae6320::OutputErrorMessage( "The file couldn't be read", i_path.c_str() );
+		return false;
+	}
+
+	io_includeStack.pop_back();
+	return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool ParseInclude( const std::string& i_line, std::string& o_includedPath )
+	{
+		o_includedPath.clear();
+		const char* const whitespace = " \t";
+		size_t position = i_line.find_first_not_of( whitespace );
+		if ( ( position == std::string::npos ) || ( i_line[position] != '#' ) )
+		{
+			return false;
+		}
+		position = i_line.find_first_not_of( whitespace, position + 1 );
+		const char* const directive = "include";
+		const size_t directiveLength = strlen( directive );
+		if ( ( position == std::string::npos ) || ( i_line.compare( position, directiveLength, directive ) != 0 ) )
+		{
+			return false;
+		}
+		position = i_line.find_first_not_of( whitespace, position + directiveLength );
+		if ( ( position != std::string::npos ) && ( i_line[position] == '"' ) )
+		{
+			const size_t closingQuote = i_line.find( '"', position + 1 );
+			if ( ( closingQuote != std::string::npos ) && ( closingQuote > ( position + 1 ) ) )
+			{
+				o_includedPath = i_line.substr( position + 1, closingQuote - position - 1 );
+			}
+		}
+		return true;
+	}
+}
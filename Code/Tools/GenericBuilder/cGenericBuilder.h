@@ -1,6 +1,13 @@
 /*
 	This is an example builder program that just copies the source file to the target path
 	(as opposed to actually "building" it in some way so that the target is different than the source)
+
+	If it is given the "-expandIncludes" argument, though, it treats the source as text
+	and replaces every #include "path" line with the contents of the file
+	(the path is relative to the file that includes it).
+	This is how shaders share code: the engine compiles shaders from memory where #include doesn't work.
+	Every included file is a dependency of the target,
+	and so changing one rebuilds every target that includes it.
 */
 
 #ifndef EAE6320_CGENERICBUILDER_H
@@ -27,6 +34,15 @@ namespace eae6320
 		//------
 
 		virtual bool Build( const std::vector<std::string>& i_arguments );
+
+		// Implementation
+		//===============
+
+	private:
+
+		// The include stack is the files that are currently being expanded
+		// (a file that includes itself, even indirectly, would never finish)
+		bool ExpandIncludes( const std::string& i_path, std::vector<std::string>& io_includeStack, std::string& io_expandedText );
 	};
 }
 
@@ -0,0 +1,43 @@
+/*
+	The main() function is where the program starts execution
+
+	Usage (from the game directory):
+		GoldenImageTests.exe <golden image directory> [-update]
+	"-update" overwrites the golden images with what is drawn
+	(the new images should be looked at before they are checked in)
+*/
+
+// Header Files
+//=============
+
+#include "GoldenImageTests.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "../../Engine/UserOutput/Log.h"
+
+// Entry Point
+//============
+
+int main( int i_argumentCount, char** i_arguments )
+{
+	if ( i_argumentCount < 2 )
+	{
+		std::cerr << "Usage: GoldenImageTests <golden image directory> [-update]\n";
+		return EXIT_FAILURE;
+	}
+	std::string goldenImageDirectory( i_arguments[1] );
+	if ( ( goldenImageDirectory[goldenImageDirectory.size() - 1] != '\\' ) && ( goldenImageDirectory[goldenImageDirectory.size() - 1] != '/' ) )
+	{
+		goldenImageDirectory += '/';
+	}
+	const bool shouldUpdate = ( i_argumentCount > 2 ) && ( strcmp( i_arguments[2], "-update" ) == 0 );
+
+	// Errors about loading assets are written to the log
+	eae6320::UserOutput::Log::Initialize( "GoldenImageTests.log" );
+	const bool werePassed = eae6320::GoldenImageTests::Run( goldenImageDirectory.c_str(), shouldUpdate );
+	eae6320::UserOutput::Log::ShutDown();
+
+	return werePassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,378 @@
+// Header Files
+//=============
+
+#include "GoldenImageTests.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../Engine/Graphics/Graphics.h"
+#include "../../Engine/Graphics/Renderable.h"
+#include "../../Engine/Graphics/RenderQueue.h"
+#include "../../Engine/Graphics/SoftwareRasterizer.h"
+#include "../../Engine/Windows/WindowsFunctions.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// One unit (half of the screen) covers 64 pixels,
+	// which is big enough to see every mesh but keeps the golden images small
+	const unsigned int s_imageSize = 128;
+	// Every channel of every pixel must be at most this different from the golden image.
+	// Which pixels are covered is exact (positions are snapped to a fixed-point grid),
+	// but interpolated colors can round differently with a different compiler
+	const int s_channelTolerance = 2;
+	// The grid's offsets are multiples of this, which is a whole number of pixels,
+	// so that a mesh's vertices fall at the same place within a pixel in every cell
+	const float s_gridSpacing = 0.25f;
+	const int s_gridCellsPerSide = 7;
+
+	const char* const s_windowClassName = "EAE6320 Golden Image Tests";
+	HWND s_window = NULL;
+
+	// A renderable can be submitted more than once because each packet copies the offset
+	eae6320::Graphics::Renderable s_triangle;
+	eae6320::Graphics::Renderable s_rectangle;
+
+	typedef void ( *tSubmitScene )( eae6320::Graphics::RenderQueue& io_renderQueue );
+	struct sScene
+	{
+		const char* name;
+		tSubmitScene submit;
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Initialization / Shut Down
+	//---------------------------
+
+	bool Initialize();
+	bool ShutDown();
+
+	// Scenes
+	//-------
+
+	void SubmitTriangle( eae6320::Graphics::RenderQueue& io_renderQueue );
+	void SubmitRectangle( eae6320::Graphics::RenderQueue& io_renderQueue );
+	// Overlapping rectangles with triangles on top of some of them,
+	// so that the draw order and batching both affect the image
+	void SubmitGrid( eae6320::Graphics::RenderQueue& io_renderQueue );
+
+	// Golden Images
+	//--------------
+
+	// Only reads binary PPMs like the ones SoftwareRasterizer::WritePpm() writes
+	bool ReadPpm( const std::string& i_path, unsigned int& o_width, unsigned int& o_height, std::vector<uint8_t>& o_pixels,
+		std::string& o_errorMessage );
+	// Returns false if the golden image can't be read or if it is a different size.
+	// Otherwise the pixels that are too different are counted
+	bool CompareWithGoldenImage( const eae6320::Graphics::SoftwareRasterizer& i_rasterizer, const std::string& i_path,
+		unsigned int& o_differentPixelCount, std::string& o_errorMessage );
+}
+
+// Interface
+//==========
+
+bool eae6320::GoldenImageTests::Run( const char* i_goldenImageDirectory, const bool i_shouldUpdateGoldenImages )
+{
+	const sScene scenes[] =
+	{
+		{ "triangle", SubmitTriangle },
+		{ "rectangle", SubmitRectangle },
+		{ "grid", SubmitGrid },
+	};
+	const unsigned int sceneCount = sizeof( scenes ) / sizeof( scenes[0] );
+
+	bool wereThereErrors = false;
+	unsigned int failedCount = 0;
+	Graphics::SoftwareRasterizer rasterizer;
+	Graphics::RenderQueue renderQueue;
+	std::string errorMessage;
+
+	if ( !Initialize() )
+	{
+		wereThereErrors = true;
+		goto OnExit;
+	}
+	if ( !rasterizer.Initialize( s_imageSize, s_imageSize, 0, &errorMessage ) )
+	{
+		std::cerr << "The software rasterizer couldn't be initialized: " << errorMessage << "\n";
+		wereThereErrors = true;
+		goto OnExit;
+	}
+
+	for ( unsigned int i = 0; i < sceneCount; ++i )
+	{
+		const sScene& scene = scenes[i];
+		const std::string path_golden = std::string( i_goldenImageDirectory ) + scene.name + ".ppm";
+		// Batching must not change the image, and so both ways are compared with the same golden image
+		for ( unsigned int j = 0; j < 2; ++j )
+		{
+			const bool isInstancingEnabled = j == 0;
+			const char* const variant = isInstancingEnabled ? "" : " (without instancing)";
+
+			renderQueue.SetIsInstancingEnabled( isInstancingEnabled );
+			scene.submit( renderQueue );
+			rasterizer.Clear();
+			renderQueue.Draw( rasterizer );
+			rasterizer.Flush();
+
+			// The rasterizer counts its draw calls the same way that the GPU backends issue them
+			if ( rasterizer.GetStats().drawCallCount != renderQueue.GetStats().drawCallCount )
+			{
+				std::cerr << scene.name << variant << ": the render queue issued " << renderQueue.GetStats().drawCallCount
+					<< " draw calls but the rasterizer drew " << rasterizer.GetStats().drawCallCount << "\n";
+				++failedCount;
+				continue;
+			}
+
+			if ( i_shouldUpdateGoldenImages )
+			{
+				if ( isInstancingEnabled )
+				{
+					if ( rasterizer.WritePpm( path_golden.c_str(), &errorMessage ) )
+					{
+						std::cout << scene.name << ": updated " << path_golden << "\n";
+					}
+					else
+					{
+						std::cerr << scene.name << ": " << errorMessage << "\n";
+						++failedCount;
+					}
+				}
+				continue;
+			}
+
+			unsigned int differentPixelCount;
+			if ( !CompareWithGoldenImage( rasterizer, path_golden, differentPixelCount, errorMessage ) )
+			{
+				std::cerr << scene.name << variant << ": " << errorMessage << "\n";
+				++failedCount;
+			}
+			else if ( differentPixelCount > 0 )
+			{
+				const std::string path_failed = std::string( scene.name ) + ".failed.ppm";
+				std::cerr << scene.name << variant << ": " << differentPixelCount << " pixels are different from " << path_golden;
+				if ( rasterizer.WritePpm( path_failed.c_str() ) )
+				{
+					std::cerr << " (the image that was drawn is " << path_failed << ")";
+				}
+				std::cerr << "\n";
+				++failedCount;
+			}
+			else
+			{
+				std::cout << scene.name << variant << ": passed\n";
+			}
+		}
+	}
+	if ( failedCount > 0 )
+	{
+		std::cerr << failedCount << " of " << ( sceneCount * 2 ) << " golden image tests failed\n";
+		wereThereErrors = true;
+	}
+
+OnExit:
+
+	rasterizer.ShutDown();
+	if ( !ShutDown() )
+	{
+		wereThereErrors = true;
+	}
+
+	return !wereThereErrors;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	// Initialization / Shut Down
+	//---------------------------
+
+	bool Initialize()
+	{
+		const HINSTANCE thisInstanceOfTheProgram = GetModuleHandle( NULL );
+		{
+			WNDCLASSEXA windowClass = { 0 };
+			windowClass.cbSize = sizeof( WNDCLASSEXA );
+			windowClass.lpfnWndProc = DefWindowProcA;
+			windowClass.hInstance = thisInstanceOfTheProgram;
+			windowClass.lpszClassName = s_windowClassName;
+			if ( RegisterClassExA( &windowClass ) == NULL )
+			{
+				std::cerr << "Windows failed to register the window class: " << eae6320::GetLastWindowsError() << "\n";
+				return false;
+			}
+		}
+		// The window is only needed for the graphics context, and so it is never shown
+		s_window = CreateWindowExA( 0, s_windowClassName, s_windowClassName, WS_OVERLAPPEDWINDOW,
+			CW_USEDEFAULT, CW_USEDEFAULT, s_imageSize, s_imageSize, NULL, NULL, thisInstanceOfTheProgram, NULL );
+		if ( s_window == NULL )
+		{
+			std::cerr << "Windows failed to create the window: " << eae6320::GetLastWindowsError() << "\n";
+			return false;
+		}
+		if ( !eae6320::Graphics::Initialize( s_window ) )
+		{
+			std::cerr << "The graphics context couldn't be created\n";
+			return false;
+		}
+
+		// Errors about individual assets are written to the log
+		if ( !s_triangle.Initialize( "data/triangle.msh" ) )
+		{
+			std::cerr << "data/triangle.msh couldn't be loaded (is the working directory the game directory?)\n";
+			return false;
+		}
+		if ( !s_rectangle.Initialize( "data/rectangle.msh" ) )
+		{
+			std::cerr << "data/rectangle.msh couldn't be loaded (is the working directory the game directory?)\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	bool ShutDown()
+	{
+		bool wereThereErrors = false;
+
+		s_triangle.ShutDown();
+		s_rectangle.ShutDown();
+		if ( !eae6320::Graphics::ShutDown() )
+		{
+			wereThereErrors = true;
+		}
+		if ( s_window )
+		{
+			if ( DestroyWindow( s_window ) == FALSE )
+			{
+				std::cerr << "Windows failed to destroy the window: " << eae6320::GetLastWindowsError() << "\n";
+				wereThereErrors = true;
+			}
+			s_window = NULL;
+		}
+		UnregisterClassA( s_windowClassName, GetModuleHandle( NULL ) );
+
+		return !wereThereErrors;
+	}
+
+	// Scenes
+	//-------
+
+	void SubmitTriangle( eae6320::Graphics::RenderQueue& io_renderQueue )
+	{
+		s_triangle.SetPositionOffset( eae6320::Math::cVector() );
+		io_renderQueue.Submit( s_triangle );
+	}
+
+	void SubmitRectangle( eae6320::Graphics::RenderQueue& io_renderQueue )
+	{
+		s_rectangle.SetPositionOffset( eae6320::Math::cVector() );
+		io_renderQueue.Submit( s_rectangle );
+	}
+
+	void SubmitGrid( eae6320::Graphics::RenderQueue& io_renderQueue )
+	{
+		const int cellCount = s_gridCellsPerSide * s_gridCellsPerSide;
+		const float firstOffset = -s_gridSpacing * static_cast<float>( s_gridCellsPerSide / 2 );
+		for ( int i = 0; i < cellCount; ++i )
+		{
+			const int column = i % s_gridCellsPerSide;
+			const int row = i / s_gridCellsPerSide;
+			const eae6320::Math::cVector offset( firstOffset + ( s_gridSpacing * static_cast<float>( column ) ),
+				firstOffset + ( s_gridSpacing * static_cast<float>( row ) ) );
+			// Neighboring rectangles overlap, and so each one gets its own depth to make the order well defined
+			const float depth = static_cast<float>( i ) / static_cast<float>( cellCount );
+			s_rectangle.SetPositionOffset( offset );
+			io_renderQueue.Submit( s_rectangle, 0, depth );
+			if ( ( ( column + row ) % 2 ) == 1 )
+			{
+				s_triangle.SetPositionOffset( offset );
+				io_renderQueue.Submit( s_triangle, 1, depth );
+			}
+		}
+	}
+
+	// Golden Images
+	//--------------
+
+	bool ReadPpm( const std::string& i_path, unsigned int& o_width, unsigned int& o_height, std::vector<uint8_t>& o_pixels,
+		std::string& o_errorMessage )
+	{
+		std::ifstream file( i_path.c_str(), std::ios::in | std::ios::binary );
+		if ( !file )
+		{
+			o_errorMessage = "The golden image \"" + i_path + "\" couldn't be opened";
+			return false;
+		}
+		std::string magicNumber;
+		unsigned int maxValue;
+		file >> magicNumber >> o_width >> o_height >> maxValue;
+		// A single whitespace character separates the header from the pixels
+		file.get();
+		if ( !file || ( magicNumber != "P6" ) || ( maxValue != 255 ) )
+		{
+			o_errorMessage = "The golden image \"" + i_path + "\" isn't a binary PPM with 8 bits per channel";
+			return false;
+		}
+		o_pixels.resize( o_width * o_height * 3 );
+		if ( !o_pixels.empty() )
+		{
+			file.read( reinterpret_cast<char*>( &o_pixels[0] ), o_pixels.size() );
+		}
+		if ( !file )
+		{
+			o_errorMessage = "The golden image \"" + i_path + "\" is truncated";
+			return false;
+		}
+		return true;
+	}
+
+	bool CompareWithGoldenImage( const eae6320::Graphics::SoftwareRasterizer& i_rasterizer, const std::string& i_path,
+		unsigned int& o_differentPixelCount, std::string& o_errorMessage )
+	{
+		unsigned int width, height;
+		std::vector<uint8_t> goldenPixels;
+		if ( !ReadPpm( i_path, width, height, goldenPixels, o_errorMessage ) )
+		{
+			return false;
+		}
+		if ( ( width != i_rasterizer.GetWidth() ) || ( height != i_rasterizer.GetHeight() ) )
+		{
+			o_errorMessage = "The golden image \"" + i_path + "\" is a different size than the framebuffer";
+			return false;
+		}
+
+		o_differentPixelCount = 0;
+		for ( unsigned int y = 0; y < height; ++y )
+		{
+			for ( unsigned int x = 0; x < width; ++x )
+			{
+				// The PPM doesn't have the alpha channel
+				const uint8_t* const pixel = i_rasterizer.GetPixel( x, y );
+				const uint8_t* const goldenPixel = &goldenPixels[( ( y * width ) + x ) * 3];
+				for ( unsigned int i = 0; i < 3; ++i )
+				{
+					if ( std::abs( static_cast<int>( pixel[i] ) - static_cast<int>( goldenPixel[i] ) ) > s_channelTolerance )
+					{
+						++o_differentPixelCount;
+						break;
+					}
+				}
+			}
+		}
+		return true;
+	}
+}
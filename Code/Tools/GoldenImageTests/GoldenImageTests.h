@@ -0,0 +1,28 @@
+/*
+	These functions draw the game's meshes with the software rasterizer
+	and compare the framebuffer with golden images that are checked in next to this file
+
+	They must be run from the game directory so that the built meshes and shaders in data/ are found.
+	A mesh can't be loaded without a graphics context (its GPU objects are created as well),
+	and so a window that is never shown is created for one.
+*/
+
+#ifndef EAE6320_GOLDENIMAGETESTS_H
+#define EAE6320_GOLDENIMAGETESTS_H
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace GoldenImageTests
+	{
+		// Every scene is drawn through a RenderQueue both with and without instancing,
+		// and both images must match the scene's golden image (<directory>/<scene>.ppm).
+		// A scene that doesn't match is written to <scene>.failed.ppm in the working directory.
+		// If the golden images are being updated they are overwritten instead of being compared
+		bool Run( const char* i_goldenImageDirectory, const bool i_shouldUpdateGoldenImages = false );
+	}
+}
+
+#endif	// EAE6320_GOLDENIMAGETESTS_H
@@ -0,0 +1,170 @@
+// Header Files
+//=============
+
+#include "MeshEncoder.h"
+
+#include <cstring>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const size_t s_minMatchLength = 4;
+	// Offsets are stored in 16 bits
+	const size_t s_maxOffset = 0xffff;
+	const unsigned int s_hashBitCount = 16;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	uint32_t Read32( const uint8_t* i_data );
+	uint32_t Hash( const uint32_t i_bytes );
+	void WriteLength( size_t i_length, std::vector<uint8_t>& io_output );
+	void WriteSequence( const uint8_t* i_literals, const size_t i_literalCount, const size_t i_offset, const size_t i_matchLength,
+		std::vector<uint8_t>& io_output );
+}
+
+// Interface
+//==========
+
+void eae6320::MeshEncoder::Encode( const void* i_vertices, const uint32_t i_vertexCount, const size_t i_vertexSize,
+	const uint32_t* i_indices, const uint32_t i_indexCount, std::vector<uint8_t>& o_encoded )
+{
+	const size_t vertexSize = static_cast<size_t>( i_vertexCount ) * i_vertexSize;
+	const size_t indexSize = static_cast<size_t>( i_indexCount ) * sizeof( uint32_t );
+	std::vector<uint8_t> planes( vertexSize + indexSize + 1 );
+	FilterVertices( static_cast<const uint8_t*>( i_vertices ), i_vertexCount, i_vertexSize, &planes[0] );
+	FilterIndices( i_indices, i_indexCount, &planes[vertexSize] );
+	CompressLz( &planes[0], vertexSize + indexSize, o_encoded );
+}
+
+void eae6320::MeshEncoder::FilterVertices( const uint8_t* i_vertices, const uint32_t i_vertexCount, const size_t i_vertexSize, uint8_t* o_planes )
+{
+	const size_t vertexSize = i_vertexSize;
+	for ( size_t k = 0; k < vertexSize; ++k )
+	{
+		uint8_t previous = 0;
+		uint8_t* const plane = o_planes + ( k * i_vertexCount );
+		for ( uint32_t i = 0; i < i_vertexCount; ++i )
+		{
+			const uint8_t byte = i_vertices[( i * vertexSize ) + k];
+			plane[i] = static_cast<uint8_t>( byte - previous );
+			previous = byte;
+		}
+	}
+}
+
+void eae6320::MeshEncoder::FilterIndices( const uint32_t* i_indices, const uint32_t i_indexCount, uint8_t* o_planes )
+{
+	uint32_t previous = 0;
+	for ( uint32_t i = 0; i < i_indexCount; ++i )
+	{
+		const int32_t delta = static_cast<int32_t>( i_indices[i] - previous );
+		const uint32_t zigzag = ( static_cast<uint32_t>( delta ) << 1 ) ^ static_cast<uint32_t>( delta >> 31 );
+		previous = i_indices[i];
+		for ( size_t byte = 0; byte < 4; ++byte )
+		{
+			o_planes[( byte * i_indexCount ) + i] = static_cast<uint8_t>( zigzag >> ( byte * 8 ) );
+		}
+	}
+}
+
+void eae6320::MeshEncoder::CompressLz( const uint8_t* i_data, const size_t i_size, std::vector<uint8_t>& o_compressed )
+{
+	o_compressed.clear();
+	o_compressed.reserve( i_size + ( i_size / 255 ) + 16 );
+
+	// Greedy matching with a single candidate per hash
+	std::vector<uint32_t> positions( static_cast<size_t>( 1 ) << s_hashBitCount, 0xffffffff );
+	size_t literalStart = 0;
+	size_t position = 0;
+	while ( ( position + s_minMatchLength ) <= i_size )
+	{
+		const uint32_t bytes = Read32( i_data + position );
+		uint32_t& candidateSlot = positions[Hash( bytes )];
+		const size_t candidate = candidateSlot;
+		candidateSlot = static_cast<uint32_t>( position );
+		if ( ( candidate != 0xffffffff ) && ( ( position - candidate ) <= s_maxOffset ) && ( Read32( i_data + candidate ) == bytes ) )
+		{
+			size_t matchLength = s_minMatchLength;
+			while ( ( ( position + matchLength ) < i_size ) && ( i_data[candidate + matchLength] == i_data[position + matchLength] ) )
+			{
+				++matchLength;
+			}
+			WriteSequence( i_data + literalStart, position - literalStart, position - candidate, matchLength, o_compressed );
+			// Remember a couple of positions inside of the match so that the next one can be found sooner
+			if ( ( position + matchLength + s_minMatchLength ) <= i_size )
+			{
+				const size_t lastPosition = position + matchLength - 2;
+				positions[Hash( Read32( i_data + lastPosition ) )] = static_cast<uint32_t>( lastPosition );
+			}
+			position += matchLength;
+			literalStart = position;
+		}
+		else
+		{
+			++position;
+		}
+	}
+
+	// The last sequence only has literals
+	// (even if there aren't any, so that the decoder knows where the block ends)
+	const size_t literalCount = i_size - literalStart;
+	o_compressed.push_back( static_cast<uint8_t>( ( ( literalCount < 15 ) ? literalCount : 15 ) << 4 ) );
+	if ( literalCount >= 15 )
+	{
+		WriteLength( literalCount - 15, o_compressed );
+	}
+	o_compressed.insert( o_compressed.end(), i_data + literalStart, i_data + i_size );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	uint32_t Read32( const uint8_t* i_data )
+	{
+		uint32_t bytes;
+		memcpy( &bytes, i_data, sizeof( bytes ) );
+		return bytes;
+	}
+
+	uint32_t Hash( const uint32_t i_bytes )
+	{
+		return ( i_bytes * 2654435761u ) >> ( 32 - s_hashBitCount );
+	}
+
+	void WriteLength( size_t i_length, std::vector<uint8_t>& io_output )
+	{
+		while ( i_length >= 255 )
+		{
+			io_output.push_back( 255 );
+			i_length -= 255;
+		}
+		io_output.push_back( static_cast<uint8_t>( i_length ) );
+	}
+
+	void WriteSequence( const uint8_t* i_literals, const size_t i_literalCount, const size_t i_offset, const size_t i_matchLength,
+		std::vector<uint8_t>& io_output )
+	{
+		const size_t matchLengthCode = i_matchLength - s_minMatchLength;
+		io_output.push_back( static_cast<uint8_t>( ( ( ( i_literalCount < 15 ) ? i_literalCount : 15 ) << 4 )
+			| ( ( matchLengthCode < 15 ) ? matchLengthCode : 15 ) ) );
+		if ( i_literalCount >= 15 )
+		{
+			WriteLength( i_literalCount - 15, io_output );
+		}
+		io_output.insert( io_output.end(), i_literals, i_literals + i_literalCount );
+		io_output.push_back( static_cast<uint8_t>( i_offset & 0xff ) );
+		io_output.push_back( static_cast<uint8_t>( i_offset >> 8 ) );
+		if ( matchLengthCode >= 15 )
+		{
+			WriteLength( matchLengthCode - 15, io_output );
+		}
+	}
+}
@@ -0,0 +1,35 @@
+/*
+	The mesh encoder compresses a mesh's vertices and indices
+	into the format that is described in Engine/Graphics/MeshFile.h
+	(and that Engine/Graphics/MeshDecoder decodes)
+*/
+
+#ifndef EAE6320_MESHENCODER_H
+#define EAE6320_MESHENCODER_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace MeshEncoder
+	{
+		// The vertex size is MeshFile::GetVertexSize() of the file's position format
+		void Encode( const void* i_vertices, const uint32_t i_vertexCount, const size_t i_vertexSize,
+			const uint32_t* i_indices, const uint32_t i_indexCount, std::vector<uint8_t>& o_encoded );
+
+		// The parts of Encode()
+		void FilterVertices( const uint8_t* i_vertices, const uint32_t i_vertexCount, const size_t i_vertexSize, uint8_t* o_planes );
+		void FilterIndices( const uint32_t* i_indices, const uint32_t i_indexCount, uint8_t* o_planes );
+		void CompressLz( const uint8_t* i_data, const size_t i_size, std::vector<uint8_t>& o_compressed );
+	}
+}
+
+#endif	// EAE6320_MESHENCODER_H
@@ -0,0 +1,492 @@
+// Header Files
+//=============
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const uint32_t s_invalidVertex = 0xffffffff;
+}
+
+// Helper Class Declarations
+//==========================
+
+namespace
+{
+	// The sum of the squared distances to a set of lines
+	// (every line is ax + by + c = 0 with a^2 + b^2 = 1),
+	// each weighted by the length of the edge that it came from
+	struct sQuadric
+	{
+		double a2, ab, ac, b2, bc, c2;
+		// The total length
+		double weight;
+	};
+
+	enum eVertexKind
+	{
+		// Can be collapsed into any neighbor
+		Kind_interior,
+		// On a single boundary loop, and so it can only be collapsed along the boundary
+		Kind_boundary,
+		// Never moved (e.g. where boundaries touch, where triangles aren't wound consistently, or on a seam)
+		Kind_locked,
+	};
+
+	struct sCollapse
+	{
+		uint32_t from, to;
+		// The mean squared distance (see Evaluate())
+		double error;
+
+		bool operator <( const sCollapse& i_rhs ) const { return error < i_rhs.error; }
+	};
+
+	// The triangles that use each vertex
+	struct sAdjacency
+	{
+		// The triangles of vertex i are triangles[offsets[i]] to triangles[offsets[i + 1] - 1]
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> triangles;
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void AddLine( const float* i_start, const float* i_end, sQuadric& io_quadric );
+	void AddQuadric( const sQuadric& i_quadric, sQuadric& io_sum );
+	double Evaluate( const sQuadric& i_quadric, const float* i_position );
+	double GetSignedArea( const float* i_a, const float* i_b, const float* i_c );
+	void BuildAdjacency( const std::vector<uint32_t>& i_indices, const uint32_t i_vertexCount, sAdjacency& o_adjacency );
+	bool HaveSameAttributes( const uint8_t* i_vertices, const size_t i_vertexStride, const uint32_t i_a, const uint32_t i_b );
+	bool HasVertex( const uint32_t* i_triangle, const uint32_t i_vertex );
+}
+
+// Interface
+//==========
+
+void eae6320::MeshSimplifier::Simplify( const void* i_vertices, const uint32_t i_vertexCount, const size_t i_vertexStride,
+	const uint32_t* i_indices, const uint32_t i_indexCount, const uint32_t i_targetIndexCount,
+	std::vector<uint32_t>& o_indices, float& o_error )
+{
+	o_error = 0.0f;
+	const uint8_t* const vertices = static_cast<const uint8_t*>( i_vertices );
+
+	// Triangles that can't be drawn anyway are dropped before simplifying
+	o_indices.clear();
+	o_indices.reserve( i_indexCount );
+	for ( uint32_t i = 0; ( i + 2 ) < i_indexCount; i += 3 )
+	{
+		const uint32_t* const triangle = i_indices + i;
+		if ( ( triangle[0] < i_vertexCount ) && ( triangle[1] < i_vertexCount ) && ( triangle[2] < i_vertexCount )
+			&& ( triangle[0] != triangle[1] ) && ( triangle[1] != triangle[2] ) && ( triangle[0] != triangle[2] ) )
+		{
+			o_indices.insert( o_indices.end(), triangle, triangle + 3 );
+		}
+	}
+
+	std::vector<float> positions( static_cast<size_t>( i_vertexCount ) * 2 );
+	for ( uint32_t i = 0; i < i_vertexCount; ++i )
+	{
+		memcpy( &positions[i * 2], vertices + ( i * i_vertexStride ), sizeof( float ) * 2 );
+	}
+
+	sAdjacency adjacency;
+	BuildAdjacency( o_indices, i_vertexCount, adjacency );
+
+	// Classify the vertices and build the quadrics from the boundary edges
+	std::vector<uint8_t> kinds( i_vertexCount, Kind_interior );
+	std::vector<uint32_t> boundaryNext( i_vertexCount, s_invalidVertex );
+	std::vector<uint32_t> boundaryPrevious( i_vertexCount, s_invalidVertex );
+	std::vector<sQuadric> quadrics( i_vertexCount, sQuadric() );
+	{
+		const size_t indexCount = o_indices.size();
+		for ( size_t i = 0; i < indexCount; ++i )
+		{
+			const uint32_t a = o_indices[i];
+			const uint32_t b = o_indices[( ( i % 3 ) == 2 ) ? ( i - 2 ) : ( i + 1 )];
+			// An edge is on the boundary if no other triangle has it in the opposite direction
+			unsigned int sameDirectionCount = 0;
+			unsigned int oppositeDirectionCount = 0;
+			for ( uint32_t j = adjacency.offsets[a]; j < adjacency.offsets[a + 1]; ++j )
+			{
+				const uint32_t* const triangle = &o_indices[adjacency.triangles[j] * 3];
+				for ( size_t k = 0; k < 3; ++k )
+				{
+					const uint32_t x = triangle[k];
+					const uint32_t y = triangle[( k + 1 ) % 3];
+					sameDirectionCount += ( ( x == a ) && ( y == b ) ) ? 1 : 0;
+					oppositeDirectionCount += ( ( x == b ) && ( y == a ) ) ? 1 : 0;
+				}
+			}
+			if ( ( sameDirectionCount > 1 ) || ( oppositeDirectionCount > 1 ) )
+			{
+				// More than two triangles share the edge or they are wound differently
+				kinds[a] = kinds[b] = Kind_locked;
+			}
+			else if ( oppositeDirectionCount == 0 )
+			{
+				if ( ( boundaryNext[a] != s_invalidVertex ) || ( boundaryPrevious[b] != s_invalidVertex ) )
+				{
+					// Two boundary loops touch at a vertex
+					kinds[a] = kinds[b] = Kind_locked;
+				}
+				else
+				{
+					boundaryNext[a] = b;
+					boundaryPrevious[b] = a;
+				}
+				AddLine( &positions[a * 2], &positions[b * 2], quadrics[a] );
+				AddLine( &positions[a * 2], &positions[b * 2], quadrics[b] );
+			}
+		}
+		for ( uint32_t i = 0; i < i_vertexCount; ++i )
+		{
+			if ( ( kinds[i] == Kind_interior ) && ( ( boundaryNext[i] != s_invalidVertex ) || ( boundaryPrevious[i] != s_invalidVertex ) ) )
+			{
+				kinds[i] = ( ( boundaryNext[i] != s_invalidVertex ) && ( boundaryPrevious[i] != s_invalidVertex ) ) ? Kind_boundary : Kind_locked;
+			}
+		}
+	}
+	// Vertices that are in the same place as another vertex (i.e. on a seam between two colors) are locked
+	// so that the two sides can't be simplified differently and open a crack
+	{
+		std::vector<std::pair<std::pair<float, float>, uint32_t> > sortedPositions( i_vertexCount );
+		for ( uint32_t i = 0; i < i_vertexCount; ++i )
+		{
+			sortedPositions[i] = std::make_pair( std::make_pair( positions[i * 2], positions[( i * 2 ) + 1] ), i );
+		}
+		std::sort( sortedPositions.begin(), sortedPositions.end() );
+		for ( uint32_t i = 1; i < i_vertexCount; ++i )
+		{
+			if ( sortedPositions[i].first == sortedPositions[i - 1].first )
+			{
+				kinds[sortedPositions[i].second] = kinds[sortedPositions[i - 1].second] = Kind_locked;
+			}
+		}
+	}
+
+	// Every pass makes the cheapest collapses that don't touch each other,
+	// and then the triangles are rebuilt before the next pass
+	std::vector<sCollapse> collapses;
+	std::vector<uint32_t> remap( i_vertexCount );
+	std::vector<uint8_t> isTouched( i_vertexCount );
+	std::vector<uint8_t> isUniform( i_vertexCount );
+	std::vector<uint32_t> sharedNeighbors;
+	double maxError = 0.0;
+	while ( o_indices.size() > i_targetIndexCount )
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>( o_indices.size() / 3 );
+
+		// A vertex can only be moved if every triangle that it's in has a single color
+		for ( uint32_t i = 0; i < i_vertexCount; ++i )
+		{
+			bool isVertexUniform = true;
+			for ( uint32_t j = adjacency.offsets[i]; isVertexUniform && ( j < adjacency.offsets[i + 1] ); ++j )
+			{
+				const uint32_t* const triangle = &o_indices[adjacency.triangles[j] * 3];
+				for ( size_t k = 0; k < 3; ++k )
+				{
+					if ( !HaveSameAttributes( vertices, i_vertexStride, i, triangle[k] ) )
+					{
+						isVertexUniform = false;
+						break;
+					}
+				}
+			}
+			isUniform[i] = isVertexUniform ? 1 : 0;
+		}
+
+		collapses.clear();
+		for ( size_t i = 0; i < o_indices.size(); ++i )
+		{
+			const uint32_t a = o_indices[i];
+			const uint32_t b = o_indices[( ( i % 3 ) == 2 ) ? ( i - 2 ) : ( i + 1 )];
+			for ( size_t direction = 0; direction < 2; ++direction )
+			{
+				const uint32_t from = ( direction == 0 ) ? a : b;
+				const uint32_t to = ( direction == 0 ) ? b : a;
+				if ( ( kinds[from] == Kind_locked ) || !isUniform[from] )
+				{
+					continue;
+				}
+				if ( kinds[from] == Kind_boundary )
+				{
+					// Boundary vertices can only slide along the boundary
+					// (and a loop of two edges can't lose a vertex)
+					if ( ( ( to != boundaryNext[from] ) && ( to != boundaryPrevious[from] ) ) || ( boundaryNext[from] == boundaryPrevious[from] ) )
+					{
+						continue;
+					}
+				}
+				sCollapse collapse;
+				collapse.from = from;
+				collapse.to = to;
+				collapse.error = Evaluate( quadrics[from], &positions[to * 2] );
+				collapses.push_back( collapse );
+			}
+		}
+		if ( collapses.empty() )
+		{
+			break;
+		}
+		std::sort( collapses.begin(), collapses.end() );
+
+		for ( uint32_t i = 0; i < i_vertexCount; ++i )
+		{
+			remap[i] = i;
+		}
+		std::fill( isTouched.begin(), isTouched.end(), 0 );
+		uint32_t removedTriangleCount = 0;
+		uint32_t collapseCount = 0;
+		for ( size_t i = 0; i < collapses.size(); ++i )
+		{
+			if ( ( static_cast<size_t>( triangleCount - removedTriangleCount ) * 3 ) <= i_targetIndexCount )
+			{
+				break;
+			}
+			const sCollapse& collapse = collapses[i];
+			const uint32_t from = collapse.from;
+			const uint32_t to = collapse.to;
+			if ( isTouched[from] || isTouched[to] )
+			{
+				continue;
+			}
+
+			// The vertices that share a triangle with both ends of the edge must be exactly the ones across from the edge
+			// (otherwise the collapse would fold the mesh onto itself)
+			uint32_t edgeTriangleCount = 0;
+			{
+				sharedNeighbors.clear();
+				for ( uint32_t j = adjacency.offsets[from]; j < adjacency.offsets[from + 1]; ++j )
+				{
+					const uint32_t* const triangle = &o_indices[adjacency.triangles[j] * 3];
+					if ( HasVertex( triangle, to ) )
+					{
+						++edgeTriangleCount;
+						continue;
+					}
+					for ( size_t k = 0; k < 3; ++k )
+					{
+						const uint32_t neighbor = triangle[k];
+						if ( neighbor == from )
+						{
+							continue;
+						}
+						for ( uint32_t m = adjacency.offsets[to]; m < adjacency.offsets[to + 1]; ++m )
+						{
+							if ( HasVertex( &o_indices[adjacency.triangles[m] * 3], neighbor ) )
+							{
+								sharedNeighbors.push_back( neighbor );
+								break;
+							}
+						}
+					}
+				}
+				std::sort( sharedNeighbors.begin(), sharedNeighbors.end() );
+				sharedNeighbors.erase( std::unique( sharedNeighbors.begin(), sharedNeighbors.end() ), sharedNeighbors.end() );
+			}
+			// The neighbors across from the edge are in the triangles that are removed,
+			// and so any that were found in the other triangles are extra
+			{
+				bool isLinked = true;
+				for ( size_t j = 0; isLinked && ( j < sharedNeighbors.size() ); ++j )
+				{
+					bool isAcrossFromEdge = false;
+					for ( uint32_t m = adjacency.offsets[from]; m < adjacency.offsets[from + 1]; ++m )
+					{
+						const uint32_t* const triangle = &o_indices[adjacency.triangles[m] * 3];
+						if ( HasVertex( triangle, to ) && HasVertex( triangle, sharedNeighbors[j] ) )
+						{
+							isAcrossFromEdge = true;
+							break;
+						}
+					}
+					isLinked = isAcrossFromEdge;
+				}
+				if ( !isLinked || ( edgeTriangleCount == 0 ) )
+				{
+					continue;
+				}
+			}
+			// None of the triangles that are kept can flip over or become degenerate
+			{
+				bool doesFlip = false;
+				for ( uint32_t j = adjacency.offsets[from]; !doesFlip && ( j < adjacency.offsets[from + 1] ); ++j )
+				{
+					const uint32_t* const triangle = &o_indices[adjacency.triangles[j] * 3];
+					if ( HasVertex( triangle, to ) )
+					{
+						continue;
+					}
+					const float* oldPositions[3];
+					const float* newPositions[3];
+					for ( size_t k = 0; k < 3; ++k )
+					{
+						oldPositions[k] = &positions[triangle[k] * 2];
+						newPositions[k] = ( triangle[k] == from ) ? &positions[to * 2] : oldPositions[k];
+					}
+					const double oldArea = GetSignedArea( oldPositions[0], oldPositions[1], oldPositions[2] );
+					const double newArea = GetSignedArea( newPositions[0], newPositions[1], newPositions[2] );
+					doesFlip = ( oldArea * newArea ) <= 0.0;
+				}
+				if ( doesFlip )
+				{
+					continue;
+				}
+			}
+
+			// Collapse the edge
+			remap[from] = to;
+			AddQuadric( quadrics[from], quadrics[to] );
+			maxError = std::max( maxError, collapse.error );
+			removedTriangleCount += edgeTriangleCount;
+			++collapseCount;
+			for ( uint32_t j = adjacency.offsets[from]; j < adjacency.offsets[from + 1]; ++j )
+			{
+				const uint32_t* const triangle = &o_indices[adjacency.triangles[j] * 3];
+				isTouched[triangle[0]] = isTouched[triangle[1]] = isTouched[triangle[2]] = 1;
+			}
+			if ( kinds[from] == Kind_boundary )
+			{
+				if ( to == boundaryNext[from] )
+				{
+					boundaryNext[boundaryPrevious[from]] = to;
+					boundaryPrevious[to] = boundaryPrevious[from];
+				}
+				else
+				{
+					boundaryPrevious[boundaryNext[from]] = to;
+					boundaryNext[to] = boundaryNext[from];
+				}
+			}
+		}
+		if ( collapseCount == 0 )
+		{
+			break;
+		}
+
+		// Move the collapsed vertices and remove the triangles that became degenerate
+		{
+			size_t keptIndexCount = 0;
+			for ( size_t i = 0; i < o_indices.size(); i += 3 )
+			{
+				const uint32_t a = remap[o_indices[i]];
+				const uint32_t b = remap[o_indices[i + 1]];
+				const uint32_t c = remap[o_indices[i + 2]];
+				if ( ( a != b ) && ( b != c ) && ( a != c ) )
+				{
+					o_indices[keptIndexCount++] = a;
+					o_indices[keptIndexCount++] = b;
+					o_indices[keptIndexCount++] = c;
+				}
+			}
+			o_indices.resize( keptIndexCount );
+		}
+		BuildAdjacency( o_indices, i_vertexCount, adjacency );
+	}
+
+	o_error = static_cast<float>( std::sqrt( maxError ) );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void AddLine( const float* i_start, const float* i_end, sQuadric& io_quadric )
+	{
+		const double dx = static_cast<double>( i_end[0] ) - i_start[0];
+		const double dy = static_cast<double>( i_end[1] ) - i_start[1];
+		const double length = std::sqrt( ( dx * dx ) + ( dy * dy ) );
+		if ( !( length > 0.0 ) )
+		{
+			return;
+		}
+		// The normal of the line
+		const double a = -dy / length;
+		const double b = dx / length;
+		const double c = -( ( a * i_start[0] ) + ( b * i_start[1] ) );
+		io_quadric.a2 += a * a * length;
+		io_quadric.ab += a * b * length;
+		io_quadric.ac += a * c * length;
+		io_quadric.b2 += b * b * length;
+		io_quadric.bc += b * c * length;
+		io_quadric.c2 += c * c * length;
+		io_quadric.weight += length;
+	}
+
+	void AddQuadric( const sQuadric& i_quadric, sQuadric& io_sum )
+	{
+		io_sum.a2 += i_quadric.a2;
+		io_sum.ab += i_quadric.ab;
+		io_sum.ac += i_quadric.ac;
+		io_sum.b2 += i_quadric.b2;
+		io_sum.bc += i_quadric.bc;
+		io_sum.c2 += i_quadric.c2;
+		io_sum.weight += i_quadric.weight;
+	}
+
+	double Evaluate( const sQuadric& i_quadric, const float* i_position )
+	{
+		// Interior vertices don't have any lines
+		if ( !( i_quadric.weight > 0.0 ) )
+		{
+			return 0.0;
+		}
+		const double x = i_position[0];
+		const double y = i_position[1];
+		const double error = ( i_quadric.a2 * x * x ) + ( 2.0 * i_quadric.ab * x * y ) + ( 2.0 * i_quadric.ac * x )
+			+ ( i_quadric.b2 * y * y ) + ( 2.0 * i_quadric.bc * y ) + i_quadric.c2;
+		// Rounding can make a position that is on every line slightly negative
+		return ( error > 0.0 ) ? ( error / i_quadric.weight ) : 0.0;
+	}
+
+	double GetSignedArea( const float* i_a, const float* i_b, const float* i_c )
+	{
+		return ( ( static_cast<double>( i_b[0] ) - i_a[0] ) * ( static_cast<double>( i_c[1] ) - i_a[1] ) )
+			- ( ( static_cast<double>( i_b[1] ) - i_a[1] ) * ( static_cast<double>( i_c[0] ) - i_a[0] ) );
+	}
+
+	void BuildAdjacency( const std::vector<uint32_t>& i_indices, const uint32_t i_vertexCount, sAdjacency& o_adjacency )
+	{
+		o_adjacency.offsets.assign( static_cast<size_t>( i_vertexCount ) + 1, 0 );
+		for ( size_t i = 0; i < i_indices.size(); ++i )
+		{
+			++o_adjacency.offsets[i_indices[i] + 1];
+		}
+		for ( uint32_t i = 0; i < i_vertexCount; ++i )
+		{
+			o_adjacency.offsets[i + 1] += o_adjacency.offsets[i];
+		}
+		o_adjacency.triangles.resize( i_indices.size() );
+		std::vector<uint32_t> cursors( o_adjacency.offsets.begin(), o_adjacency.offsets.end() - 1 );
+		for ( size_t i = 0; i < i_indices.size(); ++i )
+		{
+			o_adjacency.triangles[cursors[i_indices[i]]++] = static_cast<uint32_t>( i / 3 );
+		}
+	}
+
+	bool HaveSameAttributes( const uint8_t* i_vertices, const size_t i_vertexStride, const uint32_t i_a, const uint32_t i_b )
+	{
+		// Everything after the position
+		const size_t positionSize = sizeof( float ) * 2;
+		return memcmp( i_vertices + ( i_a * i_vertexStride ) + positionSize, i_vertices + ( i_b * i_vertexStride ) + positionSize,
+			i_vertexStride - positionSize ) == 0;
+	}
+
+	bool HasVertex( const uint32_t* i_triangle, const uint32_t i_vertex )
+	{
+		return ( i_triangle[0] == i_vertex ) || ( i_triangle[1] == i_vertex ) || ( i_triangle[2] == i_vertex );
+	}
+}
@@ -0,0 +1,48 @@
+/*
+	The mesh simplifier makes a coarser version of a mesh's triangles for a lower level of detail
+	by collapsing edges (moving one vertex onto a neighbor) in the order of a quadric error metric.
+
+	The meshes are 2D, and so the planes of the triangles can't measure any error
+	(they are all the same plane):
+	instead the quadrics are built from the lines of the mesh's boundary edges,
+	and the error of a collapse is the root mean squared distance
+	from the new position to every boundary line that the collapsed vertex was responsible for
+	(weighted by the lengths of the original edges).
+	Interior vertices can move without changing the mesh's outline,
+	but a vertex is only collapsed if every vertex that it shares a triangle with has the same color,
+	and so the colors that are interpolated across the mesh never change.
+
+	Every simplified triangle uses the original vertices
+	(a collapse moves a vertex onto one of its neighbors rather than to a new position),
+	and so every level of detail can share a single vertex buffer.
+*/
+
+#ifndef EAE6320_MESHSIMPLIFIER_H
+#define EAE6320_MESHSIMPLIFIER_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace MeshSimplifier
+	{
+		// Every vertex starts with two floats for its position,
+		// and the rest of its bytes (i.e. its color) must match a neighbor's for it to be collapsed.
+		// Collapses are made until there are no more than i_targetIndexCount indices
+		// or until nothing else can be collapsed without flipping a triangle or changing a color.
+		// The error is in the mesh's local space
+		void Simplify( const void* i_vertices, const uint32_t i_vertexCount, const size_t i_vertexStride,
+			const uint32_t* i_indices, const uint32_t i_indexCount, const uint32_t i_targetIndexCount,
+			std::vector<uint32_t>& o_indices, float& o_error );
+	}
+}
+
+#endif	// EAE6320_MESHSIMPLIFIER_H
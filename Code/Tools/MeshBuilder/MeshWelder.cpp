@@ -0,0 +1,236 @@
+// Header Files
+//=============
+
+#include "MeshWelder.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	const uint32_t s_invalidVertex = 0xffffffff;
+	// Positions whose cell coordinates can't be represented exactly in a double
+	// (or that aren't finite) are never welded
+	const double s_maxCellCoordinate = 9007199254740992.0;	// 2^53
+}
+
+// Helper Class Declarations
+//==========================
+
+namespace
+{
+	// When welding bit-identical vertices a cell's coordinates are the bits of a position
+	// (and so every distinct position has its own cell)
+	struct sCell
+	{
+		int64_t x, y;
+
+		bool operator ==( const sCell& i_rhs ) const { return ( x == i_rhs.x ) && ( y == i_rhs.y ); }
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	bool GetCell( const float* i_position, const float i_epsilon, sCell& o_cell );
+	uint64_t Hash( const sCell& i_cell, const uint8_t* i_attributes, const size_t i_attributeSize );
+	uint64_t Mix( uint64_t i_value );
+}
+
+// Interface
+//==========
+
+bool eae6320::MeshWelder::Weld( void* io_vertices, uint32_t& io_vertexCount, const size_t i_vertexStride,
+	uint32_t* io_indices, const uint32_t i_indexCount, const float i_epsilon, sStats& o_stats )
+{
+	uint8_t* const vertices = reinterpret_cast<uint8_t*>( io_vertices );
+	const uint32_t vertexCount = io_vertexCount;
+	const size_t attributeOffset = sizeof( float ) * 2;
+	const size_t attributeSize = i_vertexStride - attributeOffset;
+	const float epsilon = ( i_epsilon > 0.0f ) ? i_epsilon : 0.0f;
+
+	// Find which vertices are used
+	// (an index that is out of range means that the mesh itself is wrong)
+	std::vector<uint8_t> isUsed( vertexCount, 0 );
+	uint32_t usedVertexCount = 0;
+	for ( uint32_t i = 0; i < i_indexCount; ++i )
+	{
+		const uint32_t index = io_indices[i];
+		if ( index >= vertexCount )
+		{
+			return false;
+		}
+		if ( !isUsed[index] )
+		{
+			isUsed[index] = 1;
+			++usedVertexCount;
+		}
+	}
+
+	// Merge every used vertex into the first vertex (in authored order) that it matches.
+	// The hash table only holds those first vertices (the representatives),
+	// and it is open addressed with linear probing and at most half full
+	std::vector<uint32_t> representatives( vertexCount, s_invalidVertex );
+	{
+		uint32_t tableSize = 16;
+		while ( tableSize < ( usedVertexCount * 2 ) )
+		{
+			tableSize *= 2;
+		}
+		const uint32_t tableMask = tableSize - 1;
+		std::vector<uint32_t> table( tableSize, s_invalidVertex );
+		std::vector<sCell> cells( vertexCount );
+		// Two vertices within the epsilon of each other are in the same or neighboring cells
+		const int64_t cellRange = ( epsilon > 0.0f ) ? 1 : 0;
+		for ( uint32_t v = 0; v < vertexCount; ++v )
+		{
+			if ( !isUsed[v] )
+			{
+				continue;
+			}
+			const uint8_t* const vertex = vertices + ( v * i_vertexStride );
+			const float* const position = reinterpret_cast<const float*>( vertex );
+			sCell cell;
+			if ( !GetCell( position, epsilon, cell ) )
+			{
+				representatives[v] = v;
+				continue;
+			}
+			cells[v] = cell;
+			uint32_t match = s_invalidVertex;
+			float matchDistance = 0.0f;
+			for ( int64_t y = -cellRange; y <= cellRange; ++y )
+			{
+				for ( int64_t x = -cellRange; x <= cellRange; ++x )
+				{
+					sCell neighbor;
+					neighbor.x = cell.x + x;
+					neighbor.y = cell.y + y;
+					for ( uint32_t slot = static_cast<uint32_t>( Hash( neighbor, vertex + attributeOffset, attributeSize ) ) & tableMask;
+						table[slot] != s_invalidVertex; slot = ( slot + 1 ) & tableMask )
+					{
+						const uint32_t candidate = table[slot];
+						if ( !( cells[candidate] == neighbor ) )
+						{
+							continue;
+						}
+						const uint8_t* const candidateVertex = vertices + ( candidate * i_vertexStride );
+						if ( std::memcmp( candidateVertex + attributeOffset, vertex + attributeOffset, attributeSize ) != 0 )
+						{
+							continue;
+						}
+						// Bit-identical positions are always in the same cell,
+						// but positions in neighboring cells still have to be compared
+						const float* const candidatePosition = reinterpret_cast<const float*>( candidateVertex );
+						const float distance = std::fmax( std::fabs( candidatePosition[0] - position[0] ),
+							std::fabs( candidatePosition[1] - position[1] ) );
+						if ( ( distance <= epsilon ) && ( ( match == s_invalidVertex ) || ( distance < matchDistance ) ) )
+						{
+							match = candidate;
+							matchDistance = distance;
+						}
+					}
+				}
+			}
+			if ( match != s_invalidVertex )
+			{
+				representatives[v] = match;
+			}
+			else
+			{
+				representatives[v] = v;
+				uint32_t slot = static_cast<uint32_t>( Hash( cell, vertex + attributeOffset, attributeSize ) ) & tableMask;
+				while ( table[slot] != s_invalidVertex )
+				{
+					slot = ( slot + 1 ) & tableMask;
+				}
+				table[slot] = v;
+			}
+		}
+	}
+
+	// Compact the representatives
+	// (a vertex is only ever moved to a lower position, and so nothing is overwritten before it is moved)
+	uint32_t outputVertexCount = 0;
+	{
+		std::vector<uint32_t> newIndices( vertexCount, s_invalidVertex );
+		for ( uint32_t v = 0; v < vertexCount; ++v )
+		{
+			if ( representatives[v] == v )
+			{
+				newIndices[v] = outputVertexCount;
+				if ( outputVertexCount != v )
+				{
+					std::memcpy( vertices + ( outputVertexCount * i_vertexStride ), vertices + ( v * i_vertexStride ), i_vertexStride );
+				}
+				++outputVertexCount;
+			}
+		}
+		for ( uint32_t i = 0; i < i_indexCount; ++i )
+		{
+			io_indices[i] = newIndices[representatives[io_indices[i]]];
+		}
+	}
+
+	o_stats.inputVertexCount = vertexCount;
+	o_stats.outputVertexCount = outputVertexCount;
+	o_stats.unusedVertexCount = vertexCount - usedVertexCount;
+	o_stats.mergedVertexCount = usedVertexCount - outputVertexCount;
+	io_vertexCount = outputVertexCount;
+	return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool GetCell( const float* i_position, const float i_epsilon, sCell& o_cell )
+	{
+		if ( i_epsilon > 0.0f )
+		{
+			const double x = std::floor( static_cast<double>( i_position[0] ) / i_epsilon );
+			const double y = std::floor( static_cast<double>( i_position[1] ) / i_epsilon );
+			// This is also false for NaNs
+			if ( !( ( std::fabs( x ) < s_maxCellCoordinate ) && ( std::fabs( y ) < s_maxCellCoordinate ) ) )
+			{
+				return false;
+			}
+			o_cell.x = static_cast<int64_t>( x );
+			o_cell.y = static_cast<int64_t>( y );
+		}
+		else
+		{
+			uint32_t x, y;
+			std::memcpy( &x, i_position, sizeof( x ) );
+			std::memcpy( &y, i_position + 1, sizeof( y ) );
+			o_cell.x = x;
+			o_cell.y = y;
+		}
+		return true;
+	}
+
+	uint64_t Hash( const sCell& i_cell, const uint8_t* i_attributes, const size_t i_attributeSize )
+	{
+		uint64_t hash = Mix( static_cast<uint64_t>( i_cell.x ) ) ^ Mix( static_cast<uint64_t>( i_cell.y ) + 0x9e3779b97f4a7c15ull );
+		for ( size_t i = 0; i < i_attributeSize; ++i )
+		{
+			hash = ( hash ^ i_attributes[i] ) * 0x100000001b3ull;
+		}
+		return Mix( hash );
+	}
+
+	// The finalizer of SplitMix64, which spreads every input bit across the whole output
+	uint64_t Mix( uint64_t i_value )
+	{
+		i_value = ( i_value ^ ( i_value >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+		i_value = ( i_value ^ ( i_value >> 27 ) ) * 0x94d049bb133111ebull;
+		return i_value ^ ( i_value >> 31 );
+	}
+}
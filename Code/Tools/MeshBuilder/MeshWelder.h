@@ -0,0 +1,49 @@
+/*
+	The mesh welder merges duplicated vertices
+	(vertices that are bit-identical, or whose positions are within an epsilon of each other and whose colors are identical),
+	changes the indices to use the vertex that each one was merged into,
+	and strips vertices that no triangle uses.
+
+	Vertices are found with a hash table of grid cells that are the size of the epsilon
+	(every vertex only has to look in its own cell and the eight around it),
+	and so welding takes expected linear time.
+	The vertices that are kept stay in their authored order
+	and keep their authored positions (they aren't averaged with the vertices that were merged into them).
+*/
+
+#ifndef EAE6320_MESHWELDER_H
+#define EAE6320_MESHWELDER_H
+
+// Header Files
+//=============
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace MeshWelder
+	{
+		struct sStats
+		{
+			uint32_t inputVertexCount;
+			uint32_t outputVertexCount;
+			// inputVertexCount == outputVertexCount + mergedVertexCount + unusedVertexCount
+			uint32_t mergedVertexCount;
+			uint32_t unusedVertexCount;
+		};
+
+		// Every vertex starts with two floats for its position,
+		// and the rest of its bytes (i.e. its color) must be identical for it to be merged.
+		// With an epsilon of 0 only bit-identical vertices are merged.
+		// The vertices are compacted in place and io_vertexCount is changed to how many are left.
+		// Returns false (without changing anything) if an index is out of range
+		bool Weld( void* io_vertices, uint32_t& io_vertexCount, const size_t i_vertexStride,
+			uint32_t* io_indices, const uint32_t i_indexCount, const float i_epsilon, sStats& o_stats );
+	}
+}
+
+#endif	// EAE6320_MESHWELDER_H
@@ -3,10 +3,33 @@
 
 #include "cMeshBuilder.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <sstream>
+#include "../BuilderHelper/cLuaAllocator.h"
 #include "../../Engine/Windows/WindowsFunctions.h"
+#include "../../Engine/Graphics/MeshFile.h"
+#include "MeshEncoder.h"
+#include "MeshSimplifier.h"
+#include "MeshWelder.h"
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Every LOD tries to have this fraction of the triangles of the one before it,
+	// and the chain ends when a LOD can't be made with fewer than s_maxLodTriangleRatio of them
+	// (a LOD that barely has fewer triangles isn't worth its indices)
+	const float s_targetLodTriangleRatio = 0.5f;
+	const float s_maxLodTriangleRatio = 0.85f;
+}
+
 // Interface
 //==========
 
@@ -21,14 +44,63 @@ eae6320::cMeshBuilder::sVertex GetVertexData(lua_State& io_luaState);
 
 
 
-bool eae6320::cMeshBuilder::Build(const std::vector<std::string>&)
+bool eae6320::cMeshBuilder::Build(const std::vector<std::string>& i_arguments)
 {
 	bool wereThereErrors = false;
 
+	// "-compress" encodes the geometry,
+	// "-quantize" stores positions as 16-bit integers,
+	// "-lods" adds simplified levels of detail (see MeshFile.h),
+	// and "-weld=<epsilon>" also merges vertices whose positions are within the epsilon
+	// (bit-identical vertices are always merged)
+	bool shouldCompress = false;
+	bool shouldQuantize = false;
+	bool shouldGenerateLods = false;
+	float weldEpsilon = 0.0f;
+	for (size_t i = 0; i < i_arguments.size(); ++i)
+	{
+		if (i_arguments[i] == "-compress")
+		{
+			shouldCompress = true;
+		}
+		else if (i_arguments[i].compare(0, 6, "-weld=") == 0)
+		{
+			const char * const value = i_arguments[i].c_str() + 6;
+			char * end;
+			weldEpsilon = static_cast<float>(strtod(value, &end));
+			if ((end == value) || (*end != '\0') || !(weldEpsilon >= 0.0f))
+			{
+				std::stringstream errorMessage;
+				errorMessage << "The weld epsilon in \"" << i_arguments[i] << "\" must be a non-negative number";
+				eae6320::OutputErrorMessage(errorMessage.str().c_str(), __FILE__);
+				return false;
+			}
+		}
+		else if (i_arguments[i] == "-quantize")
+		{
+			shouldQuantize = true;
+		}
+		else if (i_arguments[i] == "-lods")
+		{
+			shouldGenerateLods = true;
+		}
+		else
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Unknown argument \"" << i_arguments[i] << "\"";
+			eae6320::OutputErrorMessage(errorMessage.str().c_str(), __FILE__);
+			return false;
+		}
+	}
+
+	// Everything that Lua allocates while the mesh is being built comes from this allocator,
+	// and it is all freed at once when the build is finished
+	cLuaAllocator luaAllocator;
+
 	// Create a new Lua state
 	lua_State* luaState = NULL;
 	{
-		luaState = luaL_newstate();
+		luaState = luaAllocator.NewState();
 		if (!luaState)
 		{
 			wereThereErrors = true;
@@ -110,6 +182,31 @@ bool eae6320::cMeshBuilder::Build(const std::vector<std::string>&)
 
 	// Pop the table
 	lua_pop(luaState, 1);
+	EndPhase("parse");
+
+	// Merge duplicated vertices and strip unused ones
+	// before anything else (the LODs, quantization, and compression) works with them
+	if (!wereThereErrors)
+	{
+		const uint32_t authoredVertexCount = mVertexCount;
+		MeshWelder::sStats stats;
+		if (MeshWelder::Weld(mVertexData, mVertexCount, sizeof(sVertex), mIndexData, mIndexCount, weldEpsilon, stats))
+		{
+			if (mVertexCount != authoredVertexCount)
+			{
+				std::cout << m_path_source << ": welded " << authoredVertexCount << " vertices into " << mVertexCount <<
+					" (" << stats.mergedVertexCount << " merged and " << stats.unusedVertexCount << " unused), " <<
+					(sizeof(sVertex) * authoredVertexCount) << " bytes of vertex data became " << (sizeof(sVertex) * mVertexCount) <<
+					" (" << ((1.0f - (static_cast<float>(mVertexCount) / authoredVertexCount)) * 100.0f) << "% smaller)\n";
+			}
+		}
+		else
+		{
+			wereThereErrors = true;
+			eae6320::OutputErrorMessage("An index refers to a vertex that doesn't exist", m_path_source);
+		}
+		EndPhase("weld");
+	}
 
 
 	//Write to file
@@ -119,11 +216,127 @@ bool eae6320::cMeshBuilder::Build(const std::vector<std::string>&)
 		fopen_s(&oFile, m_path_target, "wb");
 		if (oFile != NULL)
 		{
-			fwrite(&mVertexCount, sizeof(uint32_t), 1, oFile);
-			fwrite(&mIndexCount, sizeof(uint32_t), 1, oFile);
-			fwrite(mVertexData, sizeof(sVertex), mVertexCount, oFile);
-			fwrite(mIndexData, sizeof(uint32_t), mIndexCount, oFile);
+			// The header identifies the format and stores the bounds that the engine culls with
+			Graphics::MeshFile::sHeader header;
+			header.magic = Graphics::MeshFile::s_magic;
+			header.version = Graphics::MeshFile::s_version;
+			header.vertexCount = mVertexCount;
+			Graphics::MeshFile::CalculateBounds(mVertexData, sizeof(sVertex), mVertexCount, header.bounds);
+			header.flags = 0;
+			header.encodedSize = 0;
+			header.positionFormat = Graphics::MeshFile::PositionFormat_float32;
+			for (size_t j = 0; j < 2; ++j)
+			{
+				header.positionScale[j] = 1.0f;
+				header.positionBias[j] = 0.0f;
+			}
+			// LOD 0 is the authored triangles,
+			// and the indices of every other LOD follow it
+			std::vector<uint32_t> indices(mIndexData, mIndexData + mIndexCount);
+			memset(header.lods, 0, sizeof(header.lods));
+			header.lodCount = 1;
+			header.lods[0].firstIndex = 0;
+			header.lods[0].indexCount = mIndexCount;
+			header.lods[0].error = 0.0f;
+			if (shouldGenerateLods)
+			{
+				std::vector<uint32_t> lodIndices;
+				const uint32_t authoredTriangleCount = mIndexCount / 3;
+				uint32_t previousTriangleCount = authoredTriangleCount;
+				while ((header.lodCount < Graphics::MeshFile::s_maxLodCount) && (previousTriangleCount > 1))
+				{
+					// Every LOD is simplified from the authored triangles
+					// so that its error is measured against them rather than against another approximation
+					const uint32_t targetTriangleCount = static_cast<uint32_t>(previousTriangleCount * s_targetLodTriangleRatio);
+					float error;
+					MeshSimplifier::Simplify(mVertexData, mVertexCount, sizeof(sVertex), mIndexData, mIndexCount, targetTriangleCount * 3,
+						lodIndices, error);
+					const uint32_t triangleCount = static_cast<uint32_t>(lodIndices.size() / 3);
+					if (triangleCount >= static_cast<uint32_t>(previousTriangleCount * s_maxLodTriangleRatio))
+					{
+						break;
+					}
+					Graphics::MeshFile::sLod & lod = header.lods[header.lodCount];
+					lod.firstIndex = static_cast<uint32_t>(indices.size());
+					lod.indexCount = static_cast<uint32_t>(lodIndices.size());
+					// The engine looks for the coarsest LOD that is accurate enough,
+					// and so the errors must never get smaller
+					lod.error = std::max(error, header.lods[header.lodCount - 1].error);
+					indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+					std::cout << m_path_source << ": LOD " << header.lodCount << " has " << triangleCount << " triangles (" <<
+						((static_cast<float>(triangleCount) / authoredTriangleCount) * 100.0f) << "% of LOD 0) with an error of " << lod.error << "\n";
+					++header.lodCount;
+					previousTriangleCount = triangleCount;
+				}
+				EndPhase("lods");
+			}
+			header.indexCount = static_cast<uint32_t>(indices.size());
+			const uint32_t * const indexData = indices.empty() ? NULL : &indices[0];
+
+			const void * vertexData = mVertexData;
+			std::vector<sQuantizedVertex> quantizedVertices;
+			if (shouldQuantize)
+			{
+				header.positionFormat = Graphics::MeshFile::PositionFormat_unorm16;
+				for (size_t j = 0; j < 2; ++j)
+				{
+					header.positionScale[j] = header.bounds.aabbMax[j] - header.bounds.aabbMin[j];
+					header.positionBias[j] = header.bounds.aabbMin[j];
+				}
+				// Report how far the quantized positions are from the authored ones
+				// so that meshes that need more precision can be built without "-quantize"
+				float maxError = 0.0f;
+				quantizedVertices.resize(mVertexCount);
+				for (uint32_t i = 0; i < mVertexCount; ++i)
+				{
+					const sVertex & vertex = mVertexData[i];
+					sQuantizedVertex & quantizedVertex = quantizedVertices[i];
+					quantizedVertex.x = Graphics::MeshFile::QuantizePosition(vertex.x, header.positionScale[0], header.positionBias[0]);
+					quantizedVertex.y = Graphics::MeshFile::QuantizePosition(vertex.y, header.positionScale[1], header.positionBias[1]);
+					quantizedVertex.r = vertex.r;
+					quantizedVertex.g = vertex.g;
+					quantizedVertex.b = vertex.b;
+					quantizedVertex.a = vertex.a;
+					const float errorX = std::abs(Graphics::MeshFile::DequantizePosition(quantizedVertex.x, header.positionScale[0], header.positionBias[0]) - vertex.x);
+					const float errorY = std::abs(Graphics::MeshFile::DequantizePosition(quantizedVertex.y, header.positionScale[1], header.positionBias[1]) - vertex.y);
+					maxError = std::max(maxError, std::max(errorX, errorY));
+				}
+				const float extent = std::max(header.positionScale[0], header.positionScale[1]);
+				std::cout << m_path_source << ": quantized positions to 16 bits with a max error of " << maxError;
+				if (extent > 0.0f)
+				{
+					std::cout << " (" << ((maxError / extent) * 100.0f) << "% of the bounds)";
+				}
+				std::cout << "\n";
+				vertexData = quantizedVertices.empty() ? NULL : &quantizedVertices[0];
+				EndPhase("quantize");
+			}
+			const size_t vertexSize = Graphics::MeshFile::GetVertexSize(header.positionFormat);
+			// The compressed geometry is only kept if it is actually smaller
+			std::vector<uint8_t> encoded;
+			if (shouldCompress)
+			{
+				MeshEncoder::Encode(vertexData, mVertexCount, vertexSize, indexData, header.indexCount, encoded);
+				const size_t rawSize = (vertexSize * mVertexCount) + (sizeof(uint32_t) * header.indexCount);
+				if (encoded.size() < rawSize)
+				{
+					header.flags |= Graphics::MeshFile::Flag_compressed;
+					header.encodedSize = static_cast<uint32_t>(encoded.size());
+				}
+				EndPhase("compress");
+			}
+			fwrite(&header, sizeof(header), 1, oFile);
+			if (header.flags & Graphics::MeshFile::Flag_compressed)
+			{
+				fwrite(&encoded[0], 1, encoded.size(), oFile);
+			}
+			else
+			{
+				fwrite(vertexData, vertexSize, mVertexCount, oFile);
+				fwrite(indexData, sizeof(uint32_t), header.indexCount, oFile);
+			}
 			fclose(oFile);
+			EndPhase("write");
 		}
 	}
 OnExit:
@@ -137,6 +350,7 @@ OnExit:
 
 		lua_close(luaState);
 		luaState = NULL;
+		std::cout << m_path_source << ": " << luaAllocator.GetStatsSummary() << "\n";
 	}
 	if (mVertexData)
 		delete mVertexData;
@@ -23,6 +23,16 @@ namespace eae6320
 			uint8_t r, g, b, a;
 #elif defined EAE6320_PLATFORM_D3D
 			uint8_t b, g, r, a;
+#endif
+		};
+		// The position is normalized across the mesh's bounds (see MeshFile.h)
+		struct sQuantizedVertex
+		{
+			uint16_t x, y;
+#if defined EAE6320_PLATFORM_GL
+			uint8_t r, g, b, a;
+#elif defined EAE6320_PLATFORM_D3D
+			uint8_t b, g, r, a;
 #endif
 		};
 	private:
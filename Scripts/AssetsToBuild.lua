@@ -2,6 +2,10 @@ return
 {
 	{
 		builder = "MeshBuilder.exe",
+		-- Meshes are compressed (they are only stored compressed if that makes them smaller),
+		-- their positions are quantized to 16 bits (MeshBuilder reports the error for each mesh),
+		-- and simplified levels of detail are generated for them
+		arguments = "-compress -quantize -lods",
 		assets = 
 		{
 			{source = "rectangle.msh", target = "rectangle.msh"},
@@ -10,6 +14,9 @@ return
 	},
 	{
 		builder = "GenericBuilder.exe",
+		-- Shaders can #include "files" that are relative to them
+		-- (the engine compiles shaders from memory, and so the builder copies the included files into them)
+		arguments = "-expandIncludes",
 		assets = 
 		{
 			{source = "vertex.shader", target = "vertex.shader"},
@@ -40,9 +40,9 @@ end
 -- Function Definitions
 --=====================
 
--- EAE6320_TODO: I have shown the simplest parameters to BuildAsset() that are possible.
+-- EAE6320_TODO: I have shown the simplest parameters to DescribeAsset() that are possible.
 -- You should definitely feel free to change these
-local function BuildAsset( i_builderFileName, i_sourcePath, i_targetPath )
+local function DescribeAsset( i_builderFileName, i_sourcePath, i_targetPath, i_optionalArguments )
 	-- Get the absolute paths to the source and target
 	-- EAE6320_TODO: I am assuming that the relative path of the source and target is the same,
 	-- but if this isn't true for you (i.e. you use different extensions)
@@ -55,7 +55,7 @@ local function BuildAsset( i_builderFileName, i_sourcePath, i_targetPath )
 		local doesSourceExist = DoesFileExist( path_source )
 		if not doesSourceExist then
 			OutputErrorMessage( "The source asset doesn't exist", path_source )
-			return false
+			return nil
 		end
 	end
 
@@ -73,101 +73,667 @@ local function BuildAsset( i_builderFileName, i_sourcePath, i_targetPath )
 		end
 	end
 
-	-- Decide if the target needs to be built
-	local shouldTargetBeBuilt
-	do
-		-- The simplest reason a target should be built is if it doesn't exist
-		local doesTargetExist = DoesFileExist( path_target )
-		if doesTargetExist then
-			-- Even if the target exists it may be out-of-date.
-			-- If the source has been modified more recently than the target
-			-- then the target should be re-built.
-			local lastWriteTime_source = GetLastWriteTime( path_source )
-			local lastWriteTime_target = GetLastWriteTime( path_target )
-			shouldTargetBeBuilt = lastWriteTime_source > lastWriteTime_target
-			if not shouldTargetBeBuilt then
-				-- Even if the target was built from the current source
-				-- the builder may have changed which could cause different output
-				local lastWriteTime_builder = GetLastWriteTime( path_builder )
-				shouldTargetBeBuilt = lastWriteTime_builder > lastWriteTime_target
+	return
+	{
+		builder = i_builderFileName, source = i_sourcePath, target = i_targetPath, arguments = i_optionalArguments or "",
+		path_source = path_source, path_target = path_target, path_builder = path_builder,
+	}
+end
+
+-- The Build Graph
+--================
+
+-- The build graph remembers what every target was built from:
+-- its builder and arguments and every file that the builder read
+-- (builders write these to a dependency file next to the target, like a compiler's .d file).
+-- A target is rebuilt when any of them change,
+-- and a target that was built from another target is built after it.
+-- The graph is saved with the targets between builds
+local s_buildGraphFileName = "BuildGraph.lua"
+local s_dependencyFileExtension = ".d"
+local s_timingFileExtension = ".timing"
+
+-- Paths are compared without case and with the same slashes
+local function NormalizePath( i_path )
+	return ( string.gsub( string.lower( i_path ), "\\", "/" ) )
+end
+
+local function LoadBuildGraph()
+	local path_buildGraph = s_BuiltAssetDir .. s_buildGraphFileName
+	if DoesFileExist( path_buildGraph ) then
+		-- The graph is only data, and so it is loaded without access to any functions
+		local chunk = loadfile( path_buildGraph, "t", {} )
+		if chunk then
+			local result, buildGraph = pcall( chunk )
+			if result and ( type( buildGraph ) == "table" ) then
+				return buildGraph
+			end
+		end
+		-- If the graph can't be read every target is rebuilt (and the graph is saved again)
+		print( "The build graph (\"" .. path_buildGraph .. "\") couldn't be read, and so every asset will be built" )
+	end
+	return {}
+end
+
+local function SaveBuildGraph( i_buildGraph )
+	local path_buildGraph = s_BuiltAssetDir .. s_buildGraphFileName
+	local file, errorMessage = io.open( path_buildGraph, "w" )
+	if not file then
+		OutputErrorMessage( "The build graph couldn't be saved: " .. errorMessage, path_buildGraph )
+		return false
+	end
+	-- The targets are sorted so that the file only changes when the graph does
+	local targetPaths = {}
+	for targetPath in pairs( i_buildGraph ) do
+		targetPaths[#targetPaths + 1] = targetPath
+	end
+	table.sort( targetPaths )
+	file:write( "return\n{\n" )
+	for i, targetPath in ipairs( targetPaths ) do
+		local node = i_buildGraph[targetPath]
+		file:write( "\t[", string.format( "%q", targetPath ), "] =\n\t{\n" )
+		file:write( "\t\tbuilder = ", string.format( "%q", node.builder ), ",\n" )
+		file:write( "\t\tsource = ", string.format( "%q", node.source ), ",\n" )
+		file:write( "\t\targuments = ", string.format( "%q", node.arguments ), ",\n" )
+		file:write( "\t\tdependencies =\n\t\t{\n" )
+		for j, path_dependency in ipairs( node.dependencies ) do
+			file:write( "\t\t\t", string.format( "%q", path_dependency ), ",\n" )
+		end
+		file:write( "\t\t},\n\t},\n" )
+	end
+	file:write( "}\n" )
+	local result
+	result, errorMessage = file:close()
+	if not result then
+		OutputErrorMessage( "The build graph couldn't be saved: " .. errorMessage, path_buildGraph )
+		return false
+	end
+	return true
+end
+
+local function GetMillisecondsSince( i_startTime )
+	return ( GetTime() - i_startTime ) * 1000
+end
+
+local function ReadDependencyFile( i_asset )
+	local path_dependencyFile = i_asset.path_target .. s_dependencyFileExtension
+	local dependencies = {}
+	local file = io.open( path_dependencyFile, "r" )
+	if file then
+		for path_dependency in file:lines() do
+			if path_dependency ~= "" then
+				dependencies[#dependencies + 1] = path_dependency
+			end
+		end
+		file:close()
+		-- Everything in the file is now in the build graph
+		os.remove( path_dependencyFile )
+	end
+	-- A builder that doesn't write a dependency file only depends on its source
+	if #dependencies == 0 then
+		dependencies[1] = i_asset.path_source
+	end
+	return dependencies
+end
+
+-- Returns the phases that the builder reported in the order it reported them
+local function ReadTimingFile( i_asset )
+	local path_timingFile = i_asset.path_target .. s_timingFileExtension
+	local phases = {}
+	local file = io.open( path_timingFile, "r" )
+	if file then
+		for line in file:lines() do
+			local name, milliseconds = string.match( line, "^(%S+)%s+(%S+)$" )
+			milliseconds = tonumber( milliseconds )
+			if name and milliseconds then
+				phases[#phases + 1] = { name = name, milliseconds = milliseconds }
+			end
+		end
+		file:close()
+		os.remove( path_timingFile )
+	end
+	return phases
+end
+
+-- Returns the assets ordered so that every asset comes after the assets that it was built from,
+-- or nil if the assets were built from each other in a cycle.
+-- The order comes from the previous build's graph:
+-- if a builder starts reading another target it might be built first once,
+-- but then it is older than the other target and is rebuilt in the next build
+local function SortAssets( i_assets, i_buildGraph )
+	local assetsByTarget = {}
+	for i, asset in ipairs( i_assets ) do
+		assetsByTarget[NormalizePath( asset.path_target )] = asset
+		asset.inputs = {}
+		asset.dependents = {}
+	end
+	for i, asset in ipairs( i_assets ) do
+		local node = i_buildGraph[asset.target]
+		if node then
+			local isInput = {}
+			for j, path_dependency in ipairs( node.dependencies ) do
+				local input = assetsByTarget[NormalizePath( path_dependency )]
+				if input and ( input ~= asset ) and not isInput[input] then
+					isInput[input] = true
+					asset.inputs[#asset.inputs + 1] = input
+					input.dependents[#input.dependents + 1] = asset
+				end
+			end
+		end
+	end
+
+	-- Assets with nothing left to wait for are added in the order they are listed
+	local sortedAssets = {}
+	local unsortedInputCounts = {}
+	for i, asset in ipairs( i_assets ) do
+		unsortedInputCounts[asset] = #asset.inputs
+		if #asset.inputs == 0 then
+			sortedAssets[#sortedAssets + 1] = asset
+		end
+	end
+	local i = 1
+	while i <= #sortedAssets do
+		for j, dependent in ipairs( sortedAssets[i].dependents ) do
+			unsortedInputCounts[dependent] = unsortedInputCounts[dependent] - 1
+			if unsortedInputCounts[dependent] == 0 then
+				sortedAssets[#sortedAssets + 1] = dependent
 			end
-		else
-			shouldTargetBeBuilt = true;
 		end
+		i = i + 1
 	end
+	if #sortedAssets < #i_assets then
+		for i, asset in ipairs( i_assets ) do
+			if unsortedInputCounts[asset] > 0 then
+				OutputErrorMessage( "The target is built from other targets that are built from it", asset.path_source )
+				-- Its edges are forgotten so that the next build finds out whether the cycle still exists
+				i_buildGraph[asset.target] = nil
+			end
+		end
+		return nil
+	end
+	return sortedAssets
+end
 
-	-- Build the target if necessary
-	if shouldTargetBeBuilt then
-		-- Create the target directory if necessary
-		CreateDirectoryIfNecessary( path_target )
-		-- Build
+local function IsTargetOutOfDate( i_asset, i_node )
+	-- A target that wasn't built by the same builder from the same source with the same arguments is out-of-date
+	if not i_node or ( i_node.builder ~= i_asset.builder ) or ( i_node.source ~= i_asset.source ) or ( i_node.arguments ~= i_asset.arguments ) then
+		return true
+	end
+	-- The simplest reason a target should be built is if it doesn't exist
+	if not DoesFileExist( i_asset.path_target ) then
+		return true
+	end
+	-- Even if the target exists it may be out-of-date
+	-- if the builder or anything the target was built from has been modified more recently than the target
+	-- (or if a dependency has been deleted, in which case the builder will probably report an error)
+	local lastWriteTime_target = GetLastWriteTime( i_asset.path_target )
+	if GetLastWriteTime( i_asset.path_builder ) > lastWriteTime_target then
+		return true
+	end
+	for i, path_dependency in ipairs( i_node.dependencies ) do
+		if not DoesFileExist( path_dependency ) or ( GetLastWriteTime( path_dependency ) > lastWriteTime_target ) then
+			return true
+		end
+	end
+	return false
+end
+
+local function FinishBuildingAsset( i_asset, i_commandLine, i_result, io_buildGraph )
+	i_asset.milliseconds = i_result.milliseconds or 0
+	i_asset.phases = ReadTimingFile( i_asset )
+	if i_result.exitCode == 0 then
+		io_buildGraph[i_asset.target] =
+		{
+			builder = i_asset.builder, source = i_asset.source, arguments = i_asset.arguments,
+			dependencies = ReadDependencyFile( i_asset ),
+		}
+		-- Display a message for each asset
+		print( "Built " .. i_asset.path_source )
+		-- If the game is running it reloads the target
+		NotifyRunningGame( i_asset.target )
+		return true
+	else
+		-- The builder should already output a descriptive error message if there was an error
+		-- (remember that you write the builder code,
+		-- and so if the build process failed it means that _your_ code has returned an error code)
+		-- but it can be helpful to still return an additional vague error message here
+		-- in case there is a bug in the specific builder that doesn't output an error message
 		do
-			-- The command starts with the builder
-			local command = "\"" .. path_builder .. "\""
-			-- The source and target path must always be passed in
-			local arguments = "\"" .. path_source .. "\" \"" .. path_target .. "\""
-			-- If you create a mechanism so that some asset types could include extra arguments
-			-- you would concatenate them here, something like:
-			-- arguments = arguments .. " " .. i_optionalArguments
-			-- IMPORTANT NOTE:
-			-- If you need to debug a builder you can put print statements here to
-			-- find out what the exact command line should be.
-			-- "command" should go in Debugging->Command
-			-- "arguments" should go in Debugging->Command Arguments
-
-			-- Surround the entire command line in quotes
-			local commandLine = "\"" .. command .. " " .. arguments .. "\""
-			local result, terminationType, exitCode = os.execute( commandLine )
-			if result then
-				-- Display a message for each asset
-				print( "Built " .. path_source )
-				-- Return the exit code for informational purposes since we have it
-				return true, exitCode
+			local errorMessage = "The command " .. i_commandLine
+			if i_result.exitCode then
+				errorMessage = errorMessage .. " exited with code " .. tostring( i_result.exitCode )
 			else
-				-- The builder should already output a descriptive error message if there was an error
-				-- (remember that you write the builder code,
-				-- and so if the build process failed it means that _your_ code has returned an error code)
-				-- but it can be helpful to still return an additional vague error message here
-				-- in case there is a bug in the specific builder that doesn't output an error message
-				do
-					local errorMessage = "The command " .. tostring( commandLine )
-					if terminationType ~= "signal" then
-						errorMessage = errorMessage .. " exited with code "
-					else
-						errorMessage = errorMessage .. " was terminated by the signal "
+				errorMessage = errorMessage .. " couldn't be run: " .. tostring( i_result.errorMessage )
+			end
+			OutputErrorMessage( errorMessage, i_asset.path_source )
+		end
+		-- There's a chance that the builder already created the target file,
+		-- in which case it will have a new time stamp and wouldn't get built again
+		-- even though the process failed
+		if DoesFileExist( i_asset.path_target ) then
+			local result, errorMessage = os.remove( i_asset.path_target )
+			if not result then
+				OutputErrorMessage( "Failed to delete the incorrectly-built target: " .. errorMessage, i_asset.path_target )
+			end
+		end
+		-- The target's node is kept so that the next build still knows what it is built from
+		-- (it will be rebuilt because the target doesn't exist)
+		return false
+	end
+end
+
+-- Builds every asset that is out-of-date
+-- (which includes assets that are built from other assets that are out-of-date).
+-- The assets are built in waves: every asset in a wave is only built from assets in earlier waves,
+-- and so all of the builders in a wave run at the same time.
+-- How long everything takes is added to the report
+local function BuildOutOfDateAssets( i_assets, io_report )
+	local wereThereErrors = false
+
+	local startTime = GetTime()
+	local buildGraph = LoadBuildGraph()
+	-- Anything in the graph that isn't listed as an asset anymore is forgotten
+	do
+		local listedTargets = {}
+		for i, asset in ipairs( i_assets ) do
+			listedTargets[asset.target] = true
+		end
+		for targetPath, node in pairs( buildGraph ) do
+			if not listedTargets[targetPath] or ( type( node ) ~= "table" ) or ( type( node.dependencies ) ~= "table" ) then
+				buildGraph[targetPath] = nil
+			end
+		end
+	end
+
+	io_report.phases.loadGraph = GetMillisecondsSince( startTime )
+
+	startTime = GetTime()
+	local sortedAssets = SortAssets( i_assets, buildGraph )
+	if sortedAssets then
+		-- Decide which targets need to be built and in which wave
+		local waves = {}
+		for i, asset in ipairs( sortedAssets ) do
+			local wave = 1
+			local shouldTargetBeBuilt = IsTargetOutOfDate( asset, buildGraph[asset.target] )
+			for j, input in ipairs( asset.inputs ) do
+				if input.wave then
+					shouldTargetBeBuilt = true
+					wave = math.max( wave, input.wave + 1 )
+				end
+			end
+			if shouldTargetBeBuilt then
+				asset.wave = wave
+				waves[wave] = waves[wave] or {}
+				table.insert( waves[wave], asset )
+			end
+		end
+		io_report.phases.checkTargets = GetMillisecondsSince( startTime )
+
+		-- Build them
+		startTime = GetTime()
+		io_report.sortedAssets = sortedAssets
+		io_report.waves = {}
+		for i, wave in ipairs( waves ) do
+			local assetsToBuild = {}
+			local commandLines = {}
+			for j, asset in ipairs( wave ) do
+				-- An asset can't be built if something that it is built from failed
+				local failedInput
+				for k, input in ipairs( asset.inputs ) do
+					if input.hasFailed then
+						failedInput = input
+						break
 					end
-					errorMessage = errorMessage .. tostring( exitCode )
-					OutputErrorMessage( errorMessage, path_source )
 				end
-				-- There's a chance that the builder already created the target file,
-				-- in which case it will have a new time stamp and wouldn't get built again
-				-- even though the process failed
-				if DoesFileExist( path_target ) then
-					local result, errorMessage = os.remove( path_target )
-					if not result then
-						OutputErrorMessage( "Failed to delete the incorrectly-built target: " .. errorMessage, path_target )
+				if failedInput then
+					asset.hasFailed = true
+					wereThereErrors = true
+					OutputErrorMessage( "The target wasn't built because \"" .. failedInput.path_source .. "\" failed to build", asset.path_source )
+				else
+					-- Create the target directory if necessary
+					CreateDirectoryIfNecessary( asset.path_target )
+					-- A dependency file from an earlier build must never be mistaken for this build's
+					os.remove( asset.path_target .. s_dependencyFileExtension )
+					-- The command starts with the builder
+					local command = "\"" .. asset.path_builder .. "\""
+					-- The source and target path must always be passed in
+					local arguments = "\"" .. asset.path_source .. "\" \"" .. asset.path_target .. "\""
+					-- Some asset types (or individual assets) include extra arguments
+					if asset.arguments ~= "" then
+						arguments = arguments .. " " .. asset.arguments
 					end
+					-- IMPORTANT NOTE:
+					-- If you need to debug a builder you can put print statements here to
+					-- find out what the exact command line should be.
+					-- "command" should go in Debugging->Command
+					-- "arguments" should go in Debugging->Command Arguments
+					assetsToBuild[#assetsToBuild + 1] = asset
+					commandLines[#commandLines + 1] = command .. " " .. arguments
 				end
+			end
+			local waveStartTime = GetTime()
+			local results = {}
+			if #commandLines > 0 then
+				results, io_report.maxProcessCount = RunCommands( commandLines )
+			end
+			io_report.waves[i] = { assetCount = #commandLines, milliseconds = GetMillisecondsSince( waveStartTime ) }
+			for j, asset in ipairs( assetsToBuild ) do
+				asset.wasRun = true
+				if not FinishBuildingAsset( asset, commandLines[j], results[j], buildGraph ) then
+					asset.hasFailed = true
+					wereThereErrors = true
+				end
+			end
+		end
+		io_report.phases.buildTargets = GetMillisecondsSince( startTime )
+	else
+		wereThereErrors = true
+	end
+
+	startTime = GetTime()
+	if not SaveBuildGraph( buildGraph ) then
+		wereThereErrors = true
+	end
+	io_report.phases.saveGraph = GetMillisecondsSince( startTime )
+
+	return not wereThereErrors
+end
+
+-- Every built asset is also put into a single pack
+-- so that the game can find them without opening each file
+-- (the loose files are still used if there is no pack)
+local s_assetPackFileName = "assets.pak"
+
+local function PackAssets( i_targetPaths )
+	local path_pack = s_BuiltAssetDir .. s_assetPackFileName
+
+	-- The pack only needs to be rebuilt if one of the targets is newer than it
+	local shouldPackBeBuilt = not DoesFileExist( path_pack )
+	if not shouldPackBeBuilt then
+		local lastWriteTime_pack = GetLastWriteTime( path_pack )
+		for i, targetPath in ipairs( i_targetPaths ) do
+			if GetLastWriteTime( s_BuiltAssetDir .. targetPath ) > lastWriteTime_pack then
+				shouldPackBeBuilt = true
+				break
+			end
+		end
+	end
+
+	if shouldPackBeBuilt then
+		local result, errorMessage = BuildAssetPack( path_pack, s_BuiltAssetDir, i_targetPaths )
+		if result then
+			print( "Built " .. path_pack .. " (" .. #i_targetPaths .. " assets)" )
+		else
+			OutputErrorMessage( errorMessage, path_pack )
+			return false
+		end
+	end
+	return true
+end
+
+-- The Build Report
+--=================
+
+-- Every build that runs a builder writes a report of where its time went
+-- next to the targets (and prints a summary of it)
+-- so that optimizations can be aimed at whatever is actually slow
+local s_buildReportFileName = "BuildReport.json"
+local s_slowestAssetCountToPrint = 5
 
-				return false, exitCode
+-- Tables with an array part are written as JSON arrays and other tables as objects
+local function EncodeJson( i_value, i_indentation )
+	local valueType = type( i_value )
+	if valueType == "table" then
+		local indentation = i_indentation .. "\t"
+		local elements = {}
+		if #i_value > 0 then
+			for i, element in ipairs( i_value ) do
+				elements[i] = indentation .. EncodeJson( element, indentation )
 			end
+			return "[\n" .. table.concat( elements, ",\n" ) .. "\n" .. i_indentation .. "]"
+		else
+			-- The keys are sorted so that reports can be compared
+			local keys = {}
+			for key in pairs( i_value ) do
+				keys[#keys + 1] = tostring( key )
+			end
+			if #keys == 0 then
+				return "{}"
+			end
+			table.sort( keys )
+			for i, key in ipairs( keys ) do
+				elements[i] = indentation .. EncodeJson( key, indentation ) .. ": " .. EncodeJson( i_value[key], indentation )
+			end
+			return "{\n" .. table.concat( elements, ",\n" ) .. "\n" .. i_indentation .. "}"
+		end
+	elseif valueType == "string" then
+		return "\"" .. string.gsub( i_value, "[%c\"\\]", function( i_character )
+				return string.format( "\\u%04x", string.byte( i_character ) )
+			end ) .. "\""
+	elseif valueType == "number" then
+		if i_value == math.floor( i_value ) then
+			return string.format( "%d", i_value )
+		else
+			return string.format( "%.3f", i_value )
 		end
 	else
+		return tostring( i_value )
+	end
+end
+
+local function FormatMilliseconds( i_milliseconds )
+	return string.format( "%.1f ms", i_milliseconds )
+end
+
+local function FormatAssetCount( i_assetCount )
+	return i_assetCount .. ( ( i_assetCount == 1 ) and " asset" or " assets" )
+end
+
+local function FormatPhases( i_phases )
+	local formattedPhases = {}
+	for i, phase in ipairs( i_phases ) do
+		formattedPhases[i] = phase.name .. " " .. FormatMilliseconds( phase.milliseconds )
+	end
+	return table.concat( formattedPhases, ", " )
+end
+
+-- Returns false if the report couldn't be written
+local function WriteBuildReport( i_report )
+	if not i_report.sortedAssets then
 		return true
 	end
+	local builtAssets = {}
+	for i, asset in ipairs( i_report.sortedAssets ) do
+		if asset.wasRun then
+			builtAssets[#builtAssets + 1] = asset
+		end
+	end
+	if #builtAssets == 0 then
+		return true
+	end
+
+	-- The time that each asset's process ran but that its builder didn't report
+	-- is how long it took to start and stop the process
+	for i, asset in ipairs( builtAssets ) do
+		local reportedMilliseconds = 0
+		for j, phase in ipairs( asset.phases ) do
+			reportedMilliseconds = reportedMilliseconds + phase.milliseconds
+		end
+		asset.phases[#asset.phases + 1] = { name = "process", milliseconds = math.max( asset.milliseconds - reportedMilliseconds, 0 ) }
+	end
+
+	-- The totals for each builder
+	local builders = {}
+	do
+		local buildersByName = {}
+		for i, asset in ipairs( builtAssets ) do
+			local builder = buildersByName[asset.builder]
+			if not builder then
+				builder = { builder = asset.builder, assetCount = 0, milliseconds = 0, phases = {}, phasesByName = {} }
+				buildersByName[asset.builder] = builder
+				builders[#builders + 1] = builder
+			end
+			builder.assetCount = builder.assetCount + 1
+			builder.milliseconds = builder.milliseconds + asset.milliseconds
+			for j, phase in ipairs( asset.phases ) do
+				local builderPhase = builder.phasesByName[phase.name]
+				if not builderPhase then
+					builderPhase = { name = phase.name, milliseconds = 0 }
+					builder.phasesByName[phase.name] = builderPhase
+					builder.phases[#builder.phases + 1] = builderPhase
+				end
+				builderPhase.milliseconds = builderPhase.milliseconds + phase.milliseconds
+			end
+		end
+		for i, builder in ipairs( builders ) do
+			builder.phasesByName = nil
+		end
+		table.sort( builders, function( i_lhs, i_rhs ) return i_lhs.milliseconds > i_rhs.milliseconds end )
+	end
+
+	-- The critical path is the slowest chain of assets that had to be built one after another,
+	-- and no amount of parallelism could make the build faster than it
+	local criticalPath = { milliseconds = 0, targets = {} }
+	do
+		local lastAsset
+		-- The assets are sorted, and so every asset's inputs have already been visited
+		for i, asset in ipairs( builtAssets ) do
+			asset.pathMilliseconds = asset.milliseconds
+			for j, input in ipairs( asset.inputs ) do
+				if input.wasRun and ( ( input.pathMilliseconds + asset.milliseconds ) > asset.pathMilliseconds ) then
+					asset.pathMilliseconds = input.pathMilliseconds + asset.milliseconds
+					asset.pathInput = input
+				end
+			end
+			if asset.pathMilliseconds > criticalPath.milliseconds then
+				criticalPath.milliseconds = asset.pathMilliseconds
+				lastAsset = asset
+			end
+		end
+		local asset = lastAsset
+		while asset do
+			table.insert( criticalPath.targets, 1, asset.target )
+			asset = asset.pathInput
+		end
+	end
+
+	-- The parallel efficiency is how much of the time that builders could have been running they actually were
+	local builderMilliseconds = 0
+	for i, asset in ipairs( builtAssets ) do
+		builderMilliseconds = builderMilliseconds + asset.milliseconds
+	end
+	local largestWaveAssetCount = 0
+	for i, wave in ipairs( i_report.waves ) do
+		largestWaveAssetCount = math.max( largestWaveAssetCount, wave.assetCount )
+	end
+	local processCount = math.min( i_report.maxProcessCount or 1, largestWaveAssetCount )
+	local parallelEfficiency = 1
+	if i_report.phases.buildTargets > 0 then
+		parallelEfficiency = math.min( builderMilliseconds / ( i_report.phases.buildTargets * processCount ), 1 )
+	end
+
+	-- The slowest assets come first
+	table.sort( builtAssets, function( i_lhs, i_rhs ) return i_lhs.milliseconds > i_rhs.milliseconds end )
+
+	-- Write the report
+	local path_buildReport = s_BuiltAssetDir .. s_buildReportFileName
+	do
+		local assets = {}
+		for i, asset in ipairs( builtAssets ) do
+			assets[i] =
+			{
+				target = asset.target, source = asset.source, builder = asset.builder, wave = asset.wave,
+				succeeded = not asset.hasFailed, milliseconds = asset.milliseconds, phases = asset.phases,
+			}
+		end
+		local report =
+		{
+			totalMilliseconds = i_report.totalMilliseconds, phases = i_report.phases,
+			builderMilliseconds = builderMilliseconds, processCount = processCount, parallelEfficiency = parallelEfficiency,
+			waves = i_report.waves, criticalPath = criticalPath, builders = builders, assets = assets,
+		}
+		local file, errorMessage = io.open( path_buildReport, "w" )
+		if not file then
+			OutputErrorMessage( "The build report couldn't be written: " .. errorMessage, path_buildReport )
+			return false
+		end
+		file:write( EncodeJson( report, "" ), "\n" )
+		local result
+		result, errorMessage = file:close()
+		if not result then
+			OutputErrorMessage( "The build report couldn't be written: " .. errorMessage, path_buildReport )
+			return false
+		end
+	end
+
+	-- Print a summary of it
+	do
+		local phases = i_report.phases
+		print( "Built " .. FormatAssetCount( #builtAssets ) .. " in " .. FormatMilliseconds( i_report.totalMilliseconds ) ..
+			" (see \"" .. path_buildReport .. "\")" )
+		print( "\tAssetBuilder: " .. FormatPhases( {
+				{ name = "loading the graph", milliseconds = phases.loadGraph or 0 },
+				{ name = "checking targets", milliseconds = phases.checkTargets or 0 },
+				{ name = "building", milliseconds = phases.buildTargets or 0 },
+				{ name = "saving the graph", milliseconds = phases.saveGraph or 0 },
+				{ name = "packing", milliseconds = phases.pack or 0 },
+			} ) )
+		print( "\tBuilders ran for " .. FormatMilliseconds( builderMilliseconds ) .. " in " .. #i_report.waves ..
+			" waves with up to " .. processCount .. " at once (" .. string.format( "%.0f", parallelEfficiency * 100 ) .. "% parallel efficiency)" )
+		print( "\tCritical path: " .. FormatMilliseconds( criticalPath.milliseconds ) .. " (" .. table.concat( criticalPath.targets, " -> " ) .. ")" )
+		print( "\tSlowest assets:" )
+		for i = 1, math.min( #builtAssets, s_slowestAssetCountToPrint ) do
+			local asset = builtAssets[i]
+			print( "\t\t" .. FormatMilliseconds( asset.milliseconds ) .. "\t" .. asset.target .. " (" .. FormatPhases( asset.phases ) .. ")" )
+		end
+		print( "\tBuilders:" )
+		for i, builder in ipairs( builders ) do
+			print( "\t\t" .. FormatMilliseconds( builder.milliseconds ) .. "\t" .. builder.builder .. ", " .. FormatAssetCount( builder.assetCount ) ..
+				" (" .. FormatPhases( builder.phases ) .. ")" )
+		end
+	end
+
+	return true
 end
 
-local function BuildAssets( i_assetsToBuild )
+local function BuildAssets( i_assetsToBuild, i_isWatching )
 	local wereThereErrors = false
+	local targetPaths = {}
+	local assets = {}
+	local report = { phases = {} }
+	local startTime = GetTime()
 
 	for i, assetType in ipairs(i_assetsToBuild) do
 		local builderName = assetType.builder
 		for i, asset in ipairs(assetType.assets) do
-			if not BuildAsset(builderName, asset.source, asset.target) then
+			-- An asset's own arguments replace the arguments of its type
+			local arguments = asset.arguments or assetType.arguments
+			local describedAsset = DescribeAsset(builderName, asset.source, asset.target, arguments)
+			if describedAsset then
+				assets[#assets + 1] = describedAsset
+			else
 				wereThereErrors = true
 			end
+			targetPaths[#targetPaths + 1] = asset.target
 		end
 	end
+	if not BuildOutOfDateAssets( assets, report ) then
+		wereThereErrors = true
+	end
+	-- A pack is only built from a complete set of assets,
+	-- and it isn't rebuilt while AssetBuilder is watching for changes
+	-- (a running game has the pack open and reloads the loose files instead)
+	if not wereThereErrors and not i_isWatching then
+		local packStartTime = GetTime()
+		if not PackAssets( targetPaths ) then
+			wereThereErrors = true
+		end
+		report.phases.pack = GetMillisecondsSince( packStartTime )
+	end
+	report.totalMilliseconds = GetMillisecondsSince( startTime )
+	if not WriteBuildReport( report ) then
+		wereThereErrors = true
+	end
 	-- EAE620_TODO
 
 	-- "i_assetsToBuild" should be the exact table that you return from AssetsToBuild.lua,
@@ -250,12 +816,13 @@ end
 --============
 
 -- Command line arguments are represented in Lua as three dots ("...")
-local commandLineArgument = ...
+-- (the second argument is true when AssetBuilder is watching for changes)
+local commandLineArgument, isWatching = ...
 if commandLineArgument then
 	local path_assetsToBuild = commandLineArgument
 	if DoesFileExist( path_assetsToBuild ) then
 		local assetsToBuild = dofile( path_assetsToBuild )
-		return BuildAssets( assetsToBuild )
+		return BuildAssets( assetsToBuild, isWatching )
 	else
 		OutputErrorMessage( "The path to the list of assets to build that was provided to BuildAssets.lua as argument #1 (\"" ..
 			path_assetsToBuild .. "\") doesn't exist" )